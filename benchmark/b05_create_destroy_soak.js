@@ -0,0 +1,57 @@
+
+
+// Creates and destroys threads with pending jobs for a while and checks that
+// the RSS doesn't keep growing once it has warmed up.
+// node b05_create_destroy_soak.js [seconds] [threadsPerRound]
+
+var T= require('webworker-threads');
+
+var seconds= +process.argv[2] || 60;
+var k= +process.argv[3] || 4;
+var big= new Array(1e4+ 1).join('x');
+var i= 0;
+var callbacks= 0;
+var baseline= 0;
+var peak= 0;
+var stop= false;
+
+function cb (err, data) {
+  callbacks++;
+}
+
+(function again () {
+  var j= k;
+  while (j--) {
+    var t= T.create();
+    t.eval('"'+ big+ '".length', cb);
+    t.eval('while (Date.now() < '+ (Date.now()+ 5)+ ');', cb);
+    t.emit('event', big);
+    t.eval('"pending"', cb);
+    t.destroy();
+  }
+  i+= k;
+  if (!stop) setTimeout(again, 1);
+})();
+
+
+var t0= Date.now();
+function display () {
+  var e= Date.now()- t0;
+  var rss= process.memoryUsage().rss;
+  if (e > 10e3 && !baseline) baseline= rss;
+  if (baseline && rss > peak) peak= rss;
+  console.log('t (ms) -> '+ e+ ', created/destroyed -> '+ i+ ', callbacks -> '+ callbacks+ ', rss (MB) -> '+ (rss/1048576).toFixed(1));
+  if (e >= seconds* 1e3) {
+    stop= true;
+    clearInterval(interval);
+    var growth= baseline ? (peak- baseline)/ baseline : 0;
+    console.log('baseline rss (MB) -> '+ (baseline/1048576).toFixed(1)+ ', peak rss (MB) -> '+ (peak/1048576).toFixed(1)+ ', growth -> '+ (growth*100).toFixed(1)+ '%');
+    if (growth > 0.2) {
+      console.log('FAIL: the RSS keeps growing');
+      process.exit(1);
+    }
+    console.log('OK: flat RSS');
+  }
+}
+
+var interval= setInterval(display, 1e3);
@@ -0,0 +1,48 @@
+
+
+// Queues a burst of jobs, then sits idle and shows how the free lists (and
+// the RSS) shrink back once they're trimmed.
+// node b06_burst_then_idle.js [jobs] [threads] [idleSeconds]
+
+var T= require('webworker-threads');
+
+var jobs= +process.argv[2] || 1e5;
+var n= +process.argv[3] || 4;
+var idleSeconds= +process.argv[4] || 10;
+var threads= [];
+var done= 0;
+var t0= Date.now();
+
+function mb (bytes) {
+  return (bytes/1048576).toFixed(1)+ 'MB';
+}
+
+function show (label) {
+  var s= T.stats();
+  console.log(label+ ' rss: '+ mb(process.memoryUsage().rss)+ ', freeJobs: '+ s.freeJobs+ ', freeItems: '+ s.freeItems+ ', freeThreads: '+ s.freeThreads);
+}
+
+function cb (err, data) {
+  if (++done < jobs) return;
+  show('burst done in '+ (Date.now()- t0)+ 'ms,');
+  threads.forEach(function (t) { t.destroy() });
+  var seconds= 0;
+  var interval= setInterval(function () {
+    show('idle '+ (++seconds)+ 's,');
+    if (seconds >= idleSeconds) {
+      clearInterval(interval);
+      var s= T.stats();
+      if (s.freeJobs > s.freeListLowWater || s.freeItems > s.freeListLowWater) {
+        console.log('FAIL: the free lists were not trimmed');
+        process.exit(1);
+      }
+      console.log('OK: the free lists are back to their low watermark');
+    }
+  }, 1e3);
+}
+
+show('before,');
+while (n--) threads.push(T.create());
+var i= jobs;
+while (i--) threads[i % threads.length].eval('0', cb);
+show('queued,');
@@ -0,0 +1,54 @@
+
+
+// pool.sort() versus Array.prototype.sort and a single thread, and
+// pool.binarySearchMany(), at 1..maxThreads threads.
+// node b07_parallel_sort.js [elements] [maxThreads] [queries]
+
+var T= require('webworker-threads');
+
+var length= +process.argv[2] || 5e6;
+var maxThreads= +process.argv[3] || 8;
+var queries= +process.argv[4] || 1e6;
+
+function randomArray (n) {
+  var a= new Float64Array(n);
+  while (n--) a[n]= Math.random();
+  return a;
+}
+
+function checkSorted (a) {
+  var i= a.length;
+  while (--i > 0) if (a[i- 1] > a[i]) throw 'not sorted at '+ i;
+}
+
+var jsLength= Math.min(length, 1e6);
+var a= randomArray(jsLength);
+var t0= Date.now();
+Array.prototype.sort.call(a, function (x, y) { return x- y });
+var jsTime= (Date.now()- t0)* length/ jsLength;
+console.log('Array.prototype.sort: '+ jsTime.toFixed(0)+ 'ms'+ (jsLength < length ? ' (extrapolated from '+ jsLength+ ' elements)' : ''));
+
+var singleTime;
+var n= 1;
+(function next () {
+  if (n > maxThreads) return;
+  var pool= T.createPool(n);
+  var a= randomArray(length);
+  var t0= Date.now();
+  pool.sort(a, function (err, sorted) {
+    if (err) throw err;
+    var time= Date.now()- t0;
+    checkSorted(sorted);
+    if (n === 1) singleTime= time;
+    var q= randomArray(queries);
+    var t1= Date.now();
+    pool.binarySearchMany(sorted, q, function (err, results) {
+      if (err) throw err;
+      console.log(n+ ' threads: sort '+ time+ 'ms (x'+ (jsTime/ time).toFixed(1)+ ' vs Array.prototype.sort, x'+
+                  (singleTime/ time).toFixed(1)+ ' vs 1 thread), binarySearchMany '+ (Date.now()- t1)+ 'ms');
+      pool.destroy();
+      n*= 2;
+      next();
+    });
+  });
+})();
@@ -0,0 +1,73 @@
+
+
+// JSON.parse / JSON.stringify in the main thread versus pool.parseJSON() and
+// pool.stringifyJSON(), to find the payload size where offloading pays off.
+// "main busy" is the time the main thread is blocked; "latency" is until the
+// callback.
+// node b08_json_offload.js [threads] [sizes, e.g. 1e3,1e6,1e8]
+
+var T= require('webworker-threads');
+
+var n= +process.argv[2] || 4;
+var sizes= (process.argv[3] || '1e3,1e6,1e8').split(',').map(Number);
+var pool= T.createPool(n);
+
+function makeDocument (bytes) {
+  var items= [];
+  var item= { id: 0, name: 'item', tags: ['a', 'b', 'c'], price: 12.5, stock: true };
+  var itemBytes= JSON.stringify(item).length+ 1;
+  var i= Math.max(1, Math.floor(bytes/ itemBytes));
+  while (i--) items.push({ id: i, name: 'item'+ i, tags: ['a', 'b', 'c'], price: i/ 8, stock: !!(i & 1) });
+  return items;
+}
+
+function mainBusy (f) {
+  var t0= Date.now();
+  f();
+  return Date.now()- t0;
+}
+
+function row (label, busy, latency) {
+  console.log('  '+ label+ ': main busy '+ busy+ 'ms, latency '+ latency+ 'ms');
+}
+
+function run (size, done) {
+  var doc= makeDocument(size);
+  var text= JSON.stringify(doc);
+  var buffer= new Buffer(text);
+  console.log(text.length+ ' bytes:');
+  row('JSON.parse          ', mainBusy(function () { JSON.parse(text) }), '-');
+
+  var t0= Date.now();
+  var busy= mainBusy(function () {
+    pool.parseJSON(text, function (err, result) {
+      if (err) throw err;
+      var latency= Date.now()- t0;
+      row('pool.parseJSON(text)', busy+ mainBusy(function () { result.length }), latency);
+
+      var t1= Date.now();
+      var busy1= mainBusy(function () {
+        pool.parseJSON(buffer, function (err, result) {
+          if (err) throw err;
+          row('pool.parseJSON(buf) ', busy1, Date.now()- t1);
+          row('JSON.stringify      ', mainBusy(function () { JSON.stringify(doc) }), '-');
+
+          var t2= Date.now();
+          var busy2= mainBusy(function () {
+            pool.stringifyJSON(doc, function (err, result) {
+              if (err) throw err;
+              if (result.length !== text.length) throw 'stringifyJSON() differs from JSON.stringify()';
+              row('pool.stringifyJSON  ', busy2, Date.now()- t2);
+              done();
+            });
+          });
+        });
+      });
+    });
+  });
+}
+
+(function next () {
+  if (!sizes.length) return pool.destroy();
+  run(sizes.shift(), next);
+})();
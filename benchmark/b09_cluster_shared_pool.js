@@ -0,0 +1,48 @@
+
+
+// Like b03_fibonacci_server_clustered.js, but the cluster workers don't compute
+// fib() themselves: the master hosts a single pool sized to the cores, and the
+// workers submit their jobs to it through a Unix domain socket.
+// node b09_cluster_shared_pool.js [port] [numWorkers] [numThreads]
+
+var T= require('webworker-threads');
+var cluster= require('cluster');
+var path= '/tmp/webworker-threads-b09.sock';
+
+function fib (n) {
+  return (n < 2) ? 1 : fib(n-2)+ fib(n-1);
+}
+
+if (cluster.isMaster) {
+  var numWorkers= +process.argv[3] || 2;
+  var numThreads= +process.argv[4] || require('os').cpus().length;
+  try { require('fs').unlinkSync(path) } catch (e) {}
+  var pool= T.createPool(numThreads).all.eval(fib);
+  var server= pool.serve(path);
+  console.log('Shared pool of '+ numThreads+ ' threads serving @'+ path);
+  for (var i = 0; i < numWorkers; i++) cluster.fork();
+  setInterval(function () {
+    console.log('\n[shared pool] '+ JSON.stringify(server.stats())+ ', pending: '+ pool.pendingJobs());
+  }, 5e3);
+}
+else {
+  var remote= T.connect(path);
+  var i= 0;
+  var n= 35;
+  var port= +process.argv[2] || 1234;
+  require('http').createServer(function (req, res) {
+    if ((++i) % 10) {
+      res.end(" QUICK");
+      process.stdout.write(" QUICK");
+    }
+    else {
+      remote.any.call('fib', [n], function (err, data) {
+        if (err) throw err;
+        var txt= ' '+ data;
+        res.end(txt);
+        process.stdout.write(txt);
+      });
+    }
+  }).listen(port);
+  console.log('Fibonacci server (CLUSTERED, SHARED POOL) listening: '+ port);
+}
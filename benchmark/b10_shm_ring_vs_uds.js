@@ -0,0 +1,72 @@
+
+
+// The same jobs through pool.serve() over a Unix domain socket and over the
+// shared memory rings: throughput with `window` jobs in flight, and the
+// latency of one job at a time.
+// node b10_shm_ring_vs_uds.js [jobs] [window] [payloadBytes]
+
+var T= require('webworker-threads');
+
+var jobs= +process.argv[2] || 100000;
+var window= +process.argv[3] || 256;
+var payloadBytes= +process.argv[4] || 64;
+
+function echo (x) { return x }
+
+function throughput (remote, payload, cb) {
+  var sent= 0, done= 0, t0= Date.now();
+  function send () {
+    sent++;
+    remote.call('echo', [payload], function (err) {
+      if (err) throw err;
+      if (++done === jobs) return cb(jobs* 1e3/ (Date.now()- t0));
+      if (sent < jobs) send();
+    });
+  }
+  while ((sent < window) && (sent < jobs)) send();
+}
+
+function latency (remote, payload, cb) {
+  var times= [], n= Math.min(jobs, 20000);
+  (function next () {
+    var t0= process.hrtime();
+    remote.call('echo', [payload], function (err) {
+      if (err) throw err;
+      var t= process.hrtime(t0);
+      times.push(t[0]* 1e6+ t[1]/ 1e3);
+      if (times.length < n) return next();
+      times.sort(function (a, b) { return a- b });
+      cb(times[Math.floor(n* 0.5)], times[Math.floor(n* 0.99)]);
+    });
+  })();
+}
+
+if (process.argv[5] === 'client') {
+  var options= { transport: process.argv[6] };
+  var remote= T.connect(process.argv[7], options);
+  var payload= new Array(payloadBytes+ 1).join('x');
+  throughput(remote, payload, function (rate) {
+    latency(remote, payload, function (p50, p99) {
+      remote.destroy();
+      process.send({ rate: rate, p50: p50, p99: p99 });
+    });
+  });
+}
+else {
+  var pool= T.createPool(2).all.eval(echo);
+  var transports= process.platform === 'linux' ? ['uds', 'shm'] : ['uds'];
+  console.log(jobs+ ' jobs, '+ window+ ' in flight, '+ payloadBytes+ ' bytes each');
+
+  (function run (i) {
+    if (i === transports.length) return pool.destroy();
+    var transport= transports[i];
+    var path= transport === 'shm' ? 'webworker-threads-b10.'+ process.pid : '/tmp/webworker-threads-b10.'+ process.pid+ '.sock';
+    var server= pool.serve(path, { transport: transport });
+    var args= [jobs, window, payloadBytes, 'client', transport, path];
+    require('child_process').fork(__filename, args).on('message', function (r) {
+      console.log(transport+ ': '+ Math.round(r.rate)+ ' jobs/s, latency p50 '+ r.p50.toFixed(1)+ 'us p99 '+ r.p99.toFixed(1)+ 'us');
+      server.close();
+      run(i+ 1);
+    });
+  })(0);
+}
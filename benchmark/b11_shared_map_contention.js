@@ -0,0 +1,56 @@
+
+
+// SharedMap under contention: every thread of a pool reads (and writes a
+// fraction of the time) the same hot keys, with more and more threads.
+// Reads take no locks, so their throughput should scale with the threads.
+// node b11_shared_map_contention.js [opsPerThread] [keys] [writePercent]
+
+var T= require('webworker-threads');
+var os= require('os');
+
+var ops= +process.argv[2] || 1000000;
+var keys= +process.argv[3] || 1000;
+var writePercent= +process.argv[4] || 10;
+
+var map= new T.SharedMap('b11', { maxEntries: keys* 2 });
+for (var i= 0; i < keys; i++) map.set(i, { id: i, name: 'key'+ i });
+map.set('counter', 0);
+
+function hammer (ops, keys, writePercent) {
+  var map= new SharedMap('b11');
+  var t0= Date.now();
+  for (var i= 0; i < ops; i++) {
+    var k= (Math.random()* keys) | 0;
+    if ((i % 100) < writePercent) {
+      if (i & 1) map.incr('counter');
+      else map.set(k, { id: k, name: 'key'+ k });
+    }
+    else {
+      map.get(k);
+    }
+  }
+  return Date.now()- t0;
+}
+
+var counts= [1, 2, 4, 8, 16].filter(function (n) { return n <= os.cpus().length* 2 });
+
+(function next () {
+  var n= counts.shift();
+  if (!n) {
+    console.log(map.stats());
+    return;
+  }
+  var pool= T.createPool(n);
+  pool.all.eval(hammer.toString());
+  var pending= n, slowest= 0;
+  var t0= Date.now();
+  pool.all.call('hammer', [ops, keys, writePercent], function (err, ms) {
+    if (err) throw err;
+    slowest= Math.max(slowest, ms);
+    if (--pending) return;
+    var total= n* ops;
+    console.log(n+ ' threads: '+ (total* 1e3/ slowest/ 1e6).toFixed(2)+ ' Mops/s ('+ writePercent+ '% writes, '+ (Date.now()- t0)+ 'ms)');
+    pool.destroy();
+    next();
+  });
+})();
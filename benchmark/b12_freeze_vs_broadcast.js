@@ -0,0 +1,54 @@
+
+
+// The same lookup tables in every thread of a pool: broadcast (each thread
+// parses its own copy) versus Threads.freeze() (one copy, read in place).
+// Prints the memory that each way adds to the process, and the lookups/s.
+// node b12_freeze_vs_broadcast.js [threads] [entries] [lookupsPerThread]
+
+var T= require('webworker-threads');
+
+var numThreads= +process.argv[2] || 8;
+var entries= +process.argv[3] || 200000;
+var lookups= +process.argv[4] || 1000000;
+
+var table= {};
+for (var i= 0; i < entries; i++) table['k'+ i]= { id: i, name: 'entry number '+ i, tags: ['a'+ (i % 10), 'b'+ (i % 100)] };
+var json= JSON.stringify(table);
+
+function work (lookups, entries) {
+  var t0= Date.now(), n= 0;
+  for (var i= 0; i < lookups; i++) n+= table['k'+ ((i* 7919) % entries)].id;
+  return Date.now()- t0;
+}
+
+function rss () {
+  return process.memoryUsage().rss;
+}
+
+function run (label, setup, done) {
+  var pool= T.createPool(numThreads);
+  var before= rss();
+  setup(pool);
+  pool.all.eval(work.toString());
+  var pending= numThreads, slowest= 0;
+  pool.all.call('work', [lookups, entries], function (err, ms) {
+    if (err) throw err;
+    slowest= Math.max(slowest, ms);
+    if (--pending) return;
+    var mb= (rss()- before)/ 1024/ 1024;
+    console.log(label+ ': +'+ mb.toFixed(1)+ 'MB rss, '+ (numThreads* lookups* 1e3/ slowest/ 1e6).toFixed(2)+ ' Mlookups/s');
+    pool.destroy();
+    done();
+  });
+}
+
+console.log(numThreads+ ' threads, a table of '+ entries+ ' entries ('+ (json.length/ 1024/ 1024).toFixed(1)+ 'MB of JSON)');
+run('broadcast', function (pool) {
+  pool.all.eval('var table= '+ json);
+}, function () {
+  run('freeze', function (pool) {
+    T.freeze('b12', table);
+    console.log('snapshot: '+ (T.frozenStats().bytes/ 1024/ 1024).toFixed(1)+ 'MB');
+    pool.all.eval('var table= frozen("b12")');
+  }, function () {});
+});
@@ -0,0 +1,50 @@
+
+
+// Results made of many small objects, deserialized in the main thread: rows
+// that all have the same keys (the key and shape caches of the deserializer
+// make them from a boilerplate) versus rows whose keys are all different
+// (nothing to cache). Same number of rows and properties either way.
+// node b13_bson_shapes.js [rowsPerResult] [results]
+
+var T= require('webworker-threads');
+
+var rows= +process.argv[2] || 10000;
+var results= +process.argv[3] || 200;
+var pool= T.createPool(1);
+
+function table (rows, fresh) {
+  var result= [];
+  for (var i= 0; i < rows; i++) {
+    var k= fresh ? i.toString(36) : '';
+    var row= {};
+    row['id'+ k]= i;
+    row['name'+ k]= 'row';
+    row['price'+ k]= i/ 8;
+    row['stock'+ k]= !!(i & 1);
+    row['owner'+ k]= 'x';
+    result.push(row);
+  }
+  return result;
+}
+
+pool.all.eval(table.toString());
+
+function run (label, fresh, done) {
+  var n= results, t0= Date.now();
+  (function next () {
+    pool.any.call('table', [rows, fresh], function (err, result) {
+      if (err) throw err;
+      if (result.length !== rows) throw 'bad result';
+      if (--n) return next();
+      var ms= Date.now()- t0;
+      console.log(label+ ': '+ (rows* results* 1e3/ ms/ 1e6).toFixed(2)+ ' Mrows/s ('+ ms+ 'ms)');
+      done();
+    });
+  })();
+}
+
+run('different keys', true, function () {
+  run('same keys', false, function () {
+    pool.destroy();
+  });
+});
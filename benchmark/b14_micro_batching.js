@@ -0,0 +1,37 @@
+
+
+// Many tiny pool.any.call()s, one at a time per job versus in adaptive
+// batches ({ batch } pools): calls/s and the latency of the slowest call.
+// node b14_micro_batching.js [threads] [calls] [maxLatencyMs]
+
+var T= require('webworker-threads');
+
+var numThreads= +process.argv[2] || 4;
+var calls= +process.argv[3] || 200000;
+var maxLatencyMs= +process.argv[4] || 2;
+
+function tiny (x) {
+  return x* 2+ 1;
+}
+
+function run (label, options, done) {
+  var pool= T.createPool(numThreads, options);
+  pool.all.eval(tiny.toString());
+  var pending= calls, worst= 0, t0= Date.now();
+  for (var i= 0; i < calls; i++) (function (queued) {
+    pool.any.call('tiny', [i], function (err) {
+      if (err) throw err;
+      worst= Math.max(worst, Date.now()- queued);
+      if (--pending) return;
+      var ms= Date.now()- t0;
+      var stats= pool.batchStats();
+      console.log(label+ ': '+ (calls* 1e3/ ms).toFixed(0)+ ' calls/s, slowest '+ worst+ 'ms'+ (stats.batches ? ', '+ stats.average.toFixed(1)+ ' calls per batch' : ''));
+      pool.destroy();
+      done();
+    });
+  })(Date.now());
+}
+
+run('one by one', null, function () {
+  run('batched', { batch: { maxLatencyMs: maxLatencyMs } }, function () {});
+});
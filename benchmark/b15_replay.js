@@ -0,0 +1,95 @@
+
+
+// Replays a log of Threads.startRecording() against a fresh pool: the jobs go
+// in at the times they were submitted (divided by speed, 0 is as fast as it
+// can), and it reports the throughput and the latency of the calls. The jobs
+// submitted to a thread go to the pool: its evals and loads to all the threads.
+// A pool's .shard(), .scatter(), .spawnActor(), .schedule() and .serve() jobs
+// aren't in the log, so a replay leaves them out.
+// node b15_replay.js log [speed] [threads] [poolOptions]
+// node b15_replay.js --record log [calls]   records some bursty traffic to try it
+
+var T= require('webworker-threads');
+
+if (process.argv[2] === '--record') record(process.argv[3], +process.argv[4] || 20000);
+else if (process.argv[2]) replay(process.argv[2], process.argv[3] === undefined ? 1 : +process.argv[3], +process.argv[4] || 4, JSON.parse(process.argv[5] || 'null'));
+else console.log('node b15_replay.js log [speed] [threads] [poolOptions]\nnode b15_replay.js --record log [calls]');
+
+function fib (n) {
+  return n < 2 ? n : fib(n- 1)+ fib(n- 2);
+}
+
+function record (path, calls) {
+  T.startRecording(path);
+  var pool= T.createPool(4);
+  pool.all.eval(fib.toString());
+  var sent= 0, pending= calls;
+  (function burst () {
+    var n= Math.min(calls- sent, 1+ Math.floor(Math.random()* 200));
+    while (n--) pool.any.call('fib', [10+ (sent++ % 12)], done);
+    if (sent < calls) setTimeout(burst, Math.random()* 20);
+  })();
+  function done (err) {
+    if (err) throw err;
+    if (--pending) return;
+    var stats= T.stopRecording();
+    console.log(path+ ': '+ stats.jobs+ ' jobs, '+ stats.bytes+ ' bytes');
+    pool.destroy();
+  }
+}
+
+function replay (path, speed, numThreads, options) {
+  var log= T.readRecording(path);
+  var records= log.records;
+  if (!records.length) return console.log(path+ ': no jobs');
+
+  var pool= T.createPool(numThreads, options);
+  var latencies= [], errors= 0, pending= 0, submitted= 0, lag= 0, i= 0;
+  var t0= Date.now();
+
+  (function submit () {
+    var now= Date.now()- t0;
+    while ((i < records.length) && (!speed || (records[i].at/ speed <= now))) {
+      if (speed) lag= Math.max(lag, now- records[i].at/ speed);
+      run(records[i++]);
+    }
+    if ((i === records.length) && !pending) return report();
+    if (i < records.length) setTimeout(submit, speed ? Math.max(0, records[i].at/ speed- (Date.now()- t0)) : 0);
+  })();
+
+  function run (r) {
+    var all= (r.origin === 'all') || ((r.origin === 'thread') && ((r.type === 'eval') || (r.type === 'load')));
+    var to= all ? pool.all : pool.any;
+    var args= r.args || [];
+    submitted++;
+    if (r.type === 'emit') return to.emit.apply(null, [r.name].concat(args));
+    pending+= all ? numThreads : 1;
+    var cb= track(Date.now());
+    if (r.type === 'eval') return to.eval(r.name, cb);
+    if (r.type === 'load') return pool.load(r.name, cb);
+    var names= r.name.split('\n');
+    if ((names.length === 1) || all) return to.call(names[0], args, cb);
+    var future= pool.any.chain(names[0], args);
+    names.slice(1).forEach(function (name) { future= future.then(name) });
+    future.then(cb);
+  }
+
+  function track (t) {
+    return function (err) {
+      if (err) errors++;
+      latencies.push(Date.now()- t);
+      if (--pending || (i < records.length)) return;
+      report();
+    };
+  }
+
+  function report () {
+    var ms= Date.now()- t0;
+    latencies.sort(function (a, b) { return a- b });
+    function pct (p) { return latencies[Math.min(latencies.length- 1, Math.floor(latencies.length* p))] }
+    console.log(path+ ': '+ submitted+ ' jobs recorded over '+ (records[records.length- 1].at/ 1e3).toFixed(2)+ 's, replayed at '+ (speed ? speed+ 'x' : 'full speed')+ ' in '+ (ms/ 1e3).toFixed(2)+ 's with '+ numThreads+ ' threads'+ (options ? ' '+ JSON.stringify(options) : ''));
+    console.log('throughput: '+ (submitted* 1e3/ ms).toFixed(0)+ ' jobs/s, '+ errors+ ' errors, submitted up to '+ lag.toFixed(0)+ 'ms late');
+    console.log('latency (ms): p50 '+ pct(0.5)+ ', p90 '+ pct(0.9)+ ', p99 '+ pct(0.99)+ ', max '+ latencies[latencies.length- 1]);
+    pool.destroy();
+  }
+}
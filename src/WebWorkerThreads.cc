@@ -3,6 +3,7 @@
 
 
 #include <v8.h>
+#include <v8-debug.h>
 #include <node.h>
 #include <uv.h>
 #include <string.h>
@@ -16,13 +17,18 @@
 #include <unistd.h>
 #ifndef uv_cond_t
 #define uv_cond_signal(x) pthread_cond_signal(x)
+#define uv_cond_broadcast(x) pthread_cond_broadcast(x)
+#define uv_cond_destroy(x) pthread_cond_destroy(x)
 #define uv_cond_init(x) pthread_cond_init(x, NULL)
 #define uv_cond_wait(x,y) pthread_cond_wait(x, y)
 typedef pthread_cond_t uv_cond_t;
 #endif
+#define wwt_getpid() getpid()
 #else
 #define pthread_setcancelstate(x,y) NULL
 #define pthread_setcanceltype(x,y) NULL
+#include <process.h>
+#define wwt_getpid() _getpid()
 #endif
 
 
@@ -31,19 +37,59 @@ static int debug_threads= 0;
 static int debug_allocs= 0;
 */
 
+#include "atomics.h"
 #include "queues_a_gogo.cc"
 #include "bson.cc"
 #include "jslib.cc"
+#include "parallel_sort.cc"
+#include "remote.cc"
+#include "shm_ring.cc"
+#include "memo_cache.cc"
+#include "scatter_merge.cc"
+#include "shared_map.cc"
+#include "frozen.cc"
+#include "recorder.cc"
 
 //using namespace node;
 using namespace v8;
 
 static Persistent<String> id_symbol;
+static Persistent<String> pinned_symbol;
+static Persistent<String> memo_symbol;
+static Persistent<ObjectTemplate> memoKeyTemplate;
+static BSON* mainBSON= NULL;
 static Persistent<ObjectTemplate> threadTemplate;
 static bool useLocker;
 
+#define kThreadDestroyed "thread.destroy(): the thread has been destroyed"
+
 static typeQueue* freeJobsQueue= NULL;
 static typeQueue* freeThreadsQueue= NULL;
+static uv_timer_t trimTimer;
+
+#define kFreeThreadsHighWater 64
+#define kFreeThreadsLowWater 4
+#define kTrimInterval 1000
+#define kTeardownGCRounds 16
+
+// Bytes of job payloads (sources, event args, BSON buffers, results) sitting in
+// the queues. queuedBytesLimit is a soft limit: 0 means no limit.
+static volatile long queuedBytesTotal= 0;
+static volatile long queuedBytesLimit= 0;
+static long queuedBytesReported= 0; // What V8 has been told, main thread only.
+static long queueRejected= 0;       // main thread only.
+static volatile long queueWaits= 0;
+static volatile long queueRoomWaiters= 0;
+static uv_mutex_t queueRoomMutex;
+static uv_cond_t queueRoomCV;
+
+// What an isolate needs to make the views of the snapshots of Threads.freeze().
+typedef struct {
+  Persistent<ObjectTemplate> view;
+  Persistent<Object> arrayPrototype;
+} typeFrozenViews;
+
+static typeFrozenViews* mainFrozenViews= NULL;
 
 #define kThreadMagicCookie 0x99c0ffee
 typedef struct {
@@ -52,32 +98,70 @@ typedef struct {
   long int id;
   uv_thread_t thread;
   volatile int sigkill;
+  volatile int ended; //The isolate has been disposed and the thread is about to exit
 
   typeQueue inQueue;  //Jobs to run
   typeQueue outQueue; //Jobs done
+  volatile long queuedBytes; //Payload bytes of the jobs in both queues
 
   volatile int IDLE;
   uv_cond_t IDLE_cv;
   uv_mutex_t IDLE_mutex;
 
   Isolate* isolate;
+  BSON* bson;
+  Persistent<FunctionTemplate> bufferTemplate;
+  typeFrozenViews* frozenViews; //Made on first use, see isolateFrozenViews()
   Persistent<Context> context;
   Persistent<Object> JSObject;
   Persistent<Object> threadJSObject;
   Persistent<Object> dispatchEvents;
 
+  volatile long heartbeat;     //Bumped by eventLoop() at each job
+  volatile uint64_t busySince; //uv_hrtime() at the start of the job running now, 0 while idle
+  long stallBeat;              //The heartbeat of the job last seen stalled, see stallMonitor()
+  uint64_t stallSince;         //When the monitor saw it
+  double stallMs;              //How long it had been running by then
+  volatile int stallState;     //Under stallLock, see stallStates
+  char* stallStack;            //Under stallLock
+  int stallListening;          //stallDebugEvent() is the isolate's debug event listener
+  int pooled;                  //Its pool records its jobs, not the thread, see RecordJob()
+
   unsigned long threadMagicCookie;
 } typeThread;
 
 enum jobTypes {
   kJobTypeEval,
   kJobTypeEvent,
-  kJobTypeEventSerialized
+  kJobTypeEventSerialized,
+  kJobTypeCall,
+  kJobTypeTask,
+  kJobTypeActor
 };
 
+struct typeGroup;
+struct typePipeline;
+struct typeActor;
+struct typeSchedule;
+struct typeConnection;
+
+// A typed array (or Buffer) lent to a thread for the duration of a call() job.
+typedef struct {
+  int argIndex;
+  void* data;
+  ExternalArrayType arrayType;
+  int length;
+  Persistent<Object> owner; //Main thread's handle
+} typePin;
+
 typedef struct {
   int jobType;
+  long bytes; //Payload bytes accounted to this job, see jobAccount()
   Persistent<Object> cb;
+  struct typeConnection* remote; //Submitted by another process, see Threads.serve()
+  uint32_t remoteId;
+  struct typeSchedule* schedule; //Queued by the scheduler thread, see pool.schedule()
+  typeMemoKey* memo; //{ memoize: true }: the result is stored in the cache under this key
   union {
     struct {
       int length;
@@ -90,10 +174,34 @@ typedef struct {
       char* buffer;
       size_t bufferSize;
     } typeEventSerialized;
+    struct {
+      int error;
+      int tiene_callBack;
+      int argc;
+      String::Utf8Value* fnName;
+      char* buffer; //BSON [args...] on the way in, [result] (or [errorMessage]) on the way out
+      size_t bufferSize;
+      int pinnedLength;
+      typePin* pinned;
+      struct typePipeline* pipeline; //Threads.pipeline(): the result goes on to the next stage
+      int stage;
+      String::Utf8Value** thens; //thread.call([fnName, then...]): called next, in this thread, with the result
+      int thensLength;
+      int thenNext;
+    } typeCall;
+    struct {
+      struct typeGroup* group;
+      int op;
+      size_t from, mid, to, outFrom, outTo;
+    } typeTask;
+    struct {
+      struct typeActor* actor;
+    } typeActor;
     struct {
       int error;
       int tiene_callBack;
       int useStringObject;
+      int loadPath; //thread.load(): scriptText_CharPtr is the path of the file, read in the thread
       String::Utf8Value* resultado;
       union {
         char* scriptText_CharPtr;
@@ -110,6 +218,7 @@ gcc minify.c -o minify
 cat ../../../src/events.js | ./minify kEvents_js > ../../../src/kEvents_js
 cat ../../../src/load.js | ./minify kLoad_js > ../../../src/kLoad_js
 cat ../../../src/createPool.js | ./minify kCreatePool_js > ../../../src/kCreatePool_js
+cat ../../../src/pipeline.js | ./minify kPipeline_js > ../../../src/kPipeline_js
 cat ../../../src/worker.js | ./minify kWorker_js > ../../../src/kWorker_js
 cat ../../../src/thread_nextTick.js | ./minify kThread_nextTick_js > ../../../src/kThread_nextTick_js
 
@@ -118,6 +227,7 @@ cat ../../../src/thread_nextTick.js | ./minify kThread_nextTick_js > ../../../sr
 #include "events.js.c"
 #include "load.js.c"
 #include "createPool.js.c"
+#include "pipeline.js.c"
 #include "worker.js.c"
 #include "thread_nextTick.js.c"
 //#include "JASON.js.c"
@@ -136,6 +246,16 @@ static typeQueueItem* nuJobQueueItem (void) {
   if (!qitem) {
     qitem= nuItem(kItemTypePointer, calloc(1, sizeof(typeJob)));
   }
+  else {
+    atomic_inc(&freeListUses);
+  }
+  ((typeJob*) qitem->asPtr)->remote= NULL;
+  ((typeJob*) qitem->asPtr)->schedule= NULL;
+  ((typeJob*) qitem->asPtr)->memo= NULL;
+  ((typeJob*) qitem->asPtr)->typeCall.pipeline= NULL;
+  ((typeJob*) qitem->asPtr)->typeCall.thens= NULL;
+  ((typeJob*) qitem->asPtr)->typeCall.thenNext= 0;
+  ((typeJob*) qitem->asPtr)->typeEval.loadPath= 0;
   return qitem;
 }
 
@@ -144,19 +264,14 @@ static typeQueueItem* nuJobQueueItem (void) {
 
 
 
-static typeThread* isAThread (Handle<Object> receiver) {
-  typeThread* thread;
-
-  if (receiver->IsObject()) {
-    if (receiver->InternalFieldCount() == 1) {
-      thread= (typeThread*) receiver->GetPointerFromInternalField(0);
-      if (thread && (thread->threadMagicCookie == kThreadMagicCookie)) {
-        return thread;
-      }
-    }
+static void destroyJobQueueItem (typeQueueItem* qitem) {
+  if (freeJobsQueue->length < freeListHighWater) {
+    stack_push(qitem, freeJobsQueue);
+  }
+  else {
+    free(qitem->asPtr);
+    destroyItem(qitem);
   }
-
-  return NULL;
 }
 
 
@@ -164,277 +279,204 @@ static typeThread* isAThread (Handle<Object> receiver) {
 
 
 
-static void pushToInQueue (typeQueueItem* qitem, typeThread* thread) {
-  uv_mutex_lock(&thread->IDLE_mutex);
-  queue_push(qitem, &thread->inQueue);
-  if (thread->IDLE) {
-    uv_cond_signal(&thread->IDLE_cv);
+// Runs in the main thread every kTrimInterval ms. The free lists that haven't
+// been used since the previous run are trimmed down to their low watermark.
+static void trimFreeLists (uv_timer_t* handle, int status) {
+  typeQueueItem* qitem;
+  typeQueueItem* next;
+
+  long uses= atomic_read(&freeListUses);
+  if (uses) {
+    atomic_add(&freeListUses, -uses);
+    return;
   }
-  uv_mutex_unlock(&thread->IDLE_mutex);
-}
 
+  qitem= queue_trim(freeThreadsQueue, kFreeThreadsLowWater);
+  while (qitem) {
+    next= qitem->next;
+    free(qitem->asPtr);
+    free(qitem);
+    qitem= next;
+  }
 
+  qitem= queue_trim(freeJobsQueue, freeListLowWater);
+  while (qitem) {
+    next= qitem->next;
+    free(qitem->asPtr);
+    free(qitem);
+    qitem= next;
+  }
 
+  qitem= queue_trim(freeItemsQueue, freeListLowWater);
+  while (qitem) {
+    next= qitem->next;
+    free(qitem);
+    qitem= next;
+  }
+}
 
 
 
-static Handle<Value> Puts (const Arguments &args) {
-  //fprintf(stdout, "*** Puts BEGIN\n");
 
-  HandleScope scope;
-  int i= 0;
-  while (i < args.Length()) {
-    String::Utf8Value c_str(args[i]);
-    fputs(*c_str, stdout);
-    i++;
-  }
-  fflush(stdout);
 
-  //fprintf(stdout, "*** Puts END\n");
-  return Undefined();
-}
 
-static Handle<Value> Print (const Arguments &args) {
-	HandleScope scope;
-	int i= 0;
-	while (i < args.Length()) {
-		String::Utf8Value c_str(args[i]);
-		fputs(*c_str, stdout);
-		i++;
-	}
-	static char end = '\n';
-	fputs(&end, stdout);
-	fflush(stdout);
-	
-	//fprintf(stdout, "*** Puts END\n");
-	return Undefined();
+// Adds bytes to the payload accounted for this job, its thread and the process.
+static void jobAccount (typeThread* thread, typeJob* job, long bytes) {
+  job->bytes+= bytes;
+  atomic_add(&thread->queuedBytes, bytes);
+  atomic_add(&queuedBytesTotal, bytes);
 }
 
 
 
 
-static void eventLoop (typeThread* thread);
-
-// A background thread
-#ifdef WWT_PTHREAD
-static void* aThread (void* arg) {
-#else
-static void aThread (void* arg) {
-#endif
-
-  int dummy;
-  pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, &dummy);
-  pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, &dummy);
 
-  typeThread* thread= (typeThread*) arg;
-  thread->isolate= Isolate::New();
-  thread->isolate->SetData(thread);
 
-  if (useLocker) {
-    //printf("**** USING LOCKER: YES\n");
-    v8::Locker myLocker(thread->isolate);
-    //v8::Isolate::Scope isolate_scope(thread->isolate);
-    eventLoop(thread);
+// Gives back the job's payload bytes, once its payload has been freed.
+static void jobRelease (typeThread* thread, typeJob* job) {
+  long bytes= job->bytes;
+  if (!bytes) return;
+  job->bytes= 0;
+  atomic_add(&thread->queuedBytes, -bytes);
+  atomic_add(&queuedBytesTotal, -bytes);
+  if (atomic_read(&queueRoomWaiters)) {
+    uv_mutex_lock(&queueRoomMutex);
+    uv_cond_broadcast(&queueRoomCV);
+    uv_mutex_unlock(&queueRoomMutex);
   }
-  else {
-    //printf("**** USING LOCKER: NO\n");
-    //v8::Isolate::Scope isolate_scope(thread->isolate);
-    eventLoop(thread);
-  }
-  thread->isolate->Exit();
-  thread->isolate->Dispose();
-
-  // wake up callback
-  if (!(thread->inQueue.length)) uv_async_send(&thread->async_watcher);
-#ifdef WWT_PTHREAD
-  return NULL;
-#endif
 }
 
 
 
-static Handle<Value> threadEmit (const Arguments &args);
-static Handle<Value> postMessage (const Arguments &args);
-static Handle<Value> postError (const Arguments &args);
-
-
 
-static void eventLoop (typeThread* thread) {
-  thread->isolate->Enter();
-  thread->context= Context::New();
-  thread->context->Enter();
 
-  {
-    HandleScope scope1;
 
-    Local<Object> global= thread->context->Global();
+static int queueIsFull (void) {
+  long limit= queuedBytesLimit;
+  return limit && (atomic_read(&queuedBytesTotal) >= limit);
+}
 
-    Handle<Object> fs_obj = Object::New();
-    JSObjFn(fs_obj, "readFileSync", readFileSync_);
-    global->Set(String::New("native_fs_"), fs_obj, attribute_ro_dd);
 
-    Handle<Object> console_obj = Object::New();
-    JSObjFn(console_obj, "log", console_log);
-    JSObjFn(console_obj, "error", console_error);
-    global->Set(String::New("console"), console_obj, attribute_ro_dd);
 
-    global->Set(String::NewSymbol("self"), global);
-    global->Set(String::NewSymbol("global"), global);
 
-    global->Set(String::NewSymbol("puts"), FunctionTemplate::New(Puts)->GetFunction());
-    global->Set(String::NewSymbol("print"), FunctionTemplate::New(Print)->GetFunction());
 
-    global->Set(String::NewSymbol("postMessage"), FunctionTemplate::New(postMessage)->GetFunction());
-    global->Set(String::NewSymbol("__postError"), FunctionTemplate::New(postError)->GetFunction());
 
-    Local<Object> threadObject= Object::New();
-    global->Set(String::NewSymbol("thread"), threadObject);
+// Main thread only: tells V8 how much memory is held by the queues.
+static void reportQueuedBytes (void) {
+  long delta= atomic_read(&queuedBytesTotal)- queuedBytesReported;
+  if (delta) {
+    queuedBytesReported+= delta;
+    V8::AdjustAmountOfExternalAllocatedMemory(delta);
+  }
+}
 
-    threadObject->Set(String::NewSymbol("id"), Number::New(thread->id));
-    threadObject->Set(String::NewSymbol("emit"), FunctionTemplate::New(threadEmit)->GetFunction());
-    Local<Object> dispatchEvents= Script::Compile(String::New(kEvents_js))->Run()->ToObject()->CallAsFunction(threadObject, 0, NULL)->ToObject();
-    Local<Object> dispatchNextTicks= Script::Compile(String::New(kThread_nextTick_js))->Run()->ToObject();
-    Local<Array> _ntq= (v8::Array*) *threadObject->Get(String::NewSymbol("_ntq"));
 
-    Script::Compile(String::New(kLoad_js))->Run();
 
-    double nextTickQueueLength= 0;
-    long int ctr= 0;
 
-    //SetFatalErrorHandler(FatalErrorCB);
 
-    while (!thread->sigkill) {
-      typeJob* job;
-      typeQueueItem* qitem;
 
-      {
-        HandleScope scope2;
-        TryCatch onError;
-        String::Utf8Value* str;
-        Local<String> source;
-        Local<Script> script;
-        Local<Value> resultado;
+// Worker threads only: backpressure. While over the limit, a thread may only
+// have one message travelling to the main thread. It waits here until the
+// main thread has drained its outQueue (or the limit is no longer exceeded).
+static void waitForQueueRoom (typeThread* thread) {
+  if (!queueIsFull() || !thread->outQueue.length) return;
+  atomic_inc(&queueWaits);
+  uv_mutex_lock(&queueRoomMutex);
+  atomic_inc(&queueRoomWaiters);
+  while (queueIsFull() && thread->outQueue.length && !thread->sigkill) {
+    uv_cond_wait(&queueRoomCV, &queueRoomMutex);
+  }
+  atomic_dec(&queueRoomWaiters);
+  uv_mutex_unlock(&queueRoomMutex);
+}
 
 
-        while ((qitem= queue_pull(&thread->inQueue))) {
 
-          job= (typeJob*) qitem->asPtr;
 
-          if ((++ctr) > 2e3) {
-            ctr= 0;
-            V8::IdleNotification();
-          }
 
-          if (job->jobType == kJobTypeEval) {
-            //Ejecutar un texto
 
-            if (job->typeEval.useStringObject) {
-              str= job->typeEval.scriptText_StringObject;
-              source= String::New(**str, (*str).length());
-              delete str;
-            }
-            else {
-              source= String::New(job->typeEval.scriptText_CharPtr);
-              free(job->typeEval.scriptText_CharPtr);
-            }
+// Main thread producers are rejected instead.
+static Handle<Value> throwQueueFull (const char* who) {
+  queueRejected++;
+  std::string msg(who);
+  msg+= ": the queued messages memory limit has been reached";
+  return ThrowException(Exception::Error(String::New(msg.c_str())));
+}
 
-            script= Script::New(source);
 
-            if (!onError.HasCaught()) resultado= script->Run();
 
-            if (job->typeEval.tiene_callBack) {
-              job->typeEval.error= onError.HasCaught() ? 1 : 0;
-              job->typeEval.resultado= new String::Utf8Value(job->typeEval.error ? onError.Exception() : resultado);
-              queue_push(qitem, &thread->outQueue);
-              // wake up callback
-              if (!(thread->inQueue.length)) uv_async_send(&thread->async_watcher);
-            }
-            else {
-              queue_push(qitem, freeJobsQueue);
-            }
 
-            if (onError.HasCaught()) onError.Reset();
-          }
-          else if (job->jobType == kJobTypeEvent) {
-            //Emitir evento.
 
-            Local<Value> args[2];
-            str= job->typeEvent.eventName;
-            args[0]= String::New(**str, (*str).length());
-            delete str;
 
-            Local<Array> array= Array::New(job->typeEvent.length);
-            args[1]= array;
+// The threads' Buffer: a Uint8Array like object over malloc()ed memory
+// that belongs to the thread's isolate. The BSON serializer reads it and
+// writes into it directly.
 
-            int i= 0;
-            while (i < job->typeEvent.length) {
-              str= job->typeEvent.argumentos[i];
-              array->Set(i, String::New(**str, (*str).length()));
-              delete str;
-              i++;
-            }
+static void freeBuffer (Persistent<Value> object, void* data) {
+  int length= object->ToObject()->GetIndexedPropertiesExternalArrayDataLength();
+  V8::AdjustAmountOfExternalAllocatedMemory(-length);
+  free(data);
+  object.Dispose();
+  object.Clear();
+}
 
-            free(job->typeEvent.argumentos);
-            queue_push(qitem, freeJobsQueue);
-            dispatchEvents->CallAsFunction(global, 2, args);
-          }
-          else if (job->jobType == kJobTypeEventSerialized) {
-            Local<Value> args[2];
-            str= job->typeEventSerialized.eventName;
-            args[0]= String::New(**str, (*str).length());
-            delete str;
 
-      int len = job->typeEventSerialized.length;
-      Local<Array> array= Array::New(len);
-      args[1]= array;
 
-        {
-          BSON *bson = new BSON();
-          char* data = job->typeEventSerialized.buffer;
-          size_t size = job->typeEventSerialized.bufferSize;
-          BSONDeserializer deserializer(bson, data, size);
-          Local<Object> result = deserializer.DeserializeDocument()->ToObject();
-          int i = 0; do { array->Set(i, result->Get(i)); } while (++i < len);
-          free(data);
-        }
 
-            queue_push(qitem, freeJobsQueue);
-            dispatchEvents->CallAsFunction(global, 2, args);
-          }
-        }
 
-        if (_ntq->Length()) {
 
-          if ((++ctr) > 2e3) {
-            ctr= 0;
-            V8::IdleNotification();
-          }
+static Handle<Value> BufferNew (const Arguments &args) {
+  HandleScope scope;
 
-          resultado= dispatchNextTicks->CallAsFunction(global, 0, NULL);
-          if (onError.HasCaught()) {
-            nextTickQueueLength= 1;
-            onError.Reset();
-          }
-          else {
-            nextTickQueueLength= resultado->NumberValue();
-          }
-        }
-      }
+  if (!args.IsConstructCall()) {
+    int argc= args.Length();
+    Local<Value>* argv= new Local<Value>[argc+ 1];
+    int i= 0;
+    while (i < argc) { argv[i]= args[i]; i++; }
+    Local<Object> buffer= args.Callee()->NewInstance(argc, argv);
+    delete[] argv;
+    return scope.Close(buffer);
+  }
 
-      if (nextTickQueueLength || thread->inQueue.length) continue;
-      if (thread->sigkill) break;
+  Local<Object> buffer= args.This();
+  Local<Value> source= args[0];
+  size_t length= 0;
+  char* data;
 
-      uv_mutex_lock(&thread->IDLE_mutex);
-      if (!thread->inQueue.length) {
-        thread->IDLE= 1;
-        uv_cond_wait(&thread->IDLE_cv, &thread->IDLE_mutex);
-        thread->IDLE= 0;
-      }
-      uv_mutex_unlock(&thread->IDLE_mutex);
+  if (source->IsNumber()) {
+    if (source->NumberValue() < 0 || source->NumberValue() > 0x3fffffff) {
+      return ThrowException(Exception::RangeError(String::New("Buffer(): bad length")));
     }
+    length= source->Uint32Value();
+    data= (char*) calloc(length ? length : 1, 1);
+  }
+  else if (source->IsString()) {
+    length= source->ToString()->Utf8Length();
+    data= (char*) malloc(length ? length : 1);
+    source->ToString()->WriteUtf8(data, (int) length, NULL, String::NO_NULL_TERMINATION);
+  }
+  else if (source->IsObject() && source->ToObject()->HasIndexedPropertiesInExternalArrayData()) {
+    length= ExternalArrayByteLength(source->ToObject());
+    data= (char*) malloc(length ? length : 1);
+    memcpy(data, source->ToObject()->GetIndexedPropertiesExternalArrayData(), length);
+  }
+  else if (source->IsArray()) {
+    Local<Array> array= Local<Array>::Cast(source);
+    length= array->Length();
+    data= (char*) malloc(length ? length : 1);
+    size_t i= 0;
+    while (i < length) { data[i]= (char) array->Get(i)->Int32Value(); i++; }
+  }
+  else {
+    return ThrowException(Exception::TypeError(String::New("Buffer( size | string | array | buffer ): bad argument")));
   }
 
-  thread->context.Dispose();
+  buffer->SetIndexedPropertiesToExternalArrayData(data, kExternalUnsignedByteArray, (int) length);
+  buffer->Set(String::NewSymbol("length"), Integer::NewFromUnsigned((uint32_t) length), attribute_ro_dd);
+  Persistent<Object>::New(buffer).MakeWeak(data, freeBuffer);
+  V8::AdjustAmountOfExternalAllocatedMemory((int) length);
+
+  return scope.Close(buffer);
 }
 
 
@@ -442,23 +484,24 @@ static void eventLoop (typeThread* thread) {
 
 
 
-static void destroyaThread (typeThread* thread) {
+// buffer.toString([start [, end]]): decodes the bytes as utf8.
+static Handle<Value> BufferToString (const Arguments &args) {
+  HandleScope scope;
 
-  thread->sigkill= 0;
-  //TODO: hay que vaciar las colas y destruir los trabajos antes de ponerlas a NULL
-  thread->inQueue.first= thread->inQueue.last= NULL;
-  thread->outQueue.first= thread->outQueue.last= NULL;
-  thread->JSObject->SetPointerInInternalField(0, NULL);
-  thread->JSObject.Dispose();
+  Local<Object> buffer= args.This();
+  if (!buffer->HasIndexedPropertiesInExternalArrayData()) {
+    return ThrowException(Exception::TypeError(String::New("buffer.toString(): the receiver must be a Buffer")));
+  }
 
-  uv_unref((uv_handle_t*)&thread->async_watcher);
+  int length= (int) ExternalArrayByteLength(buffer);
+  int start= args.Length() > 0 ? args[0]->Int32Value() : 0;
+  int end= args.Length() > 1 && !args[1]->IsUndefined() ? args[1]->Int32Value() : length;
+  if (start < 0) start= 0;
+  if (end > length) end= length;
+  if (end < start) end= start;
 
-  if (freeThreadsQueue) {
-    queue_push(nuItem(kItemTypePointer, thread), freeThreadsQueue);
-  }
-  else {
-    free(thread);
-  }
+  char* data= (char*) buffer->GetIndexedPropertiesExternalArrayData();
+  return scope.Close(String::New(data+ start, end- start));
 }
 
 
@@ -466,137 +509,4578 @@ static void destroyaThread (typeThread* thread) {
 
 
 
-// C callback that runs in the main nodejs thread. This is the one responsible for
-// calling the thread's JS callback.
+static Handle<Value> BufferIsBuffer (const Arguments &args) {
+  typeThread* thread= (typeThread*) Isolate::GetCurrent()->GetData();
+  return thread->bufferTemplate->HasInstance(args[0]) ? True() : False();
+}
+
+
+
+
+
+
+static Handle<Value> BufferByteLength (const Arguments &args) {
+  HandleScope scope;
+  return scope.Close(Integer::New(args[0]->ToString()->Utf8Length()));
+}
+
+
+
+
+
+
+static Persistent<FunctionTemplate> newBufferTemplate (void) {
+  Local<FunctionTemplate> bufferTemplate= FunctionTemplate::New(BufferNew);
+  bufferTemplate->SetClassName(String::NewSymbol("Buffer"));
+  bufferTemplate->PrototypeTemplate()->Set(String::NewSymbol("toString"), FunctionTemplate::New(BufferToString));
+  bufferTemplate->Set(String::NewSymbol("isBuffer"), FunctionTemplate::New(BufferIsBuffer));
+  bufferTemplate->Set(String::NewSymbol("byteLength"), FunctionTemplate::New(BufferByteLength));
+  return Persistent<FunctionTemplate>::New(bufferTemplate);
+}
+
+
+
+
+
+
+// Used by the BSON deserializer for binary data: a node Buffer in the main
+// thread, a thread's Buffer in the threads.
+Local<Object> NewIsolateBuffer (const char* data, size_t length) {
+  typeThread* thread= (typeThread*) Isolate::GetCurrent()->GetData();
+
+  if (!thread) {
+    return Local<Object>::New(Buffer::New(data, length)->handle_);
+  }
+
+  Handle<Value> argv[1]= { Integer::NewFromUnsigned((uint32_t) length) };
+  Local<Object> buffer= thread->bufferTemplate->GetFunction()->NewInstance(1, argv);
+  memcpy(buffer->GetIndexedPropertiesExternalArrayData(), data, length);
+  return buffer;
+}
+
+
+
+
+
+
+// The BSON instance of the current isolate.
+static BSON* isolateBSON (void) {
+  typeThread* thread= (typeThread*) Isolate::GetCurrent()->GetData();
+  return thread ? thread->bson : mainBSON;
+}
+
+
+
+
+
+
+// BSON serializes the properties of value into a malloc()ed buffer.
+// Throws a malloc()ed char* on error, as bson.cc does.
+static char* serialize (Handle<Value> value, size_t* size) {
+  BSON* bson= isolateBSON();
+  char* buffer= NULL;
+
+  try {
+    Local<Object> object= bson->GetSerializeObject(value);
+    BSONSerializer<CountStream> counter(bson, false, false);
+    counter.SerializeDocument(object);
+    *size= counter.GetSerializeSize();
+    buffer= (char*) malloc(*size);
+    BSONSerializer<DataStream> data(bson, false, false, buffer);
+    data.SerializeDocument(object);
+  }
+  catch (char* err) {
+    free(buffer);
+    throw;
+  }
+
+  return buffer;
+}
+
+
+
+
+
+
+static Local<Object> deserialize (char* buffer, size_t size) {
+  BSONDeserializer deserializer(isolateBSON(), buffer, size);
+  return deserializer.DeserializeDocument()->ToObject();
+}
+
+
+
+
+
+
+static int isPinnable (Handle<Value> value) {
+  return value->IsObject() && value->ToObject()->HasIndexedPropertiesInExternalArrayData();
+}
+
+
+
+
+
+
+// Main thread: lends the memory of a typed array to a thread. Until it's
+// returned by unpinArray() the array's elements are gone in the main thread:
+// reads return undefined and writes are dropped. Its length is ReadOnly, and
+// stays as it was. Other arrays over the same memory aren't pinned.
+static void pinArray (typePin* pin, Local<Object> owner, int argIndex) {
+  pin->argIndex= argIndex;
+  pin->data= owner->GetIndexedPropertiesExternalArrayData();
+  pin->arrayType= owner->GetIndexedPropertiesExternalArrayDataType();
+  pin->length= owner->GetIndexedPropertiesExternalArrayDataLength();
+  pin->owner= Persistent<Object>::New(owner);
+  owner->SetHiddenValue(pinned_symbol, True());
+  owner->SetIndexedPropertiesToExternalArrayData(pin->data, pin->arrayType, 0);
+}
+
+
+
+
+
+
+static void unpinArray (typePin* pin) {
+  pin->owner->SetIndexedPropertiesToExternalArrayData(pin->data, pin->arrayType, pin->length);
+  pin->owner->DeleteHiddenValue(pinned_symbol);
+  pin->owner.Dispose();
+}
+
+
+
+
+
+
+static void unpinJob (typeJob* job) {
+  int i= 0;
+  while (i < job->typeCall.pinnedLength) unpinArray(&job->typeCall.pinned[i++]);
+  free(job->typeCall.pinned);
+  job->typeCall.pinned= NULL;
+  job->typeCall.pinnedLength= 0;
+}
+
+
+
+
+
+
+// Worker thread: a view of a pinned array. It's a plain Object with the
+// array's elements and a length, not a typed array: it has none of their
+// methods, and no subarray().
+static Local<Object> pinnedView (typePin* pin) {
+  Local<Object> view= Object::New();
+  view->SetIndexedPropertiesToExternalArrayData(pin->data, pin->arrayType, pin->length);
+  view->Set(String::NewSymbol("length"), Integer::New(pin->length));
+  return view;
+}
+
+
+
+
+
+
+// Worker thread: "a.b.c" -> global.a.b.c, and *holder= global.a.b, its `this`.
+static Local<Value> lookupFunction (Local<Object> global, String::Utf8Value* fnName, Local<Object>* holder) {
+  Local<Value> value= global;
+  char* name= **fnName;
+  char* dot;
+
+  while ((dot= strchr(name, '.'))) {
+    value= value->ToObject()->Get(String::New(name, (int) (dot- name)));
+    if (!value->IsObject()) return Local<Value>::New(Undefined());
+    name= dot+ 1;
+  }
+
+  *holder= value->ToObject();
+  return (*holder)->Get(String::New(name));
+}
+
+
+
+
+
+
+// Worker thread: the [0, result] or [1, error] of each call of a __batch
+// (see createPool.ls) that couldn't be serialized as a whole. Those whose
+// result can't be becomes [1, error], so that only its own call fails.
+// Returns whether any did.
+static int batchFailures (Handle<Value> results) {
+  if (!results->IsArray()) return 0;
+  Local<Array> array= Local<Array>::Cast(results);
+  int failed= 0;
+  uint32_t i= 0;
+  while (i < array->Length()) {
+    Local<Value> entry= array->Get(i);
+    size_t size;
+    try {
+      free(serialize(entry, &size));
+    }
+    catch (char* err) {
+      Local<Array> failure= Array::New(2);
+      failure->Set(0, Integer::New(1));
+      failure->Set(1, String::New(err));
+      free(err);
+      array->Set(i, failure);
+      failed= 1;
+    }
+    i++;
+  }
+  return failed;
+}
+
+
+
+
+
+
+// The thens of a call() job that haven't been called.
+static void freeThens (typeJob* job) {
+  if (!job->typeCall.thens) return;
+  while (job->typeCall.thenNext < job->typeCall.thensLength) delete job->typeCall.thens[job->typeCall.thenNext++];
+  free(job->typeCall.thens);
+  job->typeCall.thens= NULL;
+}
+
+
+
+
+
+
+static typeThread* isAThread (Handle<Object> receiver) {
+  typeThread* thread;
+
+  if (receiver->IsObject()) {
+    if (receiver->InternalFieldCount() == 1) {
+      thread= (typeThread*) receiver->GetPointerFromInternalField(0);
+      if (thread && (thread->threadMagicCookie == kThreadMagicCookie)) {
+        return thread;
+      }
+    }
+  }
+
+  return NULL;
+}
+
+
+
+
+
+
+static void pushToInQueue (typeQueueItem* qitem, typeThread* thread) {
+  uv_mutex_lock(&thread->IDLE_mutex);
+  queue_push(qitem, &thread->inQueue);
+  if (thread->IDLE) {
+    uv_cond_signal(&thread->IDLE_cv);
+  }
+  uv_mutex_unlock(&thread->IDLE_mutex);
+}
+
+
+
+
+
+
+// A group of native tasks spread over a pool's threads: pool.sort() and
+// pool.binarySearchMany(). The threads run the tasks without touching their
+// isolates, over the memory of the arrays lent to the group. The main thread
+// starts the next round of tasks when all those of the previous are done.
+
+enum taskOps {
+  kTaskSort,
+  kTaskMerge,
+  kTaskCopy,
+  kTaskSearch
+};
+
+#define kMinTaskElements 16384
+
+struct typeGroup {
+  int pending;    //Tasks not yet done
+  int error;      //A thread has been destroyed under our feet
+  int descending;
+  int threadsLength;
+  int nextThread;
+  const typeSortOps* ops;
+  size_t length;
+  char* source;   //The sorted runs are here...
+  char* target;   //...and are merged into here
+  char* scratch;
+  size_t* runs;   //Boundaries of the sorted runs: runs[0] .. runs[runsLength]
+  int runsLength;
+  int pinsLength;
+  typePin pins[3];
+  Persistent<Array> threads;
+  Persistent<Object> cb;
+};
+typedef struct typeGroup typeGroup;
+
+
+
+
+
+
+static void runTask (typeJob* job) {
+  typeGroup* group= job->typeTask.group;
+  size_t elementSize= group->ops->elementSize;
+
+  switch (job->typeTask.op) {
+    case kTaskSort:
+      group->ops->sort(group->source, job->typeTask.from, job->typeTask.to, group->descending);
+      break;
+    case kTaskMerge:
+      group->ops->merge(group->source, group->target, job->typeTask.from, job->typeTask.mid, job->typeTask.to,
+                        job->typeTask.outFrom, job->typeTask.outTo, group->descending);
+      break;
+    case kTaskCopy:
+      memcpy(group->target+ job->typeTask.from* elementSize, group->source+ job->typeTask.from* elementSize,
+             (job->typeTask.to- job->typeTask.from)* elementSize);
+      break;
+    case kTaskSearch:
+      group->ops->search((char*) group->pins[0].data, group->pins[0].length, (double*) group->pins[1].data,
+                         (int32_t*) group->pins[2].data, job->typeTask.from, job->typeTask.to, group->descending);
+      break;
+  }
+}
+
+
+
+
+
+
+static void pushTask (typeGroup* group, int op, size_t from, size_t mid, size_t to, size_t outFrom, size_t outTo) {
+  typeThread* thread= isAThread(group->threads->Get(group->nextThread++ % group->threadsLength)->ToObject());
+
+  if (!thread || thread->sigkill) {
+    group->error= 1;
+    return;
+  }
+
+  typeQueueItem* qitem= nuJobQueueItem();
+  typeJob* job= (typeJob*) qitem->asPtr;
+  job->jobType= kJobTypeTask;
+  job->typeTask.group= group;
+  job->typeTask.op= op;
+  job->typeTask.from= from;
+  job->typeTask.mid= mid;
+  job->typeTask.to= to;
+  job->typeTask.outFrom= outFrom;
+  job->typeTask.outTo= outTo;
+  group->pending++;
+  pushToInQueue(qitem, thread);
+}
+
+
+
+
+
+
+// Splits [from, to) into about `parts` tasks of op, each of at least kMinTaskElements.
+static void pushTasks (typeGroup* group, int op, size_t from, size_t to, int parts) {
+  size_t length= to- from;
+  size_t n= length / kMinTaskElements;
+  if (n < 1) n= 1;
+  if (n > (size_t) parts) n= parts;
+  size_t i= 0;
+  while (i < n) {
+    pushTask(group, op, from+ (length* i)/ n, 0, from+ (length* (i+ 1))/ n, 0, 0);
+    i++;
+  }
+}
+
+
+
+
+
+
+static void finishGroup (typeGroup* group) {
+  Local<Value> argv[2];
+  int i= 0;
+
+  while (i < group->pinsLength) unpinArray(&group->pins[i++]);
+  free(group->scratch);
+  free(group->runs);
+
+  if (group->error) {
+    argv[0]= Exception::Error(String::New(kThreadDestroyed));
+    argv[1]= Local<Value>::New(Null());
+  }
+  else {
+    argv[0]= Local<Value>::New(Null());
+    argv[1]= Local<Value>::New(group->pins[group->pinsLength- 1].owner);
+  }
+
+  Local<Object> cb= Local<Object>::New(group->cb);
+  group->cb.Dispose();
+  group->threads.Dispose();
+  free(group);
+
+  cb->CallAsFunction(Context::GetCurrent()->Global(), 2, argv);
+}
+
+
+
+
+
+
+// pool.sort(): the first round sorts group->runsLength runs in place. Then
+// each round merges pairs of runs from source into target (the array and the
+// scratch buffer, back and forth), splitting each merge among the threads,
+// until there's a single run. The tasks of a round write into group->target.
+static void nextSortRound (typeGroup* group) {
+  char* data= (char*) group->pins[0].data;
+  char* result= group->target;
+
+  if (group->error || ((group->runsLength == 1) && (result == data))) {
+    finishGroup(group);
+    return;
+  }
+
+  if (!group->scratch) {
+    group->scratch= (char*) malloc(group->length* group->ops->elementSize);
+    if (!group->scratch) {
+      group->error= 1;
+      finishGroup(group);
+      return;
+    }
+  }
+
+  group->source= result;
+  group->target= (result == data) ? group->scratch : data;
+
+  if (group->runsLength == 1) {
+    // The sorted array is in the scratch buffer
+    pushTasks(group, kTaskCopy, 0, group->length, group->threadsLength);
+  }
+  else {
+    int pairs= (group->runsLength+ 1)/ 2;
+    int segments= group->threadsLength/ pairs;
+    if (segments < 1) segments= 1;
+    int r= 0;
+    int k= 0;
+    while (r < group->runsLength) {
+      size_t from= group->runs[r];
+      size_t mid= group->runs[r+ 1];
+      // An odd run out is merged with nothing, i.e. copied
+      size_t to= (r+ 1 < group->runsLength) ? group->runs[r+ 2] : mid;
+      size_t length= to- from;
+      size_t n= length/ kMinTaskElements;
+      if (n < 1) n= 1;
+      if (n > (size_t) segments) n= segments;
+      size_t i= 0;
+      while (i < n) {
+        pushTask(group, kTaskMerge, from, mid, to, from+ (length* i)/ n, from+ (length* (i+ 1))/ n);
+        i++;
+      }
+      group->runs[k++]= from;
+      r+= 2;
+    }
+    group->runs[k]= group->length;
+    group->runsLength= k;
+  }
+
+  if (!group->pending) finishGroup(group);
+}
+
+
+
+
+
+
+// Main thread: a task is back from its thread (or has been aborted).
+static void taskDone (typeQueueItem* qitem) {
+  typeJob* job= (typeJob*) qitem->asPtr;
+  typeGroup* group= job->typeTask.group;
+  int op= job->typeTask.op;
+
+  destroyJobQueueItem(qitem);
+  if (--group->pending) return;
+
+  if (op == kTaskSearch) finishGroup(group);
+  else nextSortRound(group);
+}
+
+
+
+
+
+
+// Threads.pipeline(): a pool of threads per stage. The call() jobs go from a
+// thread of a stage straight to the least busy thread of the next, with the
+// result of one stage serialized as the args of the next, and come back to
+// the main thread only at the end. Each stage holds at most queueDepth jobs:
+// a thread that has one for a full stage waits for room, in pipelineForward(),
+// parked in uv_cond_wait() with its isolate. It runs nothing else meanwhile,
+// so a slow stage stalls the threads of the stage before it, not the main thread.
+// Once push() has said that the first stage is full, the pipeline emits a
+// 'drain' when it has room again.
+
+#define kPipelineStageFn "__pipelineStage"
+
+typedef struct {
+  int threadsLength;
+  typeThread** threads;
+  long depth;     //Jobs queued for or running in this stage
+  long maxDepth;
+  long waits;     //Times that the previous stage had to wait for room
+  double processed;
+  double busyNs;  //Running the stage function, all its threads together
+  uv_cond_t room;
+} typePipelineStage;
+
+struct typePipeline {
+  int stagesLength;
+  typePipelineStage* stages;
+  long queueDepth;
+  uv_mutex_t lock;
+  volatile int destroyed;
+  int full;       //push() has returned false: a 'drain' is due
+  uv_async_t drain;
+  long inFlight;  //Main thread only
+  double done;
+  double errors;
+  uint64_t started;
+  Persistent<Object> JSObject;
+  struct typePipeline* next; //In pipelines
+};
+typedef struct typePipeline typePipeline;
+
+// Those not freed yet. Main thread only.
+static typePipeline* pipelines= NULL;
+
+
+
+
+
+
+static typeThread* leastBusyStageThread (typePipelineStage* stage) {
+  typeThread* best= NULL;
+  int i= 0;
+  while (i < stage->threadsLength) {
+    typeThread* thread= stage->threads[i++];
+    if (!thread->sigkill && (!best || (thread->inQueue.length < best->inQueue.length))) best= thread;
+  }
+  return best;
+}
+
+// With the lock: a job is out of stage i. Wakes up a thread waiting for room
+// in it, and if it's the first stage, the main thread for the 'drain'.
+static void pipelineStageLeft (typePipeline* pipeline, int i) {
+  typePipelineStage* stage= &pipeline->stages[i];
+  stage->depth--;
+  uv_cond_signal(&stage->room);
+  if (!i && pipeline->full && (stage->depth < pipeline->queueDepth)) {
+    pipeline->full= 0;
+    uv_async_send(&pipeline->drain);
+  }
+}
+
+// Worker thread: the job is done with its stage.
+static void pipelineStageDone (typeJob* job, uint64_t busyNs) {
+  typePipeline* pipeline= job->typeCall.pipeline;
+  typePipelineStage* stage= &pipeline->stages[job->typeCall.stage];
+  uv_mutex_lock(&pipeline->lock);
+  stage->processed++;
+  stage->busyNs+= busyNs;
+  pipelineStageLeft(pipeline, job->typeCall.stage);
+  uv_mutex_unlock(&pipeline->lock);
+}
+
+// Main thread: a thread is being destroyed. If it's waiting for room in a
+// stage it has to see it. The others just check again.
+static void pipelinesWake (void) {
+  typePipeline* pipeline= pipelines;
+  while (pipeline) {
+    uv_mutex_lock(&pipeline->lock);
+    int i= 0;
+    while (i < pipeline->stagesLength) uv_cond_broadcast(&pipeline->stages[i++].room);
+    uv_mutex_unlock(&pipeline->lock);
+    pipeline= pipeline->next;
+  }
+}
+
+// Worker thread: hands the job, whose buffer holds [result], to the next stage.
+// Returns 0 if it's done with the last stage, -1 if the pipeline has been destroyed.
+static int pipelineForward (typeThread* thread, typeQueueItem* qitem) {
+  typeJob* job= (typeJob*) qitem->asPtr;
+  typePipeline* pipeline= job->typeCall.pipeline;
+  int n= job->typeCall.stage+ 1;
+  if (n >= pipeline->stagesLength) return 0;
+
+  typePipelineStage* next= &pipeline->stages[n];
+  typeThread* target= NULL;
+  uv_mutex_lock(&pipeline->lock);
+  if (next->depth >= pipeline->queueDepth) next->waits++;
+  while ((next->depth >= pipeline->queueDepth) && !pipeline->destroyed && !thread->sigkill) {
+    uv_cond_wait(&next->room, &pipeline->lock);
+  }
+  if (!pipeline->destroyed && !thread->sigkill && (target= leastBusyStageThread(next))) {
+    if (++next->depth > next->maxDepth) next->maxDepth= next->depth;
+  }
+  uv_mutex_unlock(&pipeline->lock);
+  if (!target) return -1;
+
+  job->typeCall.stage= n;
+  job->typeCall.argc= 1;
+  jobRelease(thread, job);
+  jobAccount(target, job, job->typeCall.bufferSize);
+  pushToInQueue(qitem, target);
+  return 1;
+}
+
+
+
+
+
+
+// pool.spawnActor(): an actor is an object that lives in a thread, the global
+// __actors[id], and a mailbox of jobs for it. Whenever the mailbox isn't empty
+// the actor's token is in its thread's inQueue: the thread runs one job of the
+// mailbox and puts the token back at the end of the inQueue, so that the
+// actors of a thread (and its other jobs) take turns, and the jobs of an actor
+// run one at a time, in order.
+
+typedef struct typeActor {
+  long id;
+  typeQueueItem* token; //A kJobTypeActor job
+  typeQueue mailbox;
+  uv_mutex_t lock;      //For scheduled and closed
+  int scheduled;        //The token is in the inQueue
+  int closed;           //actor.destroy()ed: freed once it isn't scheduled
+  double messages;      //Main thread only
+  Persistent<Object> thread;
+  Persistent<Object> JSObject;
+} typeActor;
+
+// Any thread: the mailbox is empty, the token is out and nobody has it.
+static void actorFree (typeActor* actor) {
+  free(actor->token->asPtr);
+  destroyItem(actor->token);
+  uv_mutex_destroy(&actor->mailbox.queueLock);
+  uv_mutex_destroy(&actor->lock);
+  free(actor);
+}
+
+// Worker thread: the actor's turn. Returns its next job.
+static typeQueueItem* actorNext (typeThread* thread, typeActor* actor) {
+  uv_mutex_lock(&actor->lock);
+  typeQueueItem* qitem= queue_pull(&actor->mailbox);
+  int more= actor->mailbox.length > 0;
+  int release= 0;
+  if (!more) {
+    actor->scheduled= 0;
+    release= actor->closed;
+  }
+  uv_mutex_unlock(&actor->lock);
+
+  if (more) queue_push(actor->token, &thread->inQueue);
+  if (release) actorFree(actor);
+  return qitem;
+}
+
+
+
+
+
+
+// pool.schedule(): a program that the scheduler thread queues every everyMs
+// (see schedulerThread()) straight into the pool's threads. The jobs are evals
+// without callback: the main thread doesn't hear of them unless they emit.
+
+enum scheduleOverlap {
+  kOverlapSkip,   //Not while the previous run is queued or running
+  kOverlapQueue
+};
+
+enum scheduleMissed {
+  kMissedSkip,    //Run once for all the ticks missed
+  kMissedCatchUp  //Run once per tick missed
+};
+
+typedef struct typeSchedule {
+  struct typeSchedule* next; //In its wheel slot
+  long rounds;               //Turns of the wheel to go
+  double due;                //ms, of the next tick without jitter
+  double everyMs;
+  double jitterMs;
+  int overlap;
+  int missed;
+  uint32_t seed;             //xorshift32, never 0
+  char* source;
+  int threadsLength;
+  typeThread** threads;
+  int cancelled;
+  volatile long refs;        //The wheel, plus one per job
+  volatile long running;     //Jobs queued or running
+  volatile long errors;
+  double runs;               //These under wheelLock
+  double overlapSkipped;
+  double missedTicks;
+  double dropped;            //Because of the queue limit
+} typeSchedule;
+
+static void scheduleRelease (typeSchedule* schedule) {
+  if (atomic_dec(&schedule->refs)) return;
+  free(schedule->source);
+  free(schedule->threads);
+  free(schedule);
+}
+
+// Worker (or main, if aborted) thread: a scheduled job is done.
+static void scheduleJobDone (typeJob* job, int error) {
+  typeSchedule* schedule= job->schedule;
+  job->schedule= NULL;
+  if (error) atomic_inc(&schedule->errors);
+  atomic_dec(&schedule->running);
+  scheduleRelease(schedule);
+}
+
+
+
+
+
+
+// Worker thread: thread.load()'s file, malloc()ed, or NULL and *error a malloc()ed message.
+static char* readFile (const char* path, char** error) {
+  char* buf= NULL;
+  long len= -1;
+  errno= 0;
+  FILE* fp= fopen(path, "rb");
+  if (fp && !fseek(fp, 0, SEEK_END)) len= ftell(fp);
+  if (len >= 0) {
+    rewind(fp);
+    buf= (char*) malloc(len+ 1);
+    if (buf && (fread(buf, 1, len, fp) == (size_t) len)) {
+      buf[len]= 0;
+      fclose(fp);
+      return buf;
+    }
+  }
+  const char* reason= strerror(errno ? errno : EIO);
+  *error= (char*) malloc(strlen(path)+ strlen(reason)+ 40);
+  sprintf(*error, "thread.load(): can't read %s: %s", path, reason);
+  free(buf);
+  if (fp) fclose(fp);
+  return NULL;
+}
+
+
+
+
+
+
+static Handle<Value> Puts (const Arguments &args) {
+  //fprintf(stdout, "*** Puts BEGIN\n");
+
+  HandleScope scope;
+  int i= 0;
+  while (i < args.Length()) {
+    String::Utf8Value c_str(args[i]);
+    fputs(*c_str, stdout);
+    i++;
+  }
+  fflush(stdout);
+
+  //fprintf(stdout, "*** Puts END\n");
+  return Undefined();
+}
+
+static Handle<Value> Print (const Arguments &args) {
+	HandleScope scope;
+	int i= 0;
+	while (i < args.Length()) {
+		String::Utf8Value c_str(args[i]);
+		fputs(*c_str, stdout);
+		i++;
+	}
+	static char end = '\n';
+	fputs(&end, stdout);
+	fflush(stdout);
+	
+	//fprintf(stdout, "*** Puts END\n");
+	return Undefined();
+}
+
+
+
+
+// The stall monitor: a thread that every kStallScanMs looks for the threads
+// whose job has been running for longer than stallThresholdMs (see
+// Threads.setStallThreshold()). It asks V8 to break into the stuck isolate,
+// whose debug event listener records its JS stack, and then the main thread
+// emits a 'stall' event on the thread with it, see stallNotify().
+
+#define kStallScanMs 50
+#define kStallStackWaitMs 1000 //Without a break by then the 'stall' goes without its stack
+#define kStallFrames 32
+
+enum stallStates {
+  kStallNone,
+  kStallWaiting, //For the stack
+  kStallReady,   //To be emitted
+  kStallEmitted
+};
+
+static std::vector<typeThread*> stallWatched;
+static uv_mutex_t stallLock;
+static uv_cond_t stallCV;
+static uv_async_t stallAsync;
+static uv_thread_t stallThread;
+static int stallRunning= 0;
+static volatile long stallThresholdMs= 0;
+static volatile long stallsTotal= 0;
+
+static void stallWatch (typeThread* thread) {
+  thread->busySince= 0;
+  thread->stallState= kStallNone;
+  thread->stallListening= 0;
+  uv_mutex_lock(&stallLock);
+  stallWatched.push_back(thread);
+  uv_mutex_unlock(&stallLock);
+}
+
+static void stallUnwatch (typeThread* thread) {
+  uv_mutex_lock(&stallLock);
+  std::vector<typeThread*>::iterator i= std::find(stallWatched.begin(), stallWatched.end(), thread);
+  if (i != stallWatched.end()) stallWatched.erase(i);
+  free(thread->stallStack);
+  thread->stallStack= NULL;
+  uv_mutex_unlock(&stallLock);
+}
+
+// In the thread, at the start of each job.
+static void stallHeartbeat (typeThread* thread) {
+  thread->heartbeat++;
+  thread->busySince= uv_hrtime();
+}
+
+static std::string stallFormat (Local<StackTrace> trace) {
+  std::string stack;
+  int i= 0;
+  while (i < trace->GetFrameCount()) {
+    Local<StackFrame> frame= trace->GetFrame(i++);
+    String::Utf8Value fn(frame->GetFunctionName());
+    String::Utf8Value script(frame->GetScriptName());
+    char position[32];
+    snprintf(position, sizeof(position), ":%d:%d", frame->GetLineNumber(), frame->GetColumn());
+    stack+= "    at ";
+    stack+= (*fn && **fn) ? *fn : "<anonymous>";
+    stack+= " (";
+    stack+= (*script && **script) ? *script : "<eval>";
+    stack+= position;
+    stack+= ")\n";
+  }
+  return stack;
+}
+
+// The listener of the isolate's debug events: Debug::DebugBreak() lands here,
+// in the thread, in the middle of whatever it's running.
+static void stallDebugEvent (const Debug::EventDetails& details) {
+  if (details.GetEvent() != Break) return;
+  typeThread* thread= (typeThread*) Isolate::GetCurrent()->GetData();
+  if (!thread) return;
+
+  HandleScope scope;
+  uv_mutex_lock(&stallLock);
+  int wanted= (thread->stallState == kStallWaiting) && (thread->stallBeat == thread->heartbeat);
+  uv_mutex_unlock(&stallLock);
+  // A break that comes after its job is done isn't about that job
+  if (!wanted) return;
+
+  std::string stack= stallFormat(StackTrace::CurrentStackTrace(kStallFrames, StackTrace::kDetailed));
+  uv_mutex_lock(&stallLock);
+  if (thread->stallState == kStallWaiting) {
+    free(thread->stallStack);
+    thread->stallStack= strdup(stack.c_str());
+    thread->stallState= kStallReady;
+  }
+  uv_mutex_unlock(&stallLock);
+  uv_async_send(&stallAsync);
+}
+
+// In the thread: listens to the debug events only while stalls are watched.
+static void stallListen (typeThread* thread) {
+  int on= atomic_read(&stallThresholdMs) > 0;
+  if (on == thread->stallListening) return;
+  Debug::SetDebugEventListener2(on ? stallDebugEvent : NULL);
+  thread->stallListening= on;
+}
+
+static void stallWait (int ms) {
+#ifdef WWT_PTHREAD
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  ts.tv_nsec+= (ms % 1000)* 1000000L;
+  ts.tv_sec+= ms/ 1000+ ts.tv_nsec/ 1000000000L;
+  ts.tv_nsec%= 1000000000L;
+  pthread_cond_timedwait(&stallCV, &stallLock, &ts);
+#else
+  uv_cond_timedwait(&stallCV, &stallLock, (uint64_t) ms* 1000000);
+#endif
+}
+
+static void stallMonitor (void* arg) {
+  uv_mutex_lock(&stallLock);
+  while (1) {
+    long threshold= atomic_read(&stallThresholdMs);
+    if (threshold <= 0) {
+      stallWait(kStallScanMs* 20);
+      continue;
+    }
+    uint64_t now= uv_hrtime();
+    int notify= 0;
+    size_t i= 0;
+    while (i < stallWatched.size()) {
+      typeThread* thread= stallWatched[i++];
+      uint64_t since= thread->busySince;
+      long beat= thread->heartbeat;
+      if (thread->stallState == kStallWaiting) {
+        if ((thread->stallBeat != beat) || (now- thread->stallSince > (uint64_t) kStallStackWaitMs* 1000000)) {
+          // Done, or not breaking (stuck outside of JS?): it goes without its stack
+          thread->stallState= kStallReady;
+          notify= 1;
+        }
+        continue;
+      }
+      if (!since || (thread->stallBeat == beat) || (now- since < (uint64_t) threshold* 1000000)) continue;
+
+      thread->stallBeat= beat;
+      thread->stallSince= now;
+      thread->stallMs= (now- since)/ 1e6;
+      thread->stallState= kStallWaiting;
+      atomic_inc(&stallsTotal);
+      // Destroy() may TerminateExecution() this isolate: it does so under IDLE_mutex
+      uv_mutex_lock(&thread->IDLE_mutex);
+      if (thread->isolate && thread->stallListening) {
+        Debug::DebugBreak(thread->isolate);
+      }
+      else {
+        thread->stallState= kStallReady;
+        notify= 1;
+      }
+      uv_mutex_unlock(&thread->IDLE_mutex);
+    }
+    if (notify) uv_async_send(&stallAsync);
+    stallWait(kStallScanMs);
+  }
+}
+
+// In the main thread: emits the 'stall's that are ready.
+static void stallNotify (uv_async_t* watcher, int revents) {
+  HandleScope scope;
+  std::vector<typeThread*> threads;
+  std::vector<std::string> stacks;
+  std::vector<double> ms;
+
+  uv_mutex_lock(&stallLock);
+  size_t i= 0;
+  while (i < stallWatched.size()) {
+    typeThread* thread= stallWatched[i++];
+    if (thread->stallState != kStallReady) continue;
+    thread->stallState= kStallEmitted;
+    threads.push_back(thread);
+    stacks.push_back(thread->stallStack ? thread->stallStack : "");
+    ms.push_back(thread->stallMs);
+    free(thread->stallStack);
+    thread->stallStack= NULL;
+  }
+  uv_mutex_unlock(&stallLock);
+
+  TryCatch onError;
+  i= 0;
+  while (i < threads.size()) {
+    typeThread* thread= threads[i];
+    if (thread->sigkill) {
+      i++;
+      continue;
+    }
+    Local<Object> stall= Object::New();
+    stall->Set(String::NewSymbol("thread"), Number::New(thread->id));
+    stall->Set(String::NewSymbol("ms"), Number::New(ms[i]));
+    if (stacks[i].length()) stall->Set(String::NewSymbol("stack"), String::New(stacks[i].c_str()));
+    Local<Array> array= Array::New(1);
+    array->Set(0, stall);
+    Local<Value> args[2]= { String::NewSymbol("stall"), array };
+    thread->dispatchEvents->CallAsFunction(thread->JSObject, 2, args);
+    if (onError.HasCaught()) {
+      node::FatalException(onError);
+      return;
+    }
+    i++;
+  }
+}
+
+static void stall_init (void) {
+  uv_mutex_init(&stallLock);
+  uv_cond_init(&stallCV);
+  uv_async_init(uv_default_loop(), &stallAsync, stallNotify);
+  uv_unref((uv_handle_t*) &stallAsync);
+}
+
+
+
+
+
+
+static Local<Function> sharedMapClass (void);
+static Handle<Value> Frozen (const Arguments &args);
+static void eventLoop (typeThread* thread);
+
+// A background thread
+#ifdef WWT_PTHREAD
+static void* aThread (void* arg) {
+#else
+static void aThread (void* arg) {
+#endif
+
+  int dummy;
+  pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, &dummy);
+  pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, &dummy);
+
+  typeThread* thread= (typeThread*) arg;
+  Isolate* isolate= Isolate::New();
+  isolate->SetData(thread);
+  uv_mutex_lock(&thread->IDLE_mutex);
+  thread->isolate= isolate;
+  uv_mutex_unlock(&thread->IDLE_mutex);
+
+  if (useLocker) {
+    //printf("**** USING LOCKER: YES\n");
+    v8::Locker myLocker(thread->isolate);
+    //v8::Isolate::Scope isolate_scope(thread->isolate);
+    eventLoop(thread);
+  }
+  else {
+    //printf("**** USING LOCKER: NO\n");
+    //v8::Isolate::Scope isolate_scope(thread->isolate);
+    eventLoop(thread);
+  }
+  // Destroy() may TerminateExecution() this isolate: it does so under IDLE_mutex
+  uv_mutex_lock(&thread->IDLE_mutex);
+  thread->isolate= NULL;
+  uv_mutex_unlock(&thread->IDLE_mutex);
+  isolate->Exit();
+  isolate->Dispose();
+
+  // wake up callback, so that it can release the thread and whatever is left in its queues
+  thread->ended= 1;
+  uv_async_send(&thread->async_watcher);
+#ifdef WWT_PTHREAD
+  return NULL;
+#endif
+}
+
+
+
+static Handle<Value> threadEmit (const Arguments &args);
+static Handle<Value> threadParseJSON (const Arguments &args);
+static Handle<Value> postMessage (const Arguments &args);
+static Handle<Value> postError (const Arguments &args);
+
+
+
+static void eventLoop (typeThread* thread) {
+  thread->isolate->Enter();
+  thread->context= Context::New();
+  thread->context->Enter();
+
+  {
+    HandleScope scope1;
+
+    thread->bson= new BSON();
+    thread->bufferTemplate= newBufferTemplate();
+
+    Local<Object> global= thread->context->Global();
+
+    Local<Function> bufferConstructor= thread->bufferTemplate->GetFunction();
+    global->Set(String::NewSymbol("Buffer"), bufferConstructor);
+
+    Handle<Object> fs_obj = Object::New();
+    JSObjFn(fs_obj, "readFileSync", readFileSync_);
+    global->Set(String::New("native_fs_"), fs_obj, attribute_ro_dd);
+
+    Handle<Object> console_obj = Object::New();
+    JSObjFn(console_obj, "log", console_log);
+    JSObjFn(console_obj, "error", console_error);
+    global->Set(String::New("console"), console_obj, attribute_ro_dd);
+
+    global->Set(String::NewSymbol("self"), global);
+    global->Set(String::NewSymbol("global"), global);
+
+    global->Set(String::NewSymbol("puts"), FunctionTemplate::New(Puts)->GetFunction());
+    global->Set(String::NewSymbol("print"), FunctionTemplate::New(Print)->GetFunction());
+
+    global->Set(String::NewSymbol("postMessage"), FunctionTemplate::New(postMessage)->GetFunction());
+    global->Set(String::NewSymbol("__postError"), FunctionTemplate::New(postError)->GetFunction());
+    global->Set(String::NewSymbol("SharedMap"), sharedMapClass());
+    global->Set(String::NewSymbol("frozen"), FunctionTemplate::New(Frozen)->GetFunction());
+
+    Local<Object> threadObject= Object::New();
+    global->Set(String::NewSymbol("thread"), threadObject);
+
+    threadObject->Set(String::NewSymbol("id"), Number::New(thread->id));
+    threadObject->Set(String::NewSymbol("emit"), FunctionTemplate::New(threadEmit)->GetFunction());
+    threadObject->Set(String::NewSymbol("parseJSON"), FunctionTemplate::New(threadParseJSON)->GetFunction());
+    Local<Object> dispatchEvents= Script::Compile(String::New(kEvents_js))->Run()->ToObject()->CallAsFunction(threadObject, 0, NULL)->ToObject();
+    Local<Object> dispatchNextTicks= Script::Compile(String::New(kThread_nextTick_js))->Run()->ToObject();
+    Local<Array> _ntq= (v8::Array*) *threadObject->Get(String::NewSymbol("_ntq"));
+
+    Script::Compile(String::New(kLoad_js))->Run();
+
+    double nextTickQueueLength= 0;
+    long int ctr= 0;
+
+    //SetFatalErrorHandler(FatalErrorCB);
+
+    while (!thread->sigkill) {
+      typeJob* job;
+      typeQueueItem* qitem;
+
+      {
+        HandleScope scope2;
+        TryCatch onError;
+        String::Utf8Value* str;
+        Local<String> source;
+        Local<Script> script;
+        Local<Value> resultado;
+
+
+        while (!thread->sigkill && (qitem= queue_pull(&thread->inQueue))) {
+
+          job= (typeJob*) qitem->asPtr;
+
+          if (job->jobType == kJobTypeActor) {
+            if (!(qitem= actorNext(thread, job->typeActor.actor))) continue;
+            job= (typeJob*) qitem->asPtr;
+          }
+
+          stallListen(thread);
+          stallHeartbeat(thread);
+
+          if ((++ctr) > 2e3) {
+            ctr= 0;
+            V8::IdleNotification();
+          }
+
+          if (job->jobType == kJobTypeEval) {
+            //Ejecutar un texto
+
+            char* loadError= NULL;
+            if (job->typeEval.useStringObject) {
+              str= job->typeEval.scriptText_StringObject;
+              source= String::New(**str, (*str).length());
+              delete str;
+            }
+            else if (job->typeEval.loadPath) {
+              char* text= readFile(job->typeEval.scriptText_CharPtr, &loadError);
+              if (text) {
+                jobAccount(thread, job, strlen(text));
+                source= String::New(text);
+                free(text);
+              }
+              else if (!job->typeEval.tiene_callBack) {
+                // Nobody to tell but the 'error' listeners
+                Local<Object> error= Object::New();
+                error->Set(String::NewSymbol("message"), String::New(loadError));
+                error->Set(String::NewSymbol("filename"), String::New(job->typeEval.scriptText_CharPtr));
+                error->Set(String::NewSymbol("lineno"), Number::New(0));
+                Local<Value> postError= global->Get(String::NewSymbol("__postError"));
+                Handle<Value> argv[1]= { error };
+                if (postError->IsFunction()) Local<Function>::Cast(postError)->Call(global, 1, argv);
+              }
+              free(job->typeEval.scriptText_CharPtr);
+            }
+            else {
+              source= String::New(job->typeEval.scriptText_CharPtr);
+              free(job->typeEval.scriptText_CharPtr);
+            }
+            jobRelease(thread, job);
+
+            if (!loadError) {
+              script= Script::New(source);
+              if (!onError.HasCaught()) resultado= script->Run();
+            }
+            if (job->schedule) scheduleJobDone(job, onError.HasCaught());
+
+            if (job->typeEval.tiene_callBack) {
+              job->typeEval.error= (loadError || onError.HasCaught()) ? 1 : 0;
+              if (loadError) {
+                job->typeEval.resultado= new String::Utf8Value(String::New(loadError));
+              }
+              else if (job->typeEval.error && !onError.CanContinue()) {
+                // TerminateExecution()d by Destroy()
+                job->typeEval.resultado= new String::Utf8Value(String::New(kThreadDestroyed));
+              }
+              else {
+                job->typeEval.resultado= new String::Utf8Value(job->typeEval.error ? onError.Exception() : resultado);
+              }
+              waitForQueueRoom(thread);
+              jobAccount(thread, job, job->typeEval.resultado->length());
+              queue_push(qitem, &thread->outQueue);
+              // wake up callback
+              if (!(thread->inQueue.length)) uv_async_send(&thread->async_watcher);
+            }
+            else {
+              destroyJobQueueItem(qitem);
+            }
+
+            free(loadError);
+            if (onError.HasCaught()) onError.Reset();
+          }
+          else if (job->jobType == kJobTypeEvent) {
+            //Emitir evento.
+
+            Local<Value> args[2];
+            str= job->typeEvent.eventName;
+            args[0]= String::New(**str, (*str).length());
+            delete str;
+
+            Local<Array> array= Array::New(job->typeEvent.length);
+            args[1]= array;
+
+            int i= 0;
+            while (i < job->typeEvent.length) {
+              str= job->typeEvent.argumentos[i];
+              array->Set(i, String::New(**str, (*str).length()));
+              delete str;
+              i++;
+            }
+
+            free(job->typeEvent.argumentos);
+            jobRelease(thread, job);
+            destroyJobQueueItem(qitem);
+            dispatchEvents->CallAsFunction(global, 2, args);
+          }
+          else if (job->jobType == kJobTypeEventSerialized) {
+            Local<Value> args[2];
+            str= job->typeEventSerialized.eventName;
+            args[0]= String::New(**str, (*str).length());
+            delete str;
+
+      int len = job->typeEventSerialized.length;
+      Local<Array> array= Array::New(len);
+      args[1]= array;
+
+        {
+          BSON *bson = isolateBSON();
+          char* data = job->typeEventSerialized.buffer;
+          size_t size = job->typeEventSerialized.bufferSize;
+          BSONDeserializer deserializer(bson, data, size);
+          Local<Object> result = deserializer.DeserializeDocument()->ToObject();
+          int i = 0; do { array->Set(i, result->Get(i)); } while (++i < len);
+          free(data);
+        }
+
+            jobRelease(thread, job);
+            destroyJobQueueItem(qitem);
+            dispatchEvents->CallAsFunction(global, 2, args);
+          }
+          else if (job->jobType == kJobTypeCall) {
+            //Llamar a una función
+            int argc= job->typeCall.argc;
+            // The thens get only the previous result
+            int pinnedLength= job->typeCall.thenNext ? 0 : job->typeCall.pinnedLength;
+            Local<Value>* argv= new Local<Value>[argc+ 1];
+            Local<Object>* views= new Local<Object>[pinnedLength+ 1];
+            char* errorMessage= NULL;
+            int i;
+
+            try {
+              Local<Object> array= deserialize(job->typeCall.buffer, job->typeCall.bufferSize);
+              i= 0;
+              while (i < argc) { argv[i]= array->Get(i); i++; }
+            }
+            catch (char* err) {
+              errorMessage= err;
+            }
+            i= 0;
+            while (i < pinnedLength) {
+              typePin* pin= &job->typeCall.pinned[i];
+              argv[pin->argIndex]= views[i++]= pinnedView(pin);
+            }
+            free(job->typeCall.buffer);
+            job->typeCall.buffer= NULL;
+            jobRelease(thread, job);
+
+            uint64_t t0= job->typeCall.pipeline ? uv_hrtime() : 0;
+            int batch= !job->typeCall.thenNext && !strcmp(**job->typeCall.fnName, "__batch");
+            if (!errorMessage) {
+              Local<Object> holder= global;
+              Local<Value> fn= lookupFunction(global, job->typeCall.fnName, &holder);
+              if (onError.HasCaught()) {
+                resultado= Local<Value>();
+              }
+              else if (!fn->IsFunction()) {
+                std::string msg("thread.call(): ");
+                msg+= **job->typeCall.fnName;
+                msg+= " is not a function";
+                ThrowException(Exception::TypeError(String::New(msg.c_str())));
+              }
+              else {
+                resultado= Local<Function>::Cast(fn)->Call(holder, argc, argv);
+              }
+            }
+
+            // The thread can't keep them once the main thread gets them back.
+            i= 0;
+            while (i < pinnedLength) {
+              typePin* pin= &job->typeCall.pinned[i];
+              views[i++]->SetIndexedPropertiesToExternalArrayData(pin->data, pin->arrayType, 0);
+            }
+            delete[] views;
+            delete[] argv;
+            if (job->typeCall.pipeline) {
+              // Its fnName goes on to the next stage
+              pipelineStageDone(job, uv_hrtime()- t0);
+            }
+            else {
+              delete job->typeCall.fnName;
+              job->typeCall.fnName= NULL;
+            }
+
+            if (job->typeCall.tiene_callBack || job->typeCall.pipeline || job->typeCall.thens) {
+              Local<Array> result= Array::New(1);
+              job->typeCall.error= (errorMessage || onError.HasCaught()) ? 1 : 0;
+              if (errorMessage) {
+                result->Set(0, String::New(errorMessage));
+                free(errorMessage);
+              }
+              else if (onError.HasCaught()) {
+                result->Set(0, onError.CanContinue() ? onError.Exception()->ToString() : String::New(kThreadDestroyed));
+              }
+              else {
+                result->Set(0, resultado);
+              }
+              try {
+                job->typeCall.buffer= serialize(result, &job->typeCall.bufferSize);
+              }
+              catch (char* err) {
+                if (batch && !job->typeCall.error && batchFailures(resultado)) {
+                  free(err);
+                  err= NULL;
+                  try {
+                    job->typeCall.buffer= serialize(result, &job->typeCall.bufferSize);
+                  }
+                  catch (char* again) {
+                    err= again;
+                  }
+                }
+                if (err) {
+                  result->Set(0, String::New(err));
+                  free(err);
+                  job->typeCall.error= 1;
+                  job->typeCall.buffer= serialize(result, &job->typeCall.bufferSize);
+                }
+              }
+              if (job->memo) {
+                if (!job->typeCall.error && job->memo->store) memo_put(job->memo, job->typeCall.buffer, job->typeCall.bufferSize);
+                memo_key_free(job->memo);
+                job->memo= NULL;
+              }
+              if (job->typeCall.thens && !job->typeCall.error && (job->typeCall.thenNext < job->typeCall.thensLength)) {
+                // Chained: [result] are the next function's args, and it runs next, here
+                job->typeCall.fnName= job->typeCall.thens[job->typeCall.thenNext++];
+                job->typeCall.argc= 1;
+                jobAccount(thread, job, job->typeCall.bufferSize);
+                stack_push(qitem, &thread->inQueue);
+                if (onError.HasCaught()) onError.Reset();
+                continue;
+              }
+              if (job->typeCall.pipeline && !job->typeCall.error) {
+                int forwarded= pipelineForward(thread, qitem);
+                if (forwarded > 0) {
+                  if (onError.HasCaught()) onError.Reset();
+                  continue;
+                }
+                if (forwarded < 0) {
+                  free(job->typeCall.buffer);
+                  result->Set(0, String::New("pipeline.push(): the pipeline has been destroyed"));
+                  job->typeCall.error= 1;
+                  job->typeCall.buffer= serialize(result, &job->typeCall.bufferSize);
+                }
+              }
+              waitForQueueRoom(thread);
+              jobAccount(thread, job, job->typeCall.bufferSize);
+            }
+            else {
+              free(errorMessage);
+            }
+
+            freeThens(job);
+            if (job->typeCall.tiene_callBack || job->typeCall.pinnedLength || job->typeCall.pipeline) {
+              // The pinned arrays go back to the main thread in any case
+              queue_push(qitem, &thread->outQueue);
+              if (!(thread->inQueue.length)) uv_async_send(&thread->async_watcher);
+            }
+            else {
+              free(job->typeCall.buffer);
+              job->typeCall.buffer= NULL;
+              jobRelease(thread, job);
+              destroyJobQueueItem(qitem);
+            }
+
+            if (onError.HasCaught()) onError.Reset();
+          }
+          else if (job->jobType == kJobTypeTask) {
+            runTask(job);
+            queue_push(qitem, &thread->outQueue);
+            if (!(thread->inQueue.length)) uv_async_send(&thread->async_watcher);
+          }
+        }
+
+        if (_ntq->Length()) {
+
+          if ((++ctr) > 2e3) {
+            ctr= 0;
+            V8::IdleNotification();
+          }
+
+          stallHeartbeat(thread);
+          resultado= dispatchNextTicks->CallAsFunction(global, 0, NULL);
+          if (onError.HasCaught()) {
+            nextTickQueueLength= 1;
+            onError.Reset();
+          }
+          else {
+            nextTickQueueLength= resultado->NumberValue();
+          }
+        }
+      }
+
+      if (nextTickQueueLength || thread->inQueue.length) continue;
+      thread->busySince= 0;
+      if (thread->sigkill) break;
+
+      uv_mutex_lock(&thread->IDLE_mutex);
+      if (!thread->inQueue.length && !thread->sigkill) {
+        thread->IDLE= 1;
+        uv_cond_wait(&thread->IDLE_cv, &thread->IDLE_mutex);
+        thread->IDLE= 0;
+      }
+      uv_mutex_unlock(&thread->IDLE_mutex);
+    }
+  }
+
+  delete thread->bson;
+  thread->bson= NULL;
+  if (thread->frozenViews) {
+    thread->frozenViews->view.Dispose();
+    thread->frozenViews->arrayPrototype.Dispose();
+    delete thread->frozenViews;
+    thread->frozenViews= NULL;
+  }
+  thread->context.Dispose();
+
+  // Run the weak callbacks of the Buffers and frozen views that are still around.
+  // Bounded, so that a thread can't be kept from ending by weak callbacks that
+  // keep making garbage: the memory of the ones that haven't run by then leaks.
+  int rounds= 0;
+  while (!V8::IdleNotification() && (++rounds < kTeardownGCRounds));
+  thread->bufferTemplate.Dispose();
+}
+
+
+
+
+
+
+static void remoteJobDone (typeThread* thread, typeQueueItem* qitem);
+static void remoteJobAborted (typeJob* job, Local<Value> error);
+static void pipelineJobDone (typeJob* job);
+static void pipelineJobAborted (typeJob* job);
+static void actorAbort (typeThread* thread, typeActor* actor, Local<Value> error);
+
+// Frees the payload of a job that never reached its thread and, if it has a
+// callback, calls it with an error. Main thread only.
+static void abortJob (typeThread* thread, typeQueueItem* qitem, Local<Value> error) {
+  typeJob* job= (typeJob*) qitem->asPtr;
+  int i;
+
+  if (job->jobType == kJobTypeEval) {
+    if (job->typeEval.useStringObject) {
+      delete job->typeEval.scriptText_StringObject;
+    }
+    else {
+      free(job->typeEval.scriptText_CharPtr);
+    }
+  }
+  else if (job->jobType == kJobTypeEvent) {
+    delete job->typeEvent.eventName;
+    i= 0;
+    while (i < job->typeEvent.length) delete job->typeEvent.argumentos[i++];
+    free(job->typeEvent.argumentos);
+  }
+  else if (job->jobType == kJobTypeEventSerialized) {
+    delete job->typeEventSerialized.eventName;
+    free(job->typeEventSerialized.buffer);
+  }
+  else if (job->jobType == kJobTypeCall) {
+    delete job->typeCall.fnName;
+    freeThens(job);
+    free(job->typeCall.buffer);
+    unpinJob(job);
+    if (job->typeCall.pipeline) pipelineJobAborted(job);
+  }
+  else if (job->jobType == kJobTypeTask) {
+    job->typeTask.group->error= 1;
+    taskDone(qitem);
+    return;
+  }
+  else if (job->jobType == kJobTypeActor) {
+    actorAbort(thread, job->typeActor.actor, error);
+    return;
+  }
+  jobRelease(thread, job);
+
+  if (job->schedule) scheduleJobDone(job, 1);
+
+  if (job->memo) {
+    memo_key_free(job->memo);
+    job->memo= NULL;
+  }
+
+  if (job->remote) {
+    remoteJobAborted(job, error);
+    job->typeEval.tiene_callBack= job->typeCall.tiene_callBack= 0;
+  }
+
+  if (((job->jobType == kJobTypeEval) && job->typeEval.tiene_callBack) ||
+      ((job->jobType == kJobTypeCall) && job->typeCall.tiene_callBack)) {
+    Local<Value> argv[2];
+    argv[0]= error;
+    argv[1]= Local<Value>::New(Null());
+    job->typeEval.tiene_callBack= job->typeCall.tiene_callBack= 0;
+    job->cb->CallAsFunction(thread->JSObject, 2, argv);
+    job->cb.Dispose();
+  }
+
+  destroyJobQueueItem(qitem);
+}
+
+
+
+
+
+
+static void recycleaThread (uv_handle_t* handle) {
+  typeThread* thread= (typeThread*) handle;
+
+  uv_cond_destroy(&thread->IDLE_cv);
+  uv_mutex_destroy(&thread->IDLE_mutex);
+  uv_mutex_destroy(&thread->inQueue.queueLock);
+  uv_mutex_destroy(&thread->outQueue.queueLock);
+
+  if (freeThreadsQueue && (freeThreadsQueue->length < kFreeThreadsHighWater)) {
+    stack_push(nuItem(kItemTypePointer, thread), freeThreadsQueue);
+  }
+  else {
+    free(thread);
+  }
+}
+
+
+
+
+
+
+// Runs in the main thread once the thread has ended (or never started), and
+// its outQueue has been delivered: whatever is left in the inQueue never ran.
+static void destroyaThread (typeThread* thread) {
+  typeQueueItem* qitem;
+
+  HandleScope scope;
+  TryCatch onError;
+  Local<Value> error= Exception::Error(String::New(kThreadDestroyed));
+  while ((qitem= queue_pull(&thread->inQueue))) {
+    abortJob(thread, qitem, error);
+    if (onError.HasCaught()) {
+      uv_async_send(&thread->async_watcher); // come back for the rest
+      reportQueuedBytes();
+      node::FatalException(onError);
+      return;
+    }
+  }
+  reportQueuedBytes();
+  stallUnwatch(thread);
+
+  thread->sigkill= 0;
+  thread->ended= 0;
+  thread->IDLE= 0;
+  thread->JSObject->SetPointerInInternalField(0, NULL);
+  thread->JSObject.Dispose();
+  thread->dispatchEvents.Dispose();
+
+  V8::AdjustAmountOfExternalAllocatedMemory(-((int) sizeof(typeThread)));
+  uv_close((uv_handle_t*)&thread->async_watcher, recycleaThread);
+}
+
+
+
+
+
+
+// C callback that runs in the main nodejs thread. This is the one responsible for
+// calling the thread's JS callback.
 static void Callback (uv_async_t *watcher, int revents) {
   typeThread* thread= (typeThread*) watcher;
 
-  if (thread->sigkill) {
-    destroyaThread(thread);
+  // A thread being destroyed wakes us up once more when it has ended.
+  if (thread->sigkill && !thread->ended) return;
+
+  HandleScope scope;
+  typeJob* job;
+  Local<Value> argv[2];
+  Local<Value> null= Local<Value>::New(Null());
+  typeQueueItem* qitem;
+  String::Utf8Value* str;
+
+  TryCatch onError;
+  while ((qitem= queue_pull(&thread->outQueue))) {
+    job= (typeJob*) qitem->asPtr;
+
+    if (job->remote) {
+      remoteJobDone(thread, qitem);
+    }
+    else if (job->jobType == kJobTypeEval) {
+
+      if (job->typeEval.tiene_callBack) {
+        str= job->typeEval.resultado;
+
+        if (job->typeEval.error) {
+          argv[0]= Exception::Error(String::New(**str, (*str).length()));
+          argv[1]= null;
+        } else {
+          argv[0]= null;
+          argv[1]= String::New(**str, (*str).length());
+        }
+        job->cb->CallAsFunction(thread->JSObject, 2, argv);
+        job->cb.Dispose();
+        job->typeEval.tiene_callBack= 0;
+
+        delete str;
+        job->typeEval.resultado= NULL;
+      }
+
+      jobRelease(thread, job);
+      destroyJobQueueItem(qitem);
+
+      if (onError.HasCaught()) {
+        if (thread->outQueue.first) {
+          uv_async_send(&thread->async_watcher); // wake up callback again
+        }
+        reportQueuedBytes();
+        node::FatalException(onError);
+        return;
+      }
+    }
+    else if (job->jobType == kJobTypeEvent) {
+
+      //fprintf(stdout, "*** Callback\n");
+
+      Local<Value> args[2];
+
+      str= job->typeEvent.eventName;
+      args[0]= String::New(**str, (*str).length());
+      delete str;
+
+      Local<Array> array= Array::New(job->typeEvent.length);
+      args[1]= array;
+
+      int i= 0;
+      while (i < job->typeEvent.length) {
+        str= job->typeEvent.argumentos[i];
+        array->Set(i, String::New(**str, (*str).length()));
+        delete str;
+        i++;
+      }
+
+      free(job->typeEvent.argumentos);
+      jobRelease(thread, job);
+      destroyJobQueueItem(qitem);
+      if (!thread->sigkill) thread->dispatchEvents->CallAsFunction(thread->JSObject, 2, args);
+    }
+    else if (job->jobType == kJobTypeEventSerialized) {
+      Local<Value> args[2];
+
+      str= job->typeEventSerialized.eventName;
+      args[0]= String::New(**str, (*str).length());
+      delete str;
+
+      int len = job->typeEventSerialized.length;
+      Local<Array> array= Array::New(len);
+      args[1]= array;
+
+        {
+          BSON *bson = isolateBSON();
+          char* data = job->typeEventSerialized.buffer;
+          size_t size = job->typeEventSerialized.bufferSize;
+          BSONDeserializer deserializer(bson, data, size);
+          Local<Object> result = deserializer.DeserializeDocument()->ToObject();
+          int i = 0; do { array->Set(i, result->Get(i)); } while (++i < len);
+          free(data);
+        }
+
+      jobRelease(thread, job);
+      destroyJobQueueItem(qitem);
+      if (!thread->sigkill) thread->dispatchEvents->CallAsFunction(thread->JSObject, 2, args);
+    }
+    else if (job->jobType == kJobTypeCall) {
+
+      // First of all give the pinned arrays back
+      unpinJob(job);
+      if (job->typeCall.pipeline) {
+        delete job->typeCall.fnName;
+        job->typeCall.fnName= NULL;
+        pipelineJobDone(job);
+      }
+
+      if (job->typeCall.tiene_callBack) {
+        Local<Value> result;
+        int error= job->typeCall.error;
+        try {
+          result= deserialize(job->typeCall.buffer, job->typeCall.bufferSize)->Get(0);
+        }
+        catch (char* err) {
+          result= String::New(err);
+          free(err);
+          error= 1;
+        }
+
+        if (error) {
+          argv[0]= Exception::Error(result->ToString());
+          argv[1]= null;
+        } else {
+          argv[0]= null;
+          argv[1]= result;
+        }
+        job->typeCall.tiene_callBack= 0;
+        job->cb->CallAsFunction(thread->JSObject, 2, argv);
+        job->cb.Dispose();
+      }
+
+      free(job->typeCall.buffer);
+      job->typeCall.buffer= NULL;
+      jobRelease(thread, job);
+      destroyJobQueueItem(qitem);
+
+      if (onError.HasCaught()) {
+        if (thread->outQueue.first) {
+          uv_async_send(&thread->async_watcher); // wake up callback again
+        }
+        reportQueuedBytes();
+        node::FatalException(onError);
+        return;
+      }
+    }
+    else if (job->jobType == kJobTypeTask) {
+      taskDone(qitem);
+
+      if (onError.HasCaught()) {
+        if (thread->outQueue.first) {
+          uv_async_send(&thread->async_watcher); // wake up callback again
+        }
+        reportQueuedBytes();
+        node::FatalException(onError);
+        return;
+      }
+    }
+  }
+
+  reportQueuedBytes();
+
+  if (thread->sigkill) destroyaThread(thread);
+}
+
+
+
+
+
+
+// unconditionally destroys a thread by brute force.
+static Handle<Value> Destroy (const Arguments &args) {
+  HandleScope scope;
+
+  typeThread* thread= isAThread(args.This());
+  if (!thread) {
+    return ThrowException(Exception::TypeError(String::New("thread.destroy(): the receiver must be a thread object")));
+  }
+
+  if (!thread->sigkill) {
+    //pthread_cancel(thread->thread);
+    thread->sigkill= 1;
+    uv_mutex_lock(&thread->IDLE_mutex);
+    if (thread->IDLE) {
+      uv_cond_signal(&thread->IDLE_cv);
+    }
+    else if (thread->isolate) {
+      // Interrupt whatever JS it's running, the pending jobs are aborted by destroyaThread()
+      V8::TerminateExecution(thread->isolate);
+    }
+    uv_mutex_unlock(&thread->IDLE_mutex);
+    uv_mutex_lock(&queueRoomMutex);
+    uv_cond_broadcast(&queueRoomCV);
+    uv_mutex_unlock(&queueRoomMutex);
+    pipelinesWake();
+  }
+
+  return Undefined();
+}
+
+
+
+
+
+
+// Threads.startRecording(): the jobs go to the log as they're submitted, see
+// recorder.cc. The args are serialized again, but only while recording.
+static void recordArgs (int type, int origin, long target, const char* name, size_t nameLength, Handle<Value> values) {
+  char* buffer= NULL;
+  size_t bufferSize= 0;
+  if (!values->IsUndefined()) {
+    try {
+      buffer= serialize(values, &bufferSize);
+    }
+    catch (char* err) {
+      free(err); //It goes without them
+    }
+  }
+  record_job(type, origin, target, name, nameLength, buffer, bufferSize);
+  free(buffer);
+}
+
+static void recordEmit (typeThread* thread, String::Utf8Value* eventName, const Arguments &args) {
+  Local<Array> values= Array::New(args.Length()- 1);
+  int i= 1;
+  while (i < args.Length()) {
+    values->Set(i- 1, args[i]);
+    i++;
+  }
+  recordArgs(kRecordEmit, kRecordThread, thread->id, **eventName, eventName->length(), values);
+}
+
+
+
+
+
+
+// Eval: Pushes a job into the thread's ->inQueue.
+static Handle<Value> Eval (const Arguments &args) {
+  HandleScope scope;
+
+  if (!args.Length()) {
+    return ThrowException(Exception::TypeError(String::New("thread.eval(program [,callback]): missing arguments")));
+  }
+
+  typeThread* thread= isAThread(args.This());
+  if (!thread) {
+    return ThrowException(Exception::TypeError(String::New("thread.eval(): the receiver must be a thread object")));
+  }
+
+  if (thread->sigkill) {
+    return ThrowException(Exception::Error(String::New(kThreadDestroyed)));
+  }
+
+  if (queueIsFull()) return throwQueueFull("thread.eval()");
+
+  typeQueueItem* qitem= nuJobQueueItem();
+  typeJob* job= (typeJob*) qitem->asPtr;
+
+  job->typeEval.tiene_callBack= ((args.Length() > 1) && (args[1]->IsFunction()));
+  if (job->typeEval.tiene_callBack) {
+    job->cb= Persistent<Object>::New(args[1]->ToObject());
+  }
+  job->typeEval.resultado= NULL;
+  job->typeEval.scriptText_StringObject= new String::Utf8Value(args[0]);
+  job->typeEval.useStringObject= 1;
+  job->jobType= kJobTypeEval;
+  jobAccount(thread, job, job->typeEval.scriptText_StringObject->length());
+  if (recorder && !thread->pooled) {
+    String::Utf8Value* source= job->typeEval.scriptText_StringObject;
+    record_job(kRecordEval, kRecordThread, thread->id, **source, source->length(), NULL, 0);
+  }
+
+  pushToInQueue(qitem, thread);
+  reportQueuedBytes();
+  return scope.Close(args.This());
+}
+
+
+
+
+
+
+
+
+
+
+
+// Call: Pushes a job that calls global[functionName](args...) into the thread's ->inQueue.
+// The typed arrays (and Buffers) in args are not copied: their memory is lent to
+// the thread, and the main thread can't get at their elements until the job completes.
+static Handle<Value> Call (const Arguments &args) {
+  HandleScope scope;
+
+  if (!args.Length() || (args[0]->IsArray() && !Local<Array>::Cast(args[0]->ToObject())->Length())) {
+    return ThrowException(Exception::TypeError(String::New("thread.call(functionName [, args] [, callback]): missing arguments")));
+  }
+
+  typeThread* thread= isAThread(args.This());
+  if (!thread) {
+    return ThrowException(Exception::TypeError(String::New("thread.call(): the receiver must be a thread object")));
+  }
+
+  if (thread->sigkill) {
+    return ThrowException(Exception::Error(String::New(kThreadDestroyed)));
+  }
+
+  if (queueIsFull()) return throwQueueFull("thread.call()");
+
+  int cbIndex= args.Length()- 1;
+  int tiene_callBack= (cbIndex > 0) && args[cbIndex]->IsFunction();
+
+  // pool.any.call(fnName, args, { memoize: true }, cb) passes the key got
+  // from memoLookup(): the args are already serialized in it.
+  typeMemoKey* memo= NULL;
+  if (tiene_callBack && (cbIndex == 3) && args[2]->IsObject() && !args[2]->ToObject()->GetHiddenValue(memo_symbol).IsEmpty()) {
+    memo= (typeMemoKey*) args[2]->ToObject()->GetPointerFromInternalField(0);
+    if (!memo) {
+      return ThrowException(Exception::Error(String::New("thread.call(): the memoize key has been used already")));
+    }
+  }
+
+  Local<Array> argv;
+  if ((args.Length() > 1) && args[1]->IsArray()) {
+    argv= Local<Array>::Cast(args[1]->ToObject());
+  }
+  else {
+    argv= Array::New((args.Length() > 1) && !(tiene_callBack && (cbIndex == 1)) ? 1 : 0);
+    if (argv->Length()) argv->Set(0, args[1]);
+  }
+  int argc= argv->Length();
+
+  // The arrays to lend: placeholders in the serialized args
+  Local<Array> serializable= Array::New(argc);
+  int pinnedLength= 0;
+  int i= memo ? argc : 0;
+  while (i < argc) {
+    Local<Value> value= argv->Get(i);
+    if (isPinnable(value)) {
+      if (!value->ToObject()->GetHiddenValue(pinned_symbol).IsEmpty()) {
+        return ThrowException(Exception::TypeError(String::New("thread.call(): an array can't be lent twice at the same time")));
+      }
+      // Mark it now, so that a second reference to it in args is caught.
+      value->ToObject()->SetHiddenValue(pinned_symbol, True());
+      serializable->Set(i, Null());
+      pinnedLength++;
+    }
+    else {
+      serializable->Set(i, value);
+    }
+    i++;
+  }
+
+  char* buffer;
+  size_t bufferSize;
+  try {
+    if (memo) {
+      argc= memo->argc;
+      bufferSize= memo->length- memo->argsOffset;
+      buffer= (char*) malloc(bufferSize);
+      memcpy(buffer, memo->bytes+ memo->argsOffset, bufferSize);
+      args[2]->ToObject()->SetPointerInInternalField(0, NULL);
+    }
+    else {
+      buffer= serialize(serializable, &bufferSize);
+    }
+  }
+  catch (char* err) {
+    i= 0;
+    while (i < argc) {
+      Local<Value> value= argv->Get(i++);
+      if (isPinnable(value)) value->ToObject()->DeleteHiddenValue(pinned_symbol);
+    }
+    Local<Value> error= Exception::Error(String::New(err));
+    free(err);
+    return ThrowException(error);
+  }
+
+  typeQueueItem* qitem= nuJobQueueItem();
+  typeJob* job= (typeJob*) qitem->asPtr;
+
+  job->jobType= kJobTypeCall;
+  job->typeCall.tiene_callBack= tiene_callBack;
+  if (tiene_callBack) {
+    job->cb= Persistent<Object>::New(args[cbIndex]->ToObject());
+  }
+  job->typeCall.error= 0;
+  job->typeCall.argc= argc;
+  job->typeCall.thenNext= 0;
+  long namesLength= 0;
+  if (args[0]->IsArray()) {
+    // [fnName, then, then...]: a chain of calls, see freeThens()
+    Local<Array> names= Local<Array>::Cast(args[0]->ToObject());
+    job->typeCall.fnName= new String::Utf8Value(names->Get(0));
+    namesLength+= job->typeCall.fnName->length();
+    job->typeCall.thensLength= names->Length()- 1;
+    if (job->typeCall.thensLength) {
+      job->typeCall.thens= (String::Utf8Value**) malloc(job->typeCall.thensLength* sizeof(String::Utf8Value*));
+      i= 0;
+      while (i < job->typeCall.thensLength) {
+        job->typeCall.thens[i]= new String::Utf8Value(names->Get(i+ 1));
+        namesLength+= job->typeCall.thens[i++]->length();
+      }
+    }
+  }
+  else {
+    job->typeCall.fnName= new String::Utf8Value(args[0]);
+    namesLength= job->typeCall.fnName->length();
+  }
+  job->typeCall.buffer= buffer;
+  job->typeCall.bufferSize= bufferSize;
+  job->memo= memo;
+  job->typeCall.pinnedLength= pinnedLength;
+  job->typeCall.pinned= NULL;
+  if (pinnedLength) {
+    job->typeCall.pinned= (typePin*) calloc(pinnedLength, sizeof(typePin));
+    int j= 0;
+    i= 0;
+    while (i < argc) {
+      Local<Value> value= argv->Get(i);
+      if (isPinnable(value)) pinArray(&job->typeCall.pinned[j++], value->ToObject(), i);
+      i++;
+    }
+  }
+  jobAccount(thread, job, bufferSize+ namesLength);
+  if (recorder && !thread->pooled) {
+    std::string names(**job->typeCall.fnName, job->typeCall.fnName->length());
+    i= 0;
+    while (job->typeCall.thens && (i < job->typeCall.thensLength)) {
+      names+= '\n';
+      names.append(**job->typeCall.thens[i], job->typeCall.thens[i]->length());
+      i++;
+    }
+    record_job(kRecordCall, kRecordThread, thread->id, names.data(), names.length(), buffer, bufferSize);
+  }
+
+  pushToInQueue(qitem, thread);
+  reportQueuedBytes();
+  return scope.Close(args.This());
+}
+
+
+
+
+
+
+// Checks the (pool's) threads of a parallel job: an Array of live threads.
+static int checkGroupThreads (Local<Value> threads) {
+  if (!threads->IsArray()) return 0;
+  Local<Array> array= Local<Array>::Cast(threads->ToObject());
+  if (!array->Length()) return 0;
+  uint32_t i= 0;
+  while (i < array->Length()) {
+    Local<Value> thread= array->Get(i++);
+    if (!thread->IsObject()) return 0;
+    typeThread* t= isAThread(thread->ToObject());
+    if (!t || t->sigkill) return 0;
+  }
+  return 1;
+}
+
+
+
+
+
+
+static typeGroup* nuGroup (Local<Value> threads, Local<Value> descending, Local<Value> cb) {
+  typeGroup* group= (typeGroup*) calloc(1, sizeof(typeGroup));
+  group->threads= Persistent<Array>::New(Local<Array>::Cast(threads->ToObject()));
+  group->threadsLength= group->threads->Length();
+  group->descending= descending->BooleanValue();
+  group->cb= Persistent<Object>::New(cb->ToObject());
+  return group;
+}
+
+
+
+
+
+
+// parallelSort(threads, typedArray, descending, cb): see pool.sort()
+static Handle<Value> ParallelSort (const Arguments &args) {
+  HandleScope scope;
+
+  if (!checkGroupThreads(args[0])) {
+    return ThrowException(Exception::Error(String::New("sort(): the pool has been destroyed")));
+  }
+
+  if (!isPinnable(args[1]) || !args[3]->IsFunction()) {
+    return ThrowException(Exception::TypeError(String::New("sort( typedArray [, options], cb ): bad arguments")));
+  }
+
+  Local<Object> array= args[1]->ToObject();
+  if (!array->GetHiddenValue(pinned_symbol).IsEmpty()) {
+    return ThrowException(Exception::TypeError(String::New("sort(): the array is lent to another job")));
+  }
+
+  const typeSortOps* ops= sortOpsFor(array->GetIndexedPropertiesExternalArrayDataType());
+  if (!ops) {
+    return ThrowException(Exception::TypeError(String::New("sort(): unsupported array type")));
+  }
+
+  typeGroup* group= nuGroup(args[0], args[2], args[3]);
+  group->ops= ops;
+  pinArray(&group->pins[0], array, 0);
+  group->pinsLength= 1;
+  group->length= group->pins[0].length;
+  group->source= group->target= (char*) group->pins[0].data;
+
+  size_t n= group->length/ kMinTaskElements;
+  if (n < 1) n= 1;
+  if (n > (size_t) group->threadsLength) n= group->threadsLength;
+  group->runs= (size_t*) malloc((n+ 1)* sizeof(size_t));
+  group->runsLength= (int) n;
+  size_t i= 0;
+  while (i <= n) {
+    group->runs[i]= (group->length* i)/ n;
+    i++;
+  }
+  i= 0;
+  while (i < n) {
+    pushTask(group, kTaskSort, group->runs[i], 0, group->runs[i+ 1], 0, 0);
+    i++;
+  }
+
+  return Undefined();
+}
+
+
+
+
+
+
+// parallelBinarySearch(threads, sorted, queries, results, descending, cb): see pool.binarySearchMany()
+static Handle<Value> ParallelBinarySearch (const Arguments &args) {
+  HandleScope scope;
+
+  if (!checkGroupThreads(args[0])) {
+    return ThrowException(Exception::Error(String::New("binarySearchMany(): the pool has been destroyed")));
+  }
+
+  if (!isPinnable(args[1]) || !isPinnable(args[2]) || !isPinnable(args[3]) || !args[5]->IsFunction() ||
+      (args[2]->ToObject()->GetIndexedPropertiesExternalArrayDataType() != kExternalDoubleArray) ||
+      (args[3]->ToObject()->GetIndexedPropertiesExternalArrayDataType() != kExternalIntArray) ||
+      (args[2]->ToObject()->GetIndexedPropertiesExternalArrayDataLength() != args[3]->ToObject()->GetIndexedPropertiesExternalArrayDataLength()) ||
+      args[1]->StrictEquals(args[2]) || args[1]->StrictEquals(args[3]) || args[2]->StrictEquals(args[3])) {
+    return ThrowException(Exception::TypeError(String::New("binarySearchMany( sortedTypedArray, queries [, options], cb ): bad arguments")));
+  }
+
+  int i= 1;
+  while (i <= 3) {
+    if (!args[i++]->ToObject()->GetHiddenValue(pinned_symbol).IsEmpty()) {
+      return ThrowException(Exception::TypeError(String::New("binarySearchMany(): the array is lent to another job")));
+    }
+  }
+
+  const typeSortOps* ops= sortOpsFor(args[1]->ToObject()->GetIndexedPropertiesExternalArrayDataType());
+  if (!ops) {
+    return ThrowException(Exception::TypeError(String::New("binarySearchMany(): unsupported array type")));
+  }
+
+  typeGroup* group= nuGroup(args[0], args[4], args[5]);
+  group->ops= ops;
+  i= 0;
+  while (i < 3) {
+    pinArray(&group->pins[i], args[i+ 1]->ToObject(), 0);
+    i++;
+  }
+  group->pinsLength= 3;
+  pushTasks(group, kTaskSearch, 0, group->pins[1].length, group->threadsLength);
+
+  return Undefined();
+}
+
+
+
+
+
+
+static typePipeline* isAPipeline (Handle<Object> receiver) {
+  if (receiver->InternalFieldCount() != 1) return NULL;
+  return (typePipeline*) receiver->GetPointerFromInternalField(0);
+}
+
+static void pipelineClosed (uv_handle_t* handle) {
+  typePipeline* pipeline= (typePipeline*) handle->data;
+  int i= 0;
+  while (i < pipeline->stagesLength) {
+    uv_cond_destroy(&pipeline->stages[i].room);
+    free(pipeline->stages[i++].threads);
+  }
+  free(pipeline->stages);
+  uv_mutex_destroy(&pipeline->lock);
+  pipeline->JSObject.Dispose();
+  free(pipeline);
+}
+
+static void pipelineFree (typePipeline* pipeline) {
+  typePipeline** p= &pipelines;
+  while (*p != pipeline) p= &(*p)->next;
+  *p= pipeline->next;
+  uv_close((uv_handle_t*) &pipeline->drain, pipelineClosed);
+}
+
+// Main thread: the first stage has room again.
+static void pipelineDrain (uv_async_t* handle, int status) {
+  typePipeline* pipeline= (typePipeline*) handle->data;
+  if (pipeline->destroyed) return;
+
+  HandleScope scope;
+  TryCatch onError;
+  Local<Value> emit= pipeline->JSObject->Get(String::NewSymbol("emit"));
+  if (!emit->IsFunction()) return;
+  Local<Value> argv[1]= { String::NewSymbol("drain") };
+  emit->ToObject()->CallAsFunction(pipeline->JSObject, 1, argv);
+  if (onError.HasCaught()) node::FatalException(onError);
+}
+
+// Main thread: a job is out of the pipeline, done or aborted.
+static void pipelineJobDone (typeJob* job) {
+  typePipeline* pipeline= job->typeCall.pipeline;
+  job->typeCall.pipeline= NULL;
+  pipeline->inFlight--;
+  pipeline->done++;
+  if (job->typeCall.error) pipeline->errors++;
+  if (pipeline->destroyed && !pipeline->inFlight) pipelineFree(pipeline);
+}
+
+static void pipelineJobAborted (typeJob* job) {
+  typePipeline* pipeline= job->typeCall.pipeline;
+  uv_mutex_lock(&pipeline->lock);
+  pipelineStageLeft(pipeline, job->typeCall.stage);
+  uv_mutex_unlock(&pipeline->lock);
+  job->typeCall.error= 1;
+  pipelineJobDone(job);
+}
+
+
+
+
+
+
+static Persistent<ObjectTemplate> pipelineTemplate;
+
+// newPipeline(stages, queueDepth): stages is an Array with an Array of threads
+// per stage, in which kPipelineStageFn is the stage's function. See Threads.pipeline().
+static Handle<Value> NewPipeline (const Arguments &args) {
+  HandleScope scope;
+
+  if (!args[0]->IsArray() || !Local<Array>::Cast(args[0]->ToObject())->Length()) {
+    return ThrowException(Exception::TypeError(String::New("pipeline( stages ): stages must be a non empty Array")));
+  }
+  Local<Array> stages= Local<Array>::Cast(args[0]->ToObject());
+  uint32_t i= 0;
+  while (i < stages->Length()) {
+    if (!checkGroupThreads(stages->Get(i++))) {
+      return ThrowException(Exception::Error(String::New("pipeline(): a stage's threads have been destroyed")));
+    }
+  }
+
+  typePipeline* pipeline= (typePipeline*) calloc(1, sizeof(typePipeline));
+  pipeline->queueDepth= (args[1]->IntegerValue() > 0) ? (long) args[1]->IntegerValue() : 1;
+  pipeline->stagesLength= stages->Length();
+  pipeline->stages= (typePipelineStage*) calloc(pipeline->stagesLength, sizeof(typePipelineStage));
+  pipeline->started= uv_hrtime();
+  uv_mutex_init(&pipeline->lock);
+  uv_async_init(uv_default_loop(), &pipeline->drain, pipelineDrain);
+  pipeline->drain.data= pipeline;
+  uv_unref((uv_handle_t*) &pipeline->drain);
+  pipeline->next= pipelines;
+  pipelines= pipeline;
+
+  i= 0;
+  while (i < stages->Length()) {
+    typePipelineStage* stage= &pipeline->stages[i];
+    Local<Array> threads= Local<Array>::Cast(stages->Get(i++)->ToObject());
+    stage->threadsLength= threads->Length();
+    stage->threads= (typeThread**) calloc(stage->threadsLength, sizeof(typeThread*));
+    uv_cond_init(&stage->room);
+    int j= 0;
+    while (j < stage->threadsLength) {
+      stage->threads[j]= isAThread(threads->Get(j)->ToObject());
+      j++;
+    }
+  }
+
+  pipeline->JSObject= Persistent<Object>::New(pipelineTemplate->NewInstance());
+  pipeline->JSObject->SetPointerInInternalField(0, pipeline);
+  return scope.Close(pipeline->JSObject);
+}
+
+// pipeline.push(item [, cb]): cb(err, result) gets the result of the last stage.
+// Returns false once the first stage is full: the item is queued anyway, and
+// the pipeline emits a 'drain' when there's room.
+static Handle<Value> PipelinePush (const Arguments &args) {
+  HandleScope scope;
+
+  typePipeline* pipeline= isAPipeline(args.This());
+  if (!pipeline) {
+    return ThrowException(Exception::Error(String::New("pipeline.push(): the pipeline has been destroyed")));
+  }
+  if (queueIsFull()) return throwQueueFull("pipeline.push()");
+
+  typePipelineStage* first= &pipeline->stages[0];
+  typeThread* thread= leastBusyStageThread(first);
+  if (!thread) {
+    return ThrowException(Exception::Error(String::New("pipeline.push(): the pipeline's threads have been destroyed")));
+  }
+
+  Local<Array> argv= Array::New(1);
+  argv->Set(0, args[0]);
+  char* buffer;
+  size_t bufferSize;
+  try {
+    buffer= serialize(argv, &bufferSize);
+  }
+  catch (char* err) {
+    Local<Value> error= Exception::Error(String::New(err));
+    free(err);
+    return ThrowException(error);
+  }
+
+  typeQueueItem* qitem= nuJobQueueItem();
+  typeJob* job= (typeJob*) qitem->asPtr;
+
+  job->jobType= kJobTypeCall;
+  job->typeCall.tiene_callBack= args[1]->IsFunction();
+  if (job->typeCall.tiene_callBack) {
+    job->cb= Persistent<Object>::New(args[1]->ToObject());
+  }
+  job->typeCall.error= 0;
+  job->typeCall.argc= 1;
+  job->typeCall.fnName= new String::Utf8Value(String::New(kPipelineStageFn));
+  job->typeCall.buffer= buffer;
+  job->typeCall.bufferSize= bufferSize;
+  job->typeCall.pinnedLength= 0;
+  job->typeCall.pinned= NULL;
+  job->typeCall.pipeline= pipeline;
+  job->typeCall.stage= 0;
+  jobAccount(thread, job, bufferSize);
+  pipeline->inFlight++;
+
+  uv_mutex_lock(&pipeline->lock);
+  long depth= ++first->depth;
+  if (depth > first->maxDepth) first->maxDepth= depth;
+  if (depth >= pipeline->queueDepth) pipeline->full= 1;
+  uv_mutex_unlock(&pipeline->lock);
+
+  pushToInQueue(qitem, thread);
+  reportQueuedBytes();
+  return scope.Close(Boolean::New(depth < pipeline->queueDepth));
+}
+
+static Handle<Value> PipelineStats (const Arguments &args) {
+  HandleScope scope;
+  typePipeline* pipeline= isAPipeline(args.This());
+  if (!pipeline) {
+    return ThrowException(Exception::Error(String::New("pipeline.stats(): the pipeline has been destroyed")));
+  }
+
+  double seconds= (uv_hrtime()- pipeline->started)/ 1e9;
+  Local<Array> stages= Array::New(pipeline->stagesLength);
+  uv_mutex_lock(&pipeline->lock);
+  int i= 0;
+  while (i < pipeline->stagesLength) {
+    typePipelineStage* stage= &pipeline->stages[i];
+    Local<Object> o= Object::New();
+    o->Set(String::NewSymbol("threads"), Number::New(stage->threadsLength));
+    o->Set(String::NewSymbol("processed"), Number::New(stage->processed));
+    o->Set(String::NewSymbol("perSecond"), Number::New(seconds > 0 ? stage->processed/ seconds : 0));
+    o->Set(String::NewSymbol("busyMs"), Number::New(stage->busyNs/ 1e6));
+    o->Set(String::NewSymbol("utilization"), Number::New(seconds > 0 ? stage->busyNs/ 1e9/ seconds/ stage->threadsLength : 0));
+    o->Set(String::NewSymbol("queueDepth"), Number::New(stage->depth));
+    o->Set(String::NewSymbol("maxQueueDepth"), Number::New(stage->maxDepth));
+    o->Set(String::NewSymbol("fullWaits"), Number::New(stage->waits));
+    stages->Set(i++, o);
+  }
+  uv_mutex_unlock(&pipeline->lock);
+
+  Local<Object> stats= Object::New();
+  stats->Set(String::NewSymbol("inFlight"), Number::New(pipeline->inFlight));
+  stats->Set(String::NewSymbol("done"), Number::New(pipeline->done));
+  stats->Set(String::NewSymbol("errors"), Number::New(pipeline->errors));
+  stats->Set(String::NewSymbol("queueDepthLimit"), Number::New(pipeline->queueDepth));
+  stats->Set(String::NewSymbol("stages"), stages);
+  return scope.Close(stats);
+}
+
+static Handle<Value> PipelinePendingJobs (const Arguments &args) {
+  HandleScope scope;
+  typePipeline* pipeline= isAPipeline(args.This());
+  return scope.Close(Number::New(pipeline ? pipeline->inFlight : 0));
+}
+
+// Wakes up the threads waiting for room: their jobs come back with an error.
+// The threads themselves are destroyed by Threads.pipeline()'s destroy().
+static Handle<Value> PipelineDestroy (const Arguments &args) {
+  HandleScope scope;
+  typePipeline* pipeline= isAPipeline(args.This());
+  if (!pipeline) return Undefined();
+
+  pipeline->JSObject->SetPointerInInternalField(0, NULL);
+  uv_mutex_lock(&pipeline->lock);
+  pipeline->destroyed= 1;
+  int i= 0;
+  while (i < pipeline->stagesLength) uv_cond_broadcast(&pipeline->stages[i++].room);
+  uv_mutex_unlock(&pipeline->lock);
+  if (!pipeline->inFlight) pipelineFree(pipeline);
+  return Undefined();
+}
+
+
+
+
+
+
+static Persistent<ObjectTemplate> actorTemplate;
+
+static typeActor* isAnActor (Handle<Object> receiver) {
+  if (receiver->InternalFieldCount() != 1) return NULL;
+  return (typeActor*) receiver->GetPointerFromInternalField(0);
+}
+
+// Main thread: its thread is gone, and so are the jobs in the mailbox.
+static void actorAbort (typeThread* thread, typeActor* actor, Local<Value> error) {
+  typeQueueItem* qitem;
+  while ((qitem= queue_pull(&actor->mailbox))) abortJob(thread, qitem, error);
+
+  uv_mutex_lock(&actor->lock);
+  actor->scheduled= 0;
+  int release= actor->closed;
+  uv_mutex_unlock(&actor->lock);
+  if (release) actorFree(actor);
+}
+
+// Main thread: queues a job (accounted to thread) for the actor.
+static void actorPost (typeActor* actor, typeThread* thread, typeQueueItem* qitem) {
+  uv_mutex_lock(&actor->lock);
+  queue_push(qitem, &actor->mailbox);
+  int wake= !actor->scheduled;
+  actor->scheduled= 1;
+  uv_mutex_unlock(&actor->lock);
+
+  actor->messages++;
+  if (wake) pushToInQueue(actor->token, thread);
+  reportQueuedBytes();
+}
+
+static void actorEval (typeActor* actor, typeThread* thread, std::string source, Local<Value> cb) {
+  typeQueueItem* qitem= nuJobQueueItem();
+  typeJob* job= (typeJob*) qitem->asPtr;
+  job->jobType= kJobTypeEval;
+  job->typeEval.tiene_callBack= cb->IsFunction();
+  if (job->typeEval.tiene_callBack) {
+    job->cb= Persistent<Object>::New(cb->ToObject());
+  }
+  job->typeEval.resultado= NULL;
+  job->typeEval.useStringObject= 0;
+  job->typeEval.scriptText_CharPtr= strdup(source.c_str());
+  jobAccount(thread, job, source.length());
+  actorPost(actor, thread, qitem);
+}
+
+// The actor's thread, unless it has been destroyed.
+static typeThread* actorThread (typeActor* actor) {
+  typeThread* thread= isAThread(actor->thread);
+  return (thread && !thread->sigkill) ? thread : NULL;
+}
+
+// spawnActor(thread, initSource [, cb]): initSource is the source of a
+// function that returns the actor's state. See pool.spawnActor(). If it
+// throws, __actors[id] is a getter that throws the same error: the calls get
+// it, instead of a "not a function". So does cb.
+static Handle<Value> SpawnActor (const Arguments &args) {
+  HandleScope scope;
+
+  typeThread* thread= args[0]->IsObject() ? isAThread(args[0]->ToObject()) : NULL;
+  if (!thread || thread->sigkill) {
+    return ThrowException(Exception::Error(String::New("spawnActor(): the pool has been destroyed")));
+  }
+  if (!args[1]->IsString()) {
+    return ThrowException(Exception::TypeError(String::New("spawnActor( initSource ): initSource must be a function or its source")));
+  }
+
+  static long actorsCtr= 0;
+  typeActor* actor= (typeActor*) calloc(1, sizeof(typeActor));
+  actor->id= actorsCtr++;
+  uv_mutex_init(&actor->lock);
+  uv_mutex_init(&actor->mailbox.queueLock);
+  actor->token= nuItem(kItemTypePointer, calloc(1, sizeof(typeJob)));
+  ((typeJob*) actor->token->asPtr)->jobType= kJobTypeActor;
+  ((typeJob*) actor->token->asPtr)->typeActor.actor= actor;
+  actor->thread= Persistent<Object>::New(args[0]->ToObject());
+  actor->JSObject= Persistent<Object>::New(actorTemplate->NewInstance());
+  actor->JSObject->SetPointerInInternalField(0, actor);
+  actor->JSObject->Set(id_symbol, Number::New(actor->id));
+
+  char id[32];
+  snprintf(id, sizeof(id), "%ld", actor->id);
+  std::string init("(function (actors) { try { actors[");
+  init+= id;
+  init+= "]= (";
+  init+= *String::Utf8Value(args[1]);
+  init+= "\n)(); } catch (e) { Object.defineProperty(actors, ";
+  init+= id;
+  init+= ", { get: function () { throw e }, configurable: true }); throw e; } })(self.__actors || (self.__actors= {}));";
+  actorEval(actor, thread, init, args[2]);
+
+  return scope.Close(actor->JSObject);
+}
+
+// actor.call(method [, args] [, cb]): calls the actor's state[method](args...)
+// with this= the state, after all the actor's previous jobs.
+static Handle<Value> ActorCall (const Arguments &args) {
+  HandleScope scope;
+
+  typeActor* actor= isAnActor(args.This());
+  if (!actor) {
+    return ThrowException(Exception::Error(String::New("actor.call(): the actor has been destroyed")));
+  }
+  typeThread* thread= actorThread(actor);
+  if (!thread) {
+    return ThrowException(Exception::Error(String::New(kThreadDestroyed)));
+  }
+  if (!args.Length() || !args[0]->IsString()) {
+    return ThrowException(Exception::TypeError(String::New("actor.call(method [, args] [, callback]): missing arguments")));
+  }
+  if (queueIsFull()) return throwQueueFull("actor.call()");
+
+  int cbIndex= args.Length()- 1;
+  int tiene_callBack= (cbIndex > 0) && args[cbIndex]->IsFunction();
+  Local<Array> argv;
+  if ((args.Length() > 1) && args[1]->IsArray()) {
+    argv= Local<Array>::Cast(args[1]->ToObject());
+  }
+  else {
+    argv= Array::New((args.Length() > 1) && !(tiene_callBack && (cbIndex == 1)) ? 1 : 0);
+    if (argv->Length()) argv->Set(0, args[1]);
+  }
+
+  char* buffer;
+  size_t bufferSize;
+  try {
+    buffer= serialize(argv, &bufferSize);
+  }
+  catch (char* err) {
+    Local<Value> error= Exception::Error(String::New(err));
+    free(err);
+    return ThrowException(error);
+  }
+
+  char id[48];
+  snprintf(id, sizeof(id), "__actors.%ld.", actor->id);
+  std::string fnName(id);
+  fnName+= *String::Utf8Value(args[0]);
+
+  typeQueueItem* qitem= nuJobQueueItem();
+  typeJob* job= (typeJob*) qitem->asPtr;
+  job->jobType= kJobTypeCall;
+  job->typeCall.tiene_callBack= tiene_callBack;
+  if (tiene_callBack) {
+    job->cb= Persistent<Object>::New(args[cbIndex]->ToObject());
+  }
+  job->typeCall.error= 0;
+  job->typeCall.argc= argv->Length();
+  job->typeCall.fnName= new String::Utf8Value(String::New(fnName.c_str()));
+  job->typeCall.buffer= buffer;
+  job->typeCall.bufferSize= bufferSize;
+  job->typeCall.pinnedLength= 0;
+  job->typeCall.pinned= NULL;
+  jobAccount(thread, job, bufferSize+ fnName.length());
+  actorPost(actor, thread, qitem);
+
+  return scope.Close(args.This());
+}
+
+static Handle<Value> ActorPendingMessages (const Arguments &args) {
+  HandleScope scope;
+  typeActor* actor= isAnActor(args.This());
+  return scope.Close(Number::New(actor ? actor->mailbox.length : 0));
+}
+
+static Handle<Value> ActorStats (const Arguments &args) {
+  HandleScope scope;
+  typeActor* actor= isAnActor(args.This());
+  if (!actor) {
+    return ThrowException(Exception::Error(String::New("actor.stats(): the actor has been destroyed")));
+  }
+  Local<Object> stats= Object::New();
+  stats->Set(String::NewSymbol("messages"), Number::New(actor->messages));
+  stats->Set(String::NewSymbol("pendingMessages"), Number::New(actor->mailbox.length));
+  stats->Set(String::NewSymbol("thread"), actor->thread->Get(id_symbol));
+  return scope.Close(stats);
+}
+
+// actor.destroy(): its pending jobs run, then its state is dropped.
+static Handle<Value> ActorDestroy (const Arguments &args) {
+  HandleScope scope;
+  typeActor* actor= isAnActor(args.This());
+  if (!actor) return Undefined();
+
+  typeThread* thread= actorThread(actor);
+  if (thread) {
+    char id[64];
+    snprintf(id, sizeof(id), "delete __actors[%ld];", actor->id);
+    actorEval(actor, thread, id, Local<Value>::New(Undefined()));
+  }
+
+  actor->JSObject->SetPointerInInternalField(0, NULL);
+  actor->JSObject.Dispose();
+  actor->thread.Dispose();
+  uv_mutex_lock(&actor->lock);
+  actor->closed= 1;
+  int release= !actor->scheduled;
+  uv_mutex_unlock(&actor->lock);
+  if (release) actorFree(actor);
+  return Undefined();
+}
+
+
+
+
+
+
+// SharedMap: see shared_map.cc. A key is a tag and an int64 or a utf8 string,
+// a value a tag and a double, a utf8 string or the BSON of [value].
+
+// Integers go as int64_t: those out of its range, NaN and the Infinities (the
+// cast would be undefined) and the fractions go as their string.
+static std::string sharedMapKey (Handle<Value> key) {
+  double n= key->NumberValue();
+  if (key->IsNumber() && (n >= -9223372036854775808.0) && (n < 9223372036854775808.0) && (n == (double) (int64_t) n)) {
+    int64_t i= (int64_t) n;
+    return std::string(1, (char) kSharedKeyInt)+ std::string((char*) &i, sizeof(i));
+  }
+  String::Utf8Value utf8(key);
+  return std::string(1, (char) kSharedKeyString)+ std::string(*utf8, utf8.length());
+}
+
+// Throws a malloc()ed char* if value can't be serialized.
+static std::string sharedMapValue (Handle<Value> value) {
+  if (value->IsNumber()) {
+    double n= value->NumberValue();
+    return std::string(1, 'n')+ std::string((char*) &n, sizeof(n));
+  }
+  if (value->IsString()) {
+    String::Utf8Value utf8(value);
+    return std::string(1, 's')+ std::string(*utf8, utf8.length());
+  }
+  Local<Array> array= Array::New(1);
+  array->Set(0, value);
+  size_t size;
+  char* buffer= serialize(array, &size);
+  std::string bytes= std::string(1, 'b')+ std::string(buffer, size);
+  free(buffer);
+  return bytes;
+}
+
+// Throws a malloc()ed char* if it's garbage.
+static Local<Value> sharedMapDecode (const char* value, uint32_t length) {
+  HandleScope scope;
+  if ((value[0] == 'n') && (length == 1+ sizeof(double))) {
+    double n;
+    memcpy(&n, value+ 1, sizeof(n));
+    return scope.Close(Number::New(n));
+  }
+  if (value[0] == 's') return scope.Close(String::New(value+ 1, length- 1));
+  return scope.Close(deserialize((char*) value+ 1, length- 1)->Get(0));
+}
+
+static typeSharedMap* sharedMapOf (const Arguments &args) {
+  return (typeSharedMap*) args.This()->GetPointerFromInternalField(0);
+}
+
+#define SHARED_MAP_KEY(key, hash, index) \
+  std::string key= sharedMapKey(args[index]); \
+  uint64_t hash= memoHash(key.data(), key.size())
+
+// new SharedMap(name [, { maxEntries, maxBytes }]): the map called name,
+// shared by all the threads. The bounds are those of whoever creates it.
+static Handle<Value> SharedMapNew (const Arguments &args) {
+  HandleScope scope;
+
+  if (!args.IsConstructCall() || !args[0]->IsString()) {
+    return ThrowException(Exception::TypeError(String::New("new SharedMap( name [, { maxEntries, maxBytes }] ): bad arguments")));
+  }
+
+  double maxEntries= kSharedMapDefaultEntries;
+  double maxBytes= kSharedMapDefaultBytes;
+  if (args[1]->IsObject()) {
+    Local<Object> options= args[1]->ToObject();
+    Local<Value> value= options->Get(String::NewSymbol("maxEntries"));
+    if (!value->IsUndefined()) maxEntries= value->NumberValue();
+    value= options->Get(String::NewSymbol("maxBytes"));
+    if (!value->IsUndefined()) maxBytes= value->NumberValue();
+  }
+  if (!(maxEntries >= 1) || !(maxBytes >= 1)) {
+    return ThrowException(Exception::TypeError(String::New("new SharedMap(): maxEntries and maxBytes must be Numbers >= 1")));
+  }
+
+  typeSharedMap* map= shared_map_open(*String::Utf8Value(args[0]), (size_t) maxEntries, (size_t) maxBytes);
+  if (!map) {
+    return ThrowException(Exception::Error(String::New("new SharedMap(): out of memory")));
+  }
+  args.This()->SetPointerInInternalField(0, map);
+  return args.This();
+}
+
+static Handle<Value> SharedMapGet (const Arguments &args) {
+  HandleScope scope;
+  SHARED_MAP_KEY(key, hash, 0);
+
+  uint32_t length;
+  char* value= shared_map_get(sharedMapOf(args), key.data(), key.size(), hash, &length);
+  if (!value) return Undefined();
+
+  Local<Value> result;
+  try {
+    result= sharedMapDecode(value, length);
+  }
+  catch (char* err) {
+    free(value);
+    Local<Value> error= Exception::Error(String::New(err));
+    free(err);
+    return ThrowException(error);
+  }
+  free(value);
+  return scope.Close(result);
+}
+
+static Handle<Value> SharedMapHas (const Arguments &args) {
+  HandleScope scope;
+  SHARED_MAP_KEY(key, hash, 0);
+
+  uint32_t length;
+  char* value= shared_map_get(sharedMapOf(args), key.data(), key.size(), hash, &length);
+  free(value);
+  return scope.Close(Boolean::New(value != NULL));
+}
+
+static Handle<Value> SharedMapSet (const Arguments &args) {
+  HandleScope scope;
+  SHARED_MAP_KEY(key, hash, 0);
+
+  std::string value;
+  try {
+    value= sharedMapValue(args[1]);
+  }
+  catch (char* err) {
+    Local<Value> error= Exception::Error(String::New(err));
+    free(err);
+    return ThrowException(error);
+  }
+  if (shared_map_set(sharedMapOf(args), key.data(), key.size(), hash, value.data(), value.size())) {
+    return ThrowException(Exception::Error(String::New("sharedMap.set(): the value doesn't fit in the map")));
+  }
+  return scope.Close(args.This());
+}
+
+static Handle<Value> SharedMapDelete (const Arguments &args) {
+  HandleScope scope;
+  SHARED_MAP_KEY(key, hash, 0);
+  return scope.Close(Boolean::New(shared_map_delete(sharedMapOf(args), key.data(), key.size(), hash)));
+}
+
+// For shared_map_update(): adds *(double*) data to a number, or to 0 if there's none.
+static char* sharedMapAdd (const char* old, uint32_t oldLength, void* data, uint32_t* length) {
+  double n= 0;
+  if (old) {
+    if ((old[0] != 'n') || (oldLength != 1+ sizeof(double))) return NULL;
+    memcpy(&n, old+ 1, sizeof(n));
+  }
+  n+= *(double*) data;
+  char* value= (char*) malloc(1+ sizeof(double));
+  if (!value) return NULL;
+  value[0]= 'n';
+  memcpy(value+ 1, &n, sizeof(n));
+  *length= 1+ sizeof(double);
+  return value;
+}
+
+// sharedMap.incr(key [, delta]): adds delta (1 by default) atomically, and returns the sum.
+static Handle<Value> SharedMapIncr (const Arguments &args) {
+  HandleScope scope;
+  SHARED_MAP_KEY(key, hash, 0);
+
+  double delta= (args.Length() > 1) ? args[1]->NumberValue() : 1;
+  char* value= shared_map_update(sharedMapOf(args), key.data(), key.size(), hash, sharedMapAdd, &delta);
+  if (!value) {
+    return ThrowException(Exception::TypeError(String::New("sharedMap.incr(): the value isn't a Number")));
+  }
+  double n;
+  memcpy(&n, value+ 1, sizeof(n));
+  free(value);
+  return scope.Close(Number::New(n));
+}
+
+// sharedMap.cas(key, expected, value): sets it to value (deletes it if undefined)
+// only if it's expected (isn't there, if undefined). Returns whether it did.
+static Handle<Value> SharedMapCas (const Arguments &args) {
+  HandleScope scope;
+  SHARED_MAP_KEY(key, hash, 0);
+
+  std::string expected, value;
+  try {
+    if (!args[1]->IsUndefined()) expected= sharedMapValue(args[1]);
+    if (!args[2]->IsUndefined()) value= sharedMapValue(args[2]);
+  }
+  catch (char* err) {
+    Local<Value> error= Exception::Error(String::New(err));
+    free(err);
+    return ThrowException(error);
+  }
+
+  int swapped= shared_map_cas(sharedMapOf(args), key.data(), key.size(), hash,
+    args[1]->IsUndefined() ? NULL : expected.data(), expected.size(),
+    args[2]->IsUndefined() ? NULL : value.data(), value.size());
+  return scope.Close(Boolean::New(swapped));
+}
+
+static Handle<Value> SharedMapSize (const Arguments &args) {
+  HandleScope scope;
+  long entries, bytes;
+  shared_map_usage(sharedMapOf(args), &entries, &bytes);
+  return scope.Close(Number::New(entries));
+}
+
+static Handle<Value> SharedMapClear (const Arguments &args) {
+  HandleScope scope;
+  shared_map_clear(sharedMapOf(args));
+  return Undefined();
+}
+
+static Handle<Value> SharedMapStats (const Arguments &args) {
+  HandleScope scope;
+  typeSharedMap* map= sharedMapOf(args);
+
+  long entries, bytes;
+  shared_map_usage(map, &entries, &bytes);
+  double hits= atomic_read(&map->hits);
+  double lookups= hits+ atomic_read(&map->misses);
+
+  Local<Object> stats= Object::New();
+  stats->Set(String::NewSymbol("hits"), Number::New(hits));
+  stats->Set(String::NewSymbol("misses"), Number::New(lookups- hits));
+  stats->Set(String::NewSymbol("hitRate"), Number::New(lookups ? hits/ lookups : 0));
+  stats->Set(String::NewSymbol("writes"), Number::New(atomic_read(&map->writes)));
+  stats->Set(String::NewSymbol("evictions"), Number::New(atomic_read(&map->evictions)));
+  stats->Set(String::NewSymbol("casFailures"), Number::New(atomic_read(&map->casFailures)));
+  stats->Set(String::NewSymbol("entries"), Number::New(entries));
+  stats->Set(String::NewSymbol("bytes"), Number::New(bytes));
+  stats->Set(String::NewSymbol("maxEntries"), Number::New(map->maxEntries));
+  stats->Set(String::NewSymbol("maxBytes"), Number::New(map->maxBytes));
+  return scope.Close(stats);
+}
+
+// The SharedMap constructor, for the current isolate: the main thread's or a thread's.
+static Local<Function> sharedMapClass (void) {
+  HandleScope scope;
+
+  Local<FunctionTemplate> sharedMap= FunctionTemplate::New(SharedMapNew);
+  sharedMap->SetClassName(String::NewSymbol("SharedMap"));
+  sharedMap->InstanceTemplate()->SetInternalFieldCount(1);
+
+  // The methods check that this is a SharedMap
+  Local<Signature> signature= Signature::New(sharedMap);
+  Local<ObjectTemplate> proto= sharedMap->PrototypeTemplate();
+  proto->Set(String::NewSymbol("get"), FunctionTemplate::New(SharedMapGet, Handle<Value>(), signature));
+  proto->Set(String::NewSymbol("has"), FunctionTemplate::New(SharedMapHas, Handle<Value>(), signature));
+  proto->Set(String::NewSymbol("set"), FunctionTemplate::New(SharedMapSet, Handle<Value>(), signature));
+  proto->Set(String::NewSymbol("delete"), FunctionTemplate::New(SharedMapDelete, Handle<Value>(), signature));
+  proto->Set(String::NewSymbol("incr"), FunctionTemplate::New(SharedMapIncr, Handle<Value>(), signature));
+  proto->Set(String::NewSymbol("cas"), FunctionTemplate::New(SharedMapCas, Handle<Value>(), signature));
+  proto->Set(String::NewSymbol("size"), FunctionTemplate::New(SharedMapSize, Handle<Value>(), signature));
+  proto->Set(String::NewSymbol("clear"), FunctionTemplate::New(SharedMapClear, Handle<Value>(), signature));
+  proto->Set(String::NewSymbol("stats"), FunctionTemplate::New(SharedMapStats, Handle<Value>(), signature));
+
+  return scope.Close(sharedMap->GetFunction());
+}
+
+
+
+
+
+
+#define kFrozenMaxDepth 1000
+#define kFrozenExternalMin 64 //Shorter strings are cheaper copied
+#define kFrozenReadOnly "Threads.freeze(): frozen objects are read-only"
+
+// The keys that JSON.stringify() would see: the own enumerable ones, as
+// Object.keys() has them (GetOwnPropertyNames() has the others too).
+static Local<Array> frozenKeys (Local<Object> object) {
+  Local<Object> constructor= Context::GetCurrent()->Global()->Get(String::NewSymbol("Object"))->ToObject();
+  Local<Function> keys= Local<Function>::Cast(constructor->Get(String::NewSymbol("keys")));
+  Handle<Value> argv[1]= { object };
+  Local<Value> result= keys->Call(constructor, 1, argv);
+  if (result.IsEmpty()) throw (char*) NULL;
+  return Local<Array>::Cast(result);
+}
+
+// Appends value, and all that it holds, to the block, as JSON.stringify()
+// would have it but for the numbers, that are kept as they are. Returns 0 for
+// what JSON leaves out (undefined, functions). Throws a malloc()ed char* on
+// error, as bson.cc does, or NULL if JS code (a getter, a toJSON()) threw.
+static int frozenBuild (typeFrozenBuilder* builder, Handle<Value> value, int depth, uint32_t* ref) {
+  HandleScope scope;
+
+  if (value->IsObject() && !value->IsFunction()) {
+    Local<Value> toJSON= value->ToObject()->Get(String::NewSymbol("toJSON"));
+    if (toJSON.IsEmpty()) throw (char*) NULL;
+    if (toJSON->IsFunction()) value= Local<Function>::Cast(toJSON)->Call(value->ToObject(), 0, NULL);
+    if (value.IsEmpty()) throw (char*) NULL;
+  }
+
+  // new Number(1) and co. are their primitives
+  if (value->IsNumberObject()) value= Number::New(Local<NumberObject>::Cast(value)->NumberValue());
+  else if (value->IsStringObject()) value= Local<StringObject>::Cast(value)->StringValue();
+  else if (value->IsBooleanObject()) value= Local<BooleanObject>::Cast(value)->BooleanValue() ? True() : False();
+
+  if (value->IsUndefined() || value->IsFunction()) return 0;
+  if (value->IsNull()) *ref= kFrozenRefNull;
+  else if (value->IsTrue()) *ref= kFrozenRefTrue;
+  else if (value->IsFalse()) *ref= kFrozenRefFalse;
+  else if (value->IsNumber()) *ref= frozen_number(builder, value->NumberValue());
+  else if (value->IsString()) {
+    String::Utf8Value utf8(value);
+    *ref= frozen_string(builder, *utf8, utf8.length());
+  }
+  else if (depth >= kFrozenMaxDepth) throw strdup("Threads.freeze(): the object is circular, or too deep");
+  else if (value->IsArray()) {
+    Local<Array> array= Local<Array>::Cast(value);
+    std::vector<uint32_t> elements(array->Length(), kFrozenRefNull);
+    uint32_t i= 0;
+    while (i < elements.size()) {
+      frozenBuild(builder, array->Get(i), depth+ 1, &elements[i]);
+      i++;
+    }
+    *ref= frozen_array(builder, elements);
+  }
+  else {
+    Local<Object> object= value->ToObject();
+    Local<Array> keys= frozenKeys(object);
+    std::vector<uint32_t> pairs;
+    uint32_t i= 0;
+    while (i < keys->Length()) {
+      Local<Value> key= keys->Get(i++);
+      uint32_t valueRef;
+      if (!frozenBuild(builder, object->Get(key), depth+ 1, &valueRef)) continue;
+      String::Utf8Value utf8(key);
+      pairs.push_back(frozen_string(builder, *utf8, utf8.length()));
+      pairs.push_back(valueRef);
+    }
+    *ref= frozen_object(builder, pairs);
+  }
+  return 1;
+}
+
+
+
+
+
+
+// The views: objects with no properties of their own, whose interceptors read
+// them from the block on demand. A view (or a string read in place) holds a
+// ref to its snapshot until it's garbage collected.
+
+static void frozenViewGone (Persistent<Value> object, void* data) {
+  frozen_release((typeFrozen*) data);
+  object.Dispose();
+  object.Clear();
+}
+
+class FrozenString : public String::ExternalAsciiStringResource {
+ public:
+  FrozenString (typeFrozen* frozen, const typeFrozenRecord* record) : frozen(frozen), record(record) { frozen_retain(frozen); }
+  ~FrozenString () { frozen_release(frozen); }
+  const char* data () const { return frozen_bytes(record); }
+  size_t length () const { return record->length; }
+ private:
+  typeFrozen* frozen;
+  const typeFrozenRecord* record;
+};
+
+static Handle<Value> FrozenGet (Local<String> property, const AccessorInfo& info);
+static Handle<Value> FrozenSet (Local<String> property, Local<Value> value, const AccessorInfo& info);
+static Handle<Integer> FrozenQuery (Local<String> property, const AccessorInfo& info);
+static Handle<Boolean> FrozenDelete (Local<String> property, const AccessorInfo& info);
+static Handle<Array> FrozenKeys (const AccessorInfo& info);
+static Handle<Value> FrozenGetIndex (uint32_t index, const AccessorInfo& info);
+static Handle<Value> FrozenSetIndex (uint32_t index, Local<Value> value, const AccessorInfo& info);
+static Handle<Integer> FrozenQueryIndex (uint32_t index, const AccessorInfo& info);
+static Handle<Boolean> FrozenDeleteIndex (uint32_t index, const AccessorInfo& info);
+static Handle<Array> FrozenIndexes (const AccessorInfo& info);
+
+// Those of the current isolate: the main thread's or a thread's.
+static typeFrozenViews* isolateFrozenViews (void) {
+  typeThread* thread= (typeThread*) Isolate::GetCurrent()->GetData();
+  typeFrozenViews** views= thread ? &thread->frozenViews : &mainFrozenViews;
+
+  if (!*views) {
+    HandleScope scope;
+    Local<ObjectTemplate> view= ObjectTemplate::New();
+    view->SetInternalFieldCount(2); //The snapshot, and the record
+    view->SetNamedPropertyHandler(FrozenGet, FrozenSet, FrozenQuery, FrozenDelete, FrozenKeys);
+    view->SetIndexedPropertyHandler(FrozenGetIndex, FrozenSetIndex, FrozenQueryIndex, FrozenDeleteIndex, FrozenIndexes);
+    Local<Object> array= Context::GetCurrent()->Global()->Get(String::NewSymbol("Array"))->ToObject();
+
+    *views= new typeFrozenViews;
+    (*views)->view= Persistent<ObjectTemplate>::New(view);
+    (*views)->arrayPrototype= Persistent<Object>::New(array->Get(String::NewSymbol("prototype"))->ToObject());
+  }
+  return *views;
+}
+
+// Arrays get Array.prototype, so that forEach(), map(), etc. work on them.
+static Local<Object> frozenView (typeFrozen* frozen, const typeFrozenRecord* record) {
+  HandleScope scope;
+  typeFrozenViews* views= isolateFrozenViews();
+
+  Local<Object> view= views->view->NewInstance();
+  view->SetPointerInInternalField(0, frozen);
+  view->SetPointerInInternalField(1, (void*) record);
+  if (record->tag == kFrozenArray) view->SetPrototype(views->arrayPrototype);
+  frozen_retain(frozen);
+  Persistent<Object>::New(view).MakeWeak(frozen, frozenViewGone);
+  return scope.Close(view);
+}
+
+static Handle<Value> frozenValue (typeFrozen* frozen, uint32_t ref) {
+  HandleScope scope;
+
+  if (ref & 1) return scope.Close(Integer::New(((int32_t) ref) >> 1));
+  if (ref == kFrozenRefNull) return Null();
+  if (ref == kFrozenRefTrue) return True();
+  if (ref == kFrozenRefFalse) return False();
+
+  const typeFrozenRecord* record= frozen_record(frozen, ref);
+  switch (record->tag) {
+    case kFrozenNumber:
+      return scope.Close(Number::New(*((const double*) frozen_bytes(record))));
+    case kFrozenAsciiString:
+      if (record->length >= kFrozenExternalMin) return scope.Close(String::NewExternal(new FrozenString(frozen, record)));
+      //else it's copied, as any other
+    case kFrozenString:
+      return scope.Close(String::New(frozen_bytes(record), record->length));
+    default:
+      return scope.Close(frozenView(frozen, record));
+  }
+}
+
+static typeFrozen* frozenOf (const AccessorInfo& info, const typeFrozenRecord** record) {
+  *record= (const typeFrozenRecord*) info.Holder()->GetPointerFromInternalField(1);
+  return (typeFrozen*) info.Holder()->GetPointerFromInternalField(0);
+}
+
+// An object's property, by its name. Returns 1 and its ref in *ref if it's there.
+static int frozenProperty (typeFrozen* frozen, const typeFrozenRecord* record, Local<String> property, uint32_t* ref) {
+  if (record->tag != kFrozenObject) return 0;
+  String::Utf8Value key(property);
+  return frozen_lookup(frozen, record, *key, key.length(), ref);
+}
+
+static int frozenIsLength (const typeFrozenRecord* record, Local<String> property) {
+  return (record->tag == kFrozenArray) && !strcmp(*String::Utf8Value(property), "length");
+}
+
+static int frozenIndex (typeFrozen* frozen, const typeFrozenRecord* record, uint32_t index, uint32_t* ref) {
+  if (record->tag == kFrozenArray) {
+    if (index >= record->length) return 0;
+    *ref= frozen_refs(record)[index];
+    return 1;
+  }
+  char key[16];
+  int length= snprintf(key, sizeof(key), "%u", index);
+  return frozen_lookup(frozen, record, key, length, ref);
+}
+
+static Handle<Value> FrozenGet (Local<String> property, const AccessorInfo& info) {
+  HandleScope scope;
+  const typeFrozenRecord* record;
+  typeFrozen* frozen= frozenOf(info, &record);
+  uint32_t ref;
+
+  if (frozenIsLength(record, property)) return scope.Close(Integer::NewFromUnsigned(record->length));
+  if (!frozenProperty(frozen, record, property, &ref)) return Handle<Value>();
+  return scope.Close(frozenValue(frozen, ref));
+}
+
+static Handle<Value> FrozenSet (Local<String> property, Local<Value> value, const AccessorInfo& info) {
+  return ThrowException(Exception::TypeError(String::New(kFrozenReadOnly)));
+}
+
+static Handle<Integer> FrozenQuery (Local<String> property, const AccessorInfo& info) {
+  HandleScope scope;
+  const typeFrozenRecord* record;
+  typeFrozen* frozen= frozenOf(info, &record);
+  uint32_t ref;
+
+  if (frozenIsLength(record, property)) return scope.Close(Integer::New(ReadOnly | DontEnum | DontDelete));
+  if (!frozenProperty(frozen, record, property, &ref)) return Handle<Integer>();
+  return scope.Close(Integer::New(ReadOnly | DontDelete));
+}
+
+static Handle<Boolean> FrozenDelete (Local<String> property, const AccessorInfo& info) {
+  const typeFrozenRecord* record;
+  typeFrozen* frozen= frozenOf(info, &record);
+  uint32_t ref;
+
+  if (frozenIsLength(record, property) || frozenProperty(frozen, record, property, &ref)) return False();
+  return Handle<Boolean>();
+}
+
+// The names of an object's properties, in order.
+static Handle<Array> FrozenKeys (const AccessorInfo& info) {
+  HandleScope scope;
+  const typeFrozenRecord* record;
+  typeFrozen* frozen= frozenOf(info, &record);
+
+  if (record->tag != kFrozenObject) return scope.Close(Array::New(0));
+  const uint32_t* pairs= frozen_refs(record);
+  Local<Array> keys= Array::New(record->length);
+  uint32_t i= 0;
+  while (i < record->length) {
+    const typeFrozenRecord* key= frozen_record(frozen, pairs[2* i]);
+    keys->Set(i++, String::New(frozen_bytes(key), key->length));
+  }
+  return scope.Close(keys);
+}
+
+static Handle<Value> FrozenGetIndex (uint32_t index, const AccessorInfo& info) {
+  HandleScope scope;
+  const typeFrozenRecord* record;
+  typeFrozen* frozen= frozenOf(info, &record);
+  uint32_t ref;
+
+  if (!frozenIndex(frozen, record, index, &ref)) return Handle<Value>();
+  return scope.Close(frozenValue(frozen, ref));
+}
+
+static Handle<Value> FrozenSetIndex (uint32_t index, Local<Value> value, const AccessorInfo& info) {
+  return ThrowException(Exception::TypeError(String::New(kFrozenReadOnly)));
+}
+
+static Handle<Integer> FrozenQueryIndex (uint32_t index, const AccessorInfo& info) {
+  HandleScope scope;
+  const typeFrozenRecord* record;
+  typeFrozen* frozen= frozenOf(info, &record);
+  uint32_t ref;
+
+  if (!frozenIndex(frozen, record, index, &ref)) return Handle<Integer>();
+  return scope.Close(Integer::New(ReadOnly | DontDelete));
+}
+
+static Handle<Boolean> FrozenDeleteIndex (uint32_t index, const AccessorInfo& info) {
+  const typeFrozenRecord* record;
+  typeFrozen* frozen= frozenOf(info, &record);
+  uint32_t ref;
+
+  if (frozenIndex(frozen, record, index, &ref)) return False();
+  return Handle<Boolean>();
+}
+
+// An array's indexes (an object's numeric keys are among its FrozenKeys()).
+static Handle<Array> FrozenIndexes (const AccessorInfo& info) {
+  HandleScope scope;
+  const typeFrozenRecord* record;
+  frozenOf(info, &record);
+
+  if (record->tag != kFrozenArray) return scope.Close(Array::New(0));
+  Local<Array> indexes= Array::New(record->length);
+  uint32_t i= 0;
+  while (i < record->length) {
+    indexes->Set(i, Integer::NewFromUnsigned(i));
+    i++;
+  }
+  return scope.Close(indexes);
+}
+
+
+
+
+
+
+// freeze(name, object): serializes object once, into read-only memory that
+// all the threads share, and names it so that they can get to it with
+// frozen(name). Returns a view of it.
+static Handle<Value> Freeze (const Arguments &args) {
+  HandleScope scope;
+
+  if (!args[0]->IsString() || !args[1]->IsObject() || args[1]->IsFunction()) {
+    return ThrowException(Exception::TypeError(String::New("Threads.freeze( name, object ): bad arguments")));
+  }
+
+  typeFrozenBuilder builder;
+  frozen_builder_init(&builder);
+  uint32_t root= kFrozenRefNull;
+  TryCatch onError;
+  try {
+    frozenBuild(&builder, args[1], 0, &root);
+  }
+  catch (char* err) {
+    if (!err) return onError.ReThrow();
+    Local<Value> error= Exception::TypeError(String::New(err));
+    free(err);
+    return ThrowException(error);
+  }
+
+  if (!builder.tooBig && !frozen_is_record(root)) {
+    return ThrowException(Exception::TypeError(String::New("Threads.freeze(): the object's toJSON() must return an object")));
+  }
+  typeFrozen* frozen= frozen_finish(&builder, root);
+  if (!frozen) {
+    return ThrowException(Exception::Error(String::New("Threads.freeze(): out of memory, or over 2GB")));
+  }
+  frozen_publish(*String::Utf8Value(args[0]), frozen);
+  Local<Object> view= frozenView(frozen, frozen_record(frozen, root));
+  frozen_release(frozen);
+  return scope.Close(view);
+}
+
+// frozen(name): a view of the snapshot called name, or undefined.
+static Handle<Value> Frozen (const Arguments &args) {
+  HandleScope scope;
+
+  typeFrozen* frozen= frozen_open(*String::Utf8Value(args[0]));
+  if (!frozen) return Undefined();
+  Local<Object> view= frozenView(frozen, frozen_record(frozen, frozen_root(frozen)));
+  frozen_release(frozen);
+  return scope.Close(view);
+}
+
+// unfreeze(name): forgets the name. The memory goes when the last view does.
+static Handle<Value> Unfreeze (const Arguments &args) {
+  return frozen_unpublish(*String::Utf8Value(args[0])) ? True() : False();
+}
+
+static Handle<Value> FrozenStats (const Arguments &args) {
+  HandleScope scope;
+  Local<Object> stats= Object::New();
+  stats->Set(String::NewSymbol("snapshots"), Number::New(atomic_read(&frozenLive)));
+  stats->Set(String::NewSymbol("bytes"), Number::New(atomic_read(&frozenBytes)));
+  return scope.Close(stats);
+}
+
+
+
+
+
+
+static double mergeKey (Local<Value> value, Handle<String> keyField) {
+  if (value->IsNumber() || keyField.IsEmpty() || !value->IsObject()) return value->NumberValue();
+  return value->ToObject()->Get(keyField)->NumberValue();
+}
+
+// mergePartials(partials, kind, k, keyField, descending): pool.scatter()'s
+// native merges of the shards' partial results. kind is 'sum' (of numbers, or
+// element by element of arrays of numbers), 'merge' (a k-way merge of arrays
+// already in order) or 'topK' (the first k, in order). The order is by the
+// elements, or by their keyField if they are objects.
+static Handle<Value> MergePartials (const Arguments &args) {
+  HandleScope scope;
+
+  if (!args[0]->IsArray()) {
+    return ThrowException(Exception::TypeError(String::New("mergePartials( partials, kind [, k] [, key] [, descending] ): partials must be an Array")));
+  }
+  Local<Array> partials= Local<Array>::Cast(args[0]->ToObject());
+  std::string kind(*String::Utf8Value(args[1]));
+  uint32_t sources= partials->Length();
+  Handle<String> keyField;
+  if (args[3]->IsString()) keyField= args[3]->ToString();
+  int descending= args[4]->BooleanValue();
+
+  if (kind == "sum") {
+    std::vector<double> sums;
+    double sum= 0;
+    int arrays= 0;
+    int numbers= 0;
+    uint32_t s= 0;
+    while (s < sources) {
+      Local<Value> partial= partials->Get(s++);
+      if (partial->IsArray()) {
+        Local<Array> array= Local<Array>::Cast(partial->ToObject());
+        arrays= 1;
+        if (sums.size() < array->Length()) sums.resize(array->Length(), 0);
+        uint32_t i= 0;
+        while (i < array->Length()) { sums[i]+= array->Get(i)->NumberValue(); i++; }
+      }
+      else {
+        numbers= 1;
+        sum+= partial->NumberValue();
+      }
+    }
+    if (arrays && numbers) {
+      return ThrowException(Exception::TypeError(String::New("mergePartials(): 'sum' can't add up numbers and arrays")));
+    }
+    if (!arrays) return scope.Close(Number::New(sum));
+    Local<Array> result= Array::New(sums.size());
+    uint32_t i= 0;
+    while (i < sums.size()) { result->Set(i, Number::New(sums[i])); i++; }
+    return scope.Close(result);
+  }
+
+  if ((kind != "merge") && (kind != "topK")) {
+    return ThrowException(Exception::TypeError(String::New("mergePartials(): kind must be 'sum', 'merge' or 'topK'")));
+  }
+
+  std::vector<typeMergeItem> items;
+  std::vector<size_t> starts;
+  uint32_t s= 0;
+  while (s < sources) {
+    starts.push_back(items.size());
+    Local<Value> partial= partials->Get(s);
+    if (partial->IsArray()) {
+      Local<Array> array= Local<Array>::Cast(partial->ToObject());
+      uint32_t i= 0;
+      while (i < array->Length()) {
+        typeMergeItem item= { mergeKey(array->Get(i), keyField), s, i };
+        items.push_back(item);
+        i++;
+      }
+    }
+    s++;
+  }
+  starts.push_back(items.size());
+
+  size_t length= items.size();
+  if (kind == "merge") {
+    std::vector<typeMergeItem> merged(length);
+    if (length) merge_kway(&items[0], &starts[0], sources, descending, &merged[0]);
+    items.swap(merged);
+  }
+  else {
+    double k= args[2]->NumberValue();
+    if (!(k >= 0)) {
+      return ThrowException(Exception::TypeError(String::New("mergePartials(): k must be a Number >= 0")));
+    }
+    if (length) length= merge_top_k(&items[0], length, (size_t) k, descending);
+  }
+
+  Local<Array> result= Array::New(length);
+  size_t i= 0;
+  while (i < length) {
+    result->Set(i, Local<Array>::Cast(partials->Get(items[i].source)->ToObject())->Get(items[i].index));
+    i++;
+  }
+  return scope.Close(result);
+}
+
+
+
+
+
+
+// The scheduler thread turns a wheel of kWheelSlots slots, one every
+// kWheelTickMs. A schedule waits in the slot of its tick, for as many turns
+// as it has rounds. If the thread falls behind it catches up tick by tick.
+
+#define kWheelSlots 512
+#define kWheelTickMs 5
+
+static typeSchedule* wheel[kWheelSlots];
+static uint64_t wheelStart;   //uv_hrtime() of tick 0
+static uint64_t wheelTick;    //The next tick to turn
+static uv_mutex_t wheelLock;
+static uv_cond_t wheelCV;
+static uv_thread_t wheelThread;
+static int wheelRunning= 0;
+static Persistent<ObjectTemplate> scheduleTemplate;
+
+static double wheelNow (void) {
+  return (uv_hrtime()- wheelStart)/ 1e6;
+}
+
+// Under wheelLock: a number in [0, 1) for the schedule's jitter.
+static double scheduleRandom (typeSchedule* schedule) {
+  uint32_t x= schedule->seed;
+  x^= x << 13;
+  x^= x >> 17;
+  x^= x << 5;
+  schedule->seed= x;
+  return x/ 4294967296.0;
+}
+
+// Under wheelLock
+static void wheelInsert (typeSchedule* schedule) {
+  double at= schedule->due;
+  if (schedule->jitterMs > 0) at+= schedule->jitterMs* scheduleRandom(schedule);
+  uint64_t tick= (uint64_t) (at/ kWheelTickMs+ 0.999999);
+  if (tick < wheelTick) tick= wheelTick;
+  schedule->rounds= (long) ((tick- wheelTick)/ kWheelSlots);
+  typeSchedule** slot= &wheel[tick % kWheelSlots];
+  schedule->next= *slot;
+  *slot= schedule;
+}
+
+static void wheelRemove (typeSchedule* schedule) {
+  int i= 0;
+  while (i < kWheelSlots) {
+    typeSchedule** p= &wheel[i++];
+    while (*p) {
+      if (*p == schedule) {
+        *p= schedule->next;
+        return;
+      }
+      p= &(*p)->next;
+    }
+  }
+}
+
+// Under wheelLock: queues the schedule's program in the least busy of its threads.
+static void scheduleRun (typeSchedule* schedule) {
+  if ((schedule->overlap == kOverlapSkip) && atomic_read(&schedule->running)) {
+    schedule->overlapSkipped++;
+    return;
+  }
+  if (queueIsFull()) {
+    schedule->dropped++;
+    return;
+  }
+
+  typeThread* thread= NULL;
+  int i= 0;
+  while (i < schedule->threadsLength) {
+    typeThread* t= schedule->threads[i++];
+    if (!t->sigkill && (!thread || (t->inQueue.length < thread->inQueue.length))) thread= t;
+  }
+  if (!thread) return;
+
+  typeQueueItem* qitem= nuJobQueueItem();
+  typeJob* job= (typeJob*) qitem->asPtr;
+  job->jobType= kJobTypeEval;
+  job->typeEval.tiene_callBack= 0;
+  job->typeEval.resultado= NULL;
+  job->typeEval.useStringObject= 0;
+  job->typeEval.scriptText_CharPtr= strdup(schedule->source);
+  job->schedule= schedule;
+  atomic_inc(&schedule->refs);
+  atomic_inc(&schedule->running);
+  schedule->runs++;
+  jobAccount(thread, job, strlen(schedule->source));
+  pushToInQueue(qitem, thread);
+}
+
+// Under wheelLock: the schedule's tick has come.
+static void scheduleFire (typeSchedule* schedule, double now) {
+  double late= now- schedule->due;
+  long missed= (late >= schedule->everyMs) ? (long) (late/ schedule->everyMs) : 0;
+  long runs= (schedule->missed == kMissedCatchUp) ? missed+ 1 : 1;
+  schedule->missedTicks+= missed;
+  while (runs--) scheduleRun(schedule);
+  schedule->due+= (missed+ 1)* schedule->everyMs;
+  wheelInsert(schedule);
+}
+
+static void wheelWait (int ms) {
+#ifdef WWT_PTHREAD
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  ts.tv_nsec+= (ms % 1000)* 1000000L;
+  ts.tv_sec+= ms/ 1000+ ts.tv_nsec/ 1000000000L;
+  ts.tv_nsec%= 1000000000L;
+  pthread_cond_timedwait(&wheelCV, &wheelLock, &ts);
+#else
+  uv_cond_timedwait(&wheelCV, &wheelLock, (uint64_t) ms* 1000000);
+#endif
+}
+
+static void schedulerThread (void* arg) {
+  uv_mutex_lock(&wheelLock);
+  while (1) {
+    double now= wheelNow();
+    while (wheelTick* kWheelTickMs <= now) {
+      typeSchedule* schedule= wheel[wheelTick % kWheelSlots];
+      wheel[wheelTick % kWheelSlots]= NULL;
+      wheelTick++;
+      while (schedule) {
+        typeSchedule* next= schedule->next;
+        if (schedule->rounds) {
+          schedule->rounds--;
+          schedule->next= wheel[(wheelTick- 1) % kWheelSlots];
+          wheel[(wheelTick- 1) % kWheelSlots]= schedule;
+        }
+        else {
+          scheduleFire(schedule, now);
+        }
+        schedule= next;
+      }
+    }
+    int ms= (int) (wheelTick* kWheelTickMs- now)+ 1;
+    wheelWait(ms > 0 ? ms : 1);
+  }
+}
+
+static typeSchedule* isASchedule (Handle<Object> receiver) {
+  if (receiver->InternalFieldCount() != 1) return NULL;
+  return (typeSchedule*) receiver->GetPointerFromInternalField(0);
+}
+
+// schedule(threads, source, everyMs, jitterMs, overlap, missed): see pool.schedule()
+static Handle<Value> Schedule (const Arguments &args) {
+  HandleScope scope;
+
+  if (!checkGroupThreads(args[0])) {
+    return ThrowException(Exception::Error(String::New("schedule(): the pool has been destroyed")));
+  }
+  if (!args[1]->IsString() || !(args[2]->NumberValue() > 0)) {
+    return ThrowException(Exception::TypeError(String::New("schedule( fn, { everyMs: ms [, jitter: ms] [, overlap: 'skip'|'queue'] [, missed: 'skip'|'catchUp'] } ): bad arguments")));
+  }
+
+  std::string overlap(*String::Utf8Value(args[4]));
+  std::string missed(*String::Utf8Value(args[5]));
+  if (((overlap != "skip") && (overlap != "queue")) || ((missed != "skip") && (missed != "catchUp"))) {
+    return ThrowException(Exception::TypeError(String::New("schedule(): overlap must be 'skip' or 'queue', and missed 'skip' or 'catchUp'")));
+  }
+
+  Local<Array> threads= Local<Array>::Cast(args[0]->ToObject());
+  typeSchedule* schedule= (typeSchedule*) calloc(1, sizeof(typeSchedule));
+  schedule->source= strdup(*String::Utf8Value(args[1]));
+  schedule->everyMs= args[2]->NumberValue();
+  schedule->jitterMs= args[3]->NumberValue() > 0 ? args[3]->NumberValue() : 0;
+  schedule->overlap= (overlap == "queue") ? kOverlapQueue : kOverlapSkip;
+  schedule->missed= (missed == "catchUp") ? kMissedCatchUp : kMissedSkip;
+  schedule->seed= ((uint32_t) uv_hrtime()) | 1;
+  schedule->threadsLength= threads->Length();
+  schedule->threads= (typeThread**) calloc(schedule->threadsLength, sizeof(typeThread*));
+  int i= 0;
+  while (i < schedule->threadsLength) {
+    schedule->threads[i]= isAThread(threads->Get(i)->ToObject());
+    i++;
+  }
+  schedule->refs= 1;
+
+  if (!wheelRunning) {
+    wheelRunning= 1;
+    uv_mutex_init(&wheelLock);
+    uv_cond_init(&wheelCV);
+    wheelStart= uv_hrtime();
+    uv_thread_create(&wheelThread, schedulerThread, NULL);
+  }
+
+  uv_mutex_lock(&wheelLock);
+  schedule->due= wheelNow()+ schedule->everyMs;
+  wheelInsert(schedule);
+  uv_cond_signal(&wheelCV);
+  uv_mutex_unlock(&wheelLock);
+
+  Local<Object> JSObject= scheduleTemplate->NewInstance();
+  JSObject->SetPointerInInternalField(0, schedule);
+  return scope.Close(JSObject);
+}
+
+// schedule.cancel(): no more runs. Those queued or running go on.
+static Handle<Value> ScheduleCancel (const Arguments &args) {
+  HandleScope scope;
+  typeSchedule* schedule= isASchedule(args.This());
+  if (!schedule) return Undefined();
+
+  args.This()->SetPointerInInternalField(0, NULL);
+  uv_mutex_lock(&wheelLock);
+  wheelRemove(schedule);
+  uv_mutex_unlock(&wheelLock);
+  scheduleRelease(schedule);
+  return Undefined();
+}
+
+static Handle<Value> ScheduleStats (const Arguments &args) {
+  HandleScope scope;
+  typeSchedule* schedule= isASchedule(args.This());
+  if (!schedule) {
+    return ThrowException(Exception::Error(String::New("schedule.stats(): the schedule has been cancelled")));
+  }
+
+  Local<Object> stats= Object::New();
+  uv_mutex_lock(&wheelLock);
+  stats->Set(String::NewSymbol("runs"), Number::New(schedule->runs));
+  stats->Set(String::NewSymbol("overlapSkipped"), Number::New(schedule->overlapSkipped));
+  stats->Set(String::NewSymbol("missedTicks"), Number::New(schedule->missedTicks));
+  stats->Set(String::NewSymbol("dropped"), Number::New(schedule->dropped));
+  stats->Set(String::NewSymbol("nextInMs"), Number::New(schedule->due- wheelNow()));
+  uv_mutex_unlock(&wheelLock);
+  stats->Set(String::NewSymbol("running"), Number::New(atomic_read(&schedule->running)));
+  stats->Set(String::NewSymbol("errors"), Number::New(atomic_read(&schedule->errors)));
+  return scope.Close(stats);
+}
+
+
+
+
+
+
+// Threads.serve(pool, path) lets other processes run jobs in this process'
+// pool, through a Unix domain socket (a named pipe in Windows) at path. The
+// jobs arrive already serialized (see remote.cc) and go to the least busy
+// thread of the pool as they are: the main thread doesn't deserialize them.
+// They go straight into the thread's inQueue, so the pool's JS queue never sees
+// them: they don't count in its pendingJobs(), and its EDF queue, batching and
+// load shedding don't apply to them. setQueueLimit() does.
+// Threads.connect(path) is the other end. With {transport:'shm'} the frames
+// go instead through rings in shared memory (see shm_ring.cc): one for the
+// requests of all the clients, and one per client for its results. A client
+// says hello with the path of its ring, and the server says hello back in it
+// with the channel the client is to put in its frames. Each end checks that
+// the other's process is still there every kRingWatchMs.
+
+struct typeRing;
+struct typeRingReader;
+struct typeConnection;
+
+typedef struct typeServer {
+  uv_pipe_t pipe;
+  char* path;
+  struct typeRingReader* shm;          //shm: reads the requests ring
+  struct typeConnection* shmConnections;
+  uv_timer_t retry;                    //shm: pushes the results that are waiting, watches the clients
+  uint32_t nextChannel;                //shm
+  int closed;
+  int connections;
+  double jobs;
+  double bytesIn;
+  double bytesOut;
+  Persistent<Array> threads;
+  Persistent<Object> JSObject;
+  unsigned long magicCookie;
+} typeServer;
+
+struct typeConnection {
+  uv_pipe_t pipe;
+  typeServer* server;
+  typeFrameReader reader;
+  struct typeRing* ring;        //shm: the client's results ring
+  uint32_t channel;             //shm: the client's id in the requests
+  struct typeConnection* next;  //shm: in server->shmConnections
+  typeQueue results;            //shm: waiting for room in the ring, in order
+  uint64_t stalledSince;        //shm: when the first of them had to wait
+  int refs;   //The open pipe, plus one per job in flight
+  int closed;
+};
+typedef struct typeConnection typeConnection;
+
+typedef struct {
+  uv_write_t req;
+  char* frame;
+} typeWrite;
+
+#define kServerMagicCookie 0x5e7e7a11
+#define kClientMagicCookie 0xc11e7e11
+
+static Persistent<ObjectTemplate> serverTemplate;
+static Persistent<ObjectTemplate> clientTemplate;
+
+
+
+
+
+
+static void writeDone (uv_write_t* req, int status) {
+  typeWrite* w= (typeWrite*) req;
+  free(w->frame);
+  free(w);
+}
+
+// Sends a frame and frees it when it's been written.
+static int writeFrame (uv_stream_t* stream, char* frame) {
+  typeWrite* w= (typeWrite*) malloc(sizeof(typeWrite));
+  w->frame= frame;
+  uv_buf_t buf= uv_buf_init(frame, ((typeFrameHeader*) frame)->length);
+  if (uv_write(&w->req, stream, &buf, 1, writeDone)) {
+    free(frame);
+    free(w);
+    return -1;
+  }
+  return 0;
+}
+
+
+
+
+
+
+#if defined(WWT_SHM_RING)
+
+// A thread that pulls the frames out of a ring and hands them to the main
+// thread through async, whose data is the server or the client.
+typedef struct typeRingReader {
+  uv_async_t async;
+  uv_thread_t thread;
+  typeRing* ring;
+  typeQueue frames;
+  volatile int stop;
+} typeRingReader;
+
+static void ringReaderLoop (void* arg) {
+  typeRingReader* reader= (typeRingReader*) arg;
+  while (!reader->stop) {
+    char* frame= ring_pull(reader->ring, kRingWaitMs);
+    if (!frame) {
+      if (reader->ring->header->closed) break;
+      continue;
+    }
+    queue_push(nuItem(kItemTypePointer, frame), &reader->frames);
+    uv_async_send(&reader->async);
+  }
+  uv_async_send(&reader->async);
+}
+
+static typeRingReader* ringReaderStart (typeRing* ring, void* owner, uv_async_cb cb) {
+  typeRingReader* reader= (typeRingReader*) calloc(1, sizeof(typeRingReader));
+  reader->ring= ring;
+  uv_mutex_init(&reader->frames.queueLock);
+  uv_async_init(uv_default_loop(), &reader->async, cb);
+  reader->async.data= owner;
+  uv_thread_create(&reader->thread, ringReaderLoop, reader);
+  return reader;
+}
+
+// The next frame pulled, or NULL. free() it when done.
+static char* ringReaderNext (typeRingReader* reader) {
+  typeQueueItem* qitem= queue_pull(&reader->frames);
+  if (!qitem) return NULL;
+  char* frame= (char*) qitem->asPtr;
+  destroyItem(qitem);
+
+  typeFrameHeader* header= (typeFrameHeader*) frame;
+  if ((header->length < sizeof(typeFrameHeader)) || (header->nameLength > header->length- sizeof(typeFrameHeader))) {
+    free(frame);
+    return ringReaderNext(reader);
+  }
+  return frame;
+}
+
+// Closes the ring and stops the thread. cb gets the async handle once closed:
+// then ringReaderFree().
+static void ringReaderStop (typeRingReader* reader, uv_close_cb cb) {
+  reader->stop= 1;
+  ring_close(reader->ring);
+  uv_thread_join(&reader->thread);
+  uv_close((uv_handle_t*) &reader->async, cb);
+}
+
+static void ringReaderFree (typeRingReader* reader) {
+  char* frame;
+  while ((frame= ringReaderNext(reader))) free(frame);
+  uv_mutex_destroy(&reader->frames.queueLock);
+  ring_destroy(reader->ring);
+  free(reader);
+}
+
+// Runs cb every ms: kRingRetryMs while there are frames waiting for room in a
+// ring, kRingWatchMs otherwise.
+static void ringTimerEvery (uv_timer_t* timer, uv_timer_cb cb, int64_t ms) {
+  if (uv_is_active((uv_handle_t*) timer) && (uv_timer_get_repeat(timer) == ms)) return;
+  uv_timer_start(timer, cb, ms, ms);
+}
+
+#endif
+
+
+
+
+
+
+static void serverRelease (typeServer* server) {
+  if (!server->closed || server->connections || server->pipe.data || server->shm || server->retry.data) return;
+  free(server->path);
+  server->threads.Dispose();
+  server->JSObject.Dispose();
+  free(server);
+}
+
+static void serverClosed (uv_handle_t* handle) {
+  typeServer* server= (typeServer*) handle->data;
+  server->pipe.data= NULL;
+  serverRelease(server);
+}
+
+static void connectionRelease (typeConnection* conn) {
+  if (--conn->refs) return;
+  typeServer* server= conn->server;
+  frameReaderFree(&conn->reader);
+#if defined(WWT_SHM_RING)
+  if (conn->ring) {
+    typeQueueItem* qitem;
+    while ((qitem= queue_pull(&conn->results))) {
+      free(qitem->asPtr);
+      destroyItem(qitem);
+    }
+    uv_mutex_destroy(&conn->results.queueLock);
+    ring_destroy(conn->ring);
+  }
+#endif
+  free(conn);
+  server->connections--;
+  serverRelease(server);
+}
+
+static void connectionClosed (uv_handle_t* handle) {
+  connectionRelease((typeConnection*) handle->data);
+}
+
+static void connectionClose (typeConnection* conn) {
+  if (conn->closed) return;
+  conn->closed= 1;
+  if (!conn->ring) {
+    uv_close((uv_handle_t*) &conn->pipe, connectionClosed);
+    return;
+  }
+
+  typeConnection** p= &conn->server->shmConnections;
+  while (*p != conn) p= &(*p)->next;
+  *p= conn->next;
+  connectionRelease(conn);
+}
+
+
+
+
+
+
+#if defined(WWT_SHM_RING)
+
+// shm: pushes the results that are waiting, in order, as long as there's room
+// in the ring. A client that doesn't take its results in a while is gone.
+// Returns whether some are still waiting: if not, conn may have been freed.
+static int connectionFlush (typeConnection* conn) {
+  typeQueueItem* qitem;
+  while ((qitem= queue_pull(&conn->results))) {
+    int err= ring_push(conn->ring, (char*) qitem->asPtr, 0);
+    if (err == -3) {
+      stack_push(qitem, &conn->results);
+      break;
+    }
+    free(qitem->asPtr);
+    destroyItem(qitem);
+    conn->stalledSince= uv_now(uv_default_loop());
+    if (err) {
+      connectionClose(conn);
+      return 0;
+    }
+  }
+  if (!conn->results.length) return 0;
+  if (uv_now(uv_default_loop())- conn->stalledSince >= kRingWaitMs* 10) {
+    connectionClose(conn);
+    return 0;
+  }
+  return 1;
+}
+
+// A client whose process has died, or that has closed its ring without a
+// bye, is gone: its ring is unlinked if it was left behind.
+static void serverRetry (uv_timer_t* handle, int status) {
+  typeServer* server= (typeServer*) handle->data;
+  int waiting= 0;
+  typeConnection* conn= server->shmConnections;
+  while (conn) {
+    typeConnection* next= conn->next;
+    if (!ring_owner_alive(conn->ring)) {
+      conn->ring->owner= 1;
+      connectionClose(conn);
+    }
+    else if (conn->ring->header->closed) connectionClose(conn);
+    else if (connectionFlush(conn)) waiting= 1;
+    conn= next;
+  }
+  ringTimerEvery(handle, serverRetry, waiting ? kRingRetryMs : kRingWatchMs);
+}
+
+static void serverRetryClosed (uv_handle_t* handle) {
+  typeServer* server= (typeServer*) handle->data;
+  server->retry.data= NULL;
+  serverRelease(server);
+}
+
+// shm: the main thread never waits for room in the client's ring: while it's
+// full the results wait in conn->results, and serverRetry() pushes them.
+static void connectionPush (typeConnection* conn, char* frame) {
+  if (!ring_fits(conn->ring, frame)) {
+    const char* tooBig= "the result is too big for the ring";
+    uint32_t id= ((typeFrameHeader*) frame)->id;
+    free(frame);
+    frame= frameNew(kFrameError, id, 0, NULL, 0, tooBig, strlen(tooBig));
+  }
+  typeServer* server= conn->server;
+  if (!conn->results.length) conn->stalledSince= uv_now(uv_default_loop());
+  queue_push(nuItem(kItemTypePointer, frame), &conn->results);
+  if (connectionFlush(conn)) ringTimerEvery(&server->retry, serverRetry, kRingRetryMs);
+}
+
+#endif
+
+static void remoteReply (typeConnection* conn, uint32_t id, uint32_t kind, const char* payload, size_t length) {
+  if (conn->closed) return;
+
+  char* frame= frameNew(kind, id, 0, NULL, 0, payload, length);
+  if (!frame) {
+    const char* tooBig= "the result is too big";
+    frame= frameNew(kFrameError, id, 0, NULL, 0, tooBig, strlen(tooBig));
+  }
+  conn->server->bytesOut+= ((typeFrameHeader*) frame)->length;
+#if defined(WWT_SHM_RING)
+  if (conn->ring) {
+    connectionPush(conn, frame);
     return;
   }
+#endif
+  if (writeFrame((uv_stream_t*) &conn->pipe, frame)) connectionClose(conn);
+}
 
-  HandleScope scope;
-  typeJob* job;
-  Local<Value> argv[2];
-  Local<Value> null= Local<Value>::New(Null());
-  typeQueueItem* qitem;
-  String::Utf8Value* str;
+static void remoteReplyError (typeConnection* conn, uint32_t id, Local<Value> error) {
+  String::Utf8Value message(error);
+  remoteReply(conn, id, kFrameError, *message, message.length());
+}
 
-  TryCatch onError;
-  while ((qitem= queue_pull(&thread->outQueue))) {
-    job= (typeJob*) qitem->asPtr;
 
-    if (job->jobType == kJobTypeEval) {
 
-      if (job->typeEval.tiene_callBack) {
-        str= job->typeEval.resultado;
 
-        if (job->typeEval.error) {
-          argv[0]= Exception::Error(String::New(**str, (*str).length()));
-          argv[1]= null;
-        } else {
-          argv[0]= null;
-          argv[1]= String::New(**str, (*str).length());
-        }
-        job->cb->CallAsFunction(thread->JSObject, 2, argv);
-        job->cb.Dispose();
-        job->typeEval.tiene_callBack= 0;
 
-        delete str;
-        job->typeEval.resultado= NULL;
-      }
 
-      queue_push(qitem, freeJobsQueue);
+// Main thread: a remote job is back from its thread.
+static void remoteJobDone (typeThread* thread, typeQueueItem* qitem) {
+  typeJob* job= (typeJob*) qitem->asPtr;
+  typeConnection* conn= job->remote;
 
-      if (onError.HasCaught()) {
-        if (thread->outQueue.first) {
-          uv_async_send(&thread->async_watcher); // wake up callback again
-        }
-        node::FatalException(onError);
-        return;
+  if (job->jobType == kJobTypeEval) {
+    String::Utf8Value* str= job->typeEval.resultado;
+    remoteReply(conn, job->remoteId, job->typeEval.error ? kFrameError : kFrameResultText, **str, str->length());
+    delete str;
+    job->typeEval.resultado= NULL;
+  }
+  else if (job->jobType == kJobTypeCall) {
+    if (job->typeCall.error) {
+      Local<Value> message;
+      try {
+        message= deserialize(job->typeCall.buffer, job->typeCall.bufferSize)->Get(0);
       }
+      catch (char* err) {
+        message= String::New(err);
+        free(err);
+      }
+      remoteReplyError(conn, job->remoteId, message);
     }
-    else if (job->jobType == kJobTypeEvent) {
+    else {
+      remoteReply(conn, job->remoteId, kFrameResult, job->typeCall.buffer, job->typeCall.bufferSize);
+    }
+    free(job->typeCall.buffer);
+    job->typeCall.buffer= NULL;
+  }
 
-      //fprintf(stdout, "*** Callback\n");
+  job->remote= NULL;
+  job->typeEval.tiene_callBack= job->typeCall.tiene_callBack= 0;
+  jobRelease(thread, job);
+  destroyJobQueueItem(qitem);
+  connectionRelease(conn);
+}
 
-      Local<Value> args[2];
+static void remoteJobAborted (typeJob* job, Local<Value> error) {
+  typeConnection* conn= job->remote;
+  job->remote= NULL;
+  remoteReplyError(conn, job->remoteId, error);
+  connectionRelease(conn);
+}
 
-      str= job->typeEvent.eventName;
-      args[0]= String::New(**str, (*str).length());
-      delete str;
 
-      Local<Array> array= Array::New(job->typeEvent.length);
-      args[1]= array;
 
-      int i= 0;
-      while (i < job->typeEvent.length) {
-        str= job->typeEvent.argumentos[i];
-        array->Set(i, String::New(**str, (*str).length()));
-        delete str;
-        i++;
+
+
+
+static typeThread* leastBusyThread (Local<Array> threads) {
+  typeThread* best= NULL;
+  uint32_t i= 0;
+  while (i < threads->Length()) {
+    typeThread* thread= isAThread(threads->Get(i++)->ToObject());
+    if (thread && !thread->sigkill && (!best || (thread->inQueue.length < best->inQueue.length))) {
+      best= thread;
+    }
+  }
+  return best;
+}
+
+static void runRemoteFrame (typeConnection* conn, char* frame) {
+  typeFrameHeader* header= (typeFrameHeader*) frame;
+  typeServer* server= conn->server;
+
+  server->jobs++;
+  server->bytesIn+= header->length;
+
+  typeThread* thread= server->closed ? NULL : leastBusyThread(Local<Array>::New(server->threads));
+  if (!thread) {
+    remoteReplyError(conn, header->id, String::New("serve(): the pool has been destroyed"));
+    return;
+  }
+
+  if (queueIsFull()) {
+    queueRejected++;
+    remoteReplyError(conn, header->id, String::New("serve(): the queued bytes limit has been reached"));
+    return;
+  }
+
+  if ((header->kind != kFrameCall) && (header->kind != kFrameEval)) {
+    remoteReplyError(conn, header->id, String::New("serve(): unknown job kind"));
+    return;
+  }
+
+  typeQueueItem* qitem= nuJobQueueItem();
+  typeJob* job= (typeJob*) qitem->asPtr;
+  size_t length= framePayloadLength(frame);
+
+  if (header->kind == kFrameCall) {
+    job->jobType= kJobTypeCall;
+    job->typeCall.error= 0;
+    job->typeCall.tiene_callBack= 1;
+    job->typeCall.argc= header->argc;
+    job->typeCall.fnName= new String::Utf8Value(String::New(frameName(frame), header->nameLength));
+    job->typeCall.buffer= (char*) malloc(length);
+    memcpy(job->typeCall.buffer, framePayload(frame), length);
+    job->typeCall.bufferSize= length;
+    job->typeCall.pinnedLength= 0;
+    job->typeCall.pinned= NULL;
+    jobAccount(thread, job, length+ header->nameLength);
+  }
+  else {
+    job->jobType= kJobTypeEval;
+    job->typeEval.tiene_callBack= 1;
+    job->typeEval.resultado= NULL;
+    job->typeEval.useStringObject= 0;
+    job->typeEval.scriptText_CharPtr= (char*) malloc(length+ 1);
+    memcpy(job->typeEval.scriptText_CharPtr, framePayload(frame), length);
+    job->typeEval.scriptText_CharPtr[length]= 0;
+    jobAccount(thread, job, length);
+  }
+  job->remote= conn;
+  job->remoteId= header->id;
+  conn->refs++;
+
+  pushToInQueue(qitem, thread);
+}
+
+
+
+
+
+
+static uv_buf_t connectionAlloc (uv_handle_t* handle, size_t suggested) {
+  typeConnection* conn= (typeConnection*) handle->data;
+  size_t size= 0;
+  char* room= frameReaderRoom(&conn->reader, suggested, &size);
+  return uv_buf_init(room, room ? (unsigned int) size : 0);
+}
+
+static void connectionRead (uv_stream_t* stream, ssize_t nread, uv_buf_t buf) {
+  typeConnection* conn= (typeConnection*) stream->data;
+
+  if (nread < 0) {
+    connectionClose(conn);
+    return;
+  }
+  frameReaderCommit(&conn->reader, nread);
+
+  HandleScope scope;
+  char* frame;
+  int bad= 0;
+  while (!conn->closed && (frame= frameReaderNext(&conn->reader, &bad))) runRemoteFrame(conn, frame);
+  if (bad) connectionClose(conn);
+  reportQueuedBytes();
+}
+
+static void serverConnection (uv_stream_t* stream, int status) {
+  typeServer* server= (typeServer*) stream->data;
+  if (status) return;
+
+  typeConnection* conn= (typeConnection*) calloc(1, sizeof(typeConnection));
+  conn->server= server;
+  uv_pipe_init(uv_default_loop(), &conn->pipe, 0);
+  conn->pipe.data= conn;
+  conn->refs= 1;
+  server->connections++;
+
+  if (uv_accept(stream, (uv_stream_t*) &conn->pipe) ||
+      uv_read_start((uv_stream_t*) &conn->pipe, connectionAlloc, connectionRead)) {
+    connectionClose(conn);
+  }
+}
+
+
+
+
+
+
+#if defined(WWT_SHM_RING)
+
+static typeConnection* shmConnection (typeServer* server, uint32_t channel) {
+  typeConnection* conn= server->shmConnections;
+  while (conn && (conn->channel != channel)) conn= conn->next;
+  return conn;
+}
+
+// Main thread: frames from the requests ring.
+static void serverRingFrames (uv_async_t* handle, int status) {
+  typeServer* server= (typeServer*) handle->data;
+  if (server->closed) return;
+
+  HandleScope scope;
+  char* frame;
+  while ((frame= ringReaderNext(server->shm))) {
+    typeFrameHeader* header= (typeFrameHeader*) frame;
+    typeConnection* conn= shmConnection(server, header->channel);
+
+    if (header->kind == kFrameHello) {
+      // The channel is ours to choose: no two clients get the same
+      std::string path(framePayload(frame), framePayloadLength(frame));
+      typeRing* ring= ring_open(path.c_str());
+      if (ring) {
+        conn= (typeConnection*) calloc(1, sizeof(typeConnection));
+        conn->server= server;
+        conn->ring= ring;
+        uv_mutex_init(&conn->results.queueLock);
+        do conn->channel= ++server->nextChannel;
+        while (!conn->channel || shmConnection(server, conn->channel));
+        conn->refs= 1;
+        conn->next= server->shmConnections;
+        server->shmConnections= conn;
+        server->connections++;
+        char* hello= frameNew(kFrameHello, 0, 0, NULL, 0, NULL, 0);
+        ((typeFrameHeader*) hello)->channel= conn->channel;
+        connectionPush(conn, hello);
       }
+    }
+    else if (header->kind == kFrameBye) {
+      if (conn) connectionClose(conn);
+    }
+    else if (conn) {
+      runRemoteFrame(conn, frame);
+    }
+    free(frame);
+  }
+  reportQueuedBytes();
+}
 
-      free(job->typeEvent.argumentos);
-      queue_push(qitem, freeJobsQueue);
-      thread->dispatchEvents->CallAsFunction(thread->JSObject, 2, args);
+static void serverRingClosed (uv_handle_t* handle) {
+  typeServer* server= (typeServer*) handle->data;
+  ringReaderFree(server->shm);
+  server->shm= NULL;
+  serverRelease(server);
+}
+
+#endif
+
+
+
+
+
+
+static typeServer* isAServer (Handle<Object> receiver) {
+  if (receiver->InternalFieldCount() != 1) return NULL;
+  typeServer* server= (typeServer*) receiver->GetPointerFromInternalField(0);
+  return (server && (server->magicCookie == kServerMagicCookie)) ? server : NULL;
+}
+
+#define kRingDefaultSize (4*1024*1024)
+
+// Whether options (of serve() or connect()) say {transport:'shm'}. Throws if
+// the transport isn't known, or if it's 'shm' and this platform hasn't got it.
+static int wantsShm (Local<Value> options, const char* who, size_t* ringSize) {
+  *ringSize= kRingDefaultSize;
+  if (!options->IsObject()) return 0;
+
+  Local<Object> o= options->ToObject();
+  Local<Value> transport= o->Get(String::NewSymbol("transport"));
+  Local<Value> size= o->Get(String::NewSymbol("ringSize"));
+  if (size->IsNumber() && (size->NumberValue() > 0)) *ringSize= (size_t) size->NumberValue();
+  if (transport->IsUndefined()) return 0;
+
+  std::string name(*String::Utf8Value(transport));
+  if (name == "uds") return 0;
+  std::string msg(who);
+  if (name != "shm") throw strdup((msg+ ": unknown transport '"+ name+ "'").c_str());
+#if defined(WWT_SHM_RING)
+  return 1;
+#else
+  throw strdup((msg+ ": the 'shm' transport is not supported on this platform").c_str());
+#endif
+}
+
+// Threads.serve(threads, path [, options]): see pool.serve()
+static Handle<Value> Serve (const Arguments &args) {
+  HandleScope scope;
+
+  if (!checkGroupThreads(args[0])) {
+    return ThrowException(Exception::Error(String::New("serve(): the pool has been destroyed")));
+  }
+  if (!args[1]->IsString()) {
+    return ThrowException(Exception::TypeError(String::New("serve( path ): path must be a String")));
+  }
+
+  size_t ringSize;
+  int shm;
+  try {
+    shm= wantsShm(args[2], "serve()", &ringSize);
+  }
+  catch (char* err) {
+    Local<Value> error= Exception::Error(String::New(err));
+    free(err);
+    return ThrowException(error);
+  }
+
+  typeServer* server= (typeServer*) calloc(1, sizeof(typeServer));
+  server->magicCookie= kServerMagicCookie;
+  server->path= strdup(*String::Utf8Value(args[1]));
+
+#if defined(WWT_SHM_RING)
+  if (shm) {
+    typeRing* ring= ring_create(server->path, ringSize);
+    if (!ring) {
+      std::string msg("serve(): ");
+      msg+= strerror(errno);
+      free(server->path);
+      free(server);
+      return ThrowException(Exception::Error(String::New(msg.c_str())));
     }
-    else if (job->jobType == kJobTypeEventSerialized) {
-      Local<Value> args[2];
+    server->shm= ringReaderStart(ring, server, serverRingFrames);
+    uv_timer_init(uv_default_loop(), &server->retry);
+    server->retry.data= server;
+    ringTimerEvery(&server->retry, serverRetry, kRingWatchMs);
+    uv_unref((uv_handle_t*) &server->retry);
+  }
+  else
+#endif
+  {
+    uv_pipe_init(uv_default_loop(), &server->pipe, 0);
+    server->pipe.data= server;
+
+    if (uv_pipe_bind(&server->pipe, server->path) ||
+        uv_listen((uv_stream_t*) &server->pipe, 511, serverConnection)) {
+      std::string msg("serve(): ");
+      msg+= uv_strerror(uv_last_error(uv_default_loop()));
+      server->closed= 1;
+      uv_close((uv_handle_t*) &server->pipe, serverClosed);
+      return ThrowException(Exception::Error(String::New(msg.c_str())));
+    }
+  }
 
-      str= job->typeEventSerialized.eventName;
-      args[0]= String::New(**str, (*str).length());
-      delete str;
+  server->threads= Persistent<Array>::New(Local<Array>::Cast(args[0]->ToObject()));
+  server->JSObject= Persistent<Object>::New(serverTemplate->NewInstance());
+  server->JSObject->SetPointerInInternalField(0, server);
+  server->JSObject->Set(String::NewSymbol("path"), args[1]);
+  server->JSObject->Set(String::NewSymbol("transport"), String::New(shm ? "shm" : "uds"));
+  return scope.Close(server->JSObject);
+}
 
-      int len = job->typeEventSerialized.length;
-      Local<Array> array= Array::New(len);
-      args[1]= array;
+// server.close(): stops taking connections. Those open go on until the clients
+// close them, but with {transport:'shm'} they're closed too.
+static Handle<Value> ServerClose (const Arguments &args) {
+  HandleScope scope;
+  typeServer* server= isAServer(args.This());
+  if (!server || server->closed) return Undefined();
+
+  server->closed= 1;
+  server->JSObject->SetPointerInInternalField(0, NULL);
+#if defined(WWT_SHM_RING)
+  if (server->shm) {
+    // Without the requests ring the clients can't say bye: tell them it's over.
+    // If there's no room for the bye, closing their ring tells them too.
+    char* bye= frameNew(kFrameBye, 0, 0, NULL, 0, NULL, 0);
+    while (server->shmConnections) {
+      typeConnection* conn= server->shmConnections;
+      if (!conn->results.length) ring_push(conn->ring, bye, 0);
+      ring_close(conn->ring);
+      connectionClose(conn);
+    }
+    free(bye);
+    uv_close((uv_handle_t*) &server->retry, serverRetryClosed);
+    ringReaderStop(server->shm, serverRingClosed);
+    return Undefined();
+  }
+#endif
+  unlink(server->path);
+  uv_close((uv_handle_t*) &server->pipe, serverClosed);
+  return Undefined();
+}
 
-        {
-          BSON *bson = new BSON();
-          char* data = job->typeEventSerialized.buffer;
-          size_t size = job->typeEventSerialized.bufferSize;
-          BSONDeserializer deserializer(bson, data, size);
-          Local<Object> result = deserializer.DeserializeDocument()->ToObject();
-          int i = 0; do { array->Set(i, result->Get(i)); } while (++i < len);
-          free(data);
-        }
+static Handle<Value> ServerStats (const Arguments &args) {
+  HandleScope scope;
+  typeServer* server= isAServer(args.This());
+  if (!server) {
+    return ThrowException(Exception::Error(String::New("server.stats(): the server has been closed")));
+  }
+
+  Local<Object> stats= Object::New();
+  stats->Set(String::NewSymbol("connections"), Number::New(server->connections));
+  stats->Set(String::NewSymbol("jobs"), Number::New(server->jobs));
+  stats->Set(String::NewSymbol("bytesIn"), Number::New(server->bytesIn));
+  stats->Set(String::NewSymbol("bytesOut"), Number::New(server->bytesOut));
+  return scope.Close(stats);
+}
+
+
+
+
+
+
+// The client end: a pool in another process.
+
+typedef struct {
+  uv_pipe_t pipe;
+  uv_connect_t connectReq;
+  typeFrameReader reader;
+  typeQueue unsent; //Frames queued before the connection is established (shm: or while the server's ring is full)
+  struct typeRing* requests;         //shm: the server's
+  struct typeRingReader* replies;    //shm: ours
+  uv_timer_t retry;                  //shm: pushes the unsent frames, watches the server
+  uint64_t helloAt;                  //shm: when we said hello
+  uint32_t channel;                  //shm: given by the server in its hello
+  int handles;                       //Still to be closed
+  int connected;
+  int closed;
+  uint32_t nextId;
+  long inFlight;
+  Persistent<Object> JSObject;
+  Persistent<Object> any;
+  Persistent<Object> callbacks; //id -> cb
+  unsigned long magicCookie;
+} typeClient;
+
+static typeClient* isAClient (Handle<Object> receiver) {
+  if (receiver->InternalFieldCount() != 1) return NULL;
+  typeClient* client= (typeClient*) receiver->GetPointerFromInternalField(0);
+  return (client && (client->magicCookie == kClientMagicCookie)) ? client : NULL;
+}
+
+
+
+
+
+
+static void clientClosed (uv_handle_t* handle) {
+  typeClient* client= (typeClient*) handle->data;
+  if (--client->handles) return;
+  typeQueueItem* qitem;
+  while ((qitem= queue_pull(&client->unsent))) {
+    free(qitem->asPtr);
+    destroyItem(qitem);
+  }
+  uv_mutex_destroy(&client->unsent.queueLock);
+  frameReaderFree(&client->reader);
+#if defined(WWT_SHM_RING)
+  if (client->replies) {
+    ringReaderFree(client->replies);
+    ring_destroy(client->requests);
+  }
+#endif
+  client->JSObject.Dispose();
+  client->any.Dispose();
+  client->callbacks.Dispose();
+  free(client);
+}
+
+// Fails the callbacks of all the jobs in flight, and closes the connection.
+static void clientClose (typeClient* client, const char* why) {
+  if (client->closed) return;
+  client->closed= 1;
+
+  HandleScope scope;
+  TryCatch onError;
+  client->JSObject->SetPointerInInternalField(0, NULL);
+  client->any->SetPointerInInternalField(0, NULL);
+
+  Local<Object> callbacks= Local<Object>::New(client->callbacks);
+  Local<Array> ids= callbacks->GetOwnPropertyNames();
+  uint32_t i= 0;
+  while (i < ids->Length()) {
+    Local<Value> cb= callbacks->Get(ids->Get(i++));
+    if (!cb->IsFunction()) continue;
+    Local<Value> argv[2];
+    argv[0]= Exception::Error(String::New(why));
+    argv[1]= Local<Value>::New(Null());
+    cb->ToObject()->CallAsFunction(client->JSObject, 2, argv);
+    if (onError.HasCaught()) break;
+  }
+
+#if defined(WWT_SHM_RING)
+  if (client->replies) {
+    char* bye= frameNew(kFrameBye, 0, 0, NULL, 0, NULL, 0);
+    ((typeFrameHeader*) bye)->channel= client->channel;
+    if (client->connected) ring_push(client->requests, bye, 0);
+    free(bye);
+    uv_close((uv_handle_t*) &client->retry, clientClosed);
+    ringReaderStop(client->replies, clientClosed);
+  }
+  else
+#endif
+  uv_close((uv_handle_t*) &client->pipe, clientClosed);
+  if (onError.HasCaught()) node::FatalException(onError);
+}
+
+
+
+
+
+
+static void clientInFlight (typeClient* client, long delta) {
+  client->inFlight+= delta;
+  // An idle connection doesn't keep the process alive
+  uv_handle_t* handle= (uv_handle_t*) &client->pipe;
+#if defined(WWT_SHM_RING)
+  if (client->replies) handle= (uv_handle_t*) &client->replies->async;
+#endif
+  if (client->inFlight) uv_ref(handle);
+  else uv_unref(handle);
+}
+
+static void clientResult (typeClient* client, char* frame) {
+  typeFrameHeader* header= (typeFrameHeader*) frame;
+  Local<Object> callbacks= Local<Object>::New(client->callbacks);
+  Local<Value> cb= callbacks->Get(header->id);
+  if (!cb->IsFunction()) return;
+  callbacks->Delete(header->id);
+  clientInFlight(client, -1);
+
+  Local<Value> argv[2];
+  argv[0]= Local<Value>::New(Null());
+  argv[1]= Local<Value>::New(Null());
+  size_t length= framePayloadLength(frame);
+
+  if (header->kind == kFrameResult) {
+    try {
+      argv[1]= deserialize(framePayload(frame), length)->Get(0);
+    }
+    catch (char* err) {
+      argv[0]= Exception::Error(String::New(err));
+      free(err);
+    }
+  }
+  else if (header->kind == kFrameResultText) {
+    argv[1]= String::New(framePayload(frame), (int) length);
+  }
+  else {
+    argv[0]= Exception::Error(String::New(framePayload(frame), (int) length));
+  }
+
+  cb->ToObject()->CallAsFunction(client->JSObject, 2, argv);
+}
+
+static uv_buf_t clientAlloc (uv_handle_t* handle, size_t suggested) {
+  typeClient* client= (typeClient*) handle->data;
+  size_t size= 0;
+  char* room= frameReaderRoom(&client->reader, suggested, &size);
+  return uv_buf_init(room, room ? (unsigned int) size : 0);
+}
+
+static void clientRead (uv_stream_t* stream, ssize_t nread, uv_buf_t buf) {
+  typeClient* client= (typeClient*) stream->data;
+
+  if (nread < 0) {
+    clientClose(client, "connect(): the connection has been closed");
+    return;
+  }
+  frameReaderCommit(&client->reader, nread);
 
-      queue_push(qitem, freeJobsQueue);
-      thread->dispatchEvents->CallAsFunction(thread->JSObject, 2, args);
+  HandleScope scope;
+  TryCatch onError;
+  char* frame;
+  int bad= 0;
+  while (!client->closed && (frame= frameReaderNext(&client->reader, &bad))) {
+    clientResult(client, frame);
+    if (onError.HasCaught()) {
+      node::FatalException(onError);
+      return;
     }
   }
+  if (bad) clientClose(client, "connect(): bad frame received");
 }
 
+#if defined(WWT_SHM_RING)
 
+static void clientRetry (uv_timer_t* handle, int status);
 
+// shm: pushes the frames that are waiting, in order, as long as there's room
+// in the server's ring. Until the server says hello back, they all wait.
+static void clientFlush (typeClient* client) {
+  if (client->closed) return;
+  typeQueueItem* qitem;
+  while (client->connected && (qitem= queue_pull(&client->unsent))) {
+    char* frame= (char*) qitem->asPtr;
+    ((typeFrameHeader*) frame)->channel= client->channel;
+    int err= ring_push(client->requests, frame, 0);
+    if (err == -3) {
+      stack_push(qitem, &client->unsent);
+      break;
+    }
+    free(frame);
+    destroyItem(qitem);
+    if (err) {
+      clientClose(client, "connect(): the server has been closed");
+      return;
+    }
+  }
+  ringTimerEvery(&client->retry, clientRetry, (client->connected && client->unsent.length) ? kRingRetryMs : kRingWatchMs);
+}
 
+static void clientRetry (uv_timer_t* handle, int status) {
+  typeClient* client= (typeClient*) handle->data;
+  if (!ring_owner_alive(client->requests)) {
+    clientClose(client, "connect(): the server has died");
+  }
+  else if (!client->connected && (uv_now(uv_default_loop())- client->helloAt >= kRingWaitMs* 10)) {
+    clientClose(client, "connect(): the server hasn't said hello back");
+  }
+  else clientFlush(client);
+}
 
+// Main thread: frames from our results ring.
+static void clientRingFrames (uv_async_t* handle, int status) {
+  typeClient* client= (typeClient*) handle->data;
 
-// unconditionally destroys a thread by brute force.
-static Handle<Value> Destroy (const Arguments &args) {
   HandleScope scope;
-  //TODO: Hay que comprobar que this en un objeto y que tiene hiddenRefTotypeThread_symbol y que no es nil
-  //TODO: Aquí habría que usar static void TerminateExecution(int thread_id);
-  //TODO: static void v8::V8::TerminateExecution  ( Isolate *   isolate= NULL   )   [static]
-
-  typeThread* thread= isAThread(args.This());
-  if (!thread) {
-    return ThrowException(Exception::TypeError(String::New("thread.destroy(): the receiver must be a thread object")));
+  TryCatch onError;
+  char* frame;
+  while (!client->closed && (frame= ringReaderNext(client->replies))) {
+    uint32_t kind= ((typeFrameHeader*) frame)->kind;
+    if (kind == kFrameBye) clientClose(client, "connect(): the server has been closed");
+    else if (kind == kFrameHello) {
+      client->channel= ((typeFrameHeader*) frame)->channel;
+      client->connected= 1;
+      clientFlush(client);
+    }
+    else clientResult(client, frame);
+    free(frame);
+    if (onError.HasCaught()) {
+      node::FatalException(onError);
+      return;
+    }
   }
+  if (!client->closed && client->replies->ring->header->closed) {
+    clientClose(client, "connect(): the connection has been closed");
+  }
+}
 
-  if (!thread->sigkill) {
-    //pthread_cancel(thread->thread);
-    thread->sigkill= 1;
-    uv_mutex_lock(&thread->IDLE_mutex);
-    if (thread->IDLE) {
-      uv_cond_signal(&thread->IDLE_cv);
-    }
-    uv_mutex_unlock(&thread->IDLE_mutex);
+#endif
+
+static void clientConnected (uv_connect_t* req, int status) {
+  typeClient* client= (typeClient*) req->data;
+  if (client->closed) return;
+
+  if (status) {
+    std::string msg("connect(): ");
+    msg+= uv_strerror(uv_last_error(uv_default_loop()));
+    clientClose(client, msg.c_str());
+    return;
   }
 
-  return Undefined();
+  client->connected= 1;
+  typeQueueItem* qitem;
+  while ((qitem= queue_pull(&client->unsent))) {
+    writeFrame((uv_stream_t*) &client->pipe, (char*) qitem->asPtr);
+    destroyItem(qitem);
+  }
+  uv_read_start((uv_stream_t*) &client->pipe, clientAlloc, clientRead);
 }
 
 
@@ -604,61 +5088,199 @@ static Handle<Value> Destroy (const Arguments &args) {
 
 
 
-// Eval: Pushes a job into the thread's ->inQueue.
-static Handle<Value> Eval (const Arguments &args) {
+static Handle<Value> clientSend (typeClient* client, char* frame, Local<Value> cb) {
+  if (!frame) {
+    return ThrowException(Exception::Error(String::New("connect(): the job is too big")));
+  }
+
+  uint32_t id= ((typeFrameHeader*) frame)->id;
+  if (cb->IsFunction()) {
+    client->callbacks->Set(id, cb);
+    clientInFlight(client, 1);
+  }
+
+#if defined(WWT_SHM_RING)
+  if (client->replies) {
+    // The main thread doesn't wait for room in the server's ring: while it's
+    // full the jobs wait in client->unsent, and clientRetry() pushes them.
+    if (!ring_fits(client->requests, frame)) {
+      free(frame);
+      if (cb->IsFunction()) {
+        client->callbacks->Delete(id);
+        clientInFlight(client, -1);
+      }
+      return ThrowException(Exception::Error(String::New("connect(): the job is too big for the ring")));
+    }
+    queue_push(nuItem(kItemTypePointer, frame), &client->unsent);
+    clientFlush(client);
+    return Undefined();
+  }
+#endif
+  if (client->connected) {
+    if (writeFrame((uv_stream_t*) &client->pipe, frame)) {
+      clientClose(client, "connect(): the connection has been closed");
+    }
+  }
+  else {
+    queue_push(nuItem(kItemTypePointer, frame), &client->unsent);
+  }
+  return Undefined();
+}
+
+// remotePool.call(functionName [, args] [, cb]): like thread.call(), but the
+// typed arrays in args are copied.
+static Handle<Value> ClientCall (const Arguments &args) {
   HandleScope scope;
 
+  typeClient* client= isAClient(args.This());
+  if (!client) {
+    return ThrowException(Exception::Error(String::New("connect(): the connection has been closed")));
+  }
   if (!args.Length()) {
-    return ThrowException(Exception::TypeError(String::New("thread.eval(program [,callback]): missing arguments")));
+    return ThrowException(Exception::TypeError(String::New("remotePool.call(functionName [, args] [, callback]): missing arguments")));
   }
 
-  typeThread* thread= isAThread(args.This());
-  if (!thread) {
-    return ThrowException(Exception::TypeError(String::New("thread.eval(): the receiver must be a thread object")));
+  int cbIndex= args.Length()- 1;
+  int tiene_callBack= (cbIndex > 0) && args[cbIndex]->IsFunction();
+  Local<Array> argv;
+  if ((args.Length() > 1) && args[1]->IsArray()) {
+    argv= Local<Array>::Cast(args[1]->ToObject());
+  }
+  else {
+    argv= Array::New((args.Length() > 1) && !(tiene_callBack && (cbIndex == 1)) ? 1 : 0);
+    if (argv->Length()) argv->Set(0, args[1]);
   }
 
-  typeQueueItem* qitem= nuJobQueueItem();
-  typeJob* job= (typeJob*) qitem->asPtr;
+  size_t size;
+  char* buffer;
+  try {
+    buffer= serialize(argv, &size);
+  }
+  catch (char* err) {
+    Local<Value> error= Exception::Error(String::New(err));
+    free(err);
+    return ThrowException(error);
+  }
 
-  job->typeEval.tiene_callBack= ((args.Length() > 1) && (args[1]->IsFunction()));
-  if (job->typeEval.tiene_callBack) {
-    job->cb= Persistent<Object>::New(args[1]->ToObject());
+  String::Utf8Value fnName(args[0]);
+  char* frame= frameNew(kFrameCall, client->nextId++, argv->Length(), *fnName, fnName.length(), buffer, size);
+  free(buffer);
+  clientSend(client, frame, tiene_callBack ? args[cbIndex] : Local<Value>::New(Undefined()));
+  return scope.Close(args.This());
+}
+
+// remotePool.eval(program [, cb])
+static Handle<Value> ClientEval (const Arguments &args) {
+  HandleScope scope;
+
+  typeClient* client= isAClient(args.This());
+  if (!client) {
+    return ThrowException(Exception::Error(String::New("connect(): the connection has been closed")));
   }
-  job->typeEval.scriptText_StringObject= new String::Utf8Value(args[0]);
-  job->typeEval.useStringObject= 1;
-  job->jobType= kJobTypeEval;
 
-  pushToInQueue(qitem, thread);
+  String::Utf8Value source(args[0]);
+  char* frame= frameNew(kFrameEval, client->nextId++, 0, NULL, 0, *source, source.length());
+  clientSend(client, frame, args[1]);
   return scope.Close(args.This());
 }
 
+static Handle<Value> ClientDestroy (const Arguments &args) {
+  HandleScope scope;
+  typeClient* client= isAClient(args.This());
+  if (client) clientClose(client, "connect(): the connection has been closed");
+  return Undefined();
+}
+
+static Handle<Value> ClientPendingJobs (const Arguments &args) {
+  HandleScope scope;
+  typeClient* client= isAClient(args.This());
+  return scope.Close(Number::New(client ? client->inFlight : 0));
+}
+
+// Threads.connect(path [, options]): a pool served by another process with pool.serve(path [, options]).
+static Handle<Value> Connect (const Arguments &args) {
+  HandleScope scope;
 
+  if (!args[0]->IsString()) {
+    return ThrowException(Exception::TypeError(String::New("connect( path ): path must be a String")));
+  }
 
+  size_t ringSize;
+  int shm;
+  try {
+    shm= wantsShm(args[1], "connect()", &ringSize);
+  }
+  catch (char* err) {
+    Local<Value> error= Exception::Error(String::New(err));
+    free(err);
+    return ThrowException(error);
+  }
 
+  String::Utf8Value path(args[0]);
+  typeClient* client= (typeClient*) calloc(1, sizeof(typeClient));
+
+#if defined(WWT_SHM_RING)
+  if (shm) {
+    static uint32_t clients= 0;
+    char name[64];
+    typeRing* replies= NULL;
+    client->requests= ring_open(*path);
+    if (client->requests) {
+      snprintf(name, sizeof(name), ".%d.%u", (int) wwt_getpid(), clients++);
+      replies= ring_create((std::string(*path)+ name).c_str(), ringSize);
+    }
+    if (!replies) {
+      std::string msg("connect(): ");
+      msg+= strerror(errno);
+      if (client->requests) ring_destroy(client->requests);
+      free(client);
+      return ThrowException(Exception::Error(String::New(msg.c_str())));
+    }
 
-static char* readFile (Handle<String> path) {
-  v8::String::Utf8Value c_str(path);
-  FILE* fp= fopen(*c_str, "rb");
-  if (!fp) {
-    fprintf(stderr, "Error opening the file %s\n", *c_str);
-    //@bruno: Shouldn't we throw, here ?
-    return NULL;
+    char* hello= frameNew(kFrameHello, 0, 0, NULL, 0, replies->path, strlen(replies->path));
+    int err= ring_push(client->requests, hello, kRingWaitMs* 10);
+    free(hello);
+    if (err) {
+      ring_destroy(replies);
+      ring_destroy(client->requests);
+      free(client);
+      return ThrowException(Exception::Error(String::New("connect(): the server isn't taking connections")));
+    }
+    client->replies= ringReaderStart(replies, client, clientRingFrames);
+    client->helloAt= uv_now(uv_default_loop());
+    uv_timer_init(uv_default_loop(), &client->retry);
+    client->retry.data= client;
+    client->handles= 1;
   }
-  fseek(fp, 0, SEEK_END);
-  size_t len= ftell(fp);
-  rewind(fp); //fseek(fp, 0, SEEK_SET);
-  char *buf= (char*)malloc((len+1) * sizeof(char)); // +1 to get null terminated string
-  if (fread(buf, sizeof(char), len, fp) < len) {
-    fprintf(stderr, "Error reading the file %s\n", *c_str);
-    return NULL;
+#endif
+
+  client->magicCookie= kClientMagicCookie;
+  client->handles++;
+  uv_mutex_init(&client->unsent.queueLock);
+  client->callbacks= Persistent<Object>::New(Object::New());
+  client->JSObject= Persistent<Object>::New(clientTemplate->NewInstance());
+  client->JSObject->SetPointerInInternalField(0, client);
+  client->any= Persistent<Object>::New(clientTemplate->NewInstance());
+  client->any->SetPointerInInternalField(0, client);
+  client->JSObject->Set(String::NewSymbol("any"), client->any);
+  client->JSObject->Set(String::NewSymbol("transport"), String::New(shm ? "shm" : "uds"));
+
+  if (shm) {
+    clientInFlight(client, 0);
+#if defined(WWT_SHM_RING)
+    ringTimerEvery(&client->retry, clientRetry, kRingWatchMs);
+    uv_unref((uv_handle_t*) &client->retry);
+#endif
+    return scope.Close(client->JSObject);
   }
-  buf[len] = 0;
-  fclose(fp);
-  /*
-  printf("SOURCE:\n%s\n", buf);
-  fflush(stdout);
-  */
-  return buf;
+
+  uv_pipe_init(uv_default_loop(), &client->pipe, 0);
+  client->pipe.data= client;
+  client->connectReq.data= client;
+  uv_pipe_connect(&client->connectReq, &client->pipe, *path, clientConnected);
+  uv_unref((uv_handle_t*) &client->pipe);
+
+  return scope.Close(client->JSObject);
 }
 
 
@@ -666,7 +5288,7 @@ static char* readFile (Handle<String> path) {
 
 
 
-// Load: Loads from file and passes to Eval
+// Load: Queues an eval of the file's contents. The file is read in the thread.
 static Handle<Value> Load (const Arguments &args) {
   HandleScope scope;
 
@@ -679,8 +5301,14 @@ static Handle<Value> Load (const Arguments &args) {
     return ThrowException(Exception::TypeError(String::New("thread.load(): the receiver must be a thread object")));
   }
 
-  char* source= readFile(args[0]->ToString());  //@Bruno: here we don't know if the file was not found or if it was an empty file
-  if (!source) return scope.Close(args.This()); //@Bruno: even if source is empty, we should call the callback ?
+  if (thread->sigkill) {
+    return ThrowException(Exception::Error(String::New(kThreadDestroyed)));
+  }
+
+  if (queueIsFull()) return throwQueueFull("thread.load()");
+
+  // The thread reads the file: the job carries just its path
+  char* path= strdup(*String::Utf8Value(args[0]));
 
   typeQueueItem* qitem= nuJobQueueItem();
   typeJob* job= (typeJob*) qitem->asPtr;
@@ -689,11 +5317,18 @@ static Handle<Value> Load (const Arguments &args) {
   if (job->typeEval.tiene_callBack) {
     job->cb= Persistent<Object>::New(args[1]->ToObject());
   }
-  job->typeEval.scriptText_CharPtr= source;
+  job->typeEval.resultado= NULL;
+  job->typeEval.scriptText_CharPtr= path;
   job->typeEval.useStringObject= 0;
+  job->typeEval.loadPath= 1;
   job->jobType= kJobTypeEval;
+  // The main thread doesn't touch the file, not even to stat() it: the thread
+  // accounts its bytes while it holds them.
+  jobAccount(thread, job, strlen(path));
+  if (recorder && !thread->pooled) record_job(kRecordLoad, kRecordThread, thread->id, path, strlen(path), NULL, 0);
 
   pushToInQueue(qitem, thread);
+  reportQueuedBytes();
 
   return scope.Close(args.This());
 }
@@ -715,6 +5350,12 @@ static Handle<Value> processEmit (const Arguments &args) {
     return ThrowException(Exception::TypeError(String::New("thread.emit(): the receiver must be a thread object")));
   }
 
+  if (thread->sigkill) {
+    return ThrowException(Exception::Error(String::New(kThreadDestroyed)));
+  }
+
+  if (queueIsFull()) return throwQueueFull("thread.emit()");
+
   typeQueueItem* qitem= nuJobQueueItem();
   typeJob* job= (typeJob*) qitem->asPtr;
 
@@ -723,12 +5364,17 @@ static Handle<Value> processEmit (const Arguments &args) {
   job->typeEvent.eventName= new String::Utf8Value(args[0]);
   job->typeEvent.argumentos= (v8::String::Utf8Value**) malloc(job->typeEvent.length* sizeof(void*));
 
+  long bytes= job->typeEvent.eventName->length();
   int i= 1;
   do {
     job->typeEvent.argumentos[i-1]= new String::Utf8Value(args[i]);
+    bytes+= job->typeEvent.argumentos[i-1]->length();
   } while (++i <= job->typeEvent.length);
+  jobAccount(thread, job, bytes);
+  if (recorder && !thread->pooled) recordEmit(thread, job->typeEvent.eventName, args);
 
   pushToInQueue(qitem, thread);
+  reportQueuedBytes();
 
   return scope.Close(args.This());
 }
@@ -746,6 +5392,12 @@ static Handle<Value> processEmitSerialized (const Arguments &args) {
     return ThrowException(Exception::TypeError(String::New("thread.emit(): the receiver must be a thread object")));
   }
 
+  if (thread->sigkill) {
+    return ThrowException(Exception::Error(String::New(kThreadDestroyed)));
+  }
+
+  if (queueIsFull()) return throwQueueFull("thread.emitSerialized()");
+
   typeQueueItem* qitem= nuJobQueueItem();
   typeJob* job= (typeJob*) qitem->asPtr;
 
@@ -757,7 +5409,7 @@ static Handle<Value> processEmitSerialized (const Arguments &args) {
 
     {
       char* buffer;
-      BSON *bson = new BSON();
+      BSON *bson = isolateBSON();
       size_t object_size;
       Local<Object> object = bson->GetSerializeObject(array);
       BSONSerializer<CountStream> counter(bson, false, false);
@@ -769,8 +5421,11 @@ static Handle<Value> processEmitSerialized (const Arguments &args) {
       job->typeEventSerialized.buffer= buffer;
       job->typeEventSerialized.bufferSize= object_size;
     }
+  jobAccount(thread, job, job->typeEventSerialized.bufferSize+ job->typeEventSerialized.eventName->length());
+  if (recorder && !thread->pooled) recordEmit(thread, job->typeEventSerialized.eventName, args);
 
   pushToInQueue(qitem, thread);
+  reportQueuedBytes();
 
   return scope.Close(args.This());
 }
@@ -795,7 +5450,7 @@ static Handle<Value> processEmitSerialized (const Arguments &args) {
  \
     { \
       char* buffer; \
-      BSON *bson = new BSON(); \
+      BSON *bson = isolateBSON(); \
       size_t object_size; \
       Local<Object> object = bson->GetSerializeObject(array); \
       BSONSerializer<CountStream> counter(bson, false, false); \
@@ -808,6 +5463,8 @@ static Handle<Value> processEmitSerialized (const Arguments &args) {
       job->typeEventSerialized.bufferSize= object_size; \
     } \
  \
+  waitForQueueRoom(thread); \
+  jobAccount(thread, job, job->typeEventSerialized.bufferSize+ job->typeEventSerialized.eventName->length()); \
   queue_push(qitem, &thread->outQueue); \
   if (!(thread->inQueue.length)) uv_async_send(&thread->async_watcher); \
  \
@@ -822,6 +5479,28 @@ static Handle<Value> postError (const Arguments &args) {
   POST_EVENT("error");
 }
 
+// thread.parseJSON(string | Buffer): JSON.parse() that reads a Buffer (or a
+// typed array lent by the main thread) as utf8 without a string detour in JS.
+static Handle<Value> threadParseJSON (const Arguments &args) {
+  HandleScope scope;
+
+  Local<Value> text= args[0];
+  if (text->IsObject() && text->ToObject()->HasIndexedPropertiesInExternalArrayData()) {
+    Local<Object> buffer= text->ToObject();
+    text= String::New((char*) buffer->GetIndexedPropertiesExternalArrayData(), (int) ExternalArrayByteLength(buffer));
+  }
+
+  Local<Object> json= Context::GetCurrent()->Global()->Get(String::NewSymbol("JSON"))->ToObject();
+  Local<Function> parse= Local<Function>::Cast(json->Get(String::NewSymbol("parse")));
+  Handle<Value> argv[1]= { text };
+  return scope.Close(parse->Call(json, 1, argv));
+}
+
+
+
+
+
+
 static Handle<Value> threadEmit (const Arguments &args) {
   HandleScope scope;
 
@@ -840,11 +5519,15 @@ static Handle<Value> threadEmit (const Arguments &args) {
   job->typeEvent.eventName= new String::Utf8Value(args[0]);
   job->typeEvent.argumentos= (v8::String::Utf8Value**) malloc(job->typeEvent.length* sizeof(void*));
 
+  long bytes= job->typeEvent.eventName->length();
   i= 1;
   do {
     job->typeEvent.argumentos[i-1]= new String::Utf8Value(args[i]);
+    bytes+= job->typeEvent.argumentos[i-1]->length();
   } while (++i <= job->typeEvent.length);
 
+  waitForQueueRoom(thread);
+  jobAccount(thread, job, bytes);
   queue_push(qitem, &thread->outQueue);
   if (!(thread->inQueue.length)) uv_async_send(&thread->async_watcher); // wake up callback
 
@@ -860,6 +5543,355 @@ static Handle<Value> threadEmit (const Arguments &args) {
 
 
 
+// thread.queuedBytes(): payload bytes of this thread's pending jobs and events.
+static Handle<Value> QueuedBytes (const Arguments &args) {
+  HandleScope scope;
+
+  typeThread* thread= isAThread(args.This());
+  if (!thread) {
+    return ThrowException(Exception::TypeError(String::New("thread.queuedBytes(): the receiver must be a thread object")));
+  }
+
+  return scope.Close(Number::New(atomic_read(&thread->queuedBytes)));
+}
+
+
+
+
+
+
+// A key that was never handed to thread.call()
+static void freeMemoKey (Persistent<Value> object, void* data) {
+  typeMemoKey* key= (typeMemoKey*) object->ToObject()->GetPointerFromInternalField(0);
+  if (key) memo_key_free(key);
+  object.Dispose();
+  object.Clear();
+}
+
+// memoLookup(scope, fnName, args, memoize, coalesce): [result] if it's in the cache,
+// else the key to pass to thread.call(fnName, args, key, cb) so that the result is
+// stored. Without memoize it just makes the key. With coalesce key.id identifies
+// the call, see { coalesce: true } in createPool.ls: it's the whole key, so two
+// calls have the same id only if their keys are the same, byte for byte.
+static Handle<Value> MemoLookup (const Arguments &args) {
+  HandleScope scope;
+
+  Local<Array> argv;
+  if (args[2]->IsArray()) {
+    argv= Local<Array>::Cast(args[2]->ToObject());
+  }
+  else {
+    argv= Array::New(args[2]->IsUndefined() ? 0 : 1);
+    if (argv->Length()) argv->Set(0, args[2]);
+  }
+
+  char* buffer;
+  size_t bufferSize;
+  try {
+    buffer= serialize(argv, &bufferSize);
+  }
+  catch (char* err) {
+    Local<Value> error= Exception::Error(String::New(err));
+    free(err);
+    return ThrowException(error);
+  }
+
+  String::Utf8Value scopeName(args[0]);
+  String::Utf8Value fnName(args[1]);
+  typeMemoKey* key= (typeMemoKey*) malloc(sizeof(typeMemoKey));
+  key->argsOffset= scopeName.length()+ 1+ fnName.length()+ 1;
+  key->length= key->argsOffset+ bufferSize;
+  key->bytes= (char*) malloc(key->length);
+  key->argc= argv->Length();
+  memcpy(key->bytes, *scopeName, scopeName.length()+ 1);
+  memcpy(key->bytes+ scopeName.length()+ 1, *fnName, fnName.length()+ 1);
+  memcpy(key->bytes+ key->argsOffset, buffer, bufferSize);
+  key->hash= memoHash(key->bytes, key->length);
+  key->store= args[3]->BooleanValue();
+  free(buffer);
+
+  size_t valueLength;
+  char* value= key->store ? memo_get(key, &valueLength) : NULL;
+  if (value) {
+    memo_key_free(key);
+    Local<Object> result;
+    try {
+      result= deserialize(value, valueLength);
+    }
+    catch (char* err) {
+      free(value);
+      Local<Value> error= Exception::Error(String::New(err));
+      free(err);
+      return ThrowException(error);
+    }
+    free(value);
+    Local<Array> found= Array::New(1);
+    found->Set(0, result->Get(0));
+    return scope.Close(found);
+  }
+
+  Local<Object> JSObject= memoKeyTemplate->NewInstance();
+  JSObject->SetPointerInInternalField(0, key);
+  JSObject->SetHiddenValue(memo_symbol, True());
+  if (args[4]->BooleanValue()) {
+    // Its length, then its bytes two by two: any uint16_t goes in a String
+    size_t units= 4+ (key->length+ 1)/ 2;
+    uint16_t* id= (uint16_t*) calloc(units, sizeof(uint16_t));
+    uint64_t length= key->length;
+    int i;
+    for (i= 0; i < 4; i++) id[i]= (uint16_t) (length >> (16* i));
+    memcpy(id+ 4, key->bytes, key->length);
+    JSObject->Set(id_symbol, String::New(id, (int) units));
+    free(id);
+  }
+  Persistent<Object>::New(JSObject).MakeWeak(NULL, freeMemoKey);
+  return scope.Close(JSObject);
+}
+
+static Handle<Value> MemoStats (const Arguments &args) {
+  HandleScope scope;
+
+  long entries, bytes;
+  memo_usage(&entries, &bytes);
+  double hits= atomic_read(&memoHits);
+  double lookups= hits+ atomic_read(&memoMisses);
+
+  Local<Object> stats= Object::New();
+  stats->Set(String::NewSymbol("hits"), Number::New(hits));
+  stats->Set(String::NewSymbol("misses"), Number::New(lookups- hits));
+  stats->Set(String::NewSymbol("hitRate"), Number::New(lookups ? hits/ lookups : 0));
+  stats->Set(String::NewSymbol("stores"), Number::New(atomic_read(&memoStores)));
+  stats->Set(String::NewSymbol("evictions"), Number::New(atomic_read(&memoEvictions)));
+  stats->Set(String::NewSymbol("entries"), Number::New(entries));
+  stats->Set(String::NewSymbol("bytes"), Number::New(bytes));
+  stats->Set(String::NewSymbol("limit"), Number::New(atomic_read(&memoLimit)));
+  return scope.Close(stats);
+}
+
+// setMemoLimit(bytes): bounds the memoize cache, 0 empties and disables it.
+static Handle<Value> SetMemoLimit (const Arguments &args) {
+  HandleScope scope;
+
+  double limit= args.Length() ? args[0]->NumberValue() : -1;
+  if (!(limit >= 0)) {
+    return ThrowException(Exception::TypeError(String::New("setMemoLimit( bytes ): bytes must be a Number >= 0")));
+  }
+
+  memo_set_limit((long) limit);
+  return Undefined();
+}
+
+
+
+
+
+
+// setQueueLimit(bytes): soft limit for the bytes queued by all the threads, 0 disables it.
+static Handle<Value> SetQueueLimit (const Arguments &args) {
+  HandleScope scope;
+
+  double limit= args.Length() ? args[0]->NumberValue() : 0;
+  if (!(limit >= 0)) {
+    return ThrowException(Exception::TypeError(String::New("setQueueLimit( bytes ): bytes must be a Number >= 0")));
+  }
+
+  queuedBytesLimit= (long) limit;
+  uv_mutex_lock(&queueRoomMutex);
+  uv_cond_broadcast(&queueRoomCV);
+  uv_mutex_unlock(&queueRoomMutex);
+
+  return Undefined();
+}
+
+
+
+
+
+
+// setStallThreshold(ms): a job running for longer than ms makes its thread
+// emit a 'stall' event, see stallMonitor(). 0 stops watching.
+static Handle<Value> SetStallThreshold (const Arguments &args) {
+  HandleScope scope;
+
+  double ms= args.Length() ? args[0]->NumberValue() : 0;
+  if (!(ms >= 0)) {
+    return ThrowException(Exception::TypeError(String::New("setStallThreshold( ms ): ms must be a Number >= 0")));
+  }
+
+  uv_mutex_lock(&stallLock);
+  atomic_add(&stallThresholdMs, (long) ms- atomic_read(&stallThresholdMs));
+  if (ms && !stallRunning) {
+    stallRunning= 1;
+    uv_thread_create(&stallThread, stallMonitor, NULL);
+  }
+  uv_cond_signal(&stallCV);
+  uv_mutex_unlock(&stallLock);
+
+  return Undefined();
+}
+
+
+
+
+
+
+// startRecording(path): from now on every job submitted to a thread or a pool
+// is appended to the log at path, see recorder.cc.
+static Handle<Value> StartRecording (const Arguments &args) {
+  HandleScope scope;
+
+  if (!args.Length() || !args[0]->IsString()) {
+    return ThrowException(Exception::TypeError(String::New("startRecording( path ): path must be a String")));
+  }
+
+  String::Utf8Value path(args[0]);
+  if (record_start(*path, (double) time(NULL)* 1e3)) {
+    std::string msg("startRecording(): can't write ");
+    msg+= *path;
+    msg+= ": ";
+    msg+= strerror(errno);
+    return ThrowException(Exception::Error(String::New(msg.c_str())));
+  }
+  return Undefined();
+}
+
+// stopRecording(): closes the log. Returns how many jobs and bytes went in it.
+static Handle<Value> StopRecording (const Arguments &args) {
+  HandleScope scope;
+
+  record_stop();
+  Local<Object> result= Object::New();
+  result->Set(String::NewSymbol("jobs"), Number::New(recordedJobs));
+  result->Set(String::NewSymbol("bytes"), Number::New(recordedBytes));
+  return scope.Close(result);
+}
+
+// recordJob(type, origin, target, name [, args]): how createPool.js records
+// the jobs submitted to a pool. Its threads don't record them again.
+static Handle<Value> RecordJob (const Arguments &args) {
+  if (!recorder) return Undefined();
+  HandleScope scope;
+
+  String::Utf8Value name(args[3]);
+  Local<Value> values= args[4];
+  if (!values->IsArray() && !values->IsUndefined()) {
+    Local<Array> array= Array::New(1);
+    array->Set(0, values);
+    values= array;
+  }
+  recordArgs(args[0]->Int32Value(), args[1]->Int32Value(), (long) args[2]->IntegerValue(), *name, name.length(), values);
+  return Undefined();
+}
+
+// readRecording(path): { startedAt, records: [{ type, origin, target, at, name [, args] }...] }
+static Handle<Value> ReadRecording (const Arguments &args) {
+  HandleScope scope;
+  static const char* types[]= { "", "eval", "emit", "call", "load" };
+  static const char* origins[]= { "thread", "any", "all" };
+
+  String::Utf8Value path(args[0]);
+  typeRecordHeader header;
+  FILE* file= record_open(*path, &header);
+  if (!file) {
+    std::string msg("readRecording(): can't read ");
+    msg+= *path;
+    msg+= ": ";
+    msg+= strerror(errno);
+    return ThrowException(Exception::Error(String::New(msg.c_str())));
+  }
+
+  Local<Array> records= Array::New();
+  typeRecord record;
+  char* data;
+  uint32_t i= 0;
+  while (record_next(file, &record, &data)) {
+    Local<Object> o= Object::New();
+    o->Set(String::NewSymbol("type"), String::New(record.type <= kRecordLoad ? types[record.type] : ""));
+    o->Set(String::NewSymbol("origin"), String::New(record.origin <= kRecordPoolAll ? origins[record.origin] : ""));
+    o->Set(String::NewSymbol("target"), Number::New(record.target));
+    o->Set(String::NewSymbol("at"), Number::New(record.at/ 1e3));
+    o->Set(String::NewSymbol("name"), String::New(data, record.nameLength));
+    if (record.length > record.nameLength) {
+      try {
+        Local<Object> values= deserialize(data+ record.nameLength, record.length- record.nameLength);
+        uint32_t length= values->GetOwnPropertyNames()->Length();
+        Local<Array> array= Array::New(length);
+        uint32_t j= 0;
+        while (j < length) {
+          array->Set(j, values->Get(j));
+          j++;
+        }
+        o->Set(String::NewSymbol("args"), array);
+      }
+      catch (char* err) {
+        free(err);
+      }
+    }
+    free(data);
+    records->Set(i++, o);
+  }
+  fclose(file);
+
+  Local<Object> result= Object::New();
+  result->Set(String::NewSymbol("startedAt"), Number::New(header.startedAt));
+  result->Set(String::NewSymbol("records"), records);
+  return scope.Close(result);
+}
+
+
+
+
+
+
+// setFreeListLimits(highWater, lowWater): bounds of the jobs and items free lists.
+static Handle<Value> SetFreeListLimits (const Arguments &args) {
+  HandleScope scope;
+
+  double high= args.Length() > 0 ? args[0]->NumberValue() : -1;
+  double low= args.Length() > 1 ? args[1]->NumberValue() : 0;
+  if (!(high >= 0) || !(low >= 0) || (low > high)) {
+    return ThrowException(Exception::TypeError(String::New("setFreeListLimits( highWater, lowWater ): must be Numbers and 0 <= lowWater <= highWater")));
+  }
+
+  freeListHighWater= (long int) high;
+  freeListLowWater= (long int) low;
+
+  return Undefined();
+}
+
+
+
+
+
+
+static Handle<Value> Stats (const Arguments &args) {
+  HandleScope scope;
+
+  Local<Object> stats= Object::New();
+  stats->Set(String::NewSymbol("queuedBytes"), Number::New(atomic_read(&queuedBytesTotal)));
+  stats->Set(String::NewSymbol("queueLimit"), Number::New(queuedBytesLimit));
+  stats->Set(String::NewSymbol("queueRejected"), Number::New(queueRejected));
+  stats->Set(String::NewSymbol("queueWaits"), Number::New(atomic_read(&queueWaits)));
+  stats->Set(String::NewSymbol("freeThreads"), Number::New(freeThreadsQueue->length));
+  stats->Set(String::NewSymbol("freeJobs"), Number::New(freeJobsQueue->length));
+  stats->Set(String::NewSymbol("freeItems"), Number::New(freeItemsQueue->length));
+  stats->Set(String::NewSymbol("freeListHighWater"), Number::New(freeListHighWater));
+  stats->Set(String::NewSymbol("freeListLowWater"), Number::New(freeListLowWater));
+  stats->Set(String::NewSymbol("stallThreshold"), Number::New(atomic_read(&stallThresholdMs)));
+  stats->Set(String::NewSymbol("stalls"), Number::New(atomic_read(&stallsTotal)));
+  stats->Set(String::NewSymbol("recording"), Boolean::New(recorder != NULL));
+  stats->Set(String::NewSymbol("recordedJobs"), Number::New(recordedJobs));
+
+  return scope.Close(stats);
+}
+
+
+
+
+
+
+
+
 // Creates and launches a new isolate in a new background thread.
 static Handle<Value> Create (const Arguments &args) {
     HandleScope scope;
@@ -868,6 +5900,7 @@ static Handle<Value> Create (const Arguments &args) {
     typeQueueItem* qitem= NULL;
     qitem= queue_pull(freeThreadsQueue);
     if (qitem) {
+      atomic_inc(&freeListUses);
       thread= (typeThread*) qitem->asPtr;
       destroyItem(qitem);
     }
@@ -878,6 +5911,8 @@ static Handle<Value> Create (const Arguments &args) {
 
     static long int threadsCtr= 0;
     thread->id= threadsCtr++;
+    // create({ pooled: true }): see RecordJob()
+    thread->pooled= args.Length() && args[0]->IsObject() && args[0]->ToObject()->Get(String::NewSymbol("pooled"))->BooleanValue();
 
     thread->JSObject= Persistent<Object>::New(threadTemplate->NewInstance());
     thread->JSObject->Set(id_symbol, Integer::New(thread->id));
@@ -892,7 +5927,9 @@ static Handle<Value> Create (const Arguments &args) {
     uv_mutex_init(&thread->IDLE_mutex);
     uv_mutex_init(&thread->inQueue.queueLock);
     uv_mutex_init(&thread->outQueue.queueLock);
+    stallWatch(thread);
 
+    V8::AdjustAmountOfExternalAllocatedMemory(sizeof(typeThread));  //OJO V8 con V mayúscula.
 #ifdef WWT_PTHREAD
     pthread_attr_t attr;
     pthread_attr_init(&attr);
@@ -908,7 +5945,6 @@ static Handle<Value> Create (const Arguments &args) {
       return ThrowException(Exception::TypeError(String::New("create(): error in pthread_create()")));
     }
 
-    V8::AdjustAmountOfExternalAllocatedMemory(sizeof(typeThread));  //OJO V8 con V mayúscula.
     return scope.Close(thread->JSObject);
 }
 
@@ -922,26 +5958,100 @@ void Init (Handle<Object> target) {
   initQueues();
   freeThreadsQueue= nuQueue(-3);
   freeJobsQueue= nuQueue(-4);
+  uv_mutex_init(&queueRoomMutex);
+  uv_cond_init(&queueRoomCV);
+  memo_init();
+  shared_map_init();
+  frozen_init();
+  stall_init();
+
+  uv_timer_init(uv_default_loop(), &trimTimer);
+  uv_timer_start(&trimTimer, trimFreeLists, kTrimInterval, kTrimInterval);
+  uv_unref((uv_handle_t*) &trimTimer);
 
   HandleScope scope;
 
   useLocker= v8::Locker::IsActive();
 
   target->Set(String::NewSymbol("create"), FunctionTemplate::New(Create)->GetFunction());
+  target->Set(String::NewSymbol("setQueueLimit"), FunctionTemplate::New(SetQueueLimit)->GetFunction());
+  target->Set(String::NewSymbol("setFreeListLimits"), FunctionTemplate::New(SetFreeListLimits)->GetFunction());
+  target->Set(String::NewSymbol("setStallThreshold"), FunctionTemplate::New(SetStallThreshold)->GetFunction());
+  target->Set(String::NewSymbol("startRecording"), FunctionTemplate::New(StartRecording)->GetFunction());
+  target->Set(String::NewSymbol("stopRecording"), FunctionTemplate::New(StopRecording)->GetFunction());
+  target->Set(String::NewSymbol("recordJob"), FunctionTemplate::New(RecordJob)->GetFunction());
+  target->Set(String::NewSymbol("readRecording"), FunctionTemplate::New(ReadRecording)->GetFunction());
+  target->Set(String::NewSymbol("stats"), FunctionTemplate::New(Stats)->GetFunction());
+  target->Set(String::NewSymbol("memoLookup"), FunctionTemplate::New(MemoLookup)->GetFunction());
+  target->Set(String::NewSymbol("memoStats"), FunctionTemplate::New(MemoStats)->GetFunction());
+  target->Set(String::NewSymbol("setMemoLimit"), FunctionTemplate::New(SetMemoLimit)->GetFunction());
+  target->Set(String::NewSymbol("parallelSort"), FunctionTemplate::New(ParallelSort)->GetFunction());
+  target->Set(String::NewSymbol("parallelBinarySearch"), FunctionTemplate::New(ParallelBinarySearch)->GetFunction());
+  target->Set(String::NewSymbol("serve"), FunctionTemplate::New(Serve)->GetFunction());
+  target->Set(String::NewSymbol("connect"), FunctionTemplate::New(Connect)->GetFunction());
+  target->Set(String::NewSymbol("newPipeline"), FunctionTemplate::New(NewPipeline)->GetFunction());
+  target->Set(String::NewSymbol("spawnActor"), FunctionTemplate::New(SpawnActor)->GetFunction());
+  target->Set(String::NewSymbol("schedule"), FunctionTemplate::New(Schedule)->GetFunction());
+  target->Set(String::NewSymbol("mergePartials"), FunctionTemplate::New(MergePartials)->GetFunction());
+  target->Set(String::NewSymbol("SharedMap"), sharedMapClass());
+  target->Set(String::NewSymbol("freeze"), FunctionTemplate::New(Freeze)->GetFunction());
+  target->Set(String::NewSymbol("frozen"), FunctionTemplate::New(Frozen)->GetFunction());
+  target->Set(String::NewSymbol("unfreeze"), FunctionTemplate::New(Unfreeze)->GetFunction());
+  target->Set(String::NewSymbol("frozenStats"), FunctionTemplate::New(FrozenStats)->GetFunction());
   target->Set(String::NewSymbol("createPool"), Script::Compile(String::New(kCreatePool_js))->Run()->ToObject());
+  target->Set(String::NewSymbol("pipeline"), Script::Compile(String::New(kPipeline_js))->Run()->ToObject());
   target->Set(String::NewSymbol("Worker"), Script::Compile(String::New(kWorker_js))->Run()->ToObject()->CallAsFunction(target, 0, NULL)->ToObject());
   //target->Set(String::NewSymbol("JASON"), Script::Compile(String::New(kJASON_js))->Run()->ToObject());
 
   id_symbol= Persistent<String>::New(String::NewSymbol("id"));
+  pinned_symbol= Persistent<String>::New(String::NewSymbol("webworker-threads::pinned"));
+  memo_symbol= Persistent<String>::New(String::NewSymbol("webworker-threads::memo"));
+  mainBSON= new BSON();
+
+  serverTemplate= Persistent<ObjectTemplate>::New(ObjectTemplate::New());
+  serverTemplate->SetInternalFieldCount(1);
+  serverTemplate->Set(String::NewSymbol("close"), FunctionTemplate::New(ServerClose));
+  serverTemplate->Set(String::NewSymbol("stats"), FunctionTemplate::New(ServerStats));
+
+  clientTemplate= Persistent<ObjectTemplate>::New(ObjectTemplate::New());
+  clientTemplate->SetInternalFieldCount(1);
+  clientTemplate->Set(String::NewSymbol("call"), FunctionTemplate::New(ClientCall));
+  clientTemplate->Set(String::NewSymbol("eval"), FunctionTemplate::New(ClientEval));
+  clientTemplate->Set(String::NewSymbol("destroy"), FunctionTemplate::New(ClientDestroy));
+  clientTemplate->Set(String::NewSymbol("pendingJobs"), FunctionTemplate::New(ClientPendingJobs));
+
+  pipelineTemplate= Persistent<ObjectTemplate>::New(ObjectTemplate::New());
+  pipelineTemplate->SetInternalFieldCount(1);
+  pipelineTemplate->Set(String::NewSymbol("push"), FunctionTemplate::New(PipelinePush));
+  pipelineTemplate->Set(String::NewSymbol("stats"), FunctionTemplate::New(PipelineStats));
+  pipelineTemplate->Set(String::NewSymbol("pendingJobs"), FunctionTemplate::New(PipelinePendingJobs));
+  pipelineTemplate->Set(String::NewSymbol("destroy"), FunctionTemplate::New(PipelineDestroy));
+
+  memoKeyTemplate= Persistent<ObjectTemplate>::New(ObjectTemplate::New());
+  memoKeyTemplate->SetInternalFieldCount(1);
+
+  scheduleTemplate= Persistent<ObjectTemplate>::New(ObjectTemplate::New());
+  scheduleTemplate->SetInternalFieldCount(1);
+  scheduleTemplate->Set(String::NewSymbol("cancel"), FunctionTemplate::New(ScheduleCancel));
+  scheduleTemplate->Set(String::NewSymbol("stats"), FunctionTemplate::New(ScheduleStats));
+
+  actorTemplate= Persistent<ObjectTemplate>::New(ObjectTemplate::New());
+  actorTemplate->SetInternalFieldCount(1);
+  actorTemplate->Set(String::NewSymbol("call"), FunctionTemplate::New(ActorCall));
+  actorTemplate->Set(String::NewSymbol("pendingMessages"), FunctionTemplate::New(ActorPendingMessages));
+  actorTemplate->Set(String::NewSymbol("stats"), FunctionTemplate::New(ActorStats));
+  actorTemplate->Set(String::NewSymbol("destroy"), FunctionTemplate::New(ActorDestroy));
 
   threadTemplate= Persistent<ObjectTemplate>::New(ObjectTemplate::New());
   threadTemplate->SetInternalFieldCount(1);
   threadTemplate->Set(id_symbol, Integer::New(0));
   threadTemplate->Set(String::NewSymbol("eval"), FunctionTemplate::New(Eval));
   threadTemplate->Set(String::NewSymbol("load"), FunctionTemplate::New(Load));
+  threadTemplate->Set(String::NewSymbol("call"), FunctionTemplate::New(Call));
   threadTemplate->Set(String::NewSymbol("emit"), FunctionTemplate::New(processEmit));
   threadTemplate->Set(String::NewSymbol("emitSerialized"), FunctionTemplate::New(processEmitSerialized));
   threadTemplate->Set(String::NewSymbol("destroy"), FunctionTemplate::New(Destroy));
+  threadTemplate->Set(String::NewSymbol("queuedBytes"), FunctionTemplate::New(QueuedBytes));
 
 }
 
@@ -0,0 +1,46 @@
+//atomics.h
+//Minimal portable atomic helpers for counters shared between the main thread and the workers.
+
+#ifndef WWT_ATOMICS_H_
+#define WWT_ATOMICS_H_
+
+#if defined(_MSC_VER)
+#include <windows.h>
+
+static inline long atomic_add (volatile long* p, long v) {
+  return InterlockedExchangeAdd(p, v) + v;
+}
+
+static inline long atomic_cas (volatile long* p, long oldValue, long newValue) {
+  return InterlockedCompareExchange(p, newValue, oldValue);
+}
+
+static inline void memory_barrier (void) {
+  MemoryBarrier();
+}
+
+#else
+
+static inline long atomic_add (volatile long* p, long v) {
+  return __sync_add_and_fetch(p, v);
+}
+
+static inline long atomic_cas (volatile long* p, long oldValue, long newValue) {
+  return __sync_val_compare_and_swap(p, oldValue, newValue);
+}
+
+static inline int atomic_add_int (volatile int* p, int v) {
+  return __sync_add_and_fetch(p, v);
+}
+
+static inline void memory_barrier (void) {
+  __sync_synchronize();
+}
+
+#endif
+
+#define atomic_inc(p) atomic_add((p), 1)
+#define atomic_dec(p) atomic_add((p), -1)
+#define atomic_read(p) atomic_add((p), 0)
+
+#endif  // WWT_ATOMICS_H_
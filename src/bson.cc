@@ -216,7 +216,7 @@ template<typename T> void BSONSerializer<T>::SerializeValue(void* typeLocation,
 
 				this->WriteInt32(length);
 				this->WriteByte(object, bson->_binarySubTypeString);	// write subtype
-				this->WriteData(Buffer::Data(bufferObj), length);
+				this->WriteData((const char*) bufferObj->GetIndexedPropertiesExternalArrayData(), length);
 			}
 			else if(bson->doubleString->StrictEquals(constructorString))
 			{
@@ -288,20 +288,16 @@ template<typename T> void BSONSerializer<T>::SerializeValue(void* typeLocation,
 				this->CommitType(typeLocation, BSON_TYPE_MAX_KEY);
 			}
 		}
-		else if(Buffer::HasInstance(value))
+		else if(object->HasIndexedPropertiesInExternalArrayData())
 		{
+			// A Buffer or typed array of any isolate: its memory is written as is
 			this->CommitType(typeLocation, BSON_TYPE_BINARY);
 
-	    #if NODE_MAJOR_VERSION == 0 && NODE_MINOR_VERSION < 3
-       Buffer *buffer = ObjectWrap::Unwrap<Buffer>(value->ToObject());
-			 uint32_t length = object->length();
-	    #else
-			 uint32_t length = Buffer::Length(value->ToObject());
-	    #endif
+			uint32_t length = (uint32_t) ExternalArrayByteLength(object);
 
 			this->WriteInt32(length);
 			this->WriteByte(0);
-			this->WriteData(Buffer::Data(value->ToObject()), length);
+			this->WriteData((const char*) object->GetIndexedPropertiesExternalArrayData(), length);
 		}
 		else
 		{
@@ -343,6 +339,30 @@ Local<String> BSONDeserializer::ReadCString()
 	return String::New(start, (int32_t) (p-start-1) );
 }
 
+// An object's key: the same internalized string every time the same bytes
+// come, so that they aren't allocated (and hashed, and looked up in the
+// symbol table by ForceSet()) over and over again. *hash is that of the bytes.
+Local<String> BSONDeserializer::ReadKey(uint32_t* hash)
+{
+	char* start = p;
+	uint32_t h = 2166136261u;	// FNV-1a
+	while(*p) h = (h ^ (unsigned char) *p++) * 16777619u;
+	uint32_t length = (uint32_t) (p++ - start);
+	*hash = h;
+	if(length > BSON_KEY_CACHE_MAX_LENGTH) return String::New(start, length);
+
+	BSON::KeyCacheEntry& entry = bson->keyCache[h & (BSON_KEY_CACHE_SIZE-1)];
+	if(entry.key.IsEmpty() || entry.hash != h || entry.length != length || memcmp(entry.bytes, start, length))
+	{
+		if(!entry.key.IsEmpty()) entry.key.Dispose();
+		entry.key = Persistent<String>::New(String::NewSymbol(start, length));
+		entry.hash = h;
+		entry.length = length;
+		memcpy(entry.bytes, start, length);
+	}
+	return Local<String>::New(entry.key);
+}
+
 int32_t BSONDeserializer::ReadRegexOptions()
 {
 	int32_t options = 0;
@@ -399,20 +419,46 @@ Handle<Value> BSONDeserializer::DeserializeDocument()
 
 Handle<Value> BSONDeserializer::DeserializeDocumentInternal()
 {
-	Local<Object> returnObject = Object::New();
+	// The first BSON_SHAPE_MAX_KEYS properties are kept aside, to make the
+	// object out of its shape at the end. If there are more, it's made by hand.
+	const char* keys[BSON_SHAPE_MAX_KEYS];
+	Local<String> names[BSON_SHAPE_MAX_KEYS];
+	Handle<Value> values[BSON_SHAPE_MAX_KEYS];
+	uint32_t count = 0;
+	uint32_t shapeHash = 2166136261u;
+	Local<Object> returnObject;
 
 	while(HasMoreData())
 	{
 		BsonType type = (BsonType) ReadByte();
-		const Local<String>& name = ReadCString();
+		const char* key = p;
+		uint32_t keyHash;
+		const Local<String>& name = ReadKey(&keyHash);
 		const Handle<Value>& value = DeserializeValue(type);
+		if(count < BSON_SHAPE_MAX_KEYS)
+		{
+			keys[count] = key;
+			names[count] = name;
+			values[count] = value;
+			shapeHash = (shapeHash ^ keyHash) * 16777619u;
+			++count;
+			continue;
+		}
+		if(returnObject.IsEmpty())
+		{
+			returnObject = Object::New();
+			for(uint32_t i = 0; i < count; ++i) returnObject->ForceSet(names[i], values[i]);
+		}
 		returnObject->ForceSet(name, value);
 	}
 	if(p != pEnd) ThrowAllocatedStringException(64, "Bad BSON Document: Serialize consumed unexpected number of bytes");
+	if(returnObject.IsEmpty()) returnObject = NewShapedObject(shapeHash, count, keys, names, values);
 
 	// From JavaScript:
 	// if(object['$id'] != null) object = new DBRef(object['$ref'], object['$id'], object['$db']);
-	if(returnObject->Has(bson->_dbRefIdRefString))
+	// Only the BSON objects made from JavaScript have got a DBRef: those of the
+	// threads leave a $id as it is.
+	if(!bson->dbrefConstructor.IsEmpty() && returnObject->Has(bson->_dbRefIdRefString))
 	{
 		Local<Value> argv[] = { returnObject->Get(bson->_dbRefRefString), returnObject->Get(bson->_dbRefIdRefString), returnObject->Get(bson->_dbRefDbRefString) };
 		return bson->dbrefConstructor->NewInstance(3, argv);
@@ -423,6 +469,61 @@ Handle<Value> BSONDeserializer::DeserializeDocumentInternal()
 	}
 }
 
+// Documents with the same keys in the same order (the messages of a protocol,
+// the rows of a table...) are made by cloning an empty object that has
+// already got those properties: one copy of a ready made hidden class and
+// property backing store, instead of one transition per property.
+Local<Object> BSONDeserializer::NewShapedObject(uint32_t hash, uint32_t count, const char* keys[], Local<String> names[], Handle<Value> values[])
+{
+	Local<Object> object;
+	if(!count) return Object::New();
+
+	BSON::ShapeCacheEntry& shape = bson->shapeCache[hash & (BSON_SHAPE_CACHE_SIZE-1)];
+	bool same = (shape.hash == hash) && (shape.count == count);
+	if(same)
+	{
+		const char* k = shape.keys.data();
+		const char* end = k + shape.keys.size();
+		for(uint32_t i = 0; same && i < count; ++i)
+		{
+			size_t n = strlen(keys[i]) + 1;
+			same = (k + n <= end) && !memcmp(k, keys[i], n);
+			k += n;
+		}
+		same = same && (k == end);
+	}
+
+	if(same && !shape.boilerplate.IsEmpty())
+	{
+		object = shape.boilerplate->Clone();
+		for(uint32_t i = 0; i < count; ++i) object->Set(names[i], values[i]);
+		return object;
+	}
+
+	object = Object::New();
+	for(uint32_t i = 0; i < count; ++i) object->ForceSet(names[i], values[i]);
+
+	if(same)
+	{
+		// Seen twice in a row: worth a boilerplate. Not with a __proto__ key,
+		// that Set() would take for the prototype.
+		for(uint32_t i = 0; i < count; ++i) if(!strcmp(keys[i], "__proto__")) return object;
+		Local<Object> boilerplate = object->Clone();
+		for(uint32_t i = 0; i < count; ++i) boilerplate->Set(names[i], Undefined());
+		shape.boilerplate = Persistent<Object>::New(boilerplate);
+	}
+	else
+	{
+		if(!shape.boilerplate.IsEmpty()) shape.boilerplate.Dispose();
+		shape.boilerplate.Clear();
+		shape.hash = hash;
+		shape.count = count;
+		shape.keys.clear();
+		for(uint32_t i = 0; i < count; ++i) shape.keys.append(keys[i], strlen(keys[i]) + 1);
+	}
+	return object;
+}
+
 Handle<Value> BSONDeserializer::DeserializeArray()
 {
 	uint32_t length = ReadUInt32();
@@ -511,12 +612,11 @@ Handle<Value> BSONDeserializer::DeserializeValue(BsonType type)
 	case BSON_TYPE_BINARY:
 		{
 			uint32_t length = ReadUInt32();
-			uint32_t subType = ReadByte();
-			Buffer* buffer = Buffer::New(p, length);
+			ReadByte();	// subtype
+			Local<Object> buffer = NewIsolateBuffer(p, length);
 			p += length;
 
-			Handle<Value> argv[] = { buffer->handle_, Uint32::New(subType) };
-			return bson->binaryConstructor->NewInstance(2, argv);
+			return buffer;
 		}
 
 	case BSON_TYPE_LONG:
@@ -608,6 +708,21 @@ BSON::BSON() : ObjectWrap()
 	timestampString = Persistent<String>::New(String::New("Timestamp"));
 	minKeyString = Persistent<String>::New(String::New("MinKey"));
 	maxKeyString = Persistent<String>::New(String::New("MaxKey"));
+
+	for(size_t i = 0; i < BSON_KEY_CACHE_SIZE; ++i) keyCache[i].hash = keyCache[i].length = 0;
+	for(size_t i = 0; i < BSON_SHAPE_CACHE_SIZE; ++i) shapeCache[i].hash = shapeCache[i].count = 0;
+}
+
+BSON::~BSON()
+{
+	for(size_t i = 0; i < BSON_KEY_CACHE_SIZE; ++i)
+	{
+		if(!keyCache[i].key.IsEmpty()) keyCache[i].key.Dispose();
+	}
+	for(size_t i = 0; i < BSON_SHAPE_CACHE_SIZE; ++i)
+	{
+		if(!shapeCache[i].boilerplate.IsEmpty()) shapeCache[i].boilerplate.Dispose();
+	}
 }
 
 void BSON::Initialize(v8::Handle<v8::Object> target)
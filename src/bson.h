@@ -11,9 +11,16 @@
 
 #define USE_MISALIGNED_MEMORY_ACCESS 1
 
+// The deserializer's caches, per BSON instance (that is, per isolate)
+#define BSON_KEY_CACHE_SIZE			1024	// Direct mapped, a power of 2
+#define BSON_KEY_CACHE_MAX_LENGTH	32		// Longer keys aren't cached
+#define BSON_SHAPE_CACHE_SIZE		256		// Direct mapped, a power of 2
+#define BSON_SHAPE_MAX_KEYS			64		// Documents with more keys aren't cached
+
 #include <node.h>
 #include <node_object_wrap.h>
 #include <v8.h>
+#include <string>
 
 using namespace v8;
 using namespace node;
@@ -43,6 +50,29 @@ enum BsonType
 	BSON_TYPE_MIN_KEY		= 0xff
 };
 
+//===========================================================================
+
+// Bytes of the external memory behind a Buffer or a typed array.
+static inline size_t ExternalArrayByteLength(const Handle<Object>& object)
+{
+	size_t elementSize = 1;
+	switch(object->GetIndexedPropertiesExternalArrayDataType())
+	{
+	case kExternalShortArray:
+	case kExternalUnsignedShortArray:	elementSize = 2; break;
+	case kExternalIntArray:
+	case kExternalUnsignedIntArray:
+	case kExternalFloatArray:			elementSize = 4; break;
+	case kExternalDoubleArray:			elementSize = 8; break;
+	default:							break;
+	}
+	return elementSize * object->GetIndexedPropertiesExternalArrayDataLength();
+}
+
+// Provided by the embedder: a new Buffer of the current isolate holding a copy of data.
+Local<Object> NewIsolateBuffer(const char* data, size_t length);
+
+
 //===========================================================================
 
 template<typename T> class BSONSerializer;
@@ -50,7 +80,7 @@ template<typename T> class BSONSerializer;
 class BSON : public ObjectWrap {
 public:    
 	BSON();
-	~BSON() {}
+	~BSON();
 
 	static void Initialize(Handle<Object> target);
 	static Handle<Value> BSONDeserializeStream(const Arguments &args);
@@ -116,6 +146,27 @@ private:
 	Persistent<String> _codeScopeString;
 	Persistent<String> _toBSONString;
 
+	// Internalized keys, by their bytes: see BSONDeserializer::ReadKey()
+	struct KeyCacheEntry
+	{
+		uint32_t			hash;
+		uint32_t			length;
+		char				bytes[BSON_KEY_CACHE_MAX_LENGTH];
+		Persistent<String>	key;
+	};
+	KeyCacheEntry keyCache[BSON_KEY_CACHE_SIZE];
+
+	// Empty objects with the properties of a sequence of keys, in order:
+	// see BSONDeserializer::NewShapedObject()
+	struct ShapeCacheEntry
+	{
+		uint32_t			hash;
+		uint32_t			count;
+		std::string			keys;			// Each followed by its '\0'
+		Persistent<Object>	boilerplate;	// Set once the shape is seen twice in a row
+	};
+	ShapeCacheEntry shapeCache[BSON_SHAPE_CACHE_SIZE];
+
 public: Local<Object> GetSerializeObject(const Handle<Value>& object);
 
 	template<typename T> friend class BSONSerializer;
@@ -238,6 +289,7 @@ public:
 
 	bool			HasMoreData() const { return p < pEnd; }
 	Local<String>	ReadCString();
+	Local<String>	ReadKey(uint32_t* hash);
 	uint32_t		ReadIntegerString();
 	int32_t			ReadRegexOptions();
 	Local<String>	ReadString();
@@ -263,6 +315,7 @@ private:
 	Handle<Value> DeserializeValue(BsonType type);
 	Handle<Value> DeserializeDocumentInternal();
 	Handle<Value> DeserializeArrayInternal();
+	Local<Object> NewShapedObject(uint32_t hash, uint32_t count, const char* keys[], Local<String> names[], Handle<Value> values[]);
 
 	BSON*		bson;
 	char* const pStart;
@@ -1,12 +1,39 @@
-function createPool(n){
-  var T, pool, idleThreads, q, poolObject, e, RUN, EMIT;
+function createPool(n, options){
+  var T, pool, idleThreads, actors, schedules, inFlight, coalescing, shards, batching, edf, heap, arrivals, deadlines, shedding, destroyed, q, poolObject, e, memoScope, i$, len$, t, RUN, EMIT, CALL, LOAD, ANY, ALL, SHARD_HELPERS, BATCH_HELPER;
   T = this;
   n = Math.floor(n);
   if (!(n > 0)) {
-    throw '.createPool( num ): number of threads must be a Number > 0';
+    throw '.createPool( num [, options] ): number of threads must be a Number > 0';
   }
+  RUN = 1;
+  EMIT = 2;
+  CALL = 3;
+  LOAD = 4;
+  ANY = 1;
+  ALL = 2;
+  SHARD_HELPERS = 'var __shards= {}, __shardQueries= {}, __shardQueriesLength= 0;\nfunction __shardLoad (src, mine) {\n  var loader= eval(\'(\'+ src+ \')\');\n  __shards= {};\n  __shardQueries= {};\n  __shardQueriesLength= 0;\n  for (var i= 0; i < mine.length; i++) __shards[mine[i][0]]= loader(mine[i][1], mine[i][0]);\n  return mine.length;\n}\nfunction __shardQuery (src, args) {\n  var fn= __shardQueries[src];\n  if (!fn) {\n    if (++__shardQueriesLength > 64) {\n      __shardQueries= {};\n      __shardQueriesLength= 1;\n    }\n    fn= __shardQueries[src]= eval(\'(\'+ src+ \')\');\n  }\n  var results= [];\n  for (var i in __shards) results.push([+i, fn.apply(null, [__shards[i]].concat(args))]);\n  return results;\n}';
+  BATCH_HELPER = 'function __batch (name, argsList) {\n  var path= name.split(\'.\'), holder= global, fn= global;\n  for (var i= 0; i < path.length; i++) { holder= fn; fn= fn[path[i]] }\n  if (typeof fn !== \'function\') throw new TypeError(\'thread.call(): \'+ name+ \' is not a function\');\n  var results= [];\n  for (var i= 0; i < argsList.length; i++) {\n    try { results.push([0, fn.apply(holder, argsList[i])]) }\n    catch (e) { results.push([1, String(e)]) }\n  }\n  return results;\n}';
   pool = [];
   idleThreads = [];
+  actors = [];
+  schedules = [];
+  inFlight = {};
+  coalescing = {
+    leaders: 0,
+    coalesced: 0
+  };
+  shards = 0;
+  batching = batchOptions(options != null ? options.batch : void 8);
+  edf = (options != null ? options.queue : void 8) === 'edf';
+  heap = [];
+  arrivals = 0;
+  deadlines = {
+    dropped: 0,
+    late: 0,
+    met: 0
+  };
+  shedding = shedOptions(options != null ? options.shed : void 8);
+  destroyed = false;
   q = {
     first: null,
     last: null,
@@ -15,41 +42,71 @@ function createPool(n){
   poolObject = {
     on: onEvent,
     load: poolLoad,
+    sort: poolSort,
+    binarySearchMany: poolBinarySearchMany,
+    parseJSON: poolParseJSON,
+    stringifyJSON: poolStringifyJSON,
+    serve: poolServe,
+    shard: poolShard,
+    scatter: poolScatter,
+    spawnActor: poolSpawnActor,
+    coalesceStats: getCoalesceStats,
+    batchStats: getBatchStats,
+    deadlineStats: getDeadlineStats,
+    shedStats: getShedStats,
+    schedule: poolSchedule,
     destroy: destroy,
     pendingJobs: getPendingJobs,
     idleThreads: getIdleThreads,
     totalThreads: getNumThreads,
     any: {
       eval: evalAny,
-      emit: emitAny
+      emit: emitAny,
+      call: callAny,
+      chain: callChain
     },
     all: {
       eval: evalAll,
-      emit: emitAll
+      emit: emitAll,
+      call: callAll
     }
   };
   try {
     while (n--) {
-      pool[n] = idleThreads[n] = T.create();
+      pool[n] = idleThreads[n] = T.create({
+        pooled: true
+      });
     }
   } catch (e$) {
     e = e$;
     destroy('rudely');
     throw e;
   }
+  memoScope = "pool" + pool[0].id;
+  if (batching) {
+    for (i$ = 0, len$ = pool.length; i$ < len$; ++i$) {
+      t = pool[i$];
+      t.eval(BATCH_HELPER);
+    }
+  }
   return poolObject;
-  RUN = 1;
-  EMIT = 2;
   function poolLoad(path, cb){
     var i;
+    record(LOAD, ALL, path);
     i = pool.length;
     while (i--) {
       pool[i].load(path, cb);
     }
   }
   function nextJob(t){
-    var job;
+    var job, jobs, t0;
+    if (destroyed) {
+      return;
+    }
     job = qPull();
+    while (job && (expired(job) || shed(job))) {
+      job = qPull();
+    }
     if (job) {
       if (job.type === RUN) {
         t.eval(job.srcTextOrEventType, function(e, d){
@@ -60,6 +117,26 @@ function createPool(n){
             return job.cbOrData.call(t, e, d);
           }
         });
+      } else if (job.type === CALL) {
+        if (job.batch) {
+          jobs = batchTake(job);
+          if (jobs.length > 1) {
+            return batchCall(t, jobs);
+          }
+          t0 = process.hrtime();
+        }
+        t.call(job.srcTextOrEventType, job.args, job.memo, function(e, d){
+          var f;
+          if (job.batch) {
+            batchAdapt(job.srcTextOrEventType, 1, process.hrtime(t0));
+          }
+          deadlineDone(job);
+          nextJob(t);
+          f = job.cbOrData;
+          if (f) {
+            return job.cbOrData.call(t, e, d);
+          }
+        });
       } else {
         if (job.type === EMIT) {
           t.emit(job.srcTextOrEventType, job.cbOrData);
@@ -67,38 +144,76 @@ function createPool(n){
         }
       }
     } else {
+      if (shedding) {
+        shedding.firstAbove = shedding.dropping = 0;
+      }
       idleThreads.push(t);
     }
   }
-  function qPush(srcTextOrEventType, cbOrData, type){
+  function qPush(srcTextOrEventType, cbOrData, type, args, memo, deadline){
     var job;
     job = {
       srcTextOrEventType: srcTextOrEventType,
       cbOrData: cbOrData,
       type: type,
-      next: null
+      args: args,
+      memo: memo,
+      deadline: deadline,
+      next: null,
+      prev: null
     };
-    if (q.last) {
+    if (shedding) {
+      job.enqueued = nowMs();
+    }
+    q.length++;
+    if (edf) {
+      heapPush(job);
+    } else if (q.last) {
+      job.prev = q.last;
       q.last = q.last.next = job;
     } else {
       q.first = q.last = job;
     }
-    q.length++;
+    return job;
   }
   function qPull(){
     var job;
-    job = q.first;
-    if (job) {
+    if (edf) {
+      job = heapPop();
+    } else if (job = q.first) {
       if (q.last === job) {
         q.first = q.last = null;
       } else {
         q.first = job.next;
+        q.first.prev = null;
       }
+    }
+    if (job) {
       q.length--;
+      if (job.batch) {
+        batchUnlink(job);
+      }
+      if (shedding) {
+        sojourn(job);
+      }
     }
     return job;
   }
+  function qUnlink(job){
+    if (job.prev) {
+      job.prev.next = job.next;
+    } else {
+      q.first = job.next;
+    }
+    if (job.next) {
+      job.next.prev = job.prev;
+    } else {
+      q.last = job.prev;
+    }
+    q.length--;
+  }
   function evalAny(src, cb){
+    record(RUN, ANY, src);
     qPush(src, cb, RUN);
     if (idleThreads.length) {
       nextJob(idleThreads.pop());
@@ -106,12 +221,14 @@ function createPool(n){
     return poolObject;
   }
   function evalAll(src, cb){
+    record(RUN, ALL, src);
     pool.forEach(function(v, i, o){
       return v.eval(src, cb);
     });
     return poolObject;
   }
   function emitAny(event, data){
+    record(EMIT, ANY, event, [data]);
     qPush(event, data, EMIT);
     if (idleThreads.length) {
       nextJob(idleThreads.pop());
@@ -119,11 +236,587 @@ function createPool(n){
     return poolObject;
   }
   function emitAll(event, data){
+    record(EMIT, ALL, event, [data]);
     pool.forEach(function(v, i, o){
       return v.emit(event, data);
     });
     return poolObject;
   }
+  function callAny(fnName, args, options, cb){
+    var ref$, memo, id, waiters, job;
+    if (typeof args === 'function') {
+      ref$ = [args, []], cb = ref$[0], args = ref$[1];
+    } else if (typeof options === 'function') {
+      ref$ = [options, null], cb = ref$[0], options = ref$[1];
+    }
+    record(CALL, ANY, fnName, args);
+    if (cb && ((options != null && options.memoize) || (options != null && options.coalesce))) {
+      memo = T.memoLookup(memoScope, fnName, args, !!options.memoize, !!options.coalesce);
+      if (Array.isArray(memo)) {
+        process.nextTick(function(){
+          return cb.call(poolObject, null, memo[0]);
+        });
+        return poolObject;
+      }
+      if (options.coalesce) {
+        id = memo.id;
+        if (waiters = inFlight[id]) {
+          coalescing.coalesced++;
+          waiters.push(cb);
+          return poolObject;
+        }
+        coalescing.leaders++;
+        waiters = inFlight[id] = [cb];
+        cb = function(e, d){
+          var i$, ref$, len$, w;
+          delete inFlight[id];
+          for (i$ = 0, len$ = (ref$ = waiters).length; i$ < len$; ++i$) {
+            w = ref$[i$];
+            w.call(this, e, d);
+          }
+        };
+      }
+    }
+    if ((shedding != null && shedding.dropping) && (options != null ? options.priority : void 8) === 'low') {
+      shedding.rejected++;
+      if (cb) {
+        process.nextTick(function(){
+          return cb.call(poolObject, overloaded(), null);
+        });
+      }
+      return poolObject;
+    }
+    job = qPush(fnName, cb, CALL, args, memo, options != null ? options.deadline : void 8);
+    if ((options != null ? options.priority : void 8) === 'low') {
+      job.low = true;
+    }
+    if (batching && !memo && batchable(args)) {
+      job.batch = true;
+      batchLink(job);
+      if (lingering(fnName)) {
+        return poolObject;
+      }
+    }
+    if (idleThreads.length) {
+      nextJob(idleThreads.pop());
+    }
+    return poolObject;
+  }
+  function batchOptions(o){
+    if (!o) {
+      return null;
+    }
+    if (o === true) {
+      o = {};
+    }
+    return {
+      maxJobs: o.maxJobs || 64,
+      maxLatencyMs: o.maxLatencyMs || 2,
+      lingerMs: o.lingerMs || 0,
+      sizes: {},
+      queued: {},
+      batches: 0,
+      batched: 0,
+      timer: null
+    };
+  }
+  function batchable(args){
+    var i$, ref$, len$, a;
+    if (args == null) {
+      return true;
+    }
+    for (i$ = 0, len$ = (ref$ = Array.isArray(args)
+      ? args
+      : [args]).length; i$ < len$; ++i$) {
+      a = ref$[i$];
+      if (a && typeof a === 'object' && (Buffer.isBuffer(a) || a.BYTES_PER_ELEMENT != null)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  function lingering(fnName){
+    if (!(batching.lingerMs && idleThreads.length)) {
+      return false;
+    }
+    if (batching.queued[fnName].length >= (batching.sizes[fnName] || 2)) {
+      return false;
+    }
+    batching.timer || (batching.timer = setTimeout(flushLingering, batching.lingerMs));
+    return true;
+  }
+  function flushLingering(){
+    batching.timer = null;
+    while (q.length && idleThreads.length) {
+      nextJob(idleThreads.pop());
+    }
+  }
+  function batchLink(job){
+    var list, key$;
+    list = batching.queued[key$ = job.srcTextOrEventType] || (batching.queued[key$] = {
+      first: null,
+      last: null,
+      length: 0
+    });
+    job.batchPrev = list.last;
+    job.batchNext = null;
+    if (list.last) {
+      list.last.batchNext = job;
+    } else {
+      list.first = job;
+    }
+    list.last = job;
+    list.length++;
+  }
+  function batchUnlink(job){
+    var list;
+    list = batching.queued[job.srcTextOrEventType];
+    if (job.batchPrev) {
+      job.batchPrev.batchNext = job.batchNext;
+    } else {
+      list.first = job.batchNext;
+    }
+    if (job.batchNext) {
+      job.batchNext.batchPrev = job.batchPrev;
+    } else {
+      list.last = job.batchPrev;
+    }
+    list.length--;
+  }
+  function batchTake(first){
+    var fnName, size, list, jobs, job;
+    fnName = first.srcTextOrEventType;
+    size = batching.sizes[fnName] || 2;
+    list = batching.queued[fnName];
+    jobs = [first];
+    while (list.first && jobs.length < size) {
+      job = list.first;
+      batchUnlink(job);
+      if (edf) {
+        heapRemove(job);
+        q.length--;
+      } else {
+        qUnlink(job);
+      }
+      if (!(expired(job) || shed(job))) {
+        jobs.push(job);
+      }
+    }
+    return jobs;
+  }
+  function batchCall(t, jobs){
+    var fnName, t0, job;
+    fnName = jobs[0].srcTextOrEventType;
+    batching.batches++;
+    batching.batched += jobs.length;
+    t0 = process.hrtime();
+    t.call('__batch', [
+      fnName, (function(){
+        var i$, ref$, len$, results$ = [];
+        for (i$ = 0, len$ = (ref$ = jobs).length; i$ < len$; ++i$) {
+          job = ref$[i$];
+          results$.push(batchArgs(job.args));
+        }
+        return results$;
+      }())
+    ], function(e, d){
+      var i$, ref$, len$, i, job;
+      batchAdapt(fnName, jobs.length, process.hrtime(t0));
+      for (i$ = 0, len$ = jobs.length; i$ < len$; ++i$) {
+        job = jobs[i$];
+        deadlineDone(job);
+      }
+      nextJob(t);
+      for (i$ = 0, len$ = (ref$ = jobs).length; i$ < len$; ++i$) {
+        i = i$;
+        job = ref$[i$];
+        if (job.cbOrData) {
+          if (e) {
+            job.cbOrData.call(t, e, null);
+          } else if (d[i][0]) {
+            job.cbOrData.call(t, new Error(d[i][1]), null);
+          } else {
+            job.cbOrData.call(t, null, d[i][1]);
+          }
+        }
+      }
+    });
+  }
+  function batchArgs(args){
+    if (args != null) {
+      if (Array.isArray(args)) {
+        return args;
+      } else {
+        return [args];
+      }
+    } else {
+      return [];
+    }
+  }
+  function batchAdapt(fnName, count, elapsed){
+    var ms, size;
+    ms = elapsed[0] * 1e3 + elapsed[1] / 1e6;
+    size = batching.sizes[fnName] || 2;
+    if (ms > batching.maxLatencyMs) {
+      size = Math.max(1, Math.floor(count * batching.maxLatencyMs / ms));
+    } else if (ms * 2 < batching.maxLatencyMs && count >= size) {
+      size = Math.min(batching.maxJobs, size * 2);
+    }
+    batching.sizes[fnName] = size;
+  }
+  function callChain(fnName, args){
+    return callFuture(fnName, args);
+  }
+  function callFuture(fnName, args, after){
+    var names, cbs, sent, settled, err, value, future, send;
+    names = [fnName];
+    cbs = [];
+    sent = settled = false;
+    err = value = null;
+    future = Object.create(poolObject);
+    future.then = function(next){
+      if (typeof next === 'function') {
+        if (settled) {
+          process.nextTick(function(){
+            return next.call(poolObject, err, value);
+          });
+        } else {
+          cbs.push(next);
+        }
+        return future;
+      } else if (sent) {
+        return callFuture(next, null, future);
+      } else {
+        names.push(next);
+        return future;
+      }
+    };
+    send = function(e, d){
+      var callArgs;
+      sent = true;
+      if (e) {
+        return settle(e, null);
+      }
+      callArgs = after ? [d] : args;
+      record(CALL, ANY, names.join('\n'), callArgs);
+      qPush(names, settle, CALL, callArgs);
+      if (idleThreads.length) {
+        return nextJob(idleThreads.pop());
+      }
+    };
+    if (after) {
+      after.then(send);
+    } else {
+      process.nextTick(send);
+    }
+    return future;
+    function settle(e, d){
+      var i$, ref$, len$, cb;
+      settled = true;
+      err = e;
+      value = d;
+      if (e && !cbs.length) {
+        throw e;
+      }
+      for (i$ = 0, len$ = (ref$ = cbs).length; i$ < len$; ++i$) {
+        cb = ref$[i$];
+        cb.call(poolObject, e, d);
+      }
+    }
+  }
+  function callAll(fnName, args, cb){
+    var ref$;
+    if (typeof args === 'function') {
+      ref$ = [args, []], cb = ref$[0], args = ref$[1];
+    }
+    record(CALL, ALL, fnName, args);
+    pool.forEach(function(v, i, o){
+      if (cb) {
+        return v.call(fnName, args, cb);
+      } else {
+        return v.call(fnName, args);
+      }
+    });
+    return poolObject;
+  }
+  function poolSort(array, opts, cb){
+    var ref$;
+    if (typeof opts === 'function') {
+      ref$ = [opts, {}], cb = ref$[0], opts = ref$[1];
+    }
+    T.parallelSort(pool, array, (opts != null ? opts.compare : void 8) === 'desc', cb);
+    return poolObject;
+  }
+  function poolBinarySearchMany(sorted, queries, opts, cb){
+    var ref$;
+    if (typeof opts === 'function') {
+      ref$ = [opts, {}], cb = ref$[0], opts = ref$[1];
+    }
+    queries = new Float64Array(queries);
+    T.parallelBinarySearch(pool, sorted, queries, new Int32Array(queries.length), (opts != null ? opts.compare : void 8) === 'desc', cb);
+    return poolObject;
+  }
+  function poolParseJSON(text, cb){
+    return callAny('thread.parseJSON', [text], cb);
+  }
+  function poolStringifyJSON(value, cb){
+    var text, e, pieces, results, pending, failed;
+    if (stringifyHere(value, [])) {
+      try {
+        text = JSON.stringify(value);
+      } catch (e$) {
+        e = e$;
+        process.nextTick(function(){
+          return cb.call(poolObject, e, null);
+        });
+        return poolObject;
+      }
+      process.nextTick(function(){
+        return cb.call(poolObject, null, text);
+      });
+      return poolObject;
+    }
+    pieces = jsonPieces(value);
+    if (!pieces) {
+      return callAny('JSON.stringify', [value], cb);
+    }
+    results = [];
+    pending = pieces.length;
+    failed = false;
+    pieces.forEach(function(piece, i){
+      return callAny('JSON.stringify', [piece], function(e, d){
+        var text;
+        if (failed) {
+          return;
+        }
+        if (e) {
+          failed = true;
+          return cb.call(this, e, null);
+        }
+        results[i] = d.slice(1, -1);
+        if (--pending) {
+          return;
+        }
+        text = results.filter(function(it){
+          return it;
+        }).join(',');
+        return cb.call(this, null, Array.isArray(value)
+          ? "[" + text + "]"
+          : "{" + text + "}");
+      });
+    });
+    return poolObject;
+  }
+  function stringifyHere(value, parents){
+    var keys, own, i$, len$, key;
+    if (value === void 8 || typeof value === 'function') {
+      return true;
+    }
+    if (!(value && typeof value === 'object')) {
+      return false;
+    }
+    if (typeof value.toJSON === 'function' || parents.indexOf(value) >= 0) {
+      return true;
+    }
+    if (value instanceof Number || value instanceof String || value instanceof Boolean) {
+      return true;
+    }
+    keys = Object.keys(value);
+    own = Object.getOwnPropertyNames(value).length;
+    if (Array.isArray(value)) {
+      if (keys.length !== value.length || own !== keys.length + 1) {
+        return true;
+      }
+    } else if (own !== keys.length) {
+      return true;
+    }
+    parents.push(value);
+    for (i$ = 0, len$ = keys.length; i$ < len$; ++i$) {
+      key = keys[i$];
+      if (key.indexOf('\0') >= 0 || stringifyHere(value[key], parents)) {
+        return true;
+      }
+    }
+    parents.pop();
+    return false;
+  }
+  function jsonPieces(value){
+    var n, i, keys, piece, i$, ref$, len$, key, results$ = [];
+    if (!(pool.length > 1 && value && typeof value === 'object')) {
+      return;
+    }
+    if (Array.isArray(value)) {
+      if (!(value.length >= pool.length * 2)) {
+        return;
+      }
+      n = pool.length;
+      for (i = 0; i < n; ++i) {
+        results$.push(value.slice(value.length * i / n | 0, value.length * (i + 1) / n | 0));
+      }
+      return results$;
+    }
+    keys = Object.keys(value);
+    if (!(keys.length >= pool.length * 2)) {
+      return;
+    }
+    n = pool.length;
+    for (i = 0; i < n; ++i) {
+      piece = {};
+      for (i$ = 0, len$ = (ref$ = keys.slice(keys.length * i / n | 0, keys.length * (i + 1) / n | 0)).length; i$ < len$; ++i$) {
+        key = ref$[i$];
+        piece[key] = value[key];
+      }
+      results$.push(piece);
+    }
+    return results$;
+  }
+  function poolShard(loader, partitions, cb){
+    var src, n, pending, failed;
+    if (destroyed) {
+      throw 'This thread pool has been destroyed';
+    }
+    src = typeof loader === 'function' ? loader.toString() : loader;
+    n = pool.length;
+    pending = n;
+    failed = false;
+    shards = 0;
+    pool.forEach(function(t, i){
+      var mine, res$, i$, ref$, len$, j, p;
+      res$ = [];
+      for (i$ = 0, len$ = (ref$ = partitions).length; i$ < len$; ++i$) {
+        j = i$;
+        p = ref$[i$];
+        if (j % n === i) {
+          res$.push([j, p]);
+        }
+      }
+      mine = res$;
+      t.eval(SHARD_HELPERS);
+      return t.call('__shardLoad', [src, mine], function(e, d){
+        if (failed) {
+          return;
+        }
+        if (e) {
+          failed = true;
+          return cb != null ? cb.call(poolObject, e, null) : void 8;
+        }
+        if (--pending) {
+          return;
+        }
+        shards = partitions.length;
+        return cb != null ? cb.call(poolObject, null, shards) : void 8;
+      });
+    });
+    return poolObject;
+  }
+  function poolScatter(query, args, merge, cb){
+    var src, partials, pending, failed;
+    if (destroyed) {
+      throw 'This thread pool has been destroyed';
+    }
+    if (!shards) {
+      throw 'pool.scatter(): there are no shards, see pool.shard()';
+    }
+    src = typeof query === 'function' ? query.toString() : query;
+    args = args != null ? Array.isArray(args) ? args : [args] : [];
+    partials = [];
+    pending = pool.length;
+    failed = false;
+    pool.forEach(function(t){
+      return t.call('__shardQuery', [src, args], function(e, d){
+        var i$, len$, ref$, i, partial, result;
+        if (failed) {
+          return;
+        }
+        if (e) {
+          failed = true;
+          return cb.call(poolObject, e, null);
+        }
+        for (i$ = 0, len$ = d.length; i$ < len$; ++i$) {
+          ref$ = d[i$], i = ref$[0], partial = ref$[1];
+          partials[i] = partial;
+        }
+        if (--pending) {
+          return;
+        }
+        try {
+          result = mergePartials(partials, merge);
+        } catch (e$) {
+          e = e$;
+          return cb.call(poolObject, e instanceof Error ? e : new Error(e), null);
+        }
+        return cb.call(poolObject, null, result);
+      });
+    });
+    return poolObject;
+  }
+  function mergePartials(partials, merge){
+    var descending;
+    if (typeof merge === 'function') {
+      return merge(partials);
+    }
+    if (typeof merge === 'string') {
+      merge = {
+        kind: merge
+      };
+    }
+    descending = merge.descending != null
+      ? merge.descending
+      : merge.kind === 'topK';
+    return T.mergePartials(partials, merge.kind, merge.k, merge.key, descending);
+  }
+  function poolServe(path, options){
+    return T.serve(pool, path, options);
+  }
+  function poolSpawnActor(init, cb){
+    var best, i$, ref$, len$, i, t, done, actor, nativeDestroy;
+    if (destroyed) {
+      throw 'This thread pool has been destroyed';
+    }
+    best = 0;
+    for (i$ = 0, len$ = (ref$ = pool).length; i$ < len$; ++i$) {
+      i = i$;
+      t = ref$[i$];
+      if ((actors[i] || 0) < (actors[best] || 0)) {
+        best = i;
+      }
+    }
+    done = cb ? function(e){
+      return cb.call(poolObject, e, e ? null : actor);
+    } : void 8;
+    actor = T.spawnActor(pool[best], typeof init === 'function' ? init.toString() : init, done);
+    actors[best] = (actors[best] || 0) + 1;
+    nativeDestroy = actor.destroy;
+    actor.destroy = function(){
+      if (!nativeDestroy) {
+        return;
+      }
+      nativeDestroy.call(actor);
+      nativeDestroy = null;
+      return actors[best]--;
+    };
+    return actor;
+  }
+  function poolSchedule(fn, options){
+    var src, schedule, nativeCancel;
+    if (destroyed) {
+      throw 'This thread pool has been destroyed';
+    }
+    options || (options = {});
+    src = typeof fn === 'function' ? "(" + fn + ")()" : fn;
+    schedule = T.schedule(pool, src, options.everyMs, options.jitter || 0, options.overlap || 'skip', options.missed || 'skip');
+    schedules.push(schedule);
+    nativeCancel = schedule.cancel;
+    schedule.cancel = function(){
+      if (!nativeCancel) {
+        return;
+      }
+      nativeCancel.call(schedule);
+      nativeCancel = null;
+      return schedules.splice(schedules.indexOf(schedule), 1);
+    };
+    return schedule;
+  }
   function onEvent(event, cb){
     pool.forEach(function(v, i, o){
       return v.on(event, cb);
@@ -143,8 +836,19 @@ function createPool(n){
       }
     };
     beRude = function(){
-      q.length = 0;
-      q.first = null;
+      var job;
+      destroyed = true;
+      if (batching != null && batching.timer) {
+        clearTimeout(batching.timer);
+      }
+      while (schedules.length) {
+        schedules[0].cancel();
+      }
+      while (job = qPull()) {
+        if (job.type !== EMIT && job.cbOrData) {
+          abortJob(job.cbOrData);
+        }
+      }
       pool.forEach(function(v, i, o){
         return v.destroy();
       });
@@ -156,6 +860,197 @@ function createPool(n){
       beNice();
     }
   }
+  function abortJob(cb){
+    return process.nextTick(function(){
+      return cb.call(poolObject, new Error('This thread pool has been destroyed'));
+    });
+  }
+  function getCoalesceStats(){
+    var calls;
+    calls = coalescing.leaders + coalescing.coalesced;
+    return {
+      leaders: coalescing.leaders,
+      coalesced: coalescing.coalesced,
+      inFlight: Object.keys(inFlight).length,
+      ratio: calls ? coalescing.coalesced / calls : 0
+    };
+  }
+  function heapBefore(a, b){
+    return a.key < b.key || (a.key === b.key && a.arrival < b.arrival);
+  }
+  function heapPush(job){
+    job.key = job.deadline != null ? job.deadline : Infinity;
+    job.arrival = arrivals++;
+    job.index = heap.length;
+    heap.push(job);
+    heapUp(job.index);
+  }
+  function heapPop(){
+    var job;
+    if (!heap.length) {
+      return null;
+    }
+    job = heap[0];
+    heapRemove(job);
+    return job;
+  }
+  function heapRemove(job){
+    var last;
+    last = heap.pop();
+    if (last === job) {
+      return;
+    }
+    heap[job.index] = last;
+    last.index = job.index;
+    heapDown(last.index);
+    heapUp(last.index);
+  }
+  function heapUp(i){
+    var job, parent;
+    job = heap[i];
+    while (i > 0) {
+      parent = (i - 1) >> 1;
+      if (!heapBefore(job, heap[parent])) {
+        break;
+      }
+      heap[i] = heap[parent];
+      heap[i].index = i;
+      i = parent;
+    }
+    heap[i] = job;
+    job.index = i;
+  }
+  function heapDown(i){
+    var job, child;
+    job = heap[i];
+    for (;;) {
+      child = 2 * i + 1;
+      if (child >= heap.length) {
+        break;
+      }
+      if (child + 1 < heap.length && heapBefore(heap[child + 1], heap[child])) {
+        child++;
+      }
+      if (!heapBefore(heap[child], job)) {
+        break;
+      }
+      heap[i] = heap[child];
+      heap[i].index = i;
+      i = child;
+    }
+    heap[i] = job;
+    job.index = i;
+  }
+  function expired(job){
+    if (!(job.deadline != null && Date.now() > job.deadline)) {
+      return false;
+    }
+    deadlines.dropped++;
+    failJob(job, poolError('pool.any.call(): its deadline has passed', 'EDEADLINE'));
+    return true;
+  }
+  function failJob(job, e){
+    var cb;
+    cb = job.cbOrData;
+    if (cb) {
+      process.nextTick(function(){
+        return cb.call(poolObject, e, null);
+      });
+    }
+  }
+  function poolError(message, code){
+    var e;
+    e = new Error(message);
+    e.code = code;
+    return e;
+  }
+  function shedOptions(o){
+    if (!o) {
+      return null;
+    }
+    if (o === true) {
+      o = {};
+    }
+    return {
+      targetMs: o.targetMs || 5,
+      intervalMs: o.intervalMs || 100,
+      firstAbove: 0,
+      dropping: 0,
+      sojournMs: 0,
+      episodes: 0,
+      rejected: 0,
+      shed: 0
+    };
+  }
+  function nowMs(){
+    var t;
+    t = process.hrtime();
+    return t[0] * 1e3 + t[1] / 1e6;
+  }
+  function sojourn(job){
+    var now;
+    now = nowMs();
+    shedding.sojournMs = now - job.enqueued;
+    if (shedding.sojournMs < shedding.targetMs) {
+      shedding.firstAbove = shedding.dropping = 0;
+    } else if (!shedding.firstAbove) {
+      shedding.firstAbove = now + shedding.intervalMs;
+    } else if (!shedding.dropping && now >= shedding.firstAbove) {
+      shedding.dropping = 1;
+      shedding.episodes++;
+    }
+  }
+  function shed(job){
+    if (!(job.low && (shedding != null && shedding.dropping))) {
+      return false;
+    }
+    shedding.shed++;
+    failJob(job, overloaded());
+    return true;
+  }
+  function overloaded(){
+    return poolError('pool.any.call(): shed, the pool is overloaded', 'EOVERLOAD');
+  }
+  function getShedStats(){
+    return {
+      dropping: !!(shedding != null && shedding.dropping),
+      sojournMs: (shedding != null ? shedding.sojournMs : void 8) || 0,
+      episodes: (shedding != null ? shedding.episodes : void 8) || 0,
+      rejected: (shedding != null ? shedding.rejected : void 8) || 0,
+      shed: (shedding != null ? shedding.shed : void 8) || 0
+    };
+  }
+  function deadlineDone(job){
+    if (job.deadline == null) {
+      return;
+    }
+    if (Date.now() > job.deadline) {
+      deadlines.late++;
+    } else {
+      deadlines.met++;
+    }
+  }
+  function getDeadlineStats(){
+    return {
+      queue: edf ? 'edf' : 'fifo',
+      dropped: deadlines.dropped,
+      late: deadlines.late,
+      met: deadlines.met
+    };
+  }
+  function getBatchStats(){
+    return {
+      batches: (batching != null ? batching.batches : void 8) || 0,
+      batched: (batching != null ? batching.batched : void 8) || 0,
+      average: (batching != null ? batching.batches : void 8) ? batching.batched / batching.batches : 0,
+      sizes: (batching != null ? batching.sizes : void 8) || {}
+    };
+  }
+  function record(type, origin, name, args){
+    if (pool.length) {
+      return T.recordJob(type, origin, pool[0].id, name, args);
+    }
+  }
   function getNumThreads(){
     return pool.length;
   }
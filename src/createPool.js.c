@@ -1 +1 @@
-static const char* kCreatePool_js= "(\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x63\x72\x65\x61\x74\x65\x50\x6f\x6f\x6c\x28\x6e\x29\x7b\x76\x61\x72 \x54\x2c\x70\x6f\x6f\x6c\x2c\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x2c\x71\x2c\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2c\x65\x2c\x52\x55\x4e\x2c\x45\x4d\x49\x54\x3b\x54\x3d\x74\x68\x69\x73\x3b\x6e\x3d\x4d\x61\x74\x68\x2e\x66\x6c\x6f\x6f\x72\x28\x6e\x29\x3b\x69\x66\x28\x21\x28\x6e\x3e\x30\x29\x29\x7b\x74\x68\x72\x6f\x77\x27\x2e\x63\x72\x65\x61\x74\x65\x50\x6f\x6f\x6c\x28 \x6e\x75\x6d \x29\x3a \x6e\x75\x6d\x62\x65\x72 \x6f\x66 \x74\x68\x72\x65\x61\x64\x73 \x6d\x75\x73\x74 \x62\x65 \x61 \x4e\x75\x6d\x62\x65\x72 \x3e \x30\x27\x3b\x7d\n\x70\x6f\x6f\x6c\x3d\x5b\x5d\x3b\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x3d\x5b\x5d\x3b\x71\x3d\x7b\x66\x69\x72\x73\x74\x3a\x6e\x75\x6c\x6c\x2c\x6c\x61\x73\x74\x3a\x6e\x75\x6c\x6c\x2c\x6c\x65\x6e\x67\x74\x68\x3a\x30\x7d\x3b\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3d\x7b\x6f\x6e\x3a\x6f\x6e\x45\x76\x65\x6e\x74\x2c\x6c\x6f\x61\x64\x3a\x70\x6f\x6f\x6c\x4c\x6f\x61\x64\x2c\x64\x65\x73\x74\x72\x6f\x79\x3a\x64\x65\x73\x74\x72\x6f\x79\x2c\x70\x65\x6e\x64\x69\x6e\x67\x4a\x6f\x62\x73\x3a\x67\x65\x74\x50\x65\x6e\x64\x69\x6e\x67\x4a\x6f\x62\x73\x2c\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x3a\x67\x65\x74\x49\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x2c\x74\x6f\x74\x61\x6c\x54\x68\x72\x65\x61\x64\x73\x3a\x67\x65\x74\x4e\x75\x6d\x54\x68\x72\x65\x61\x64\x73\x2c\x61\x6e\x79\x3a\x7b\x65\x76\x61\x6c\x3a\x65\x76\x61\x6c\x41\x6e\x79\x2c\x65\x6d\x69\x74\x3a\x65\x6d\x69\x74\x41\x6e\x79\x7d\x2c\x61\x6c\x6c\x3a\x7b\x65\x76\x61\x6c\x3a\x65\x76\x61\x6c\x41\x6c\x6c\x2c\x65\x6d\x69\x74\x3a\x65\x6d\x69\x74\x41\x6c\x6c\x7d\x7d\x3b\x74\x72\x79\x7b\x77\x68\x69\x6c\x65\x28\x6e\x2d\x2d\x29\x7b\x70\x6f\x6f\x6c\x5b\x6e\x5d\x3d\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x5b\x6e\x5d\x3d\x54\x2e\x63\x72\x65\x61\x74\x65\x28\x29\x3b\x7d\x7d\x63\x61\x74\x63\x68\x28\x65\x24\x29\x7b\x65\x3d\x65\x24\x3b\x64\x65\x73\x74\x72\x6f\x79\x28\x27\x72\x75\x64\x65\x6c\x79\x27\x29\x3b\x74\x68\x72\x6f\x77 \x65\x3b\x7d\n\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3b\x52\x55\x4e\x3d\x31\x3b\x45\x4d\x49\x54\x3d\x32\x3b\x66\x75\x6e\x63\x74\x69\x6f\x6e \x70\x6f\x6f\x6c\x4c\x6f\x61\x64\x28\x70\x61\x74\x68\x2c\x63\x62\x29\x7b\x76\x61\x72 \x69\x3b\x69\x3d\x70\x6f\x6f\x6c\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x77\x68\x69\x6c\x65\x28\x69\x2d\x2d\x29\x7b\x70\x6f\x6f\x6c\x5b\x69\x5d\x2e\x6c\x6f\x61\x64\x28\x70\x61\x74\x68\x2c\x63\x62\x29\x3b\x7d\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x6e\x65\x78\x74\x4a\x6f\x62\x28\x74\x29\x7b\x76\x61\x72 \x6a\x6f\x62\x3b\x6a\x6f\x62\x3d\x71\x50\x75\x6c\x6c\x28\x29\x3b\x69\x66\x28\x6a\x6f\x62\x29\x7b\x69\x66\x28\x6a\x6f\x62\x2e\x74\x79\x70\x65\x3d\x3d\x3d\x52\x55\x4e\x29\x7b\x74\x2e\x65\x76\x61\x6c\x28\x6a\x6f\x62\x2e\x73\x72\x63\x54\x65\x78\x74\x4f\x72\x45\x76\x65\x6e\x74\x54\x79\x70\x65\x2c\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x65\x2c\x64\x29\x7b\x76\x61\x72 \x66\x3b\x6e\x65\x78\x74\x4a\x6f\x62\x28\x74\x29\x3b\x66\x3d\x6a\x6f\x62\x2e\x63\x62\x4f\x72\x44\x61\x74\x61\x3b\x69\x66\x28\x66\x29\x7b\x72\x65\x74\x75\x72\x6e \x6a\x6f\x62\x2e\x63\x62\x4f\x72\x44\x61\x74\x61\x2e\x63\x61\x6c\x6c\x28\x74\x2c\x65\x2c\x64\x29\x3b\x7d\x7d\x29\x3b\x7d\x65\x6c\x73\x65\x7b\x69\x66\x28\x6a\x6f\x62\x2e\x74\x79\x70\x65\x3d\x3d\x3d\x45\x4d\x49\x54\x29\x7b\x74\x2e\x65\x6d\x69\x74\x28\x6a\x6f\x62\x2e\x73\x72\x63\x54\x65\x78\x74\x4f\x72\x45\x76\x65\x6e\x74\x54\x79\x70\x65\x2c\x6a\x6f\x62\x2e\x63\x62\x4f\x72\x44\x61\x74\x61\x29\x3b\x6e\x65\x78\x74\x4a\x6f\x62\x28\x74\x29\x3b\x7d\x7d\x7d\x65\x6c\x73\x65\x7b\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x2e\x70\x75\x73\x68\x28\x74\x29\x3b\x7d\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x71\x50\x75\x73\x68\x28\x73\x72\x63\x54\x65\x78\x74\x4f\x72\x45\x76\x65\x6e\x74\x54\x79\x70\x65\x2c\x63\x62\x4f\x72\x44\x61\x74\x61\x2c\x74\x79\x70\x65\x29\x7b\x76\x61\x72 \x6a\x6f\x62\x3b\x6a\x6f\x62\x3d\x7b\x73\x72\x63\x54\x65\x78\x74\x4f\x72\x45\x76\x65\x6e\x74\x54\x79\x70\x65\x3a\x73\x72\x63\x54\x65\x78\x74\x4f\x72\x45\x76\x65\x6e\x74\x54\x79\x70\x65\x2c\x63\x62\x4f\x72\x44\x61\x74\x61\x3a\x63\x62\x4f\x72\x44\x61\x74\x61\x2c\x74\x79\x70\x65\x3a\x74\x79\x70\x65\x2c\x6e\x65\x78\x74\x3a\x6e\x75\x6c\x6c\x7d\x3b\x69\x66\x28\x71\x2e\x6c\x61\x73\x74\x29\x7b\x71\x2e\x6c\x61\x73\x74\x3d\x71\x2e\x6c\x61\x73\x74\x2e\x6e\x65\x78\x74\x3d\x6a\x6f\x62\x3b\x7d\x65\x6c\x73\x65\x7b\x71\x2e\x66\x69\x72\x73\x74\x3d\x71\x2e\x6c\x61\x73\x74\x3d\x6a\x6f\x62\x3b\x7d\n\x71\x2e\x6c\x65\x6e\x67\x74\x68\x2b\x2b\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x71\x50\x75\x6c\x6c\x28\x29\x7b\x76\x61\x72 \x6a\x6f\x62\x3b\x6a\x6f\x62\x3d\x71\x2e\x66\x69\x72\x73\x74\x3b\x69\x66\x28\x6a\x6f\x62\x29\x7b\x69\x66\x28\x71\x2e\x6c\x61\x73\x74\x3d\x3d\x3d\x6a\x6f\x62\x29\x7b\x71\x2e\x66\x69\x72\x73\x74\x3d\x71\x2e\x6c\x61\x73\x74\x3d\x6e\x75\x6c\x6c\x3b\x7d\x65\x6c\x73\x65\x7b\x71\x2e\x66\x69\x72\x73\x74\x3d\x6a\x6f\x62\x2e\x6e\x65\x78\x74\x3b\x7d\n\x71\x2e\x6c\x65\x6e\x67\x74\x68\x2d\x2d\x3b\x7d\n\x72\x65\x74\x75\x72\x6e \x6a\x6f\x62\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x65\x76\x61\x6c\x41\x6e\x79\x28\x73\x72\x63\x2c\x63\x62\x29\x7b\x71\x50\x75\x73\x68\x28\x73\x72\x63\x2c\x63\x62\x2c\x52\x55\x4e\x29\x3b\x69\x66\x28\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x2e\x6c\x65\x6e\x67\x74\x68\x29\x7b\x6e\x65\x78\x74\x4a\x6f\x62\x28\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x2e\x70\x6f\x70\x28\x29\x29\x3b\x7d\n\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x65\x76\x61\x6c\x41\x6c\x6c\x28\x73\x72\x63\x2c\x63\x62\x29\x7b\x70\x6f\x6f\x6c\x2e\x66\x6f\x72\x45\x61\x63\x68\x28\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x76\x2c\x69\x2c\x6f\x29\x7b\x72\x65\x74\x75\x72\x6e \x76\x2e\x65\x76\x61\x6c\x28\x73\x72\x63\x2c\x63\x62\x29\x3b\x7d\x29\x3b\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x65\x6d\x69\x74\x41\x6e\x79\x28\x65\x76\x65\x6e\x74\x2c\x64\x61\x74\x61\x29\x7b\x71\x50\x75\x73\x68\x28\x65\x76\x65\x6e\x74\x2c\x64\x61\x74\x61\x2c\x45\x4d\x49\x54\x29\x3b\x69\x66\x28\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x2e\x6c\x65\x6e\x67\x74\x68\x29\x7b\x6e\x65\x78\x74\x4a\x6f\x62\x28\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x2e\x70\x6f\x70\x28\x29\x29\x3b\x7d\n\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x65\x6d\x69\x74\x41\x6c\x6c\x28\x65\x76\x65\x6e\x74\x2c\x64\x61\x74\x61\x29\x7b\x70\x6f\x6f\x6c\x2e\x66\x6f\x72\x45\x61\x63\x68\x28\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x76\x2c\x69\x2c\x6f\x29\x7b\x72\x65\x74\x75\x72\x6e \x76\x2e\x65\x6d\x69\x74\x28\x65\x76\x65\x6e\x74\x2c\x64\x61\x74\x61\x29\x3b\x7d\x29\x3b\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x6f\x6e\x45\x76\x65\x6e\x74\x28\x65\x76\x65\x6e\x74\x2c\x63\x62\x29\x7b\x70\x6f\x6f\x6c\x2e\x66\x6f\x72\x45\x61\x63\x68\x28\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x76\x2c\x69\x2c\x6f\x29\x7b\x72\x65\x74\x75\x72\x6e \x76\x2e\x6f\x6e\x28\x65\x76\x65\x6e\x74\x2c\x63\x62\x29\x3b\x7d\x29\x3b\x72\x65\x74\x75\x72\x6e \x74\x68\x69\x73\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x64\x65\x73\x74\x72\x6f\x79\x28\x72\x75\x64\x65\x6c\x79\x29\x7b\x76\x61\x72 \x65\x72\x72\x2c\x62\x65\x4e\x69\x63\x65\x2c\x62\x65\x52\x75\x64\x65\x3b\x65\x72\x72\x3d\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x29\x7b\x74\x68\x72\x6f\x77\x27\x54\x68\x69\x73 \x74\x68\x72\x65\x61\x64 \x70\x6f\x6f\x6c \x68\x61\x73 \x62\x65\x65\x6e \x64\x65\x73\x74\x72\x6f\x79\x65\x64\x27\x3b\x7d\x3b\x62\x65\x4e\x69\x63\x65\x3d\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x29\x7b\x69\x66\x28\x71\x2e\x6c\x65\x6e\x67\x74\x68\x29\x7b\x72\x65\x74\x75\x72\x6e \x73\x65\x74\x54\x69\x6d\x65\x6f\x75\x74\x28\x62\x65\x4e\x69\x63\x65\x2c\x36\x36\x36\x29\x3b\x7d\x65\x6c\x73\x65\x7b\x72\x65\x74\x75\x72\x6e \x62\x65\x52\x75\x64\x65\x28\x29\x3b\x7d\x7d\x3b\x62\x65\x52\x75\x64\x65\x3d\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x29\x7b\x71\x2e\x6c\x65\x6e\x67\x74\x68\x3d\x30\x3b\x71\x2e\x66\x69\x72\x73\x74\x3d\x6e\x75\x6c\x6c\x3b\x70\x6f\x6f\x6c\x2e\x66\x6f\x72\x45\x61\x63\x68\x28\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x76\x2c\x69\x2c\x6f\x29\x7b\x72\x65\x74\x75\x72\x6e \x76\x2e\x64\x65\x73\x74\x72\x6f\x79\x28\x29\x3b\x7d\x29\x3b\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2e\x65\x76\x61\x6c\x3d\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2e\x74\x6f\x74\x61\x6c\x54\x68\x72\x65\x61\x64\x73\x3d\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2e\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x3d\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2e\x70\x65\x6e\x64\x69\x6e\x67\x4a\x6f\x62\x73\x3d\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2e\x64\x65\x73\x74\x72\x6f\x79\x3d\x65\x72\x72\x3b\x7d\x3b\x69\x66\x28\x72\x75\x64\x65\x6c\x79\x29\x7b\x62\x65\x52\x75\x64\x65\x28\x29\x3b\x7d\x65\x6c\x73\x65\x7b\x62\x65\x4e\x69\x63\x65\x28\x29\x3b\x7d\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x67\x65\x74\x4e\x75\x6d\x54\x68\x72\x65\x61\x64\x73\x28\x29\x7b\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x67\x65\x74\x49\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x28\x29\x7b\x72\x65\x74\x75\x72\x6e \x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x67\x65\x74\x50\x65\x6e\x64\x69\x6e\x67\x4a\x6f\x62\x73\x28\x29\x7b\x72\x65\x74\x75\x72\x6e \x71\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x7d\n\x72\x65\x74\x75\x72\x6e \x67\x65\x74\x50\x65\x6e\x64\x69\x6e\x67\x4a\x6f\x62\x73\x3b\x7d)";
+static const char* kCreatePool_js= "(\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x63\x72\x65\x61\x74\x65\x50\x6f\x6f\x6c\x28\x6e\x2c\x6f\x70\x74\x69\x6f\x6e\x73\x29\x7b\x76\x61\x72 \x54\x2c\x70\x6f\x6f\x6c\x2c\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x2c\x61\x63\x74\x6f\x72\x73\x2c\x73\x63\x68\x65\x64\x75\x6c\x65\x73\x2c\x69\x6e\x46\x6c\x69\x67\x68\x74\x2c\x63\x6f\x61\x6c\x65\x73\x63\x69\x6e\x67\x2c\x73\x68\x61\x72\x64\x73\x2c\x62\x61\x74\x63\x68\x69\x6e\x67\x2c\x65\x64\x66\x2c\x68\x65\x61\x70\x2c\x61\x72\x72\x69\x76\x61\x6c\x73\x2c\x64\x65\x61\x64\x6c\x69\x6e\x65\x73\x2c\x73\x68\x65\x64\x64\x69\x6e\x67\x2c\x64\x65\x73\x74\x72\x6f\x79\x65\x64\x2c\x71\x2c\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2c\x65\x2c\x6d\x65\x6d\x6f\x53\x63\x6f\x70\x65\x2c\x69\x24\x2c\x6c\x65\x6e\x24\x2c\x74\x2c\x52\x55\x4e\x2c\x45\x4d\x49\x54\x2c\x43\x41\x4c\x4c\x2c\x4c\x4f\x41\x44\x2c\x41\x4e\x59\x2c\x41\x4c\x4c\x2c\x53\x48\x41\x52\x44\x5f\x48\x45\x4c\x50\x45\x52\x53\x2c\x42\x41\x54\x43\x48\x5f\x48\x45\x4c\x50\x45\x52\x3b\x54\x3d\x74\x68\x69\x73\x3b\x6e\x3d\x4d\x61\x74\x68\x2e\x66\x6c\x6f\x6f\x72\x28\x6e\x29\x3b\x69\x66\x28\x21\x28\x6e\x3e\x30\x29\x29\x7b\x74\x68\x72\x6f\x77\x27\x2e\x63\x72\x65\x61\x74\x65\x50\x6f\x6f\x6c\x28 \x6e\x75\x6d \x5b\x2c \x6f\x70\x74\x69\x6f\x6e\x73\x5d \x29\x3a \x6e\x75\x6d\x62\x65\x72 \x6f\x66 \x74\x68\x72\x65\x61\x64\x73 \x6d\x75\x73\x74 \x62\x65 \x61 \x4e\x75\x6d\x62\x65\x72 \x3e \x30\x27\x3b\x7d\n\x52\x55\x4e\x3d\x31\x3b\x45\x4d\x49\x54\x3d\x32\x3b\x43\x41\x4c\x4c\x3d\x33\x3b\x4c\x4f\x41\x44\x3d\x34\x3b\x41\x4e\x59\x3d\x31\x3b\x41\x4c\x4c\x3d\x32\x3b\x53\x48\x41\x52\x44\x5f\x48\x45\x4c\x50\x45\x52\x53\x3d\x27\x76\x61\x72 \x5f\x5f\x73\x68\x61\x72\x64\x73\x3d \x7b\x7d\x2c \x5f\x5f\x73\x68\x61\x72\x64\x51\x75\x65\x72\x69\x65\x73\x3d \x7b\x7d\x2c \x5f\x5f\x73\x68\x61\x72\x64\x51\x75\x65\x72\x69\x65\x73\x4c\x65\x6e\x67\x74\x68\x3d \x30\x3b\x5c\x6e\x66\x75\x6e\x63\x74\x69\x6f\x6e \x5f\x5f\x73\x68\x61\x72\x64\x4c\x6f\x61\x64 \x28\x73\x72\x63\x2c \x6d\x69\x6e\x65\x29 \x7b\x5c\x6e  \x76\x61\x72 \x6c\x6f\x61\x64\x65\x72\x3d \x65\x76\x61\x6c\x28\x5c\x27\x28\x5c\x27\x2b \x73\x72\x63\x2b \x5c\x27\x29\x5c\x27\x29\x3b\x5c\x6e  \x5f\x5f\x73\x68\x61\x72\x64\x73\x3d \x7b\x7d\x3b\x5c\x6e  \x5f\x5f\x73\x68\x61\x72\x64\x51\x75\x65\x72\x69\x65\x73\x3d \x7b\x7d\x3b\x5c\x6e  \x5f\x5f\x73\x68\x61\x72\x64\x51\x75\x65\x72\x69\x65\x73\x4c\x65\x6e\x67\x74\x68\x3d \x30\x3b\x5c\x6e  \x66\x6f\x72 \x28\x76\x61\x72 \x69\x3d \x30\x3b \x69 \x3c \x6d\x69\x6e\x65\x2e\x6c\x65\x6e\x67\x74\x68\x3b \x69\x2b\x2b\x29 \x5f\x5f\x73\x68\x61\x72\x64\x73\x5b\x6d\x69\x6e\x65\x5b\x69\x5d\x5b\x30\x5d\x5d\x3d \x6c\x6f\x61\x64\x65\x72\x28\x6d\x69\x6e\x65\x5b\x69\x5d\x5b\x31\x5d\x2c \x6d\x69\x6e\x65\x5b\x69\x5d\x5b\x30\x5d\x29\x3b\x5c\x6e  \x72\x65\x74\x75\x72\x6e \x6d\x69\x6e\x65\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x5c\x6e\x7d\x5c\x6e\x66\x75\x6e\x63\x74\x69\x6f\x6e \x5f\x5f\x73\x68\x61\x72\x64\x51\x75\x65\x72\x79 \x28\x73\x72\x63\x2c \x61\x72\x67\x73\x29 \x7b\x5c\x6e  \x76\x61\x72 \x66\x6e\x3d \x5f\x5f\x73\x68\x61\x72\x64\x51\x75\x65\x72\x69\x65\x73\x5b\x73\x72\x63\x5d\x3b\x5c\x6e  \x69\x66 \x28\x21\x66\x6e\x29 \x7b\x5c\x6e    \x69\x66 \x28\x2b\x2b\x5f\x5f\x73\x68\x61\x72\x64\x51\x75\x65\x72\x69\x65\x73\x4c\x65\x6e\x67\x74\x68 \x3e \x36\x34\x29 \x7b\x5c\x6e      \x5f\x5f\x73\x68\x61\x72\x64\x51\x75\x65\x72\x69\x65\x73\x3d \x7b\x7d\x3b\x5c\x6e      \x5f\x5f\x73\x68\x61\x72\x64\x51\x75\x65\x72\x69\x65\x73\x4c\x65\x6e\x67\x74\x68\x3d \x31\x3b\x5c\x6e    \x7d\x5c\x6e    \x66\x6e\x3d \x5f\x5f\x73\x68\x61\x72\x64\x51\x75\x65\x72\x69\x65\x73\x5b\x73\x72\x63\x5d\x3d \x65\x76\x61\x6c\x28\x5c\x27\x28\x5c\x27\x2b \x73\x72\x63\x2b \x5c\x27\x29\x5c\x27\x29\x3b\x5c\x6e  \x7d\x5c\x6e  \x76\x61\x72 \x72\x65\x73\x75\x6c\x74\x73\x3d \x5b\x5d\x3b\x5c\x6e  \x66\x6f\x72 \x28\x76\x61\x72 \x69 \x69\x6e \x5f\x5f\x73\x68\x61\x72\x64\x73\x29 \x72\x65\x73\x75\x6c\x74\x73\x2e\x70\x75\x73\x68\x28\x5b\x2b\x69\x2c \x66\x6e\x2e\x61\x70\x70\x6c\x79\x28\x6e\x75\x6c\x6c\x2c \x5b\x5f\x5f\x73\x68\x61\x72\x64\x73\x5b\x69\x5d\x5d\x2e\x63\x6f\x6e\x63\x61\x74\x28\x61\x72\x67\x73\x29\x29\x5d\x29\x3b\x5c\x6e  \x72\x65\x74\x75\x72\x6e \x72\x65\x73\x75\x6c\x74\x73\x3b\x5c\x6e\x7d\x27\x3b\x42\x41\x54\x43\x48\x5f\x48\x45\x4c\x50\x45\x52\x3d\x27\x66\x75\x6e\x63\x74\x69\x6f\x6e \x5f\x5f\x62\x61\x74\x63\x68 \x28\x6e\x61\x6d\x65\x2c \x61\x72\x67\x73\x4c\x69\x73\x74\x29 \x7b\x5c\x6e  \x76\x61\x72 \x70\x61\x74\x68\x3d \x6e\x61\x6d\x65\x2e\x73\x70\x6c\x69\x74\x28\x5c\x27\x2e\x5c\x27\x29\x2c \x68\x6f\x6c\x64\x65\x72\x3d \x67\x6c\x6f\x62\x61\x6c\x2c \x66\x6e\x3d \x67\x6c\x6f\x62\x61\x6c\x3b\x5c\x6e  \x66\x6f\x72 \x28\x76\x61\x72 \x69\x3d \x30\x3b \x69 \x3c \x70\x61\x74\x68\x2e\x6c\x65\x6e\x67\x74\x68\x3b \x69\x2b\x2b\x29 \x7b \x68\x6f\x6c\x64\x65\x72\x3d \x66\x6e\x3b \x66\x6e\x3d \x66\x6e\x5b\x70\x61\x74\x68\x5b\x69\x5d\x5d \x7d\x5c\x6e  \x69\x66 \x28\x74\x79\x70\x65\x6f\x66 \x66\x6e \x21\x3d\x3d \x5c\x27\x66\x75\x6e\x63\x74\x69\x6f\x6e\x5c\x27\x29 \x74\x68\x72\x6f\x77 \x6e\x65\x77 \x54\x79\x70\x65\x45\x72\x72\x6f\x72\x28\x5c\x27\x74\x68\x72\x65\x61\x64\x2e\x63\x61\x6c\x6c\x28\x29\x3a \x5c\x27\x2b \x6e\x61\x6d\x65\x2b \x5c\x27 \x69\x73 \x6e\x6f\x74 \x61 \x66\x75\x6e\x63\x74\x69\x6f\x6e\x5c\x27\x29\x3b\x5c\x6e  \x76\x61\x72 \x72\x65\x73\x75\x6c\x74\x73\x3d \x5b\x5d\x3b\x5c\x6e  \x66\x6f\x72 \x28\x76\x61\x72 \x69\x3d \x30\x3b \x69 \x3c \x61\x72\x67\x73\x4c\x69\x73\x74\x2e\x6c\x65\x6e\x67\x74\x68\x3b \x69\x2b\x2b\x29 \x7b\x5c\x6e    \x74\x72\x79 \x7b \x72\x65\x73\x75\x6c\x74\x73\x2e\x70\x75\x73\x68\x28\x5b\x30\x2c \x66\x6e\x2e\x61\x70\x70\x6c\x79\x28\x68\x6f\x6c\x64\x65\x72\x2c \x61\x72\x67\x73\x4c\x69\x73\x74\x5b\x69\x5d\x29\x5d\x29 \x7d\x5c\x6e    \x63\x61\x74\x63\x68 \x28\x65\x29 \x7b \x72\x65\x73\x75\x6c\x74\x73\x2e\x70\x75\x73\x68\x28\x5b\x31\x2c \x53\x74\x72\x69\x6e\x67\x28\x65\x29\x5d\x29 \x7d\x5c\x6e  \x7d\x5c\x6e  \x72\x65\x74\x75\x72\x6e \x72\x65\x73\x75\x6c\x74\x73\x3b\x5c\x6e\x7d\x27\x3b\x70\x6f\x6f\x6c\x3d\x5b\x5d\x3b\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x3d\x5b\x5d\x3b\x61\x63\x74\x6f\x72\x73\x3d\x5b\x5d\x3b\x73\x63\x68\x65\x64\x75\x6c\x65\x73\x3d\x5b\x5d\x3b\x69\x6e\x46\x6c\x69\x67\x68\x74\x3d\x7b\x7d\x3b\x63\x6f\x61\x6c\x65\x73\x63\x69\x6e\x67\x3d\x7b\x6c\x65\x61\x64\x65\x72\x73\x3a\x30\x2c\x63\x6f\x61\x6c\x65\x73\x63\x65\x64\x3a\x30\x7d\x3b\x73\x68\x61\x72\x64\x73\x3d\x30\x3b\x62\x61\x74\x63\x68\x69\x6e\x67\x3d\x62\x61\x74\x63\x68\x4f\x70\x74\x69\x6f\x6e\x73\x28\x6f\x70\x74\x69\x6f\x6e\x73\x21\x3d\x6e\x75\x6c\x6c\x3f\x6f\x70\x74\x69\x6f\x6e\x73\x2e\x62\x61\x74\x63\x68\x3a\x76\x6f\x69\x64 \x38\x29\x3b\x65\x64\x66\x3d\x28\x6f\x70\x74\x69\x6f\x6e\x73\x21\x3d\x6e\x75\x6c\x6c\x3f\x6f\x70\x74\x69\x6f\x6e\x73\x2e\x71\x75\x65\x75\x65\x3a\x76\x6f\x69\x64 \x38\x29\x3d\x3d\x3d\x27\x65\x64\x66\x27\x3b\x68\x65\x61\x70\x3d\x5b\x5d\x3b\x61\x72\x72\x69\x76\x61\x6c\x73\x3d\x30\x3b\x64\x65\x61\x64\x6c\x69\x6e\x65\x73\x3d\x7b\x64\x72\x6f\x70\x70\x65\x64\x3a\x30\x2c\x6c\x61\x74\x65\x3a\x30\x2c\x6d\x65\x74\x3a\x30\x7d\x3b\x73\x68\x65\x64\x64\x69\x6e\x67\x3d\x73\x68\x65\x64\x4f\x70\x74\x69\x6f\x6e\x73\x28\x6f\x70\x74\x69\x6f\x6e\x73\x21\x3d\x6e\x75\x6c\x6c\x3f\x6f\x70\x74\x69\x6f\x6e\x73\x2e\x73\x68\x65\x64\x3a\x76\x6f\x69\x64 \x38\x29\x3b\x64\x65\x73\x74\x72\x6f\x79\x65\x64\x3d\x66\x61\x6c\x73\x65\x3b\x71\x3d\x7b\x66\x69\x72\x73\x74\x3a\x6e\x75\x6c\x6c\x2c\x6c\x61\x73\x74\x3a\x6e\x75\x6c\x6c\x2c\x6c\x65\x6e\x67\x74\x68\x3a\x30\x7d\x3b\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3d\x7b\x6f\x6e\x3a\x6f\x6e\x45\x76\x65\x6e\x74\x2c\x6c\x6f\x61\x64\x3a\x70\x6f\x6f\x6c\x4c\x6f\x61\x64\x2c\x73\x6f\x72\x74\x3a\x70\x6f\x6f\x6c\x53\x6f\x72\x74\x2c\x62\x69\x6e\x61\x72\x79\x53\x65\x61\x72\x63\x68\x4d\x61\x6e\x79\x3a\x70\x6f\x6f\x6c\x42\x69\x6e\x61\x72\x79\x53\x65\x61\x72\x63\x68\x4d\x61\x6e\x79\x2c\x70\x61\x72\x73\x65\x4a\x53\x4f\x4e\x3a\x70\x6f\x6f\x6c\x50\x61\x72\x73\x65\x4a\x53\x4f\x4e\x2c\x73\x74\x72\x69\x6e\x67\x69\x66\x79\x4a\x53\x4f\x4e\x3a\x70\x6f\x6f\x6c\x53\x74\x72\x69\x6e\x67\x69\x66\x79\x4a\x53\x4f\x4e\x2c\x73\x65\x72\x76\x65\x3a\x70\x6f\x6f\x6c\x53\x65\x72\x76\x65\x2c\x73\x68\x61\x72\x64\x3a\x70\x6f\x6f\x6c\x53\x68\x61\x72\x64\x2c\x73\x63\x61\x74\x74\x65\x72\x3a\x70\x6f\x6f\x6c\x53\x63\x61\x74\x74\x65\x72\x2c\x73\x70\x61\x77\x6e\x41\x63\x74\x6f\x72\x3a\x70\x6f\x6f\x6c\x53\x70\x61\x77\x6e\x41\x63\x74\x6f\x72\x2c\x63\x6f\x61\x6c\x65\x73\x63\x65\x53\x74\x61\x74\x73\x3a\x67\x65\x74\x43\x6f\x61\x6c\x65\x73\x63\x65\x53\x74\x61\x74\x73\x2c\x62\x61\x74\x63\x68\x53\x74\x61\x74\x73\x3a\x67\x65\x74\x42\x61\x74\x63\x68\x53\x74\x61\x74\x73\x2c\x64\x65\x61\x64\x6c\x69\x6e\x65\x53\x74\x61\x74\x73\x3a\x67\x65\x74\x44\x65\x61\x64\x6c\x69\x6e\x65\x53\x74\x61\x74\x73\x2c\x73\x68\x65\x64\x53\x74\x61\x74\x73\x3a\x67\x65\x74\x53\x68\x65\x64\x53\x74\x61\x74\x73\x2c\x73\x63\x68\x65\x64\x75\x6c\x65\x3a\x70\x6f\x6f\x6c\x53\x63\x68\x65\x64\x75\x6c\x65\x2c\x64\x65\x73\x74\x72\x6f\x79\x3a\x64\x65\x73\x74\x72\x6f\x79\x2c\x70\x65\x6e\x64\x69\x6e\x67\x4a\x6f\x62\x73\x3a\x67\x65\x74\x50\x65\x6e\x64\x69\x6e\x67\x4a\x6f\x62\x73\x2c\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x3a\x67\x65\x74\x49\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x2c\x74\x6f\x74\x61\x6c\x54\x68\x72\x65\x61\x64\x73\x3a\x67\x65\x74\x4e\x75\x6d\x54\x68\x72\x65\x61\x64\x73\x2c\x61\x6e\x79\x3a\x7b\x65\x76\x61\x6c\x3a\x65\x76\x61\x6c\x41\x6e\x79\x2c\x65\x6d\x69\x74\x3a\x65\x6d\x69\x74\x41\x6e\x79\x2c\x63\x61\x6c\x6c\x3a\x63\x61\x6c\x6c\x41\x6e\x79\x2c\x63\x68\x61\x69\x6e\x3a\x63\x61\x6c\x6c\x43\x68\x61\x69\x6e\x7d\x2c\x61\x6c\x6c\x3a\x7b\x65\x76\x61\x6c\x3a\x65\x76\x61\x6c\x41\x6c\x6c\x2c\x65\x6d\x69\x74\x3a\x65\x6d\x69\x74\x41\x6c\x6c\x2c\x63\x61\x6c\x6c\x3a\x63\x61\x6c\x6c\x41\x6c\x6c\x7d\x7d\x3b\x74\x72\x79\x7b\x77\x68\x69\x6c\x65\x28\x6e\x2d\x2d\x29\x7b\x70\x6f\x6f\x6c\x5b\x6e\x5d\x3d\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x5b\x6e\x5d\x3d\x54\x2e\x63\x72\x65\x61\x74\x65\x28\x7b\x70\x6f\x6f\x6c\x65\x64\x3a\x74\x72\x75\x65\x7d\x29\x3b\x7d\x7d\x63\x61\x74\x63\x68\x28\x65\x24\x29\x7b\x65\x3d\x65\x24\x3b\x64\x65\x73\x74\x72\x6f\x79\x28\x27\x72\x75\x64\x65\x6c\x79\x27\x29\x3b\x74\x68\x72\x6f\x77 \x65\x3b\x7d\n\x6d\x65\x6d\x6f\x53\x63\x6f\x70\x65\x3d\x22\x70\x6f\x6f\x6c\x22\x2b\x70\x6f\x6f\x6c\x5b\x30\x5d\x2e\x69\x64\x3b\x69\x66\x28\x62\x61\x74\x63\x68\x69\x6e\x67\x29\x7b\x66\x6f\x72\x28\x69\x24\x3d\x30\x2c\x6c\x65\x6e\x24\x3d\x70\x6f\x6f\x6c\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x69\x24\x3c\x6c\x65\x6e\x24\x3b\x2b\x2b\x69\x24\x29\x7b\x74\x3d\x70\x6f\x6f\x6c\x5b\x69\x24\x5d\x3b\x74\x2e\x65\x76\x61\x6c\x28\x42\x41\x54\x43\x48\x5f\x48\x45\x4c\x50\x45\x52\x29\x3b\x7d\x7d\n\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3b\x66\x75\x6e\x63\x74\x69\x6f\x6e \x70\x6f\x6f\x6c\x4c\x6f\x61\x64\x28\x70\x61\x74\x68\x2c\x63\x62\x29\x7b\x76\x61\x72 \x69\x3b\x72\x65\x63\x6f\x72\x64\x28\x4c\x4f\x41\x44\x2c\x41\x4c\x4c\x2c\x70\x61\x74\x68\x29\x3b\x69\x3d\x70\x6f\x6f\x6c\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x77\x68\x69\x6c\x65\x28\x69\x2d\x2d\x29\x7b\x70\x6f\x6f\x6c\x5b\x69\x5d\x2e\x6c\x6f\x61\x64\x28\x70\x61\x74\x68\x2c\x63\x62\x29\x3b\x7d\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x6e\x65\x78\x74\x4a\x6f\x62\x28\x74\x29\x7b\x76\x61\x72 \x6a\x6f\x62\x2c\x6a\x6f\x62\x73\x2c\x74\x30\x3b\x69\x66\x28\x64\x65\x73\x74\x72\x6f\x79\x65\x64\x29\x7b\x72\x65\x74\x75\x72\x6e\x3b\x7d\n\x6a\x6f\x62\x3d\x71\x50\x75\x6c\x6c\x28\x29\x3b\x77\x68\x69\x6c\x65\x28\x6a\x6f\x62\x26\x26\x28\x65\x78\x70\x69\x72\x65\x64\x28\x6a\x6f\x62\x29\x7c\x7c\x73\x68\x65\x64\x28\x6a\x6f\x62\x29\x29\x29\x7b\x6a\x6f\x62\x3d\x71\x50\x75\x6c\x6c\x28\x29\x3b\x7d\n\x69\x66\x28\x6a\x6f\x62\x29\x7b\x69\x66\x28\x6a\x6f\x62\x2e\x74\x79\x70\x65\x3d\x3d\x3d\x52\x55\x4e\x29\x7b\x74\x2e\x65\x76\x61\x6c\x28\x6a\x6f\x62\x2e\x73\x72\x63\x54\x65\x78\x74\x4f\x72\x45\x76\x65\x6e\x74\x54\x79\x70\x65\x2c\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x65\x2c\x64\x29\x7b\x76\x61\x72 \x66\x3b\x6e\x65\x78\x74\x4a\x6f\x62\x28\x74\x29\x3b\x66\x3d\x6a\x6f\x62\x2e\x63\x62\x4f\x72\x44\x61\x74\x61\x3b\x69\x66\x28\x66\x29\x7b\x72\x65\x74\x75\x72\x6e \x6a\x6f\x62\x2e\x63\x62\x4f\x72\x44\x61\x74\x61\x2e\x63\x61\x6c\x6c\x28\x74\x2c\x65\x2c\x64\x29\x3b\x7d\x7d\x29\x3b\x7d\x65\x6c\x73\x65 \x69\x66\x28\x6a\x6f\x62\x2e\x74\x79\x70\x65\x3d\x3d\x3d\x43\x41\x4c\x4c\x29\x7b\x69\x66\x28\x6a\x6f\x62\x2e\x62\x61\x74\x63\x68\x29\x7b\x6a\x6f\x62\x73\x3d\x62\x61\x74\x63\x68\x54\x61\x6b\x65\x28\x6a\x6f\x62\x29\x3b\x69\x66\x28\x6a\x6f\x62\x73\x2e\x6c\x65\x6e\x67\x74\x68\x3e\x31\x29\x7b\x72\x65\x74\x75\x72\x6e \x62\x61\x74\x63\x68\x43\x61\x6c\x6c\x28\x74\x2c\x6a\x6f\x62\x73\x29\x3b\x7d\n\x74\x30\x3d\x70\x72\x6f\x63\x65\x73\x73\x2e\x68\x72\x74\x69\x6d\x65\x28\x29\x3b\x7d\n\x74\x2e\x63\x61\x6c\x6c\x28\x6a\x6f\x62\x2e\x73\x72\x63\x54\x65\x78\x74\x4f\x72\x45\x76\x65\x6e\x74\x54\x79\x70\x65\x2c\x6a\x6f\x62\x2e\x61\x72\x67\x73\x2c\x6a\x6f\x62\x2e\x6d\x65\x6d\x6f\x2c\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x65\x2c\x64\x29\x7b\x76\x61\x72 \x66\x3b\x69\x66\x28\x6a\x6f\x62\x2e\x62\x61\x74\x63\x68\x29\x7b\x62\x61\x74\x63\x68\x41\x64\x61\x70\x74\x28\x6a\x6f\x62\x2e\x73\x72\x63\x54\x65\x78\x74\x4f\x72\x45\x76\x65\x6e\x74\x54\x79\x70\x65\x2c\x31\x2c\x70\x72\x6f\x63\x65\x73\x73\x2e\x68\x72\x74\x69\x6d\x65\x28\x74\x30\x29\x29\x3b\x7d\n\x64\x65\x61\x64\x6c\x69\x6e\x65\x44\x6f\x6e\x65\x28\x6a\x6f\x62\x29\x3b\x6e\x65\x78\x74\x4a\x6f\x62\x28\x74\x29\x3b\x66\x3d\x6a\x6f\x62\x2e\x63\x62\x4f\x72\x44\x61\x74\x61\x3b\x69\x66\x28\x66\x29\x7b\x72\x65\x74\x75\x72\x6e \x6a\x6f\x62\x2e\x63\x62\x4f\x72\x44\x61\x74\x61\x2e\x63\x61\x6c\x6c\x28\x74\x2c\x65\x2c\x64\x29\x3b\x7d\x7d\x29\x3b\x7d\x65\x6c\x73\x65\x7b\x69\x66\x28\x6a\x6f\x62\x2e\x74\x79\x70\x65\x3d\x3d\x3d\x45\x4d\x49\x54\x29\x7b\x74\x2e\x65\x6d\x69\x74\x28\x6a\x6f\x62\x2e\x73\x72\x63\x54\x65\x78\x74\x4f\x72\x45\x76\x65\x6e\x74\x54\x79\x70\x65\x2c\x6a\x6f\x62\x2e\x63\x62\x4f\x72\x44\x61\x74\x61\x29\x3b\x6e\x65\x78\x74\x4a\x6f\x62\x28\x74\x29\x3b\x7d\x7d\x7d\x65\x6c\x73\x65\x7b\x69\x66\x28\x73\x68\x65\x64\x64\x69\x6e\x67\x29\x7b\x73\x68\x65\x64\x64\x69\x6e\x67\x2e\x66\x69\x72\x73\x74\x41\x62\x6f\x76\x65\x3d\x73\x68\x65\x64\x64\x69\x6e\x67\x2e\x64\x72\x6f\x70\x70\x69\x6e\x67\x3d\x30\x3b\x7d\n\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x2e\x70\x75\x73\x68\x28\x74\x29\x3b\x7d\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x71\x50\x75\x73\x68\x28\x73\x72\x63\x54\x65\x78\x74\x4f\x72\x45\x76\x65\x6e\x74\x54\x79\x70\x65\x2c\x63\x62\x4f\x72\x44\x61\x74\x61\x2c\x74\x79\x70\x65\x2c\x61\x72\x67\x73\x2c\x6d\x65\x6d\x6f\x2c\x64\x65\x61\x64\x6c\x69\x6e\x65\x29\x7b\x76\x61\x72 \x6a\x6f\x62\x3b\x6a\x6f\x62\x3d\x7b\x73\x72\x63\x54\x65\x78\x74\x4f\x72\x45\x76\x65\x6e\x74\x54\x79\x70\x65\x3a\x73\x72\x63\x54\x65\x78\x74\x4f\x72\x45\x76\x65\x6e\x74\x54\x79\x70\x65\x2c\x63\x62\x4f\x72\x44\x61\x74\x61\x3a\x63\x62\x4f\x72\x44\x61\x74\x61\x2c\x74\x79\x70\x65\x3a\x74\x79\x70\x65\x2c\x61\x72\x67\x73\x3a\x61\x72\x67\x73\x2c\x6d\x65\x6d\x6f\x3a\x6d\x65\x6d\x6f\x2c\x64\x65\x61\x64\x6c\x69\x6e\x65\x3a\x64\x65\x61\x64\x6c\x69\x6e\x65\x2c\x6e\x65\x78\x74\x3a\x6e\x75\x6c\x6c\x2c\x70\x72\x65\x76\x3a\x6e\x75\x6c\x6c\x7d\x3b\x69\x66\x28\x73\x68\x65\x64\x64\x69\x6e\x67\x29\x7b\x6a\x6f\x62\x2e\x65\x6e\x71\x75\x65\x75\x65\x64\x3d\x6e\x6f\x77\x4d\x73\x28\x29\x3b\x7d\n\x71\x2e\x6c\x65\x6e\x67\x74\x68\x2b\x2b\x3b\x69\x66\x28\x65\x64\x66\x29\x7b\x68\x65\x61\x70\x50\x75\x73\x68\x28\x6a\x6f\x62\x29\x3b\x7d\x65\x6c\x73\x65 \x69\x66\x28\x71\x2e\x6c\x61\x73\x74\x29\x7b\x6a\x6f\x62\x2e\x70\x72\x65\x76\x3d\x71\x2e\x6c\x61\x73\x74\x3b\x71\x2e\x6c\x61\x73\x74\x3d\x71\x2e\x6c\x61\x73\x74\x2e\x6e\x65\x78\x74\x3d\x6a\x6f\x62\x3b\x7d\x65\x6c\x73\x65\x7b\x71\x2e\x66\x69\x72\x73\x74\x3d\x71\x2e\x6c\x61\x73\x74\x3d\x6a\x6f\x62\x3b\x7d\n\x72\x65\x74\x75\x72\x6e \x6a\x6f\x62\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x71\x50\x75\x6c\x6c\x28\x29\x7b\x76\x61\x72 \x6a\x6f\x62\x3b\x69\x66\x28\x65\x64\x66\x29\x7b\x6a\x6f\x62\x3d\x68\x65\x61\x70\x50\x6f\x70\x28\x29\x3b\x7d\x65\x6c\x73\x65 \x69\x66\x28\x6a\x6f\x62\x3d\x71\x2e\x66\x69\x72\x73\x74\x29\x7b\x69\x66\x28\x71\x2e\x6c\x61\x73\x74\x3d\x3d\x3d\x6a\x6f\x62\x29\x7b\x71\x2e\x66\x69\x72\x73\x74\x3d\x71\x2e\x6c\x61\x73\x74\x3d\x6e\x75\x6c\x6c\x3b\x7d\x65\x6c\x73\x65\x7b\x71\x2e\x66\x69\x72\x73\x74\x3d\x6a\x6f\x62\x2e\x6e\x65\x78\x74\x3b\x71\x2e\x66\x69\x72\x73\x74\x2e\x70\x72\x65\x76\x3d\x6e\x75\x6c\x6c\x3b\x7d\x7d\n\x69\x66\x28\x6a\x6f\x62\x29\x7b\x71\x2e\x6c\x65\x6e\x67\x74\x68\x2d\x2d\x3b\x69\x66\x28\x6a\x6f\x62\x2e\x62\x61\x74\x63\x68\x29\x7b\x62\x61\x74\x63\x68\x55\x6e\x6c\x69\x6e\x6b\x28\x6a\x6f\x62\x29\x3b\x7d\n\x69\x66\x28\x73\x68\x65\x64\x64\x69\x6e\x67\x29\x7b\x73\x6f\x6a\x6f\x75\x72\x6e\x28\x6a\x6f\x62\x29\x3b\x7d\x7d\n\x72\x65\x74\x75\x72\x6e \x6a\x6f\x62\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x71\x55\x6e\x6c\x69\x6e\x6b\x28\x6a\x6f\x62\x29\x7b\x69\x66\x28\x6a\x6f\x62\x2e\x70\x72\x65\x76\x29\x7b\x6a\x6f\x62\x2e\x70\x72\x65\x76\x2e\x6e\x65\x78\x74\x3d\x6a\x6f\x62\x2e\x6e\x65\x78\x74\x3b\x7d\x65\x6c\x73\x65\x7b\x71\x2e\x66\x69\x72\x73\x74\x3d\x6a\x6f\x62\x2e\x6e\x65\x78\x74\x3b\x7d\n\x69\x66\x28\x6a\x6f\x62\x2e\x6e\x65\x78\x74\x29\x7b\x6a\x6f\x62\x2e\x6e\x65\x78\x74\x2e\x70\x72\x65\x76\x3d\x6a\x6f\x62\x2e\x70\x72\x65\x76\x3b\x7d\x65\x6c\x73\x65\x7b\x71\x2e\x6c\x61\x73\x74\x3d\x6a\x6f\x62\x2e\x70\x72\x65\x76\x3b\x7d\n\x71\x2e\x6c\x65\x6e\x67\x74\x68\x2d\x2d\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x65\x76\x61\x6c\x41\x6e\x79\x28\x73\x72\x63\x2c\x63\x62\x29\x7b\x72\x65\x63\x6f\x72\x64\x28\x52\x55\x4e\x2c\x41\x4e\x59\x2c\x73\x72\x63\x29\x3b\x71\x50\x75\x73\x68\x28\x73\x72\x63\x2c\x63\x62\x2c\x52\x55\x4e\x29\x3b\x69\x66\x28\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x2e\x6c\x65\x6e\x67\x74\x68\x29\x7b\x6e\x65\x78\x74\x4a\x6f\x62\x28\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x2e\x70\x6f\x70\x28\x29\x29\x3b\x7d\n\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x65\x76\x61\x6c\x41\x6c\x6c\x28\x73\x72\x63\x2c\x63\x62\x29\x7b\x72\x65\x63\x6f\x72\x64\x28\x52\x55\x4e\x2c\x41\x4c\x4c\x2c\x73\x72\x63\x29\x3b\x70\x6f\x6f\x6c\x2e\x66\x6f\x72\x45\x61\x63\x68\x28\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x76\x2c\x69\x2c\x6f\x29\x7b\x72\x65\x74\x75\x72\x6e \x76\x2e\x65\x76\x61\x6c\x28\x73\x72\x63\x2c\x63\x62\x29\x3b\x7d\x29\x3b\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x65\x6d\x69\x74\x41\x6e\x79\x28\x65\x76\x65\x6e\x74\x2c\x64\x61\x74\x61\x29\x7b\x72\x65\x63\x6f\x72\x64\x28\x45\x4d\x49\x54\x2c\x41\x4e\x59\x2c\x65\x76\x65\x6e\x74\x2c\x5b\x64\x61\x74\x61\x5d\x29\x3b\x71\x50\x75\x73\x68\x28\x65\x76\x65\x6e\x74\x2c\x64\x61\x74\x61\x2c\x45\x4d\x49\x54\x29\x3b\x69\x66\x28\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x2e\x6c\x65\x6e\x67\x74\x68\x29\x7b\x6e\x65\x78\x74\x4a\x6f\x62\x28\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x2e\x70\x6f\x70\x28\x29\x29\x3b\x7d\n\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x65\x6d\x69\x74\x41\x6c\x6c\x28\x65\x76\x65\x6e\x74\x2c\x64\x61\x74\x61\x29\x7b\x72\x65\x63\x6f\x72\x64\x28\x45\x4d\x49\x54\x2c\x41\x4c\x4c\x2c\x65\x76\x65\x6e\x74\x2c\x5b\x64\x61\x74\x61\x5d\x29\x3b\x70\x6f\x6f\x6c\x2e\x66\x6f\x72\x45\x61\x63\x68\x28\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x76\x2c\x69\x2c\x6f\x29\x7b\x72\x65\x74\x75\x72\x6e \x76\x2e\x65\x6d\x69\x74\x28\x65\x76\x65\x6e\x74\x2c\x64\x61\x74\x61\x29\x3b\x7d\x29\x3b\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x63\x61\x6c\x6c\x41\x6e\x79\x28\x66\x6e\x4e\x61\x6d\x65\x2c\x61\x72\x67\x73\x2c\x6f\x70\x74\x69\x6f\x6e\x73\x2c\x63\x62\x29\x7b\x76\x61\x72 \x72\x65\x66\x24\x2c\x6d\x65\x6d\x6f\x2c\x69\x64\x2c\x77\x61\x69\x74\x65\x72\x73\x2c\x6a\x6f\x62\x3b\x69\x66\x28\x74\x79\x70\x65\x6f\x66 \x61\x72\x67\x73\x3d\x3d\x3d\x27\x66\x75\x6e\x63\x74\x69\x6f\x6e\x27\x29\x7b\x72\x65\x66\x24\x3d\x5b\x61\x72\x67\x73\x2c\x5b\x5d\x5d\x2c\x63\x62\x3d\x72\x65\x66\x24\x5b\x30\x5d\x2c\x61\x72\x67\x73\x3d\x72\x65\x66\x24\x5b\x31\x5d\x3b\x7d\x65\x6c\x73\x65 \x69\x66\x28\x74\x79\x70\x65\x6f\x66 \x6f\x70\x74\x69\x6f\x6e\x73\x3d\x3d\x3d\x27\x66\x75\x6e\x63\x74\x69\x6f\x6e\x27\x29\x7b\x72\x65\x66\x24\x3d\x5b\x6f\x70\x74\x69\x6f\x6e\x73\x2c\x6e\x75\x6c\x6c\x5d\x2c\x63\x62\x3d\x72\x65\x66\x24\x5b\x30\x5d\x2c\x6f\x70\x74\x69\x6f\x6e\x73\x3d\x72\x65\x66\x24\x5b\x31\x5d\x3b\x7d\n\x72\x65\x63\x6f\x72\x64\x28\x43\x41\x4c\x4c\x2c\x41\x4e\x59\x2c\x66\x6e\x4e\x61\x6d\x65\x2c\x61\x72\x67\x73\x29\x3b\x69\x66\x28\x63\x62\x26\x26\x28\x28\x6f\x70\x74\x69\x6f\x6e\x73\x21\x3d\x6e\x75\x6c\x6c\x26\x26\x6f\x70\x74\x69\x6f\x6e\x73\x2e\x6d\x65\x6d\x6f\x69\x7a\x65\x29\x7c\x7c\x28\x6f\x70\x74\x69\x6f\x6e\x73\x21\x3d\x6e\x75\x6c\x6c\x26\x26\x6f\x70\x74\x69\x6f\x6e\x73\x2e\x63\x6f\x61\x6c\x65\x73\x63\x65\x29\x29\x29\x7b\x6d\x65\x6d\x6f\x3d\x54\x2e\x6d\x65\x6d\x6f\x4c\x6f\x6f\x6b\x75\x70\x28\x6d\x65\x6d\x6f\x53\x63\x6f\x70\x65\x2c\x66\x6e\x4e\x61\x6d\x65\x2c\x61\x72\x67\x73\x2c\x21\x21\x6f\x70\x74\x69\x6f\x6e\x73\x2e\x6d\x65\x6d\x6f\x69\x7a\x65\x2c\x21\x21\x6f\x70\x74\x69\x6f\x6e\x73\x2e\x63\x6f\x61\x6c\x65\x73\x63\x65\x29\x3b\x69\x66\x28\x41\x72\x72\x61\x79\x2e\x69\x73\x41\x72\x72\x61\x79\x28\x6d\x65\x6d\x6f\x29\x29\x7b\x70\x72\x6f\x63\x65\x73\x73\x2e\x6e\x65\x78\x74\x54\x69\x63\x6b\x28\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x29\x7b\x72\x65\x74\x75\x72\x6e \x63\x62\x2e\x63\x61\x6c\x6c\x28\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2c\x6e\x75\x6c\x6c\x2c\x6d\x65\x6d\x6f\x5b\x30\x5d\x29\x3b\x7d\x29\x3b\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3b\x7d\n\x69\x66\x28\x6f\x70\x74\x69\x6f\x6e\x73\x2e\x63\x6f\x61\x6c\x65\x73\x63\x65\x29\x7b\x69\x64\x3d\x6d\x65\x6d\x6f\x2e\x69\x64\x3b\x69\x66\x28\x77\x61\x69\x74\x65\x72\x73\x3d\x69\x6e\x46\x6c\x69\x67\x68\x74\x5b\x69\x64\x5d\x29\x7b\x63\x6f\x61\x6c\x65\x73\x63\x69\x6e\x67\x2e\x63\x6f\x61\x6c\x65\x73\x63\x65\x64\x2b\x2b\x3b\x77\x61\x69\x74\x65\x72\x73\x2e\x70\x75\x73\x68\x28\x63\x62\x29\x3b\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3b\x7d\n\x63\x6f\x61\x6c\x65\x73\x63\x69\x6e\x67\x2e\x6c\x65\x61\x64\x65\x72\x73\x2b\x2b\x3b\x77\x61\x69\x74\x65\x72\x73\x3d\x69\x6e\x46\x6c\x69\x67\x68\x74\x5b\x69\x64\x5d\x3d\x5b\x63\x62\x5d\x3b\x63\x62\x3d\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x65\x2c\x64\x29\x7b\x76\x61\x72 \x69\x24\x2c\x72\x65\x66\x24\x2c\x6c\x65\x6e\x24\x2c\x77\x3b\x64\x65\x6c\x65\x74\x65 \x69\x6e\x46\x6c\x69\x67\x68\x74\x5b\x69\x64\x5d\x3b\x66\x6f\x72\x28\x69\x24\x3d\x30\x2c\x6c\x65\x6e\x24\x3d\x28\x72\x65\x66\x24\x3d\x77\x61\x69\x74\x65\x72\x73\x29\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x69\x24\x3c\x6c\x65\x6e\x24\x3b\x2b\x2b\x69\x24\x29\x7b\x77\x3d\x72\x65\x66\x24\x5b\x69\x24\x5d\x3b\x77\x2e\x63\x61\x6c\x6c\x28\x74\x68\x69\x73\x2c\x65\x2c\x64\x29\x3b\x7d\x7d\x3b\x7d\x7d\n\x69\x66\x28\x28\x73\x68\x65\x64\x64\x69\x6e\x67\x21\x3d\x6e\x75\x6c\x6c\x26\x26\x73\x68\x65\x64\x64\x69\x6e\x67\x2e\x64\x72\x6f\x70\x70\x69\x6e\x67\x29\x26\x26\x28\x6f\x70\x74\x69\x6f\x6e\x73\x21\x3d\x6e\x75\x6c\x6c\x3f\x6f\x70\x74\x69\x6f\x6e\x73\x2e\x70\x72\x69\x6f\x72\x69\x74\x79\x3a\x76\x6f\x69\x64 \x38\x29\x3d\x3d\x3d\x27\x6c\x6f\x77\x27\x29\x7b\x73\x68\x65\x64\x64\x69\x6e\x67\x2e\x72\x65\x6a\x65\x63\x74\x65\x64\x2b\x2b\x3b\x69\x66\x28\x63\x62\x29\x7b\x70\x72\x6f\x63\x65\x73\x73\x2e\x6e\x65\x78\x74\x54\x69\x63\x6b\x28\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x29\x7b\x72\x65\x74\x75\x72\x6e \x63\x62\x2e\x63\x61\x6c\x6c\x28\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2c\x6f\x76\x65\x72\x6c\x6f\x61\x64\x65\x64\x28\x29\x2c\x6e\x75\x6c\x6c\x29\x3b\x7d\x29\x3b\x7d\n\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3b\x7d\n\x6a\x6f\x62\x3d\x71\x50\x75\x73\x68\x28\x66\x6e\x4e\x61\x6d\x65\x2c\x63\x62\x2c\x43\x41\x4c\x4c\x2c\x61\x72\x67\x73\x2c\x6d\x65\x6d\x6f\x2c\x6f\x70\x74\x69\x6f\x6e\x73\x21\x3d\x6e\x75\x6c\x6c\x3f\x6f\x70\x74\x69\x6f\x6e\x73\x2e\x64\x65\x61\x64\x6c\x69\x6e\x65\x3a\x76\x6f\x69\x64 \x38\x29\x3b\x69\x66\x28\x28\x6f\x70\x74\x69\x6f\x6e\x73\x21\x3d\x6e\x75\x6c\x6c\x3f\x6f\x70\x74\x69\x6f\x6e\x73\x2e\x70\x72\x69\x6f\x72\x69\x74\x79\x3a\x76\x6f\x69\x64 \x38\x29\x3d\x3d\x3d\x27\x6c\x6f\x77\x27\x29\x7b\x6a\x6f\x62\x2e\x6c\x6f\x77\x3d\x74\x72\x75\x65\x3b\x7d\n\x69\x66\x28\x62\x61\x74\x63\x68\x69\x6e\x67\x26\x26\x21\x6d\x65\x6d\x6f\x26\x26\x62\x61\x74\x63\x68\x61\x62\x6c\x65\x28\x61\x72\x67\x73\x29\x29\x7b\x6a\x6f\x62\x2e\x62\x61\x74\x63\x68\x3d\x74\x72\x75\x65\x3b\x62\x61\x74\x63\x68\x4c\x69\x6e\x6b\x28\x6a\x6f\x62\x29\x3b\x69\x66\x28\x6c\x69\x6e\x67\x65\x72\x69\x6e\x67\x28\x66\x6e\x4e\x61\x6d\x65\x29\x29\x7b\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3b\x7d\x7d\n\x69\x66\x28\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x2e\x6c\x65\x6e\x67\x74\x68\x29\x7b\x6e\x65\x78\x74\x4a\x6f\x62\x28\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x2e\x70\x6f\x70\x28\x29\x29\x3b\x7d\n\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x62\x61\x74\x63\x68\x4f\x70\x74\x69\x6f\x6e\x73\x28\x6f\x29\x7b\x69\x66\x28\x21\x6f\x29\x7b\x72\x65\x74\x75\x72\x6e \x6e\x75\x6c\x6c\x3b\x7d\n\x69\x66\x28\x6f\x3d\x3d\x3d\x74\x72\x75\x65\x29\x7b\x6f\x3d\x7b\x7d\x3b\x7d\n\x72\x65\x74\x75\x72\x6e\x7b\x6d\x61\x78\x4a\x6f\x62\x73\x3a\x6f\x2e\x6d\x61\x78\x4a\x6f\x62\x73\x7c\x7c\x36\x34\x2c\x6d\x61\x78\x4c\x61\x74\x65\x6e\x63\x79\x4d\x73\x3a\x6f\x2e\x6d\x61\x78\x4c\x61\x74\x65\x6e\x63\x79\x4d\x73\x7c\x7c\x32\x2c\x6c\x69\x6e\x67\x65\x72\x4d\x73\x3a\x6f\x2e\x6c\x69\x6e\x67\x65\x72\x4d\x73\x7c\x7c\x30\x2c\x73\x69\x7a\x65\x73\x3a\x7b\x7d\x2c\x71\x75\x65\x75\x65\x64\x3a\x7b\x7d\x2c\x62\x61\x74\x63\x68\x65\x73\x3a\x30\x2c\x62\x61\x74\x63\x68\x65\x64\x3a\x30\x2c\x74\x69\x6d\x65\x72\x3a\x6e\x75\x6c\x6c\x7d\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x62\x61\x74\x63\x68\x61\x62\x6c\x65\x28\x61\x72\x67\x73\x29\x7b\x76\x61\x72 \x69\x24\x2c\x72\x65\x66\x24\x2c\x6c\x65\x6e\x24\x2c\x61\x3b\x69\x66\x28\x61\x72\x67\x73\x3d\x3d\x6e\x75\x6c\x6c\x29\x7b\x72\x65\x74\x75\x72\x6e \x74\x72\x75\x65\x3b\x7d\n\x66\x6f\x72\x28\x69\x24\x3d\x30\x2c\x6c\x65\x6e\x24\x3d\x28\x72\x65\x66\x24\x3d\x41\x72\x72\x61\x79\x2e\x69\x73\x41\x72\x72\x61\x79\x28\x61\x72\x67\x73\x29\x3f\x61\x72\x67\x73\x3a\x5b\x61\x72\x67\x73\x5d\x29\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x69\x24\x3c\x6c\x65\x6e\x24\x3b\x2b\x2b\x69\x24\x29\x7b\x61\x3d\x72\x65\x66\x24\x5b\x69\x24\x5d\x3b\x69\x66\x28\x61\x26\x26\x74\x79\x70\x65\x6f\x66 \x61\x3d\x3d\x3d\x27\x6f\x62\x6a\x65\x63\x74\x27\x26\x26\x28\x42\x75\x66\x66\x65\x72\x2e\x69\x73\x42\x75\x66\x66\x65\x72\x28\x61\x29\x7c\x7c\x61\x2e\x42\x59\x54\x45\x53\x5f\x50\x45\x52\x5f\x45\x4c\x45\x4d\x45\x4e\x54\x21\x3d\x6e\x75\x6c\x6c\x29\x29\x7b\x72\x65\x74\x75\x72\x6e \x66\x61\x6c\x73\x65\x3b\x7d\x7d\n\x72\x65\x74\x75\x72\x6e \x74\x72\x75\x65\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x6c\x69\x6e\x67\x65\x72\x69\x6e\x67\x28\x66\x6e\x4e\x61\x6d\x65\x29\x7b\x69\x66\x28\x21\x28\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x6c\x69\x6e\x67\x65\x72\x4d\x73\x26\x26\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x2e\x6c\x65\x6e\x67\x74\x68\x29\x29\x7b\x72\x65\x74\x75\x72\x6e \x66\x61\x6c\x73\x65\x3b\x7d\n\x69\x66\x28\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x71\x75\x65\x75\x65\x64\x5b\x66\x6e\x4e\x61\x6d\x65\x5d\x2e\x6c\x65\x6e\x67\x74\x68\x3e\x3d\x28\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x73\x69\x7a\x65\x73\x5b\x66\x6e\x4e\x61\x6d\x65\x5d\x7c\x7c\x32\x29\x29\x7b\x72\x65\x74\x75\x72\x6e \x66\x61\x6c\x73\x65\x3b\x7d\n\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x74\x69\x6d\x65\x72\x7c\x7c\x28\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x74\x69\x6d\x65\x72\x3d\x73\x65\x74\x54\x69\x6d\x65\x6f\x75\x74\x28\x66\x6c\x75\x73\x68\x4c\x69\x6e\x67\x65\x72\x69\x6e\x67\x2c\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x6c\x69\x6e\x67\x65\x72\x4d\x73\x29\x29\x3b\x72\x65\x74\x75\x72\x6e \x74\x72\x75\x65\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x66\x6c\x75\x73\x68\x4c\x69\x6e\x67\x65\x72\x69\x6e\x67\x28\x29\x7b\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x74\x69\x6d\x65\x72\x3d\x6e\x75\x6c\x6c\x3b\x77\x68\x69\x6c\x65\x28\x71\x2e\x6c\x65\x6e\x67\x74\x68\x26\x26\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x2e\x6c\x65\x6e\x67\x74\x68\x29\x7b\x6e\x65\x78\x74\x4a\x6f\x62\x28\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x2e\x70\x6f\x70\x28\x29\x29\x3b\x7d\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x62\x61\x74\x63\x68\x4c\x69\x6e\x6b\x28\x6a\x6f\x62\x29\x7b\x76\x61\x72 \x6c\x69\x73\x74\x2c\x6b\x65\x79\x24\x3b\x6c\x69\x73\x74\x3d\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x71\x75\x65\x75\x65\x64\x5b\x6b\x65\x79\x24\x3d\x6a\x6f\x62\x2e\x73\x72\x63\x54\x65\x78\x74\x4f\x72\x45\x76\x65\x6e\x74\x54\x79\x70\x65\x5d\x7c\x7c\x28\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x71\x75\x65\x75\x65\x64\x5b\x6b\x65\x79\x24\x5d\x3d\x7b\x66\x69\x72\x73\x74\x3a\x6e\x75\x6c\x6c\x2c\x6c\x61\x73\x74\x3a\x6e\x75\x6c\x6c\x2c\x6c\x65\x6e\x67\x74\x68\x3a\x30\x7d\x29\x3b\x6a\x6f\x62\x2e\x62\x61\x74\x63\x68\x50\x72\x65\x76\x3d\x6c\x69\x73\x74\x2e\x6c\x61\x73\x74\x3b\x6a\x6f\x62\x2e\x62\x61\x74\x63\x68\x4e\x65\x78\x74\x3d\x6e\x75\x6c\x6c\x3b\x69\x66\x28\x6c\x69\x73\x74\x2e\x6c\x61\x73\x74\x29\x7b\x6c\x69\x73\x74\x2e\x6c\x61\x73\x74\x2e\x62\x61\x74\x63\x68\x4e\x65\x78\x74\x3d\x6a\x6f\x62\x3b\x7d\x65\x6c\x73\x65\x7b\x6c\x69\x73\x74\x2e\x66\x69\x72\x73\x74\x3d\x6a\x6f\x62\x3b\x7d\n\x6c\x69\x73\x74\x2e\x6c\x61\x73\x74\x3d\x6a\x6f\x62\x3b\x6c\x69\x73\x74\x2e\x6c\x65\x6e\x67\x74\x68\x2b\x2b\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x62\x61\x74\x63\x68\x55\x6e\x6c\x69\x6e\x6b\x28\x6a\x6f\x62\x29\x7b\x76\x61\x72 \x6c\x69\x73\x74\x3b\x6c\x69\x73\x74\x3d\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x71\x75\x65\x75\x65\x64\x5b\x6a\x6f\x62\x2e\x73\x72\x63\x54\x65\x78\x74\x4f\x72\x45\x76\x65\x6e\x74\x54\x79\x70\x65\x5d\x3b\x69\x66\x28\x6a\x6f\x62\x2e\x62\x61\x74\x63\x68\x50\x72\x65\x76\x29\x7b\x6a\x6f\x62\x2e\x62\x61\x74\x63\x68\x50\x72\x65\x76\x2e\x62\x61\x74\x63\x68\x4e\x65\x78\x74\x3d\x6a\x6f\x62\x2e\x62\x61\x74\x63\x68\x4e\x65\x78\x74\x3b\x7d\x65\x6c\x73\x65\x7b\x6c\x69\x73\x74\x2e\x66\x69\x72\x73\x74\x3d\x6a\x6f\x62\x2e\x62\x61\x74\x63\x68\x4e\x65\x78\x74\x3b\x7d\n\x69\x66\x28\x6a\x6f\x62\x2e\x62\x61\x74\x63\x68\x4e\x65\x78\x74\x29\x7b\x6a\x6f\x62\x2e\x62\x61\x74\x63\x68\x4e\x65\x78\x74\x2e\x62\x61\x74\x63\x68\x50\x72\x65\x76\x3d\x6a\x6f\x62\x2e\x62\x61\x74\x63\x68\x50\x72\x65\x76\x3b\x7d\x65\x6c\x73\x65\x7b\x6c\x69\x73\x74\x2e\x6c\x61\x73\x74\x3d\x6a\x6f\x62\x2e\x62\x61\x74\x63\x68\x50\x72\x65\x76\x3b\x7d\n\x6c\x69\x73\x74\x2e\x6c\x65\x6e\x67\x74\x68\x2d\x2d\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x62\x61\x74\x63\x68\x54\x61\x6b\x65\x28\x66\x69\x72\x73\x74\x29\x7b\x76\x61\x72 \x66\x6e\x4e\x61\x6d\x65\x2c\x73\x69\x7a\x65\x2c\x6c\x69\x73\x74\x2c\x6a\x6f\x62\x73\x2c\x6a\x6f\x62\x3b\x66\x6e\x4e\x61\x6d\x65\x3d\x66\x69\x72\x73\x74\x2e\x73\x72\x63\x54\x65\x78\x74\x4f\x72\x45\x76\x65\x6e\x74\x54\x79\x70\x65\x3b\x73\x69\x7a\x65\x3d\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x73\x69\x7a\x65\x73\x5b\x66\x6e\x4e\x61\x6d\x65\x5d\x7c\x7c\x32\x3b\x6c\x69\x73\x74\x3d\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x71\x75\x65\x75\x65\x64\x5b\x66\x6e\x4e\x61\x6d\x65\x5d\x3b\x6a\x6f\x62\x73\x3d\x5b\x66\x69\x72\x73\x74\x5d\x3b\x77\x68\x69\x6c\x65\x28\x6c\x69\x73\x74\x2e\x66\x69\x72\x73\x74\x26\x26\x6a\x6f\x62\x73\x2e\x6c\x65\x6e\x67\x74\x68\x3c\x73\x69\x7a\x65\x29\x7b\x6a\x6f\x62\x3d\x6c\x69\x73\x74\x2e\x66\x69\x72\x73\x74\x3b\x62\x61\x74\x63\x68\x55\x6e\x6c\x69\x6e\x6b\x28\x6a\x6f\x62\x29\x3b\x69\x66\x28\x65\x64\x66\x29\x7b\x68\x65\x61\x70\x52\x65\x6d\x6f\x76\x65\x28\x6a\x6f\x62\x29\x3b\x71\x2e\x6c\x65\x6e\x67\x74\x68\x2d\x2d\x3b\x7d\x65\x6c\x73\x65\x7b\x71\x55\x6e\x6c\x69\x6e\x6b\x28\x6a\x6f\x62\x29\x3b\x7d\n\x69\x66\x28\x21\x28\x65\x78\x70\x69\x72\x65\x64\x28\x6a\x6f\x62\x29\x7c\x7c\x73\x68\x65\x64\x28\x6a\x6f\x62\x29\x29\x29\x7b\x6a\x6f\x62\x73\x2e\x70\x75\x73\x68\x28\x6a\x6f\x62\x29\x3b\x7d\x7d\n\x72\x65\x74\x75\x72\x6e \x6a\x6f\x62\x73\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x62\x61\x74\x63\x68\x43\x61\x6c\x6c\x28\x74\x2c\x6a\x6f\x62\x73\x29\x7b\x76\x61\x72 \x66\x6e\x4e\x61\x6d\x65\x2c\x74\x30\x2c\x6a\x6f\x62\x3b\x66\x6e\x4e\x61\x6d\x65\x3d\x6a\x6f\x62\x73\x5b\x30\x5d\x2e\x73\x72\x63\x54\x65\x78\x74\x4f\x72\x45\x76\x65\x6e\x74\x54\x79\x70\x65\x3b\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x62\x61\x74\x63\x68\x65\x73\x2b\x2b\x3b\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x62\x61\x74\x63\x68\x65\x64\x2b\x3d\x6a\x6f\x62\x73\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x74\x30\x3d\x70\x72\x6f\x63\x65\x73\x73\x2e\x68\x72\x74\x69\x6d\x65\x28\x29\x3b\x74\x2e\x63\x61\x6c\x6c\x28\x27\x5f\x5f\x62\x61\x74\x63\x68\x27\x2c\x5b\x66\x6e\x4e\x61\x6d\x65\x2c\x28\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x29\x7b\x76\x61\x72 \x69\x24\x2c\x72\x65\x66\x24\x2c\x6c\x65\x6e\x24\x2c\x72\x65\x73\x75\x6c\x74\x73\x24\x3d\x5b\x5d\x3b\x66\x6f\x72\x28\x69\x24\x3d\x30\x2c\x6c\x65\x6e\x24\x3d\x28\x72\x65\x66\x24\x3d\x6a\x6f\x62\x73\x29\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x69\x24\x3c\x6c\x65\x6e\x24\x3b\x2b\x2b\x69\x24\x29\x7b\x6a\x6f\x62\x3d\x72\x65\x66\x24\x5b\x69\x24\x5d\x3b\x72\x65\x73\x75\x6c\x74\x73\x24\x2e\x70\x75\x73\x68\x28\x62\x61\x74\x63\x68\x41\x72\x67\x73\x28\x6a\x6f\x62\x2e\x61\x72\x67\x73\x29\x29\x3b\x7d\n\x72\x65\x74\x75\x72\x6e \x72\x65\x73\x75\x6c\x74\x73\x24\x3b\x7d\x28\x29\x29\x5d\x2c\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x65\x2c\x64\x29\x7b\x76\x61\x72 \x69\x24\x2c\x72\x65\x66\x24\x2c\x6c\x65\x6e\x24\x2c\x69\x2c\x6a\x6f\x62\x3b\x62\x61\x74\x63\x68\x41\x64\x61\x70\x74\x28\x66\x6e\x4e\x61\x6d\x65\x2c\x6a\x6f\x62\x73\x2e\x6c\x65\x6e\x67\x74\x68\x2c\x70\x72\x6f\x63\x65\x73\x73\x2e\x68\x72\x74\x69\x6d\x65\x28\x74\x30\x29\x29\x3b\x66\x6f\x72\x28\x69\x24\x3d\x30\x2c\x6c\x65\x6e\x24\x3d\x6a\x6f\x62\x73\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x69\x24\x3c\x6c\x65\x6e\x24\x3b\x2b\x2b\x69\x24\x29\x7b\x6a\x6f\x62\x3d\x6a\x6f\x62\x73\x5b\x69\x24\x5d\x3b\x64\x65\x61\x64\x6c\x69\x6e\x65\x44\x6f\x6e\x65\x28\x6a\x6f\x62\x29\x3b\x7d\n\x6e\x65\x78\x74\x4a\x6f\x62\x28\x74\x29\x3b\x66\x6f\x72\x28\x69\x24\x3d\x30\x2c\x6c\x65\x6e\x24\x3d\x28\x72\x65\x66\x24\x3d\x6a\x6f\x62\x73\x29\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x69\x24\x3c\x6c\x65\x6e\x24\x3b\x2b\x2b\x69\x24\x29\x7b\x69\x3d\x69\x24\x3b\x6a\x6f\x62\x3d\x72\x65\x66\x24\x5b\x69\x24\x5d\x3b\x69\x66\x28\x6a\x6f\x62\x2e\x63\x62\x4f\x72\x44\x61\x74\x61\x29\x7b\x69\x66\x28\x65\x29\x7b\x6a\x6f\x62\x2e\x63\x62\x4f\x72\x44\x61\x74\x61\x2e\x63\x61\x6c\x6c\x28\x74\x2c\x65\x2c\x6e\x75\x6c\x6c\x29\x3b\x7d\x65\x6c\x73\x65 \x69\x66\x28\x64\x5b\x69\x5d\x5b\x30\x5d\x29\x7b\x6a\x6f\x62\x2e\x63\x62\x4f\x72\x44\x61\x74\x61\x2e\x63\x61\x6c\x6c\x28\x74\x2c\x6e\x65\x77 \x45\x72\x72\x6f\x72\x28\x64\x5b\x69\x5d\x5b\x31\x5d\x29\x2c\x6e\x75\x6c\x6c\x29\x3b\x7d\x65\x6c\x73\x65\x7b\x6a\x6f\x62\x2e\x63\x62\x4f\x72\x44\x61\x74\x61\x2e\x63\x61\x6c\x6c\x28\x74\x2c\x6e\x75\x6c\x6c\x2c\x64\x5b\x69\x5d\x5b\x31\x5d\x29\x3b\x7d\x7d\x7d\x7d\x29\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x62\x61\x74\x63\x68\x41\x72\x67\x73\x28\x61\x72\x67\x73\x29\x7b\x69\x66\x28\x61\x72\x67\x73\x21\x3d\x6e\x75\x6c\x6c\x29\x7b\x69\x66\x28\x41\x72\x72\x61\x79\x2e\x69\x73\x41\x72\x72\x61\x79\x28\x61\x72\x67\x73\x29\x29\x7b\x72\x65\x74\x75\x72\x6e \x61\x72\x67\x73\x3b\x7d\x65\x6c\x73\x65\x7b\x72\x65\x74\x75\x72\x6e\x5b\x61\x72\x67\x73\x5d\x3b\x7d\x7d\x65\x6c\x73\x65\x7b\x72\x65\x74\x75\x72\x6e\x5b\x5d\x3b\x7d\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x62\x61\x74\x63\x68\x41\x64\x61\x70\x74\x28\x66\x6e\x4e\x61\x6d\x65\x2c\x63\x6f\x75\x6e\x74\x2c\x65\x6c\x61\x70\x73\x65\x64\x29\x7b\x76\x61\x72 \x6d\x73\x2c\x73\x69\x7a\x65\x3b\x6d\x73\x3d\x65\x6c\x61\x70\x73\x65\x64\x5b\x30\x5d\x2a\x31\x65\x33\x2b\x65\x6c\x61\x70\x73\x65\x64\x5b\x31\x5d\x2f\x31\x65\x36\x3b\x73\x69\x7a\x65\x3d\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x73\x69\x7a\x65\x73\x5b\x66\x6e\x4e\x61\x6d\x65\x5d\x7c\x7c\x32\x3b\x69\x66\x28\x6d\x73\x3e\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x6d\x61\x78\x4c\x61\x74\x65\x6e\x63\x79\x4d\x73\x29\x7b\x73\x69\x7a\x65\x3d\x4d\x61\x74\x68\x2e\x6d\x61\x78\x28\x31\x2c\x4d\x61\x74\x68\x2e\x66\x6c\x6f\x6f\x72\x28\x63\x6f\x75\x6e\x74\x2a\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x6d\x61\x78\x4c\x61\x74\x65\x6e\x63\x79\x4d\x73\x2f\x6d\x73\x29\x29\x3b\x7d\x65\x6c\x73\x65 \x69\x66\x28\x6d\x73\x2a\x32\x3c\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x6d\x61\x78\x4c\x61\x74\x65\x6e\x63\x79\x4d\x73\x26\x26\x63\x6f\x75\x6e\x74\x3e\x3d\x73\x69\x7a\x65\x29\x7b\x73\x69\x7a\x65\x3d\x4d\x61\x74\x68\x2e\x6d\x69\x6e\x28\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x6d\x61\x78\x4a\x6f\x62\x73\x2c\x73\x69\x7a\x65\x2a\x32\x29\x3b\x7d\n\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x73\x69\x7a\x65\x73\x5b\x66\x6e\x4e\x61\x6d\x65\x5d\x3d\x73\x69\x7a\x65\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x63\x61\x6c\x6c\x43\x68\x61\x69\x6e\x28\x66\x6e\x4e\x61\x6d\x65\x2c\x61\x72\x67\x73\x29\x7b\x72\x65\x74\x75\x72\x6e \x63\x61\x6c\x6c\x46\x75\x74\x75\x72\x65\x28\x66\x6e\x4e\x61\x6d\x65\x2c\x61\x72\x67\x73\x29\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x63\x61\x6c\x6c\x46\x75\x74\x75\x72\x65\x28\x66\x6e\x4e\x61\x6d\x65\x2c\x61\x72\x67\x73\x2c\x61\x66\x74\x65\x72\x29\x7b\x76\x61\x72 \x6e\x61\x6d\x65\x73\x2c\x63\x62\x73\x2c\x73\x65\x6e\x74\x2c\x73\x65\x74\x74\x6c\x65\x64\x2c\x65\x72\x72\x2c\x76\x61\x6c\x75\x65\x2c\x66\x75\x74\x75\x72\x65\x2c\x73\x65\x6e\x64\x3b\x6e\x61\x6d\x65\x73\x3d\x5b\x66\x6e\x4e\x61\x6d\x65\x5d\x3b\x63\x62\x73\x3d\x5b\x5d\x3b\x73\x65\x6e\x74\x3d\x73\x65\x74\x74\x6c\x65\x64\x3d\x66\x61\x6c\x73\x65\x3b\x65\x72\x72\x3d\x76\x61\x6c\x75\x65\x3d\x6e\x75\x6c\x6c\x3b\x66\x75\x74\x75\x72\x65\x3d\x4f\x62\x6a\x65\x63\x74\x2e\x63\x72\x65\x61\x74\x65\x28\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x29\x3b\x66\x75\x74\x75\x72\x65\x2e\x74\x68\x65\x6e\x3d\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x6e\x65\x78\x74\x29\x7b\x69\x66\x28\x74\x79\x70\x65\x6f\x66 \x6e\x65\x78\x74\x3d\x3d\x3d\x27\x66\x75\x6e\x63\x74\x69\x6f\x6e\x27\x29\x7b\x69\x66\x28\x73\x65\x74\x74\x6c\x65\x64\x29\x7b\x70\x72\x6f\x63\x65\x73\x73\x2e\x6e\x65\x78\x74\x54\x69\x63\x6b\x28\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x29\x7b\x72\x65\x74\x75\x72\x6e \x6e\x65\x78\x74\x2e\x63\x61\x6c\x6c\x28\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2c\x65\x72\x72\x2c\x76\x61\x6c\x75\x65\x29\x3b\x7d\x29\x3b\x7d\x65\x6c\x73\x65\x7b\x63\x62\x73\x2e\x70\x75\x73\x68\x28\x6e\x65\x78\x74\x29\x3b\x7d\n\x72\x65\x74\x75\x72\x6e \x66\x75\x74\x75\x72\x65\x3b\x7d\x65\x6c\x73\x65 \x69\x66\x28\x73\x65\x6e\x74\x29\x7b\x72\x65\x74\x75\x72\x6e \x63\x61\x6c\x6c\x46\x75\x74\x75\x72\x65\x28\x6e\x65\x78\x74\x2c\x6e\x75\x6c\x6c\x2c\x66\x75\x74\x75\x72\x65\x29\x3b\x7d\x65\x6c\x73\x65\x7b\x6e\x61\x6d\x65\x73\x2e\x70\x75\x73\x68\x28\x6e\x65\x78\x74\x29\x3b\x72\x65\x74\x75\x72\x6e \x66\x75\x74\x75\x72\x65\x3b\x7d\x7d\x3b\x73\x65\x6e\x64\x3d\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x65\x2c\x64\x29\x7b\x76\x61\x72 \x63\x61\x6c\x6c\x41\x72\x67\x73\x3b\x73\x65\x6e\x74\x3d\x74\x72\x75\x65\x3b\x69\x66\x28\x65\x29\x7b\x72\x65\x74\x75\x72\x6e \x73\x65\x74\x74\x6c\x65\x28\x65\x2c\x6e\x75\x6c\x6c\x29\x3b\x7d\n\x63\x61\x6c\x6c\x41\x72\x67\x73\x3d\x61\x66\x74\x65\x72\x3f\x5b\x64\x5d\x3a\x61\x72\x67\x73\x3b\x72\x65\x63\x6f\x72\x64\x28\x43\x41\x4c\x4c\x2c\x41\x4e\x59\x2c\x6e\x61\x6d\x65\x73\x2e\x6a\x6f\x69\x6e\x28\x27\x5c\x6e\x27\x29\x2c\x63\x61\x6c\x6c\x41\x72\x67\x73\x29\x3b\x71\x50\x75\x73\x68\x28\x6e\x61\x6d\x65\x73\x2c\x73\x65\x74\x74\x6c\x65\x2c\x43\x41\x4c\x4c\x2c\x63\x61\x6c\x6c\x41\x72\x67\x73\x29\x3b\x69\x66\x28\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x2e\x6c\x65\x6e\x67\x74\x68\x29\x7b\x72\x65\x74\x75\x72\x6e \x6e\x65\x78\x74\x4a\x6f\x62\x28\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x2e\x70\x6f\x70\x28\x29\x29\x3b\x7d\x7d\x3b\x69\x66\x28\x61\x66\x74\x65\x72\x29\x7b\x61\x66\x74\x65\x72\x2e\x74\x68\x65\x6e\x28\x73\x65\x6e\x64\x29\x3b\x7d\x65\x6c\x73\x65\x7b\x70\x72\x6f\x63\x65\x73\x73\x2e\x6e\x65\x78\x74\x54\x69\x63\x6b\x28\x73\x65\x6e\x64\x29\x3b\x7d\n\x72\x65\x74\x75\x72\x6e \x66\x75\x74\x75\x72\x65\x3b\x66\x75\x6e\x63\x74\x69\x6f\x6e \x73\x65\x74\x74\x6c\x65\x28\x65\x2c\x64\x29\x7b\x76\x61\x72 \x69\x24\x2c\x72\x65\x66\x24\x2c\x6c\x65\x6e\x24\x2c\x63\x62\x3b\x73\x65\x74\x74\x6c\x65\x64\x3d\x74\x72\x75\x65\x3b\x65\x72\x72\x3d\x65\x3b\x76\x61\x6c\x75\x65\x3d\x64\x3b\x69\x66\x28\x65\x26\x26\x21\x63\x62\x73\x2e\x6c\x65\x6e\x67\x74\x68\x29\x7b\x74\x68\x72\x6f\x77 \x65\x3b\x7d\n\x66\x6f\x72\x28\x69\x24\x3d\x30\x2c\x6c\x65\x6e\x24\x3d\x28\x72\x65\x66\x24\x3d\x63\x62\x73\x29\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x69\x24\x3c\x6c\x65\x6e\x24\x3b\x2b\x2b\x69\x24\x29\x7b\x63\x62\x3d\x72\x65\x66\x24\x5b\x69\x24\x5d\x3b\x63\x62\x2e\x63\x61\x6c\x6c\x28\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2c\x65\x2c\x64\x29\x3b\x7d\x7d\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x63\x61\x6c\x6c\x41\x6c\x6c\x28\x66\x6e\x4e\x61\x6d\x65\x2c\x61\x72\x67\x73\x2c\x63\x62\x29\x7b\x76\x61\x72 \x72\x65\x66\x24\x3b\x69\x66\x28\x74\x79\x70\x65\x6f\x66 \x61\x72\x67\x73\x3d\x3d\x3d\x27\x66\x75\x6e\x63\x74\x69\x6f\x6e\x27\x29\x7b\x72\x65\x66\x24\x3d\x5b\x61\x72\x67\x73\x2c\x5b\x5d\x5d\x2c\x63\x62\x3d\x72\x65\x66\x24\x5b\x30\x5d\x2c\x61\x72\x67\x73\x3d\x72\x65\x66\x24\x5b\x31\x5d\x3b\x7d\n\x72\x65\x63\x6f\x72\x64\x28\x43\x41\x4c\x4c\x2c\x41\x4c\x4c\x2c\x66\x6e\x4e\x61\x6d\x65\x2c\x61\x72\x67\x73\x29\x3b\x70\x6f\x6f\x6c\x2e\x66\x6f\x72\x45\x61\x63\x68\x28\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x76\x2c\x69\x2c\x6f\x29\x7b\x69\x66\x28\x63\x62\x29\x7b\x72\x65\x74\x75\x72\x6e \x76\x2e\x63\x61\x6c\x6c\x28\x66\x6e\x4e\x61\x6d\x65\x2c\x61\x72\x67\x73\x2c\x63\x62\x29\x3b\x7d\x65\x6c\x73\x65\x7b\x72\x65\x74\x75\x72\x6e \x76\x2e\x63\x61\x6c\x6c\x28\x66\x6e\x4e\x61\x6d\x65\x2c\x61\x72\x67\x73\x29\x3b\x7d\x7d\x29\x3b\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x70\x6f\x6f\x6c\x53\x6f\x72\x74\x28\x61\x72\x72\x61\x79\x2c\x6f\x70\x74\x73\x2c\x63\x62\x29\x7b\x76\x61\x72 \x72\x65\x66\x24\x3b\x69\x66\x28\x74\x79\x70\x65\x6f\x66 \x6f\x70\x74\x73\x3d\x3d\x3d\x27\x66\x75\x6e\x63\x74\x69\x6f\x6e\x27\x29\x7b\x72\x65\x66\x24\x3d\x5b\x6f\x70\x74\x73\x2c\x7b\x7d\x5d\x2c\x63\x62\x3d\x72\x65\x66\x24\x5b\x30\x5d\x2c\x6f\x70\x74\x73\x3d\x72\x65\x66\x24\x5b\x31\x5d\x3b\x7d\n\x54\x2e\x70\x61\x72\x61\x6c\x6c\x65\x6c\x53\x6f\x72\x74\x28\x70\x6f\x6f\x6c\x2c\x61\x72\x72\x61\x79\x2c\x28\x6f\x70\x74\x73\x21\x3d\x6e\x75\x6c\x6c\x3f\x6f\x70\x74\x73\x2e\x63\x6f\x6d\x70\x61\x72\x65\x3a\x76\x6f\x69\x64 \x38\x29\x3d\x3d\x3d\x27\x64\x65\x73\x63\x27\x2c\x63\x62\x29\x3b\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x70\x6f\x6f\x6c\x42\x69\x6e\x61\x72\x79\x53\x65\x61\x72\x63\x68\x4d\x61\x6e\x79\x28\x73\x6f\x72\x74\x65\x64\x2c\x71\x75\x65\x72\x69\x65\x73\x2c\x6f\x70\x74\x73\x2c\x63\x62\x29\x7b\x76\x61\x72 \x72\x65\x66\x24\x3b\x69\x66\x28\x74\x79\x70\x65\x6f\x66 \x6f\x70\x74\x73\x3d\x3d\x3d\x27\x66\x75\x6e\x63\x74\x69\x6f\x6e\x27\x29\x7b\x72\x65\x66\x24\x3d\x5b\x6f\x70\x74\x73\x2c\x7b\x7d\x5d\x2c\x63\x62\x3d\x72\x65\x66\x24\x5b\x30\x5d\x2c\x6f\x70\x74\x73\x3d\x72\x65\x66\x24\x5b\x31\x5d\x3b\x7d\n\x71\x75\x65\x72\x69\x65\x73\x3d\x6e\x65\x77 \x46\x6c\x6f\x61\x74\x36\x34\x41\x72\x72\x61\x79\x28\x71\x75\x65\x72\x69\x65\x73\x29\x3b\x54\x2e\x70\x61\x72\x61\x6c\x6c\x65\x6c\x42\x69\x6e\x61\x72\x79\x53\x65\x61\x72\x63\x68\x28\x70\x6f\x6f\x6c\x2c\x73\x6f\x72\x74\x65\x64\x2c\x71\x75\x65\x72\x69\x65\x73\x2c\x6e\x65\x77 \x49\x6e\x74\x33\x32\x41\x72\x72\x61\x79\x28\x71\x75\x65\x72\x69\x65\x73\x2e\x6c\x65\x6e\x67\x74\x68\x29\x2c\x28\x6f\x70\x74\x73\x21\x3d\x6e\x75\x6c\x6c\x3f\x6f\x70\x74\x73\x2e\x63\x6f\x6d\x70\x61\x72\x65\x3a\x76\x6f\x69\x64 \x38\x29\x3d\x3d\x3d\x27\x64\x65\x73\x63\x27\x2c\x63\x62\x29\x3b\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x70\x6f\x6f\x6c\x50\x61\x72\x73\x65\x4a\x53\x4f\x4e\x28\x74\x65\x78\x74\x2c\x63\x62\x29\x7b\x72\x65\x74\x75\x72\x6e \x63\x61\x6c\x6c\x41\x6e\x79\x28\x27\x74\x68\x72\x65\x61\x64\x2e\x70\x61\x72\x73\x65\x4a\x53\x4f\x4e\x27\x2c\x5b\x74\x65\x78\x74\x5d\x2c\x63\x62\x29\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x70\x6f\x6f\x6c\x53\x74\x72\x69\x6e\x67\x69\x66\x79\x4a\x53\x4f\x4e\x28\x76\x61\x6c\x75\x65\x2c\x63\x62\x29\x7b\x76\x61\x72 \x74\x65\x78\x74\x2c\x65\x2c\x70\x69\x65\x63\x65\x73\x2c\x72\x65\x73\x75\x6c\x74\x73\x2c\x70\x65\x6e\x64\x69\x6e\x67\x2c\x66\x61\x69\x6c\x65\x64\x3b\x69\x66\x28\x73\x74\x72\x69\x6e\x67\x69\x66\x79\x48\x65\x72\x65\x28\x76\x61\x6c\x75\x65\x2c\x5b\x5d\x29\x29\x7b\x74\x72\x79\x7b\x74\x65\x78\x74\x3d\x4a\x53\x4f\x4e\x2e\x73\x74\x72\x69\x6e\x67\x69\x66\x79\x28\x76\x61\x6c\x75\x65\x29\x3b\x7d\x63\x61\x74\x63\x68\x28\x65\x24\x29\x7b\x65\x3d\x65\x24\x3b\x70\x72\x6f\x63\x65\x73\x73\x2e\x6e\x65\x78\x74\x54\x69\x63\x6b\x28\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x29\x7b\x72\x65\x74\x75\x72\x6e \x63\x62\x2e\x63\x61\x6c\x6c\x28\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2c\x65\x2c\x6e\x75\x6c\x6c\x29\x3b\x7d\x29\x3b\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3b\x7d\n\x70\x72\x6f\x63\x65\x73\x73\x2e\x6e\x65\x78\x74\x54\x69\x63\x6b\x28\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x29\x7b\x72\x65\x74\x75\x72\x6e \x63\x62\x2e\x63\x61\x6c\x6c\x28\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2c\x6e\x75\x6c\x6c\x2c\x74\x65\x78\x74\x29\x3b\x7d\x29\x3b\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3b\x7d\n\x70\x69\x65\x63\x65\x73\x3d\x6a\x73\x6f\x6e\x50\x69\x65\x63\x65\x73\x28\x76\x61\x6c\x75\x65\x29\x3b\x69\x66\x28\x21\x70\x69\x65\x63\x65\x73\x29\x7b\x72\x65\x74\x75\x72\x6e \x63\x61\x6c\x6c\x41\x6e\x79\x28\x27\x4a\x53\x4f\x4e\x2e\x73\x74\x72\x69\x6e\x67\x69\x66\x79\x27\x2c\x5b\x76\x61\x6c\x75\x65\x5d\x2c\x63\x62\x29\x3b\x7d\n\x72\x65\x73\x75\x6c\x74\x73\x3d\x5b\x5d\x3b\x70\x65\x6e\x64\x69\x6e\x67\x3d\x70\x69\x65\x63\x65\x73\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x66\x61\x69\x6c\x65\x64\x3d\x66\x61\x6c\x73\x65\x3b\x70\x69\x65\x63\x65\x73\x2e\x66\x6f\x72\x45\x61\x63\x68\x28\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x70\x69\x65\x63\x65\x2c\x69\x29\x7b\x72\x65\x74\x75\x72\x6e \x63\x61\x6c\x6c\x41\x6e\x79\x28\x27\x4a\x53\x4f\x4e\x2e\x73\x74\x72\x69\x6e\x67\x69\x66\x79\x27\x2c\x5b\x70\x69\x65\x63\x65\x5d\x2c\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x65\x2c\x64\x29\x7b\x76\x61\x72 \x74\x65\x78\x74\x3b\x69\x66\x28\x66\x61\x69\x6c\x65\x64\x29\x7b\x72\x65\x74\x75\x72\x6e\x3b\x7d\n\x69\x66\x28\x65\x29\x7b\x66\x61\x69\x6c\x65\x64\x3d\x74\x72\x75\x65\x3b\x72\x65\x74\x75\x72\x6e \x63\x62\x2e\x63\x61\x6c\x6c\x28\x74\x68\x69\x73\x2c\x65\x2c\x6e\x75\x6c\x6c\x29\x3b\x7d\n\x72\x65\x73\x75\x6c\x74\x73\x5b\x69\x5d\x3d\x64\x2e\x73\x6c\x69\x63\x65\x28\x31\x2c\x2d\x31\x29\x3b\x69\x66\x28\x2d\x2d\x70\x65\x6e\x64\x69\x6e\x67\x29\x7b\x72\x65\x74\x75\x72\x6e\x3b\x7d\n\x74\x65\x78\x74\x3d\x72\x65\x73\x75\x6c\x74\x73\x2e\x66\x69\x6c\x74\x65\x72\x28\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x69\x74\x29\x7b\x72\x65\x74\x75\x72\x6e \x69\x74\x3b\x7d\x29\x2e\x6a\x6f\x69\x6e\x28\x27\x2c\x27\x29\x3b\x72\x65\x74\x75\x72\x6e \x63\x62\x2e\x63\x61\x6c\x6c\x28\x74\x68\x69\x73\x2c\x6e\x75\x6c\x6c\x2c\x41\x72\x72\x61\x79\x2e\x69\x73\x41\x72\x72\x61\x79\x28\x76\x61\x6c\x75\x65\x29\x3f\x22\x5b\x22\x2b\x74\x65\x78\x74\x2b\x22\x5d\x22\x3a\x22\x7b\x22\x2b\x74\x65\x78\x74\x2b\x22\x7d\x22\x29\x3b\x7d\x29\x3b\x7d\x29\x3b\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x73\x74\x72\x69\x6e\x67\x69\x66\x79\x48\x65\x72\x65\x28\x76\x61\x6c\x75\x65\x2c\x70\x61\x72\x65\x6e\x74\x73\x29\x7b\x76\x61\x72 \x6b\x65\x79\x73\x2c\x6f\x77\x6e\x2c\x69\x24\x2c\x6c\x65\x6e\x24\x2c\x6b\x65\x79\x3b\x69\x66\x28\x76\x61\x6c\x75\x65\x3d\x3d\x3d\x76\x6f\x69\x64 \x38\x7c\x7c\x74\x79\x70\x65\x6f\x66 \x76\x61\x6c\x75\x65\x3d\x3d\x3d\x27\x66\x75\x6e\x63\x74\x69\x6f\x6e\x27\x29\x7b\x72\x65\x74\x75\x72\x6e \x74\x72\x75\x65\x3b\x7d\n\x69\x66\x28\x21\x28\x76\x61\x6c\x75\x65\x26\x26\x74\x79\x70\x65\x6f\x66 \x76\x61\x6c\x75\x65\x3d\x3d\x3d\x27\x6f\x62\x6a\x65\x63\x74\x27\x29\x29\x7b\x72\x65\x74\x75\x72\x6e \x66\x61\x6c\x73\x65\x3b\x7d\n\x69\x66\x28\x74\x79\x70\x65\x6f\x66 \x76\x61\x6c\x75\x65\x2e\x74\x6f\x4a\x53\x4f\x4e\x3d\x3d\x3d\x27\x66\x75\x6e\x63\x74\x69\x6f\x6e\x27\x7c\x7c\x70\x61\x72\x65\x6e\x74\x73\x2e\x69\x6e\x64\x65\x78\x4f\x66\x28\x76\x61\x6c\x75\x65\x29\x3e\x3d\x30\x29\x7b\x72\x65\x74\x75\x72\x6e \x74\x72\x75\x65\x3b\x7d\n\x69\x66\x28\x76\x61\x6c\x75\x65 \x69\x6e\x73\x74\x61\x6e\x63\x65\x6f\x66 \x4e\x75\x6d\x62\x65\x72\x7c\x7c\x76\x61\x6c\x75\x65 \x69\x6e\x73\x74\x61\x6e\x63\x65\x6f\x66 \x53\x74\x72\x69\x6e\x67\x7c\x7c\x76\x61\x6c\x75\x65 \x69\x6e\x73\x74\x61\x6e\x63\x65\x6f\x66 \x42\x6f\x6f\x6c\x65\x61\x6e\x29\x7b\x72\x65\x74\x75\x72\x6e \x74\x72\x75\x65\x3b\x7d\n\x6b\x65\x79\x73\x3d\x4f\x62\x6a\x65\x63\x74\x2e\x6b\x65\x79\x73\x28\x76\x61\x6c\x75\x65\x29\x3b\x6f\x77\x6e\x3d\x4f\x62\x6a\x65\x63\x74\x2e\x67\x65\x74\x4f\x77\x6e\x50\x72\x6f\x70\x65\x72\x74\x79\x4e\x61\x6d\x65\x73\x28\x76\x61\x6c\x75\x65\x29\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x69\x66\x28\x41\x72\x72\x61\x79\x2e\x69\x73\x41\x72\x72\x61\x79\x28\x76\x61\x6c\x75\x65\x29\x29\x7b\x69\x66\x28\x6b\x65\x79\x73\x2e\x6c\x65\x6e\x67\x74\x68\x21\x3d\x3d\x76\x61\x6c\x75\x65\x2e\x6c\x65\x6e\x67\x74\x68\x7c\x7c\x6f\x77\x6e\x21\x3d\x3d\x6b\x65\x79\x73\x2e\x6c\x65\x6e\x67\x74\x68\x2b\x31\x29\x7b\x72\x65\x74\x75\x72\x6e \x74\x72\x75\x65\x3b\x7d\x7d\x65\x6c\x73\x65 \x69\x66\x28\x6f\x77\x6e\x21\x3d\x3d\x6b\x65\x79\x73\x2e\x6c\x65\x6e\x67\x74\x68\x29\x7b\x72\x65\x74\x75\x72\x6e \x74\x72\x75\x65\x3b\x7d\n\x70\x61\x72\x65\x6e\x74\x73\x2e\x70\x75\x73\x68\x28\x76\x61\x6c\x75\x65\x29\x3b\x66\x6f\x72\x28\x69\x24\x3d\x30\x2c\x6c\x65\x6e\x24\x3d\x6b\x65\x79\x73\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x69\x24\x3c\x6c\x65\x6e\x24\x3b\x2b\x2b\x69\x24\x29\x7b\x6b\x65\x79\x3d\x6b\x65\x79\x73\x5b\x69\x24\x5d\x3b\x69\x66\x28\x6b\x65\x79\x2e\x69\x6e\x64\x65\x78\x4f\x66\x28\x27\x5c\x30\x27\x29\x3e\x3d\x30\x7c\x7c\x73\x74\x72\x69\x6e\x67\x69\x66\x79\x48\x65\x72\x65\x28\x76\x61\x6c\x75\x65\x5b\x6b\x65\x79\x5d\x2c\x70\x61\x72\x65\x6e\x74\x73\x29\x29\x7b\x72\x65\x74\x75\x72\x6e \x74\x72\x75\x65\x3b\x7d\x7d\n\x70\x61\x72\x65\x6e\x74\x73\x2e\x70\x6f\x70\x28\x29\x3b\x72\x65\x74\x75\x72\x6e \x66\x61\x6c\x73\x65\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x6a\x73\x6f\x6e\x50\x69\x65\x63\x65\x73\x28\x76\x61\x6c\x75\x65\x29\x7b\x76\x61\x72 \x6e\x2c\x69\x2c\x6b\x65\x79\x73\x2c\x70\x69\x65\x63\x65\x2c\x69\x24\x2c\x72\x65\x66\x24\x2c\x6c\x65\x6e\x24\x2c\x6b\x65\x79\x2c\x72\x65\x73\x75\x6c\x74\x73\x24\x3d\x5b\x5d\x3b\x69\x66\x28\x21\x28\x70\x6f\x6f\x6c\x2e\x6c\x65\x6e\x67\x74\x68\x3e\x31\x26\x26\x76\x61\x6c\x75\x65\x26\x26\x74\x79\x70\x65\x6f\x66 \x76\x61\x6c\x75\x65\x3d\x3d\x3d\x27\x6f\x62\x6a\x65\x63\x74\x27\x29\x29\x7b\x72\x65\x74\x75\x72\x6e\x3b\x7d\n\x69\x66\x28\x41\x72\x72\x61\x79\x2e\x69\x73\x41\x72\x72\x61\x79\x28\x76\x61\x6c\x75\x65\x29\x29\x7b\x69\x66\x28\x21\x28\x76\x61\x6c\x75\x65\x2e\x6c\x65\x6e\x67\x74\x68\x3e\x3d\x70\x6f\x6f\x6c\x2e\x6c\x65\x6e\x67\x74\x68\x2a\x32\x29\x29\x7b\x72\x65\x74\x75\x72\x6e\x3b\x7d\n\x6e\x3d\x70\x6f\x6f\x6c\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x66\x6f\x72\x28\x69\x3d\x30\x3b\x69\x3c\x6e\x3b\x2b\x2b\x69\x29\x7b\x72\x65\x73\x75\x6c\x74\x73\x24\x2e\x70\x75\x73\x68\x28\x76\x61\x6c\x75\x65\x2e\x73\x6c\x69\x63\x65\x28\x76\x61\x6c\x75\x65\x2e\x6c\x65\x6e\x67\x74\x68\x2a\x69\x2f\x6e\x7c\x30\x2c\x76\x61\x6c\x75\x65\x2e\x6c\x65\x6e\x67\x74\x68\x2a\x28\x69\x2b\x31\x29\x2f\x6e\x7c\x30\x29\x29\x3b\x7d\n\x72\x65\x74\x75\x72\x6e \x72\x65\x73\x75\x6c\x74\x73\x24\x3b\x7d\n\x6b\x65\x79\x73\x3d\x4f\x62\x6a\x65\x63\x74\x2e\x6b\x65\x79\x73\x28\x76\x61\x6c\x75\x65\x29\x3b\x69\x66\x28\x21\x28\x6b\x65\x79\x73\x2e\x6c\x65\x6e\x67\x74\x68\x3e\x3d\x70\x6f\x6f\x6c\x2e\x6c\x65\x6e\x67\x74\x68\x2a\x32\x29\x29\x7b\x72\x65\x74\x75\x72\x6e\x3b\x7d\n\x6e\x3d\x70\x6f\x6f\x6c\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x66\x6f\x72\x28\x69\x3d\x30\x3b\x69\x3c\x6e\x3b\x2b\x2b\x69\x29\x7b\x70\x69\x65\x63\x65\x3d\x7b\x7d\x3b\x66\x6f\x72\x28\x69\x24\x3d\x30\x2c\x6c\x65\x6e\x24\x3d\x28\x72\x65\x66\x24\x3d\x6b\x65\x79\x73\x2e\x73\x6c\x69\x63\x65\x28\x6b\x65\x79\x73\x2e\x6c\x65\x6e\x67\x74\x68\x2a\x69\x2f\x6e\x7c\x30\x2c\x6b\x65\x79\x73\x2e\x6c\x65\x6e\x67\x74\x68\x2a\x28\x69\x2b\x31\x29\x2f\x6e\x7c\x30\x29\x29\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x69\x24\x3c\x6c\x65\x6e\x24\x3b\x2b\x2b\x69\x24\x29\x7b\x6b\x65\x79\x3d\x72\x65\x66\x24\x5b\x69\x24\x5d\x3b\x70\x69\x65\x63\x65\x5b\x6b\x65\x79\x5d\x3d\x76\x61\x6c\x75\x65\x5b\x6b\x65\x79\x5d\x3b\x7d\n\x72\x65\x73\x75\x6c\x74\x73\x24\x2e\x70\x75\x73\x68\x28\x70\x69\x65\x63\x65\x29\x3b\x7d\n\x72\x65\x74\x75\x72\x6e \x72\x65\x73\x75\x6c\x74\x73\x24\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x70\x6f\x6f\x6c\x53\x68\x61\x72\x64\x28\x6c\x6f\x61\x64\x65\x72\x2c\x70\x61\x72\x74\x69\x74\x69\x6f\x6e\x73\x2c\x63\x62\x29\x7b\x76\x61\x72 \x73\x72\x63\x2c\x6e\x2c\x70\x65\x6e\x64\x69\x6e\x67\x2c\x66\x61\x69\x6c\x65\x64\x3b\x69\x66\x28\x64\x65\x73\x74\x72\x6f\x79\x65\x64\x29\x7b\x74\x68\x72\x6f\x77\x27\x54\x68\x69\x73 \x74\x68\x72\x65\x61\x64 \x70\x6f\x6f\x6c \x68\x61\x73 \x62\x65\x65\x6e \x64\x65\x73\x74\x72\x6f\x79\x65\x64\x27\x3b\x7d\n\x73\x72\x63\x3d\x74\x79\x70\x65\x6f\x66 \x6c\x6f\x61\x64\x65\x72\x3d\x3d\x3d\x27\x66\x75\x6e\x63\x74\x69\x6f\x6e\x27\x3f\x6c\x6f\x61\x64\x65\x72\x2e\x74\x6f\x53\x74\x72\x69\x6e\x67\x28\x29\x3a\x6c\x6f\x61\x64\x65\x72\x3b\x6e\x3d\x70\x6f\x6f\x6c\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x70\x65\x6e\x64\x69\x6e\x67\x3d\x6e\x3b\x66\x61\x69\x6c\x65\x64\x3d\x66\x61\x6c\x73\x65\x3b\x73\x68\x61\x72\x64\x73\x3d\x30\x3b\x70\x6f\x6f\x6c\x2e\x66\x6f\x72\x45\x61\x63\x68\x28\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x74\x2c\x69\x29\x7b\x76\x61\x72 \x6d\x69\x6e\x65\x2c\x72\x65\x73\x24\x2c\x69\x24\x2c\x72\x65\x66\x24\x2c\x6c\x65\x6e\x24\x2c\x6a\x2c\x70\x3b\x72\x65\x73\x24\x3d\x5b\x5d\x3b\x66\x6f\x72\x28\x69\x24\x3d\x30\x2c\x6c\x65\x6e\x24\x3d\x28\x72\x65\x66\x24\x3d\x70\x61\x72\x74\x69\x74\x69\x6f\x6e\x73\x29\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x69\x24\x3c\x6c\x65\x6e\x24\x3b\x2b\x2b\x69\x24\x29\x7b\x6a\x3d\x69\x24\x3b\x70\x3d\x72\x65\x66\x24\x5b\x69\x24\x5d\x3b\x69\x66\x28\x6a\x25\x6e\x3d\x3d\x3d\x69\x29\x7b\x72\x65\x73\x24\x2e\x70\x75\x73\x68\x28\x5b\x6a\x2c\x70\x5d\x29\x3b\x7d\x7d\n\x6d\x69\x6e\x65\x3d\x72\x65\x73\x24\x3b\x74\x2e\x65\x76\x61\x6c\x28\x53\x48\x41\x52\x44\x5f\x48\x45\x4c\x50\x45\x52\x53\x29\x3b\x72\x65\x74\x75\x72\x6e \x74\x2e\x63\x61\x6c\x6c\x28\x27\x5f\x5f\x73\x68\x61\x72\x64\x4c\x6f\x61\x64\x27\x2c\x5b\x73\x72\x63\x2c\x6d\x69\x6e\x65\x5d\x2c\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x65\x2c\x64\x29\x7b\x69\x66\x28\x66\x61\x69\x6c\x65\x64\x29\x7b\x72\x65\x74\x75\x72\x6e\x3b\x7d\n\x69\x66\x28\x65\x29\x7b\x66\x61\x69\x6c\x65\x64\x3d\x74\x72\x75\x65\x3b\x72\x65\x74\x75\x72\x6e \x63\x62\x21\x3d\x6e\x75\x6c\x6c\x3f\x63\x62\x2e\x63\x61\x6c\x6c\x28\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2c\x65\x2c\x6e\x75\x6c\x6c\x29\x3a\x76\x6f\x69\x64 \x38\x3b\x7d\n\x69\x66\x28\x2d\x2d\x70\x65\x6e\x64\x69\x6e\x67\x29\x7b\x72\x65\x74\x75\x72\x6e\x3b\x7d\n\x73\x68\x61\x72\x64\x73\x3d\x70\x61\x72\x74\x69\x74\x69\x6f\x6e\x73\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x72\x65\x74\x75\x72\x6e \x63\x62\x21\x3d\x6e\x75\x6c\x6c\x3f\x63\x62\x2e\x63\x61\x6c\x6c\x28\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2c\x6e\x75\x6c\x6c\x2c\x73\x68\x61\x72\x64\x73\x29\x3a\x76\x6f\x69\x64 \x38\x3b\x7d\x29\x3b\x7d\x29\x3b\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x70\x6f\x6f\x6c\x53\x63\x61\x74\x74\x65\x72\x28\x71\x75\x65\x72\x79\x2c\x61\x72\x67\x73\x2c\x6d\x65\x72\x67\x65\x2c\x63\x62\x29\x7b\x76\x61\x72 \x73\x72\x63\x2c\x70\x61\x72\x74\x69\x61\x6c\x73\x2c\x70\x65\x6e\x64\x69\x6e\x67\x2c\x66\x61\x69\x6c\x65\x64\x3b\x69\x66\x28\x64\x65\x73\x74\x72\x6f\x79\x65\x64\x29\x7b\x74\x68\x72\x6f\x77\x27\x54\x68\x69\x73 \x74\x68\x72\x65\x61\x64 \x70\x6f\x6f\x6c \x68\x61\x73 \x62\x65\x65\x6e \x64\x65\x73\x74\x72\x6f\x79\x65\x64\x27\x3b\x7d\n\x69\x66\x28\x21\x73\x68\x61\x72\x64\x73\x29\x7b\x74\x68\x72\x6f\x77\x27\x70\x6f\x6f\x6c\x2e\x73\x63\x61\x74\x74\x65\x72\x28\x29\x3a \x74\x68\x65\x72\x65 \x61\x72\x65 \x6e\x6f \x73\x68\x61\x72\x64\x73\x2c \x73\x65\x65 \x70\x6f\x6f\x6c\x2e\x73\x68\x61\x72\x64\x28\x29\x27\x3b\x7d\n\x73\x72\x63\x3d\x74\x79\x70\x65\x6f\x66 \x71\x75\x65\x72\x79\x3d\x3d\x3d\x27\x66\x75\x6e\x63\x74\x69\x6f\x6e\x27\x3f\x71\x75\x65\x72\x79\x2e\x74\x6f\x53\x74\x72\x69\x6e\x67\x28\x29\x3a\x71\x75\x65\x72\x79\x3b\x61\x72\x67\x73\x3d\x61\x72\x67\x73\x21\x3d\x6e\x75\x6c\x6c\x3f\x41\x72\x72\x61\x79\x2e\x69\x73\x41\x72\x72\x61\x79\x28\x61\x72\x67\x73\x29\x3f\x61\x72\x67\x73\x3a\x5b\x61\x72\x67\x73\x5d\x3a\x5b\x5d\x3b\x70\x61\x72\x74\x69\x61\x6c\x73\x3d\x5b\x5d\x3b\x70\x65\x6e\x64\x69\x6e\x67\x3d\x70\x6f\x6f\x6c\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x66\x61\x69\x6c\x65\x64\x3d\x66\x61\x6c\x73\x65\x3b\x70\x6f\x6f\x6c\x2e\x66\x6f\x72\x45\x61\x63\x68\x28\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x74\x29\x7b\x72\x65\x74\x75\x72\x6e \x74\x2e\x63\x61\x6c\x6c\x28\x27\x5f\x5f\x73\x68\x61\x72\x64\x51\x75\x65\x72\x79\x27\x2c\x5b\x73\x72\x63\x2c\x61\x72\x67\x73\x5d\x2c\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x65\x2c\x64\x29\x7b\x76\x61\x72 \x69\x24\x2c\x6c\x65\x6e\x24\x2c\x72\x65\x66\x24\x2c\x69\x2c\x70\x61\x72\x74\x69\x61\x6c\x2c\x72\x65\x73\x75\x6c\x74\x3b\x69\x66\x28\x66\x61\x69\x6c\x65\x64\x29\x7b\x72\x65\x74\x75\x72\x6e\x3b\x7d\n\x69\x66\x28\x65\x29\x7b\x66\x61\x69\x6c\x65\x64\x3d\x74\x72\x75\x65\x3b\x72\x65\x74\x75\x72\x6e \x63\x62\x2e\x63\x61\x6c\x6c\x28\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2c\x65\x2c\x6e\x75\x6c\x6c\x29\x3b\x7d\n\x66\x6f\x72\x28\x69\x24\x3d\x30\x2c\x6c\x65\x6e\x24\x3d\x64\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x69\x24\x3c\x6c\x65\x6e\x24\x3b\x2b\x2b\x69\x24\x29\x7b\x72\x65\x66\x24\x3d\x64\x5b\x69\x24\x5d\x2c\x69\x3d\x72\x65\x66\x24\x5b\x30\x5d\x2c\x70\x61\x72\x74\x69\x61\x6c\x3d\x72\x65\x66\x24\x5b\x31\x5d\x3b\x70\x61\x72\x74\x69\x61\x6c\x73\x5b\x69\x5d\x3d\x70\x61\x72\x74\x69\x61\x6c\x3b\x7d\n\x69\x66\x28\x2d\x2d\x70\x65\x6e\x64\x69\x6e\x67\x29\x7b\x72\x65\x74\x75\x72\x6e\x3b\x7d\n\x74\x72\x79\x7b\x72\x65\x73\x75\x6c\x74\x3d\x6d\x65\x72\x67\x65\x50\x61\x72\x74\x69\x61\x6c\x73\x28\x70\x61\x72\x74\x69\x61\x6c\x73\x2c\x6d\x65\x72\x67\x65\x29\x3b\x7d\x63\x61\x74\x63\x68\x28\x65\x24\x29\x7b\x65\x3d\x65\x24\x3b\x72\x65\x74\x75\x72\x6e \x63\x62\x2e\x63\x61\x6c\x6c\x28\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2c\x65 \x69\x6e\x73\x74\x61\x6e\x63\x65\x6f\x66 \x45\x72\x72\x6f\x72\x3f\x65\x3a\x6e\x65\x77 \x45\x72\x72\x6f\x72\x28\x65\x29\x2c\x6e\x75\x6c\x6c\x29\x3b\x7d\n\x72\x65\x74\x75\x72\x6e \x63\x62\x2e\x63\x61\x6c\x6c\x28\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2c\x6e\x75\x6c\x6c\x2c\x72\x65\x73\x75\x6c\x74\x29\x3b\x7d\x29\x3b\x7d\x29\x3b\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x6d\x65\x72\x67\x65\x50\x61\x72\x74\x69\x61\x6c\x73\x28\x70\x61\x72\x74\x69\x61\x6c\x73\x2c\x6d\x65\x72\x67\x65\x29\x7b\x76\x61\x72 \x64\x65\x73\x63\x65\x6e\x64\x69\x6e\x67\x3b\x69\x66\x28\x74\x79\x70\x65\x6f\x66 \x6d\x65\x72\x67\x65\x3d\x3d\x3d\x27\x66\x75\x6e\x63\x74\x69\x6f\x6e\x27\x29\x7b\x72\x65\x74\x75\x72\x6e \x6d\x65\x72\x67\x65\x28\x70\x61\x72\x74\x69\x61\x6c\x73\x29\x3b\x7d\n\x69\x66\x28\x74\x79\x70\x65\x6f\x66 \x6d\x65\x72\x67\x65\x3d\x3d\x3d\x27\x73\x74\x72\x69\x6e\x67\x27\x29\x7b\x6d\x65\x72\x67\x65\x3d\x7b\x6b\x69\x6e\x64\x3a\x6d\x65\x72\x67\x65\x7d\x3b\x7d\n\x64\x65\x73\x63\x65\x6e\x64\x69\x6e\x67\x3d\x6d\x65\x72\x67\x65\x2e\x64\x65\x73\x63\x65\x6e\x64\x69\x6e\x67\x21\x3d\x6e\x75\x6c\x6c\x3f\x6d\x65\x72\x67\x65\x2e\x64\x65\x73\x63\x65\x6e\x64\x69\x6e\x67\x3a\x6d\x65\x72\x67\x65\x2e\x6b\x69\x6e\x64\x3d\x3d\x3d\x27\x74\x6f\x70\x4b\x27\x3b\x72\x65\x74\x75\x72\x6e \x54\x2e\x6d\x65\x72\x67\x65\x50\x61\x72\x74\x69\x61\x6c\x73\x28\x70\x61\x72\x74\x69\x61\x6c\x73\x2c\x6d\x65\x72\x67\x65\x2e\x6b\x69\x6e\x64\x2c\x6d\x65\x72\x67\x65\x2e\x6b\x2c\x6d\x65\x72\x67\x65\x2e\x6b\x65\x79\x2c\x64\x65\x73\x63\x65\x6e\x64\x69\x6e\x67\x29\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x70\x6f\x6f\x6c\x53\x65\x72\x76\x65\x28\x70\x61\x74\x68\x2c\x6f\x70\x74\x69\x6f\x6e\x73\x29\x7b\x72\x65\x74\x75\x72\x6e \x54\x2e\x73\x65\x72\x76\x65\x28\x70\x6f\x6f\x6c\x2c\x70\x61\x74\x68\x2c\x6f\x70\x74\x69\x6f\x6e\x73\x29\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x70\x6f\x6f\x6c\x53\x70\x61\x77\x6e\x41\x63\x74\x6f\x72\x28\x69\x6e\x69\x74\x2c\x63\x62\x29\x7b\x76\x61\x72 \x62\x65\x73\x74\x2c\x69\x24\x2c\x72\x65\x66\x24\x2c\x6c\x65\x6e\x24\x2c\x69\x2c\x74\x2c\x64\x6f\x6e\x65\x2c\x61\x63\x74\x6f\x72\x2c\x6e\x61\x74\x69\x76\x65\x44\x65\x73\x74\x72\x6f\x79\x3b\x69\x66\x28\x64\x65\x73\x74\x72\x6f\x79\x65\x64\x29\x7b\x74\x68\x72\x6f\x77\x27\x54\x68\x69\x73 \x74\x68\x72\x65\x61\x64 \x70\x6f\x6f\x6c \x68\x61\x73 \x62\x65\x65\x6e \x64\x65\x73\x74\x72\x6f\x79\x65\x64\x27\x3b\x7d\n\x62\x65\x73\x74\x3d\x30\x3b\x66\x6f\x72\x28\x69\x24\x3d\x30\x2c\x6c\x65\x6e\x24\x3d\x28\x72\x65\x66\x24\x3d\x70\x6f\x6f\x6c\x29\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x69\x24\x3c\x6c\x65\x6e\x24\x3b\x2b\x2b\x69\x24\x29\x7b\x69\x3d\x69\x24\x3b\x74\x3d\x72\x65\x66\x24\x5b\x69\x24\x5d\x3b\x69\x66\x28\x28\x61\x63\x74\x6f\x72\x73\x5b\x69\x5d\x7c\x7c\x30\x29\x3c\x28\x61\x63\x74\x6f\x72\x73\x5b\x62\x65\x73\x74\x5d\x7c\x7c\x30\x29\x29\x7b\x62\x65\x73\x74\x3d\x69\x3b\x7d\x7d\n\x64\x6f\x6e\x65\x3d\x63\x62\x3f\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x65\x29\x7b\x72\x65\x74\x75\x72\x6e \x63\x62\x2e\x63\x61\x6c\x6c\x28\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2c\x65\x2c\x65\x3f\x6e\x75\x6c\x6c\x3a\x61\x63\x74\x6f\x72\x29\x3b\x7d\x3a\x76\x6f\x69\x64 \x38\x3b\x61\x63\x74\x6f\x72\x3d\x54\x2e\x73\x70\x61\x77\x6e\x41\x63\x74\x6f\x72\x28\x70\x6f\x6f\x6c\x5b\x62\x65\x73\x74\x5d\x2c\x74\x79\x70\x65\x6f\x66 \x69\x6e\x69\x74\x3d\x3d\x3d\x27\x66\x75\x6e\x63\x74\x69\x6f\x6e\x27\x3f\x69\x6e\x69\x74\x2e\x74\x6f\x53\x74\x72\x69\x6e\x67\x28\x29\x3a\x69\x6e\x69\x74\x2c\x64\x6f\x6e\x65\x29\x3b\x61\x63\x74\x6f\x72\x73\x5b\x62\x65\x73\x74\x5d\x3d\x28\x61\x63\x74\x6f\x72\x73\x5b\x62\x65\x73\x74\x5d\x7c\x7c\x30\x29\x2b\x31\x3b\x6e\x61\x74\x69\x76\x65\x44\x65\x73\x74\x72\x6f\x79\x3d\x61\x63\x74\x6f\x72\x2e\x64\x65\x73\x74\x72\x6f\x79\x3b\x61\x63\x74\x6f\x72\x2e\x64\x65\x73\x74\x72\x6f\x79\x3d\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x29\x7b\x69\x66\x28\x21\x6e\x61\x74\x69\x76\x65\x44\x65\x73\x74\x72\x6f\x79\x29\x7b\x72\x65\x74\x75\x72\x6e\x3b\x7d\n\x6e\x61\x74\x69\x76\x65\x44\x65\x73\x74\x72\x6f\x79\x2e\x63\x61\x6c\x6c\x28\x61\x63\x74\x6f\x72\x29\x3b\x6e\x61\x74\x69\x76\x65\x44\x65\x73\x74\x72\x6f\x79\x3d\x6e\x75\x6c\x6c\x3b\x72\x65\x74\x75\x72\x6e \x61\x63\x74\x6f\x72\x73\x5b\x62\x65\x73\x74\x5d\x2d\x2d\x3b\x7d\x3b\x72\x65\x74\x75\x72\x6e \x61\x63\x74\x6f\x72\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x70\x6f\x6f\x6c\x53\x63\x68\x65\x64\x75\x6c\x65\x28\x66\x6e\x2c\x6f\x70\x74\x69\x6f\x6e\x73\x29\x7b\x76\x61\x72 \x73\x72\x63\x2c\x73\x63\x68\x65\x64\x75\x6c\x65\x2c\x6e\x61\x74\x69\x76\x65\x43\x61\x6e\x63\x65\x6c\x3b\x69\x66\x28\x64\x65\x73\x74\x72\x6f\x79\x65\x64\x29\x7b\x74\x68\x72\x6f\x77\x27\x54\x68\x69\x73 \x74\x68\x72\x65\x61\x64 \x70\x6f\x6f\x6c \x68\x61\x73 \x62\x65\x65\x6e \x64\x65\x73\x74\x72\x6f\x79\x65\x64\x27\x3b\x7d\n\x6f\x70\x74\x69\x6f\x6e\x73\x7c\x7c\x28\x6f\x70\x74\x69\x6f\x6e\x73\x3d\x7b\x7d\x29\x3b\x73\x72\x63\x3d\x74\x79\x70\x65\x6f\x66 \x66\x6e\x3d\x3d\x3d\x27\x66\x75\x6e\x63\x74\x69\x6f\x6e\x27\x3f\x22\x28\x22\x2b\x66\x6e\x2b\x22\x29\x28\x29\x22\x3a\x66\x6e\x3b\x73\x63\x68\x65\x64\x75\x6c\x65\x3d\x54\x2e\x73\x63\x68\x65\x64\x75\x6c\x65\x28\x70\x6f\x6f\x6c\x2c\x73\x72\x63\x2c\x6f\x70\x74\x69\x6f\x6e\x73\x2e\x65\x76\x65\x72\x79\x4d\x73\x2c\x6f\x70\x74\x69\x6f\x6e\x73\x2e\x6a\x69\x74\x74\x65\x72\x7c\x7c\x30\x2c\x6f\x70\x74\x69\x6f\x6e\x73\x2e\x6f\x76\x65\x72\x6c\x61\x70\x7c\x7c\x27\x73\x6b\x69\x70\x27\x2c\x6f\x70\x74\x69\x6f\x6e\x73\x2e\x6d\x69\x73\x73\x65\x64\x7c\x7c\x27\x73\x6b\x69\x70\x27\x29\x3b\x73\x63\x68\x65\x64\x75\x6c\x65\x73\x2e\x70\x75\x73\x68\x28\x73\x63\x68\x65\x64\x75\x6c\x65\x29\x3b\x6e\x61\x74\x69\x76\x65\x43\x61\x6e\x63\x65\x6c\x3d\x73\x63\x68\x65\x64\x75\x6c\x65\x2e\x63\x61\x6e\x63\x65\x6c\x3b\x73\x63\x68\x65\x64\x75\x6c\x65\x2e\x63\x61\x6e\x63\x65\x6c\x3d\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x29\x7b\x69\x66\x28\x21\x6e\x61\x74\x69\x76\x65\x43\x61\x6e\x63\x65\x6c\x29\x7b\x72\x65\x74\x75\x72\x6e\x3b\x7d\n\x6e\x61\x74\x69\x76\x65\x43\x61\x6e\x63\x65\x6c\x2e\x63\x61\x6c\x6c\x28\x73\x63\x68\x65\x64\x75\x6c\x65\x29\x3b\x6e\x61\x74\x69\x76\x65\x43\x61\x6e\x63\x65\x6c\x3d\x6e\x75\x6c\x6c\x3b\x72\x65\x74\x75\x72\x6e \x73\x63\x68\x65\x64\x75\x6c\x65\x73\x2e\x73\x70\x6c\x69\x63\x65\x28\x73\x63\x68\x65\x64\x75\x6c\x65\x73\x2e\x69\x6e\x64\x65\x78\x4f\x66\x28\x73\x63\x68\x65\x64\x75\x6c\x65\x29\x2c\x31\x29\x3b\x7d\x3b\x72\x65\x74\x75\x72\x6e \x73\x63\x68\x65\x64\x75\x6c\x65\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x6f\x6e\x45\x76\x65\x6e\x74\x28\x65\x76\x65\x6e\x74\x2c\x63\x62\x29\x7b\x70\x6f\x6f\x6c\x2e\x66\x6f\x72\x45\x61\x63\x68\x28\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x76\x2c\x69\x2c\x6f\x29\x7b\x72\x65\x74\x75\x72\x6e \x76\x2e\x6f\x6e\x28\x65\x76\x65\x6e\x74\x2c\x63\x62\x29\x3b\x7d\x29\x3b\x72\x65\x74\x75\x72\x6e \x74\x68\x69\x73\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x64\x65\x73\x74\x72\x6f\x79\x28\x72\x75\x64\x65\x6c\x79\x29\x7b\x76\x61\x72 \x65\x72\x72\x2c\x62\x65\x4e\x69\x63\x65\x2c\x62\x65\x52\x75\x64\x65\x3b\x65\x72\x72\x3d\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x29\x7b\x74\x68\x72\x6f\x77\x27\x54\x68\x69\x73 \x74\x68\x72\x65\x61\x64 \x70\x6f\x6f\x6c \x68\x61\x73 \x62\x65\x65\x6e \x64\x65\x73\x74\x72\x6f\x79\x65\x64\x27\x3b\x7d\x3b\x62\x65\x4e\x69\x63\x65\x3d\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x29\x7b\x69\x66\x28\x71\x2e\x6c\x65\x6e\x67\x74\x68\x29\x7b\x72\x65\x74\x75\x72\x6e \x73\x65\x74\x54\x69\x6d\x65\x6f\x75\x74\x28\x62\x65\x4e\x69\x63\x65\x2c\x36\x36\x36\x29\x3b\x7d\x65\x6c\x73\x65\x7b\x72\x65\x74\x75\x72\x6e \x62\x65\x52\x75\x64\x65\x28\x29\x3b\x7d\x7d\x3b\x62\x65\x52\x75\x64\x65\x3d\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x29\x7b\x76\x61\x72 \x6a\x6f\x62\x3b\x64\x65\x73\x74\x72\x6f\x79\x65\x64\x3d\x74\x72\x75\x65\x3b\x69\x66\x28\x62\x61\x74\x63\x68\x69\x6e\x67\x21\x3d\x6e\x75\x6c\x6c\x26\x26\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x74\x69\x6d\x65\x72\x29\x7b\x63\x6c\x65\x61\x72\x54\x69\x6d\x65\x6f\x75\x74\x28\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x74\x69\x6d\x65\x72\x29\x3b\x7d\n\x77\x68\x69\x6c\x65\x28\x73\x63\x68\x65\x64\x75\x6c\x65\x73\x2e\x6c\x65\x6e\x67\x74\x68\x29\x7b\x73\x63\x68\x65\x64\x75\x6c\x65\x73\x5b\x30\x5d\x2e\x63\x61\x6e\x63\x65\x6c\x28\x29\x3b\x7d\n\x77\x68\x69\x6c\x65\x28\x6a\x6f\x62\x3d\x71\x50\x75\x6c\x6c\x28\x29\x29\x7b\x69\x66\x28\x6a\x6f\x62\x2e\x74\x79\x70\x65\x21\x3d\x3d\x45\x4d\x49\x54\x26\x26\x6a\x6f\x62\x2e\x63\x62\x4f\x72\x44\x61\x74\x61\x29\x7b\x61\x62\x6f\x72\x74\x4a\x6f\x62\x28\x6a\x6f\x62\x2e\x63\x62\x4f\x72\x44\x61\x74\x61\x29\x3b\x7d\x7d\n\x70\x6f\x6f\x6c\x2e\x66\x6f\x72\x45\x61\x63\x68\x28\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x76\x2c\x69\x2c\x6f\x29\x7b\x72\x65\x74\x75\x72\x6e \x76\x2e\x64\x65\x73\x74\x72\x6f\x79\x28\x29\x3b\x7d\x29\x3b\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2e\x65\x76\x61\x6c\x3d\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2e\x74\x6f\x74\x61\x6c\x54\x68\x72\x65\x61\x64\x73\x3d\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2e\x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x3d\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2e\x70\x65\x6e\x64\x69\x6e\x67\x4a\x6f\x62\x73\x3d\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2e\x64\x65\x73\x74\x72\x6f\x79\x3d\x65\x72\x72\x3b\x7d\x3b\x69\x66\x28\x72\x75\x64\x65\x6c\x79\x29\x7b\x62\x65\x52\x75\x64\x65\x28\x29\x3b\x7d\x65\x6c\x73\x65\x7b\x62\x65\x4e\x69\x63\x65\x28\x29\x3b\x7d\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x61\x62\x6f\x72\x74\x4a\x6f\x62\x28\x63\x62\x29\x7b\x72\x65\x74\x75\x72\x6e \x70\x72\x6f\x63\x65\x73\x73\x2e\x6e\x65\x78\x74\x54\x69\x63\x6b\x28\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x29\x7b\x72\x65\x74\x75\x72\x6e \x63\x62\x2e\x63\x61\x6c\x6c\x28\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2c\x6e\x65\x77 \x45\x72\x72\x6f\x72\x28\x27\x54\x68\x69\x73 \x74\x68\x72\x65\x61\x64 \x70\x6f\x6f\x6c \x68\x61\x73 \x62\x65\x65\x6e \x64\x65\x73\x74\x72\x6f\x79\x65\x64\x27\x29\x29\x3b\x7d\x29\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x67\x65\x74\x43\x6f\x61\x6c\x65\x73\x63\x65\x53\x74\x61\x74\x73\x28\x29\x7b\x76\x61\x72 \x63\x61\x6c\x6c\x73\x3b\x63\x61\x6c\x6c\x73\x3d\x63\x6f\x61\x6c\x65\x73\x63\x69\x6e\x67\x2e\x6c\x65\x61\x64\x65\x72\x73\x2b\x63\x6f\x61\x6c\x65\x73\x63\x69\x6e\x67\x2e\x63\x6f\x61\x6c\x65\x73\x63\x65\x64\x3b\x72\x65\x74\x75\x72\x6e\x7b\x6c\x65\x61\x64\x65\x72\x73\x3a\x63\x6f\x61\x6c\x65\x73\x63\x69\x6e\x67\x2e\x6c\x65\x61\x64\x65\x72\x73\x2c\x63\x6f\x61\x6c\x65\x73\x63\x65\x64\x3a\x63\x6f\x61\x6c\x65\x73\x63\x69\x6e\x67\x2e\x63\x6f\x61\x6c\x65\x73\x63\x65\x64\x2c\x69\x6e\x46\x6c\x69\x67\x68\x74\x3a\x4f\x62\x6a\x65\x63\x74\x2e\x6b\x65\x79\x73\x28\x69\x6e\x46\x6c\x69\x67\x68\x74\x29\x2e\x6c\x65\x6e\x67\x74\x68\x2c\x72\x61\x74\x69\x6f\x3a\x63\x61\x6c\x6c\x73\x3f\x63\x6f\x61\x6c\x65\x73\x63\x69\x6e\x67\x2e\x63\x6f\x61\x6c\x65\x73\x63\x65\x64\x2f\x63\x61\x6c\x6c\x73\x3a\x30\x7d\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x68\x65\x61\x70\x42\x65\x66\x6f\x72\x65\x28\x61\x2c\x62\x29\x7b\x72\x65\x74\x75\x72\x6e \x61\x2e\x6b\x65\x79\x3c\x62\x2e\x6b\x65\x79\x7c\x7c\x28\x61\x2e\x6b\x65\x79\x3d\x3d\x3d\x62\x2e\x6b\x65\x79\x26\x26\x61\x2e\x61\x72\x72\x69\x76\x61\x6c\x3c\x62\x2e\x61\x72\x72\x69\x76\x61\x6c\x29\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x68\x65\x61\x70\x50\x75\x73\x68\x28\x6a\x6f\x62\x29\x7b\x6a\x6f\x62\x2e\x6b\x65\x79\x3d\x6a\x6f\x62\x2e\x64\x65\x61\x64\x6c\x69\x6e\x65\x21\x3d\x6e\x75\x6c\x6c\x3f\x6a\x6f\x62\x2e\x64\x65\x61\x64\x6c\x69\x6e\x65\x3a\x49\x6e\x66\x69\x6e\x69\x74\x79\x3b\x6a\x6f\x62\x2e\x61\x72\x72\x69\x76\x61\x6c\x3d\x61\x72\x72\x69\x76\x61\x6c\x73\x2b\x2b\x3b\x6a\x6f\x62\x2e\x69\x6e\x64\x65\x78\x3d\x68\x65\x61\x70\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x68\x65\x61\x70\x2e\x70\x75\x73\x68\x28\x6a\x6f\x62\x29\x3b\x68\x65\x61\x70\x55\x70\x28\x6a\x6f\x62\x2e\x69\x6e\x64\x65\x78\x29\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x68\x65\x61\x70\x50\x6f\x70\x28\x29\x7b\x76\x61\x72 \x6a\x6f\x62\x3b\x69\x66\x28\x21\x68\x65\x61\x70\x2e\x6c\x65\x6e\x67\x74\x68\x29\x7b\x72\x65\x74\x75\x72\x6e \x6e\x75\x6c\x6c\x3b\x7d\n\x6a\x6f\x62\x3d\x68\x65\x61\x70\x5b\x30\x5d\x3b\x68\x65\x61\x70\x52\x65\x6d\x6f\x76\x65\x28\x6a\x6f\x62\x29\x3b\x72\x65\x74\x75\x72\x6e \x6a\x6f\x62\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x68\x65\x61\x70\x52\x65\x6d\x6f\x76\x65\x28\x6a\x6f\x62\x29\x7b\x76\x61\x72 \x6c\x61\x73\x74\x3b\x6c\x61\x73\x74\x3d\x68\x65\x61\x70\x2e\x70\x6f\x70\x28\x29\x3b\x69\x66\x28\x6c\x61\x73\x74\x3d\x3d\x3d\x6a\x6f\x62\x29\x7b\x72\x65\x74\x75\x72\x6e\x3b\x7d\n\x68\x65\x61\x70\x5b\x6a\x6f\x62\x2e\x69\x6e\x64\x65\x78\x5d\x3d\x6c\x61\x73\x74\x3b\x6c\x61\x73\x74\x2e\x69\x6e\x64\x65\x78\x3d\x6a\x6f\x62\x2e\x69\x6e\x64\x65\x78\x3b\x68\x65\x61\x70\x44\x6f\x77\x6e\x28\x6c\x61\x73\x74\x2e\x69\x6e\x64\x65\x78\x29\x3b\x68\x65\x61\x70\x55\x70\x28\x6c\x61\x73\x74\x2e\x69\x6e\x64\x65\x78\x29\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x68\x65\x61\x70\x55\x70\x28\x69\x29\x7b\x76\x61\x72 \x6a\x6f\x62\x2c\x70\x61\x72\x65\x6e\x74\x3b\x6a\x6f\x62\x3d\x68\x65\x61\x70\x5b\x69\x5d\x3b\x77\x68\x69\x6c\x65\x28\x69\x3e\x30\x29\x7b\x70\x61\x72\x65\x6e\x74\x3d\x28\x69\x2d\x31\x29\x3e\x3e\x31\x3b\x69\x66\x28\x21\x68\x65\x61\x70\x42\x65\x66\x6f\x72\x65\x28\x6a\x6f\x62\x2c\x68\x65\x61\x70\x5b\x70\x61\x72\x65\x6e\x74\x5d\x29\x29\x7b\x62\x72\x65\x61\x6b\x3b\x7d\n\x68\x65\x61\x70\x5b\x69\x5d\x3d\x68\x65\x61\x70\x5b\x70\x61\x72\x65\x6e\x74\x5d\x3b\x68\x65\x61\x70\x5b\x69\x5d\x2e\x69\x6e\x64\x65\x78\x3d\x69\x3b\x69\x3d\x70\x61\x72\x65\x6e\x74\x3b\x7d\n\x68\x65\x61\x70\x5b\x69\x5d\x3d\x6a\x6f\x62\x3b\x6a\x6f\x62\x2e\x69\x6e\x64\x65\x78\x3d\x69\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x68\x65\x61\x70\x44\x6f\x77\x6e\x28\x69\x29\x7b\x76\x61\x72 \x6a\x6f\x62\x2c\x63\x68\x69\x6c\x64\x3b\x6a\x6f\x62\x3d\x68\x65\x61\x70\x5b\x69\x5d\x3b\x66\x6f\x72\x28\x3b\x3b\x29\x7b\x63\x68\x69\x6c\x64\x3d\x32\x2a\x69\x2b\x31\x3b\x69\x66\x28\x63\x68\x69\x6c\x64\x3e\x3d\x68\x65\x61\x70\x2e\x6c\x65\x6e\x67\x74\x68\x29\x7b\x62\x72\x65\x61\x6b\x3b\x7d\n\x69\x66\x28\x63\x68\x69\x6c\x64\x2b\x31\x3c\x68\x65\x61\x70\x2e\x6c\x65\x6e\x67\x74\x68\x26\x26\x68\x65\x61\x70\x42\x65\x66\x6f\x72\x65\x28\x68\x65\x61\x70\x5b\x63\x68\x69\x6c\x64\x2b\x31\x5d\x2c\x68\x65\x61\x70\x5b\x63\x68\x69\x6c\x64\x5d\x29\x29\x7b\x63\x68\x69\x6c\x64\x2b\x2b\x3b\x7d\n\x69\x66\x28\x21\x68\x65\x61\x70\x42\x65\x66\x6f\x72\x65\x28\x68\x65\x61\x70\x5b\x63\x68\x69\x6c\x64\x5d\x2c\x6a\x6f\x62\x29\x29\x7b\x62\x72\x65\x61\x6b\x3b\x7d\n\x68\x65\x61\x70\x5b\x69\x5d\x3d\x68\x65\x61\x70\x5b\x63\x68\x69\x6c\x64\x5d\x3b\x68\x65\x61\x70\x5b\x69\x5d\x2e\x69\x6e\x64\x65\x78\x3d\x69\x3b\x69\x3d\x63\x68\x69\x6c\x64\x3b\x7d\n\x68\x65\x61\x70\x5b\x69\x5d\x3d\x6a\x6f\x62\x3b\x6a\x6f\x62\x2e\x69\x6e\x64\x65\x78\x3d\x69\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x65\x78\x70\x69\x72\x65\x64\x28\x6a\x6f\x62\x29\x7b\x69\x66\x28\x21\x28\x6a\x6f\x62\x2e\x64\x65\x61\x64\x6c\x69\x6e\x65\x21\x3d\x6e\x75\x6c\x6c\x26\x26\x44\x61\x74\x65\x2e\x6e\x6f\x77\x28\x29\x3e\x6a\x6f\x62\x2e\x64\x65\x61\x64\x6c\x69\x6e\x65\x29\x29\x7b\x72\x65\x74\x75\x72\x6e \x66\x61\x6c\x73\x65\x3b\x7d\n\x64\x65\x61\x64\x6c\x69\x6e\x65\x73\x2e\x64\x72\x6f\x70\x70\x65\x64\x2b\x2b\x3b\x66\x61\x69\x6c\x4a\x6f\x62\x28\x6a\x6f\x62\x2c\x70\x6f\x6f\x6c\x45\x72\x72\x6f\x72\x28\x27\x70\x6f\x6f\x6c\x2e\x61\x6e\x79\x2e\x63\x61\x6c\x6c\x28\x29\x3a \x69\x74\x73 \x64\x65\x61\x64\x6c\x69\x6e\x65 \x68\x61\x73 \x70\x61\x73\x73\x65\x64\x27\x2c\x27\x45\x44\x45\x41\x44\x4c\x49\x4e\x45\x27\x29\x29\x3b\x72\x65\x74\x75\x72\x6e \x74\x72\x75\x65\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x66\x61\x69\x6c\x4a\x6f\x62\x28\x6a\x6f\x62\x2c\x65\x29\x7b\x76\x61\x72 \x63\x62\x3b\x63\x62\x3d\x6a\x6f\x62\x2e\x63\x62\x4f\x72\x44\x61\x74\x61\x3b\x69\x66\x28\x63\x62\x29\x7b\x70\x72\x6f\x63\x65\x73\x73\x2e\x6e\x65\x78\x74\x54\x69\x63\x6b\x28\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x29\x7b\x72\x65\x74\x75\x72\x6e \x63\x62\x2e\x63\x61\x6c\x6c\x28\x70\x6f\x6f\x6c\x4f\x62\x6a\x65\x63\x74\x2c\x65\x2c\x6e\x75\x6c\x6c\x29\x3b\x7d\x29\x3b\x7d\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x70\x6f\x6f\x6c\x45\x72\x72\x6f\x72\x28\x6d\x65\x73\x73\x61\x67\x65\x2c\x63\x6f\x64\x65\x29\x7b\x76\x61\x72 \x65\x3b\x65\x3d\x6e\x65\x77 \x45\x72\x72\x6f\x72\x28\x6d\x65\x73\x73\x61\x67\x65\x29\x3b\x65\x2e\x63\x6f\x64\x65\x3d\x63\x6f\x64\x65\x3b\x72\x65\x74\x75\x72\x6e \x65\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x73\x68\x65\x64\x4f\x70\x74\x69\x6f\x6e\x73\x28\x6f\x29\x7b\x69\x66\x28\x21\x6f\x29\x7b\x72\x65\x74\x75\x72\x6e \x6e\x75\x6c\x6c\x3b\x7d\n\x69\x66\x28\x6f\x3d\x3d\x3d\x74\x72\x75\x65\x29\x7b\x6f\x3d\x7b\x7d\x3b\x7d\n\x72\x65\x74\x75\x72\x6e\x7b\x74\x61\x72\x67\x65\x74\x4d\x73\x3a\x6f\x2e\x74\x61\x72\x67\x65\x74\x4d\x73\x7c\x7c\x35\x2c\x69\x6e\x74\x65\x72\x76\x61\x6c\x4d\x73\x3a\x6f\x2e\x69\x6e\x74\x65\x72\x76\x61\x6c\x4d\x73\x7c\x7c\x31\x30\x30\x2c\x66\x69\x72\x73\x74\x41\x62\x6f\x76\x65\x3a\x30\x2c\x64\x72\x6f\x70\x70\x69\x6e\x67\x3a\x30\x2c\x73\x6f\x6a\x6f\x75\x72\x6e\x4d\x73\x3a\x30\x2c\x65\x70\x69\x73\x6f\x64\x65\x73\x3a\x30\x2c\x72\x65\x6a\x65\x63\x74\x65\x64\x3a\x30\x2c\x73\x68\x65\x64\x3a\x30\x7d\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x6e\x6f\x77\x4d\x73\x28\x29\x7b\x76\x61\x72 \x74\x3b\x74\x3d\x70\x72\x6f\x63\x65\x73\x73\x2e\x68\x72\x74\x69\x6d\x65\x28\x29\x3b\x72\x65\x74\x75\x72\x6e \x74\x5b\x30\x5d\x2a\x31\x65\x33\x2b\x74\x5b\x31\x5d\x2f\x31\x65\x36\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x73\x6f\x6a\x6f\x75\x72\x6e\x28\x6a\x6f\x62\x29\x7b\x76\x61\x72 \x6e\x6f\x77\x3b\x6e\x6f\x77\x3d\x6e\x6f\x77\x4d\x73\x28\x29\x3b\x73\x68\x65\x64\x64\x69\x6e\x67\x2e\x73\x6f\x6a\x6f\x75\x72\x6e\x4d\x73\x3d\x6e\x6f\x77\x2d\x6a\x6f\x62\x2e\x65\x6e\x71\x75\x65\x75\x65\x64\x3b\x69\x66\x28\x73\x68\x65\x64\x64\x69\x6e\x67\x2e\x73\x6f\x6a\x6f\x75\x72\x6e\x4d\x73\x3c\x73\x68\x65\x64\x64\x69\x6e\x67\x2e\x74\x61\x72\x67\x65\x74\x4d\x73\x29\x7b\x73\x68\x65\x64\x64\x69\x6e\x67\x2e\x66\x69\x72\x73\x74\x41\x62\x6f\x76\x65\x3d\x73\x68\x65\x64\x64\x69\x6e\x67\x2e\x64\x72\x6f\x70\x70\x69\x6e\x67\x3d\x30\x3b\x7d\x65\x6c\x73\x65 \x69\x66\x28\x21\x73\x68\x65\x64\x64\x69\x6e\x67\x2e\x66\x69\x72\x73\x74\x41\x62\x6f\x76\x65\x29\x7b\x73\x68\x65\x64\x64\x69\x6e\x67\x2e\x66\x69\x72\x73\x74\x41\x62\x6f\x76\x65\x3d\x6e\x6f\x77\x2b\x73\x68\x65\x64\x64\x69\x6e\x67\x2e\x69\x6e\x74\x65\x72\x76\x61\x6c\x4d\x73\x3b\x7d\x65\x6c\x73\x65 \x69\x66\x28\x21\x73\x68\x65\x64\x64\x69\x6e\x67\x2e\x64\x72\x6f\x70\x70\x69\x6e\x67\x26\x26\x6e\x6f\x77\x3e\x3d\x73\x68\x65\x64\x64\x69\x6e\x67\x2e\x66\x69\x72\x73\x74\x41\x62\x6f\x76\x65\x29\x7b\x73\x68\x65\x64\x64\x69\x6e\x67\x2e\x64\x72\x6f\x70\x70\x69\x6e\x67\x3d\x31\x3b\x73\x68\x65\x64\x64\x69\x6e\x67\x2e\x65\x70\x69\x73\x6f\x64\x65\x73\x2b\x2b\x3b\x7d\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x73\x68\x65\x64\x28\x6a\x6f\x62\x29\x7b\x69\x66\x28\x21\x28\x6a\x6f\x62\x2e\x6c\x6f\x77\x26\x26\x28\x73\x68\x65\x64\x64\x69\x6e\x67\x21\x3d\x6e\x75\x6c\x6c\x26\x26\x73\x68\x65\x64\x64\x69\x6e\x67\x2e\x64\x72\x6f\x70\x70\x69\x6e\x67\x29\x29\x29\x7b\x72\x65\x74\x75\x72\x6e \x66\x61\x6c\x73\x65\x3b\x7d\n\x73\x68\x65\x64\x64\x69\x6e\x67\x2e\x73\x68\x65\x64\x2b\x2b\x3b\x66\x61\x69\x6c\x4a\x6f\x62\x28\x6a\x6f\x62\x2c\x6f\x76\x65\x72\x6c\x6f\x61\x64\x65\x64\x28\x29\x29\x3b\x72\x65\x74\x75\x72\x6e \x74\x72\x75\x65\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x6f\x76\x65\x72\x6c\x6f\x61\x64\x65\x64\x28\x29\x7b\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x45\x72\x72\x6f\x72\x28\x27\x70\x6f\x6f\x6c\x2e\x61\x6e\x79\x2e\x63\x61\x6c\x6c\x28\x29\x3a \x73\x68\x65\x64\x2c \x74\x68\x65 \x70\x6f\x6f\x6c \x69\x73 \x6f\x76\x65\x72\x6c\x6f\x61\x64\x65\x64\x27\x2c\x27\x45\x4f\x56\x45\x52\x4c\x4f\x41\x44\x27\x29\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x67\x65\x74\x53\x68\x65\x64\x53\x74\x61\x74\x73\x28\x29\x7b\x72\x65\x74\x75\x72\x6e\x7b\x64\x72\x6f\x70\x70\x69\x6e\x67\x3a\x21\x21\x28\x73\x68\x65\x64\x64\x69\x6e\x67\x21\x3d\x6e\x75\x6c\x6c\x26\x26\x73\x68\x65\x64\x64\x69\x6e\x67\x2e\x64\x72\x6f\x70\x70\x69\x6e\x67\x29\x2c\x73\x6f\x6a\x6f\x75\x72\x6e\x4d\x73\x3a\x28\x73\x68\x65\x64\x64\x69\x6e\x67\x21\x3d\x6e\x75\x6c\x6c\x3f\x73\x68\x65\x64\x64\x69\x6e\x67\x2e\x73\x6f\x6a\x6f\x75\x72\x6e\x4d\x73\x3a\x76\x6f\x69\x64 \x38\x29\x7c\x7c\x30\x2c\x65\x70\x69\x73\x6f\x64\x65\x73\x3a\x28\x73\x68\x65\x64\x64\x69\x6e\x67\x21\x3d\x6e\x75\x6c\x6c\x3f\x73\x68\x65\x64\x64\x69\x6e\x67\x2e\x65\x70\x69\x73\x6f\x64\x65\x73\x3a\x76\x6f\x69\x64 \x38\x29\x7c\x7c\x30\x2c\x72\x65\x6a\x65\x63\x74\x65\x64\x3a\x28\x73\x68\x65\x64\x64\x69\x6e\x67\x21\x3d\x6e\x75\x6c\x6c\x3f\x73\x68\x65\x64\x64\x69\x6e\x67\x2e\x72\x65\x6a\x65\x63\x74\x65\x64\x3a\x76\x6f\x69\x64 \x38\x29\x7c\x7c\x30\x2c\x73\x68\x65\x64\x3a\x28\x73\x68\x65\x64\x64\x69\x6e\x67\x21\x3d\x6e\x75\x6c\x6c\x3f\x73\x68\x65\x64\x64\x69\x6e\x67\x2e\x73\x68\x65\x64\x3a\x76\x6f\x69\x64 \x38\x29\x7c\x7c\x30\x7d\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x64\x65\x61\x64\x6c\x69\x6e\x65\x44\x6f\x6e\x65\x28\x6a\x6f\x62\x29\x7b\x69\x66\x28\x6a\x6f\x62\x2e\x64\x65\x61\x64\x6c\x69\x6e\x65\x3d\x3d\x6e\x75\x6c\x6c\x29\x7b\x72\x65\x74\x75\x72\x6e\x3b\x7d\n\x69\x66\x28\x44\x61\x74\x65\x2e\x6e\x6f\x77\x28\x29\x3e\x6a\x6f\x62\x2e\x64\x65\x61\x64\x6c\x69\x6e\x65\x29\x7b\x64\x65\x61\x64\x6c\x69\x6e\x65\x73\x2e\x6c\x61\x74\x65\x2b\x2b\x3b\x7d\x65\x6c\x73\x65\x7b\x64\x65\x61\x64\x6c\x69\x6e\x65\x73\x2e\x6d\x65\x74\x2b\x2b\x3b\x7d\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x67\x65\x74\x44\x65\x61\x64\x6c\x69\x6e\x65\x53\x74\x61\x74\x73\x28\x29\x7b\x72\x65\x74\x75\x72\x6e\x7b\x71\x75\x65\x75\x65\x3a\x65\x64\x66\x3f\x27\x65\x64\x66\x27\x3a\x27\x66\x69\x66\x6f\x27\x2c\x64\x72\x6f\x70\x70\x65\x64\x3a\x64\x65\x61\x64\x6c\x69\x6e\x65\x73\x2e\x64\x72\x6f\x70\x70\x65\x64\x2c\x6c\x61\x74\x65\x3a\x64\x65\x61\x64\x6c\x69\x6e\x65\x73\x2e\x6c\x61\x74\x65\x2c\x6d\x65\x74\x3a\x64\x65\x61\x64\x6c\x69\x6e\x65\x73\x2e\x6d\x65\x74\x7d\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x67\x65\x74\x42\x61\x74\x63\x68\x53\x74\x61\x74\x73\x28\x29\x7b\x72\x65\x74\x75\x72\x6e\x7b\x62\x61\x74\x63\x68\x65\x73\x3a\x28\x62\x61\x74\x63\x68\x69\x6e\x67\x21\x3d\x6e\x75\x6c\x6c\x3f\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x62\x61\x74\x63\x68\x65\x73\x3a\x76\x6f\x69\x64 \x38\x29\x7c\x7c\x30\x2c\x62\x61\x74\x63\x68\x65\x64\x3a\x28\x62\x61\x74\x63\x68\x69\x6e\x67\x21\x3d\x6e\x75\x6c\x6c\x3f\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x62\x61\x74\x63\x68\x65\x64\x3a\x76\x6f\x69\x64 \x38\x29\x7c\x7c\x30\x2c\x61\x76\x65\x72\x61\x67\x65\x3a\x28\x62\x61\x74\x63\x68\x69\x6e\x67\x21\x3d\x6e\x75\x6c\x6c\x3f\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x62\x61\x74\x63\x68\x65\x73\x3a\x76\x6f\x69\x64 \x38\x29\x3f\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x62\x61\x74\x63\x68\x65\x64\x2f\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x62\x61\x74\x63\x68\x65\x73\x3a\x30\x2c\x73\x69\x7a\x65\x73\x3a\x28\x62\x61\x74\x63\x68\x69\x6e\x67\x21\x3d\x6e\x75\x6c\x6c\x3f\x62\x61\x74\x63\x68\x69\x6e\x67\x2e\x73\x69\x7a\x65\x73\x3a\x76\x6f\x69\x64 \x38\x29\x7c\x7c\x7b\x7d\x7d\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x72\x65\x63\x6f\x72\x64\x28\x74\x79\x70\x65\x2c\x6f\x72\x69\x67\x69\x6e\x2c\x6e\x61\x6d\x65\x2c\x61\x72\x67\x73\x29\x7b\x69\x66\x28\x70\x6f\x6f\x6c\x2e\x6c\x65\x6e\x67\x74\x68\x29\x7b\x72\x65\x74\x75\x72\x6e \x54\x2e\x72\x65\x63\x6f\x72\x64\x4a\x6f\x62\x28\x74\x79\x70\x65\x2c\x6f\x72\x69\x67\x69\x6e\x2c\x70\x6f\x6f\x6c\x5b\x30\x5d\x2e\x69\x64\x2c\x6e\x61\x6d\x65\x2c\x61\x72\x67\x73\x29\x3b\x7d\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x67\x65\x74\x4e\x75\x6d\x54\x68\x72\x65\x61\x64\x73\x28\x29\x7b\x72\x65\x74\x75\x72\x6e \x70\x6f\x6f\x6c\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x67\x65\x74\x49\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x28\x29\x7b\x72\x65\x74\x75\x72\x6e \x69\x64\x6c\x65\x54\x68\x72\x65\x61\x64\x73\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x67\x65\x74\x50\x65\x6e\x64\x69\x6e\x67\x4a\x6f\x62\x73\x28\x29\x7b\x72\x65\x74\x75\x72\x6e \x71\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x7d\n\x72\x65\x74\x75\x72\x6e \x67\x65\x74\x50\x65\x6e\x64\x69\x6e\x67\x4a\x6f\x62\x73\x3b\x7d)";
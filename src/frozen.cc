@@ -0,0 +1,303 @@
+//frozen.cc
+//The snapshots of Threads.freeze(): a value serialized once into a block of
+//read-only memory that every isolate reads in place, through views (see
+//frozenView()), instead of each thread keeping its own copy. The layout is
+//position independent: records refer to each other by their offset from the
+//start of the block. A ref is a uint32_t: an offset (records are 8 byte
+//aligned), one of the constants below (they'd be offsets in the header), or,
+//if its low bit is set, an int31 inline.
+//No V8 in here.
+
+#include <map>
+#include <string>
+#include <vector>
+#include <algorithm>
+#if !defined(_MSC_VER)
+#include <sys/mman.h>
+#endif
+
+#define kFrozenMagic 0x465a4e31
+#define kFrozenMaxLength 0x7ffffff8u
+#define kFrozenInternMax 64 //Longer strings are rarely repeated
+
+enum frozenRefs {
+  kFrozenRefNull= 0,
+  kFrozenRefFalse= 2,
+  kFrozenRefTrue= 4
+};
+
+enum frozenTags {
+  kFrozenNumber= 1,   //then a double
+  kFrozenString,      //length: bytes of utf8, then them and a \0
+  kFrozenAsciiString, //ditto, all of them < 0x80
+  kFrozenArray,       //length: elements, then their refs
+  kFrozenObject       //length: properties, then their key and value refs in
+                      //order, then their indexes in the order of the keys
+};
+
+typedef struct {
+  uint32_t magic;
+  uint32_t root; //A ref
+  uint64_t length;
+} typeFrozenHeader;
+
+typedef struct {
+  uint32_t tag;
+  uint32_t length;
+} typeFrozenRecord;
+
+typedef struct typeFrozen {
+  struct typeFrozen* next; //In frozenSnapshots, while it's got a name
+  char* name;
+  char* base;              //The block, read-only
+  size_t length;
+  volatile long refs;      //The name's and the views'
+} typeFrozen;
+
+static typeFrozen* frozenSnapshots= NULL;
+static uv_mutex_t frozenSnapshotsLock;
+static volatile long frozenLive= 0;
+static volatile long frozenBytes= 0;
+
+
+
+
+
+
+static void frozen_init (void) {
+  uv_mutex_init(&frozenSnapshotsLock);
+}
+
+static void frozen_retain (typeFrozen* frozen) {
+  atomic_inc(&frozen->refs);
+}
+
+static void frozen_release (typeFrozen* frozen) {
+  if (atomic_dec(&frozen->refs)) return;
+  atomic_dec(&frozenLive);
+  atomic_add(&frozenBytes, -((long) frozen->length));
+#if defined(_MSC_VER)
+  free(frozen->base);
+#else
+  munmap(frozen->base, frozen->length);
+#endif
+  free(frozen->name);
+  free(frozen);
+}
+
+static uint32_t frozen_root (typeFrozen* frozen) {
+  return ((typeFrozenHeader*) frozen->base)->root;
+}
+
+static const typeFrozenRecord* frozen_record (typeFrozen* frozen, uint32_t ref) {
+  return (const typeFrozenRecord*) (frozen->base+ ref);
+}
+
+static int frozen_is_record (uint32_t ref) {
+  return !(ref & 1) && (ref >= sizeof(typeFrozenHeader));
+}
+
+static const char* frozen_bytes (const typeFrozenRecord* record) {
+  return (const char*) (record+ 1);
+}
+
+static const uint32_t* frozen_refs (const typeFrozenRecord* record) {
+  return (const uint32_t*) (record+ 1);
+}
+
+static int frozenKeyCompare (typeFrozen* frozen, uint32_t ref, const char* key, size_t length) {
+  const typeFrozenRecord* record= frozen_record(frozen, ref);
+  int c= memcmp(frozen_bytes(record), key, record->length < length ? record->length : length);
+  if (c) return c;
+  return (record->length < length) ? -1 : (record->length > length);
+}
+
+// Binary search of an object's key. Returns 1 and its value's ref in *ref if it's there.
+static int frozen_lookup (typeFrozen* frozen, const typeFrozenRecord* object, const char* key, size_t length, uint32_t* ref) {
+  const uint32_t* pairs= frozen_refs(object);
+  const uint32_t* order= pairs+ 2* object->length;
+  uint32_t lo= 0;
+  uint32_t hi= object->length;
+  while (lo < hi) {
+    uint32_t mid= lo+ (hi- lo)/ 2;
+    uint32_t i= order[mid];
+    int c= frozenKeyCompare(frozen, pairs[2* i], key, length);
+    if (!c) {
+      *ref= pairs[2* i+ 1];
+      return 1;
+    }
+    if (c < 0) lo= mid+ 1;
+    else hi= mid;
+  }
+  return 0;
+}
+
+
+
+
+
+
+// Builds a block: the records are appended children first, strings are
+// interned, and frozen_finish() copies it all into its read-only memory.
+typedef struct {
+  std::vector<char> data;
+  std::map<std::string, uint32_t> strings;
+  int tooBig;
+} typeFrozenBuilder;
+
+static void frozen_builder_init (typeFrozenBuilder* builder) {
+  builder->data.assign(sizeof(typeFrozenHeader), 0);
+  builder->tooBig= 0;
+}
+
+static uint32_t frozenAppend (typeFrozenBuilder* builder, uint32_t tag, uint32_t length, const void* payload, size_t payloadLength) {
+  size_t offset= builder->data.size();
+  size_t size= (sizeof(typeFrozenRecord)+ payloadLength+ 7) & ~((size_t) 7);
+  if (builder->tooBig || (offset+ size > kFrozenMaxLength)) {
+    builder->tooBig= 1;
+    return kFrozenRefNull;
+  }
+  builder->data.resize(offset+ size, 0);
+  typeFrozenRecord* record= (typeFrozenRecord*) &builder->data[offset];
+  record->tag= tag;
+  record->length= length;
+  if (payloadLength) memcpy(record+ 1, payload, payloadLength);
+  return (uint32_t) offset;
+}
+
+static uint32_t frozen_number (typeFrozenBuilder* builder, double n) {
+  if ((n >= -0x40000000) && (n < 0x40000000) && (n == (int32_t) n) && ((n != 0) || (1/ n > 0))) {
+    return (((uint32_t) (int32_t) n) << 1) | 1;
+  }
+  return frozenAppend(builder, kFrozenNumber, 0, &n, sizeof(n));
+}
+
+static uint32_t frozen_string (typeFrozenBuilder* builder, const char* utf8, size_t length) {
+  std::string s;
+  if (length <= kFrozenInternMax) {
+    s.assign(utf8, length);
+    std::map<std::string, uint32_t>::iterator interned= builder->strings.find(s);
+    if (interned != builder->strings.end()) return interned->second;
+  }
+
+  uint32_t tag= kFrozenAsciiString;
+  size_t i= 0;
+  while (i < length) if ((unsigned char) utf8[i++] >= 0x80) tag= kFrozenString;
+  if (length >= kFrozenMaxLength) {
+    builder->tooBig= 1;
+    return kFrozenRefNull;
+  }
+  uint32_t ref= frozenAppend(builder, tag, (uint32_t) length, utf8, length+ 1);
+  if ((length <= kFrozenInternMax) && !builder->tooBig) builder->strings[s]= ref;
+  return ref;
+}
+
+static uint32_t frozen_array (typeFrozenBuilder* builder, const std::vector<uint32_t>& elements) {
+  if (elements.empty()) return frozenAppend(builder, kFrozenArray, 0, NULL, 0);
+  return frozenAppend(builder, kFrozenArray, (uint32_t) elements.size(), &elements[0], elements.size()* sizeof(uint32_t));
+}
+
+struct frozenKeyOrder {
+  typeFrozenBuilder* builder;
+  const std::vector<uint32_t>* pairs;
+  frozenKeyOrder (typeFrozenBuilder* b, const std::vector<uint32_t>* p) : builder(b), pairs(p) {}
+  bool operator() (uint32_t a, uint32_t b) const {
+    const typeFrozenRecord* x= (const typeFrozenRecord*) &builder->data[(*pairs)[2* a]];
+    const typeFrozenRecord* y= (const typeFrozenRecord*) &builder->data[(*pairs)[2* b]];
+    int c= memcmp(x+ 1, y+ 1, x->length < y->length ? x->length : y->length);
+    return c ? (c < 0) : (x->length < y->length);
+  }
+};
+
+// pairs: the refs of each key (a string) and its value, in order.
+static uint32_t frozen_object (typeFrozenBuilder* builder, const std::vector<uint32_t>& pairs) {
+  uint32_t length= (uint32_t) (pairs.size()/ 2);
+  if (builder->tooBig) return kFrozenRefNull;
+  if (!length) return frozenAppend(builder, kFrozenObject, 0, NULL, 0);
+
+  std::vector<uint32_t> payload(pairs);
+  uint32_t i= 0;
+  while (i < length) payload.push_back(i++);
+  std::sort(payload.begin()+ 2* length, payload.end(), frozenKeyOrder(builder, &pairs));
+  return frozenAppend(builder, kFrozenObject, length, &payload[0], payload.size()* sizeof(uint32_t));
+}
+
+// The snapshot, with one ref (its creator's), or NULL if it's too big or there's no memory.
+static typeFrozen* frozen_finish (typeFrozenBuilder* builder, uint32_t root) {
+  if (builder->tooBig) return NULL;
+
+  typeFrozenHeader* header= (typeFrozenHeader*) &builder->data[0];
+  header->magic= kFrozenMagic;
+  header->root= root;
+  header->length= builder->data.size();
+
+  typeFrozen* frozen= (typeFrozen*) calloc(1, sizeof(typeFrozen));
+  if (!frozen) return NULL;
+  frozen->length= builder->data.size();
+#if defined(_MSC_VER)
+  frozen->base= (char*) malloc(frozen->length);
+  if (!frozen->base) {
+#else
+  frozen->base= (char*) mmap(NULL, frozen->length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+  if (frozen->base == MAP_FAILED) {
+#endif
+    free(frozen);
+    return NULL;
+  }
+  memcpy(frozen->base, &builder->data[0], frozen->length);
+#if !defined(_MSC_VER)
+  mprotect(frozen->base, frozen->length, PROT_READ);
+#endif
+  frozen->refs= 1;
+  atomic_inc(&frozenLive);
+  atomic_add(&frozenBytes, (long) frozen->length);
+  return frozen;
+}
+
+
+
+
+
+
+// Names the snapshot, taking a ref. Whatever had the name before loses it
+// (but lives on as long as it has views).
+static void frozen_publish (const char* name, typeFrozen* frozen) {
+  typeFrozen* old= NULL;
+  frozen_retain(frozen);
+  frozen->name= strdup(name);
+
+  uv_mutex_lock(&frozenSnapshotsLock);
+  typeFrozen** p= &frozenSnapshots;
+  while (*p && strcmp((*p)->name, name)) p= &(*p)->next;
+  if (*p) {
+    old= *p;
+    *p= old->next;
+  }
+  frozen->next= frozenSnapshots;
+  frozenSnapshots= frozen;
+  uv_mutex_unlock(&frozenSnapshotsLock);
+
+  if (old) frozen_release(old);
+}
+
+// The snapshot called name, with a ref for the caller, or NULL.
+static typeFrozen* frozen_open (const char* name) {
+  uv_mutex_lock(&frozenSnapshotsLock);
+  typeFrozen* frozen= frozenSnapshots;
+  while (frozen && strcmp(frozen->name, name)) frozen= frozen->next;
+  if (frozen) frozen_retain(frozen);
+  uv_mutex_unlock(&frozenSnapshotsLock);
+  return frozen;
+}
+
+static int frozen_unpublish (const char* name) {
+  uv_mutex_lock(&frozenSnapshotsLock);
+  typeFrozen** p= &frozenSnapshots;
+  while (*p && strcmp((*p)->name, name)) p= &(*p)->next;
+  typeFrozen* frozen= *p;
+  if (frozen) *p= frozen->next;
+  uv_mutex_unlock(&frozenSnapshotsLock);
+
+  if (frozen) frozen_release(frozen);
+  return frozen != NULL;
+}
@@ -0,0 +1,227 @@
+//memo_cache.cc
+//The results of the pool.any.call()s made with { memoize: true }, shared by all
+//the threads: a key (the pool, the function's name and its serialized args)
+//maps to the serialized [result]. It's split in shards, each with its own lock,
+//hash table and LRU list, so that threads storing results rarely collide.
+//No V8 in here.
+
+#define kMemoShards 16
+#define kMemoMinBuckets 64
+#define kMemoDefaultLimit (64* 1024* 1024)
+
+typedef struct typeMemoKey {
+  uint64_t hash;
+  char* bytes;       //scope \0 fnName \0 BSON [args...]
+  size_t length;
+  size_t argsOffset; //Of the BSON args in bytes
+  int argc;
+  int store;         //Is the result to be cached, or is it just coalesced
+} typeMemoKey;
+
+typedef struct typeMemoEntry {
+  struct typeMemoEntry* next;    //In its bucket
+  struct typeMemoEntry* lruPrev; //Towards the most recently used
+  struct typeMemoEntry* lruNext; //Towards the least recently used
+  uint64_t hash;
+  size_t keyLength;
+  size_t valueLength;
+  char data[1];                  //The key, then the value
+} typeMemoEntry;
+
+typedef struct {
+  uv_mutex_t lock;
+  typeMemoEntry** buckets;
+  size_t bucketsLength;          //A power of 2
+  size_t entries;
+  size_t bytes;
+  typeMemoEntry* lruFirst;       //Most recently used
+  typeMemoEntry* lruLast;
+} typeMemoShard;
+
+static typeMemoShard memoShards[kMemoShards];
+static volatile long memoLimit= kMemoDefaultLimit;
+static volatile long memoHits= 0;
+static volatile long memoMisses= 0;
+static volatile long memoStores= 0;
+static volatile long memoEvictions= 0;
+
+
+
+
+
+
+static uint64_t memoHash (const char* data, size_t length) {
+  uint64_t hash= 14695981039346656037ULL; //FNV-1a
+  while (length--) {
+    hash^= (unsigned char) *data++;
+    hash*= 1099511628211ULL;
+  }
+  return hash;
+}
+
+static void memo_init (void) {
+  int i= 0;
+  while (i < kMemoShards) uv_mutex_init(&memoShards[i++].lock);
+}
+
+static typeMemoShard* memoShard (uint64_t hash) {
+  return &memoShards[hash >> 60];
+}
+
+static void memo_key_free (typeMemoKey* key) {
+  free(key->bytes);
+  free(key);
+}
+
+static size_t memoEntrySize (typeMemoEntry* entry) {
+  return sizeof(typeMemoEntry)+ entry->keyLength+ entry->valueLength;
+}
+
+// Under shard->lock
+static void memoLruUnlink (typeMemoShard* shard, typeMemoEntry* entry) {
+  if (entry->lruPrev) entry->lruPrev->lruNext= entry->lruNext;
+  else shard->lruFirst= entry->lruNext;
+  if (entry->lruNext) entry->lruNext->lruPrev= entry->lruPrev;
+  else shard->lruLast= entry->lruPrev;
+}
+
+static void memoLruPushFront (typeMemoShard* shard, typeMemoEntry* entry) {
+  entry->lruPrev= NULL;
+  entry->lruNext= shard->lruFirst;
+  if (shard->lruFirst) shard->lruFirst->lruPrev= entry;
+  else shard->lruLast= entry;
+  shard->lruFirst= entry;
+}
+
+static typeMemoEntry** memoFind (typeMemoShard* shard, typeMemoKey* key) {
+  typeMemoEntry** p= &shard->buckets[key->hash & (shard->bucketsLength- 1)];
+  while (*p) {
+    typeMemoEntry* entry= *p;
+    if ((entry->hash == key->hash) && (entry->keyLength == key->length) && !memcmp(entry->data, key->bytes, key->length)) break;
+    p= &entry->next;
+  }
+  return p;
+}
+
+static void memoRemove (typeMemoShard* shard, typeMemoEntry* entry) {
+  typeMemoEntry** p= &shard->buckets[entry->hash & (shard->bucketsLength- 1)];
+  while (*p != entry) p= &(*p)->next;
+  *p= entry->next;
+  memoLruUnlink(shard, entry);
+  shard->entries--;
+  shard->bytes-= memoEntrySize(entry);
+  free(entry);
+}
+
+static void memoEvict (typeMemoShard* shard, size_t limit) {
+  while (shard->lruLast && (shard->bytes > limit)) {
+    memoRemove(shard, shard->lruLast);
+    atomic_inc(&memoEvictions);
+  }
+}
+
+static void memoGrow (typeMemoShard* shard) {
+  size_t length= shard->bucketsLength ? shard->bucketsLength* 2 : kMemoMinBuckets;
+  typeMemoEntry** buckets= (typeMemoEntry**) calloc(length, sizeof(typeMemoEntry*));
+  if (!buckets) return;
+  size_t i= 0;
+  while (i < shard->bucketsLength) {
+    typeMemoEntry* entry= shard->buckets[i++];
+    while (entry) {
+      typeMemoEntry* next= entry->next;
+      typeMemoEntry** bucket= &buckets[entry->hash & (length- 1)];
+      entry->next= *bucket;
+      *bucket= entry;
+      entry= next;
+    }
+  }
+  free(shard->buckets);
+  shard->buckets= buckets;
+  shard->bucketsLength= length;
+}
+
+
+
+
+
+
+// A malloc()ed copy of the value stored for key, or NULL.
+static char* memo_get (typeMemoKey* key, size_t* valueLength) {
+  typeMemoShard* shard= memoShard(key->hash);
+  char* value= NULL;
+
+  uv_mutex_lock(&shard->lock);
+  if (shard->entries) {
+    typeMemoEntry* entry= *memoFind(shard, key);
+    if (entry && (value= (char*) malloc(entry->valueLength))) {
+      memcpy(value, entry->data+ entry->keyLength, entry->valueLength);
+      *valueLength= entry->valueLength;
+      memoLruUnlink(shard, entry);
+      memoLruPushFront(shard, entry);
+    }
+  }
+  uv_mutex_unlock(&shard->lock);
+
+  atomic_inc(value ? &memoHits : &memoMisses);
+  return value;
+}
+
+// Stores a copy of value, evicting the least recently used to make room.
+static void memo_put (typeMemoKey* key, const char* value, size_t valueLength) {
+  typeMemoShard* shard= memoShard(key->hash);
+  size_t limit= (size_t) atomic_read(&memoLimit)/ kMemoShards;
+  size_t size= sizeof(typeMemoEntry)+ key->length+ valueLength;
+  if (size > limit) return;
+
+  typeMemoEntry* entry= (typeMemoEntry*) malloc(size);
+  if (!entry) return;
+  entry->hash= key->hash;
+  entry->keyLength= key->length;
+  entry->valueLength= valueLength;
+  memcpy(entry->data, key->bytes, key->length);
+  memcpy(entry->data+ key->length, value, valueLength);
+
+  uv_mutex_lock(&shard->lock);
+  if (shard->entries >= shard->bucketsLength) memoGrow(shard);
+  if (!shard->bucketsLength) {
+    uv_mutex_unlock(&shard->lock);
+    free(entry);
+    return;
+  }
+  typeMemoEntry* old= *memoFind(shard, key);
+  if (old) memoRemove(shard, old); //Computed twice at the same time
+  typeMemoEntry** bucket= &shard->buckets[key->hash & (shard->bucketsLength- 1)];
+  entry->next= *bucket;
+  *bucket= entry;
+  memoLruPushFront(shard, entry);
+  shard->entries++;
+  shard->bytes+= size;
+  memoEvict(shard, limit);
+  uv_mutex_unlock(&shard->lock);
+
+  atomic_inc(&memoStores);
+}
+
+// Empties the cache if limit is 0.
+static void memo_set_limit (long limit) {
+  atomic_add(&memoLimit, limit- atomic_read(&memoLimit));
+  int i= 0;
+  while (i < kMemoShards) {
+    typeMemoShard* shard= &memoShards[i++];
+    uv_mutex_lock(&shard->lock);
+    memoEvict(shard, (size_t) limit/ kMemoShards);
+    uv_mutex_unlock(&shard->lock);
+  }
+}
+
+static void memo_usage (long* entries, long* bytes) {
+  *entries= *bytes= 0;
+  int i= 0;
+  while (i < kMemoShards) {
+    typeMemoShard* shard= &memoShards[i++];
+    uv_mutex_lock(&shard->lock);
+    *entries+= shard->entries;
+    *bytes+= shard->bytes;
+    uv_mutex_unlock(&shard->lock);
+  }
+}
@@ -0,0 +1,126 @@
+//parallel_sort.cc
+//The pieces of pool.sort() and pool.binarySearchMany() that run in the threads.
+//They work on the raw memory of typed arrays: no V8 in here.
+
+#include <algorithm>
+#include <string.h>
+#include <stdint.h>
+
+// NaNs go last, both ascending and descending, so that the order is strict weak.
+template <typename T> struct sortAscending {
+  bool operator() (T a, T b) const { return (a < b) || ((a == a) && (b != b)); }
+};
+
+template <typename T> struct sortDescending {
+  bool operator() (T a, T b) const { return (a > b) || ((a == a) && (b != b)); }
+};
+
+typedef struct {
+  size_t elementSize;
+  void (*sort) (char* data, size_t from, size_t to, int descending);
+  void (*merge) (char* source, char* target, size_t from, size_t mid, size_t to, size_t outFrom, size_t outTo, int descending);
+  void (*search) (char* sorted, size_t length, double* queries, int32_t* results, size_t from, size_t to, int descending);
+} typeSortOps;
+
+
+
+
+
+
+template <typename T, typename C> static void sortRangeWith (char* data, size_t from, size_t to, C comp) {
+  T* p= (T*) data;
+  std::sort(p+ from, p+ to, comp);
+}
+
+template <typename T> static void sortRange (char* data, size_t from, size_t to, int descending) {
+  if (descending) sortRangeWith<T>(data, from, to, sortDescending<T>());
+  else sortRangeWith<T>(data, from, to, sortAscending<T>());
+}
+
+
+
+
+
+
+// How many of the first i elements of merge(a, b) come from a.
+template <typename T, typename C> static size_t coRank (size_t i, T* a, size_t m, T* b, size_t n, C comp) {
+  size_t lo= i > n ? i- n : 0;
+  size_t hi= i < m ? i : m;
+
+  while (lo < hi) {
+    size_t j= lo+ (hi- lo)/ 2;
+    size_t k= i- j;
+    if ((k > 0) && !comp(b[k- 1], a[j])) lo= j+ 1;
+    else hi= j;
+  }
+
+  return lo;
+}
+
+// Writes target[outFrom, outTo) of the merge of source[from, mid) and source[mid, to).
+// Disjoint output ranges of the same merge can run in different threads.
+template <typename T, typename C> static void mergeRangeWith (char* source, char* target, size_t from, size_t mid, size_t to, size_t outFrom, size_t outTo, C comp) {
+  T* a= ((T*) source)+ from;
+  T* b= ((T*) source)+ mid;
+  size_t m= mid- from;
+  size_t n= to- mid;
+  size_t i0= outFrom- from;
+  size_t i1= outTo- from;
+  size_t j0= coRank(i0, a, m, b, n, comp);
+  size_t j1= coRank(i1, a, m, b, n, comp);
+
+  std::merge(a+ j0, a+ j1, b+ (i0- j0), b+ (i1- j1), ((T*) target)+ outFrom, comp);
+}
+
+template <typename T> static void mergeRange (char* source, char* target, size_t from, size_t mid, size_t to, size_t outFrom, size_t outTo, int descending) {
+  if (descending) mergeRangeWith<T>(source, target, from, mid, to, outFrom, outTo, sortDescending<T>());
+  else mergeRangeWith<T>(source, target, from, mid, to, outFrom, outTo, sortAscending<T>());
+}
+
+
+
+
+
+
+// results[i]= the index of queries[i] in sorted, or -(insertion point)- 1 if it isn't there.
+template <typename T> static void searchRange (char* sorted, size_t length, double* queries, int32_t* results, size_t from, size_t to, int descending) {
+  T* p= (T*) sorted;
+
+  while (from < to) {
+    double q= queries[from];
+    size_t lo= 0;
+    size_t hi= length;
+    while (lo < hi) {
+      size_t mid= lo+ (hi- lo)/ 2;
+      double v= (double) p[mid];
+      if (descending ? (v > q) : (v < q)) lo= mid+ 1;
+      else hi= mid;
+    }
+    results[from++]= ((lo < length) && ((double) p[lo] == q)) ? (int32_t) lo : -((int32_t) lo)- 1;
+  }
+}
+
+
+
+
+
+
+template <typename T> static const typeSortOps* sortOpsOf (void) {
+  static const typeSortOps ops= { sizeof(T), sortRange<T>, mergeRange<T>, searchRange<T> };
+  return &ops;
+}
+
+static const typeSortOps* sortOpsFor (ExternalArrayType type) {
+  switch (type) {
+    case kExternalByteArray: return sortOpsOf<int8_t>();
+    case kExternalUnsignedByteArray: return sortOpsOf<uint8_t>();
+    case kExternalPixelArray: return sortOpsOf<uint8_t>();
+    case kExternalShortArray: return sortOpsOf<int16_t>();
+    case kExternalUnsignedShortArray: return sortOpsOf<uint16_t>();
+    case kExternalIntArray: return sortOpsOf<int32_t>();
+    case kExternalUnsignedIntArray: return sortOpsOf<uint32_t>();
+    case kExternalFloatArray: return sortOpsOf<float>();
+    case kExternalDoubleArray: return sortOpsOf<double>();
+  }
+  return NULL;
+}
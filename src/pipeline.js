@@ -0,0 +1,84 @@
+function pipeline(stages, options){
+  var T, n, depth, threads, i$, len$, i, fn, j, t, p, e, nativeDestroy, listeners;
+  T = this;
+  if (!(Array.isArray(stages) && stages.length)) {
+    throw '.pipeline( stages [, options] ): stages must be an Array of functions';
+  }
+  options == null && (options = {});
+  n = Math.floor(options.threadsPerStage || 1);
+  depth = Math.floor(options.queueDepth || 64);
+  if (!(n > 0)) {
+    throw '.pipeline(): threadsPerStage must be a Number > 0';
+  }
+  if (!(depth > 0)) {
+    throw '.pipeline(): queueDepth must be a Number > 0';
+  }
+  threads = [];
+  try {
+    for (i$ = 0, len$ = stages.length; i$ < len$; ++i$) {
+      i = i$;
+      fn = stages[i$];
+      if (typeof fn !== 'function') {
+        throw '.pipeline(): stage ' + i + ' is not a function';
+      }
+      threads[i] = [];
+      j = n;
+      while (j--) {
+        t = T.create();
+        threads[i].push(t);
+        t.eval('var __pipelineStage= (' + fn + ');');
+      }
+    }
+    p = T.newPipeline(threads, depth);
+  } catch (e$) {
+    e = e$;
+    destroyThreads();
+    throw e;
+  }
+  nativeDestroy = p.destroy;
+  p.destroy = destroy;
+  listeners = {};
+  p.on = on;
+  p.emit = emit;
+  return p;
+  function on(event, listener){
+    (listeners[event] || (listeners[event] = [])).push(listener);
+    return p;
+  }
+  function emit(event){
+    var i$, ref$, len$, listener;
+    for (i$ = 0, len$ = (ref$ = (listeners[event] || []).slice()).length; i$ < len$; ++i$) {
+      listener = ref$[i$];
+      listener.call(p);
+    }
+  }
+  function destroy(rudely){
+    var beNice, beRude;
+    beNice = function(){
+      if (p.pendingJobs()) {
+        return setTimeout(beNice, 666);
+      } else {
+        return beRude();
+      }
+    };
+    beRude = function(){
+      nativeDestroy.call(p);
+      return destroyThreads();
+    };
+    if (rudely) {
+      beRude();
+    } else {
+      beNice();
+    }
+  }
+  function destroyThreads(){
+    var i$, ref$, len$, stage, j$, len1$, t;
+    for (i$ = 0, len$ = (ref$ = threads).length; i$ < len$; ++i$) {
+      stage = ref$[i$];
+      for (j$ = 0, len1$ = stage.length; j$ < len1$; ++j$) {
+        t = stage[j$];
+        t.destroy();
+      }
+    }
+  }
+}
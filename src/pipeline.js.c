@@ -0,0 +1 @@
+static const char* kPipeline_js= "(\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x70\x69\x70\x65\x6c\x69\x6e\x65\x28\x73\x74\x61\x67\x65\x73\x2c\x6f\x70\x74\x69\x6f\x6e\x73\x29\x7b\x76\x61\x72 \x54\x2c\x6e\x2c\x64\x65\x70\x74\x68\x2c\x74\x68\x72\x65\x61\x64\x73\x2c\x69\x24\x2c\x6c\x65\x6e\x24\x2c\x69\x2c\x66\x6e\x2c\x6a\x2c\x74\x2c\x70\x2c\x65\x2c\x6e\x61\x74\x69\x76\x65\x44\x65\x73\x74\x72\x6f\x79\x2c\x6c\x69\x73\x74\x65\x6e\x65\x72\x73\x3b\x54\x3d\x74\x68\x69\x73\x3b\x69\x66\x28\x21\x28\x41\x72\x72\x61\x79\x2e\x69\x73\x41\x72\x72\x61\x79\x28\x73\x74\x61\x67\x65\x73\x29\x26\x26\x73\x74\x61\x67\x65\x73\x2e\x6c\x65\x6e\x67\x74\x68\x29\x29\x7b\x74\x68\x72\x6f\x77\x27\x2e\x70\x69\x70\x65\x6c\x69\x6e\x65\x28 \x73\x74\x61\x67\x65\x73 \x5b\x2c \x6f\x70\x74\x69\x6f\x6e\x73\x5d \x29\x3a \x73\x74\x61\x67\x65\x73 \x6d\x75\x73\x74 \x62\x65 \x61\x6e \x41\x72\x72\x61\x79 \x6f\x66 \x66\x75\x6e\x63\x74\x69\x6f\x6e\x73\x27\x3b\x7d\n\x6f\x70\x74\x69\x6f\x6e\x73\x3d\x3d\x6e\x75\x6c\x6c\x26\x26\x28\x6f\x70\x74\x69\x6f\x6e\x73\x3d\x7b\x7d\x29\x3b\x6e\x3d\x4d\x61\x74\x68\x2e\x66\x6c\x6f\x6f\x72\x28\x6f\x70\x74\x69\x6f\x6e\x73\x2e\x74\x68\x72\x65\x61\x64\x73\x50\x65\x72\x53\x74\x61\x67\x65\x7c\x7c\x31\x29\x3b\x64\x65\x70\x74\x68\x3d\x4d\x61\x74\x68\x2e\x66\x6c\x6f\x6f\x72\x28\x6f\x70\x74\x69\x6f\x6e\x73\x2e\x71\x75\x65\x75\x65\x44\x65\x70\x74\x68\x7c\x7c\x36\x34\x29\x3b\x69\x66\x28\x21\x28\x6e\x3e\x30\x29\x29\x7b\x74\x68\x72\x6f\x77\x27\x2e\x70\x69\x70\x65\x6c\x69\x6e\x65\x28\x29\x3a \x74\x68\x72\x65\x61\x64\x73\x50\x65\x72\x53\x74\x61\x67\x65 \x6d\x75\x73\x74 \x62\x65 \x61 \x4e\x75\x6d\x62\x65\x72 \x3e \x30\x27\x3b\x7d\n\x69\x66\x28\x21\x28\x64\x65\x70\x74\x68\x3e\x30\x29\x29\x7b\x74\x68\x72\x6f\x77\x27\x2e\x70\x69\x70\x65\x6c\x69\x6e\x65\x28\x29\x3a \x71\x75\x65\x75\x65\x44\x65\x70\x74\x68 \x6d\x75\x73\x74 \x62\x65 \x61 \x4e\x75\x6d\x62\x65\x72 \x3e \x30\x27\x3b\x7d\n\x74\x68\x72\x65\x61\x64\x73\x3d\x5b\x5d\x3b\x74\x72\x79\x7b\x66\x6f\x72\x28\x69\x24\x3d\x30\x2c\x6c\x65\x6e\x24\x3d\x73\x74\x61\x67\x65\x73\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x69\x24\x3c\x6c\x65\x6e\x24\x3b\x2b\x2b\x69\x24\x29\x7b\x69\x3d\x69\x24\x3b\x66\x6e\x3d\x73\x74\x61\x67\x65\x73\x5b\x69\x24\x5d\x3b\x69\x66\x28\x74\x79\x70\x65\x6f\x66 \x66\x6e\x21\x3d\x3d\x27\x66\x75\x6e\x63\x74\x69\x6f\x6e\x27\x29\x7b\x74\x68\x72\x6f\x77\x27\x2e\x70\x69\x70\x65\x6c\x69\x6e\x65\x28\x29\x3a \x73\x74\x61\x67\x65 \x27\x2b\x69\x2b\x27 \x69\x73 \x6e\x6f\x74 \x61 \x66\x75\x6e\x63\x74\x69\x6f\x6e\x27\x3b\x7d\n\x74\x68\x72\x65\x61\x64\x73\x5b\x69\x5d\x3d\x5b\x5d\x3b\x6a\x3d\x6e\x3b\x77\x68\x69\x6c\x65\x28\x6a\x2d\x2d\x29\x7b\x74\x3d\x54\x2e\x63\x72\x65\x61\x74\x65\x28\x29\x3b\x74\x68\x72\x65\x61\x64\x73\x5b\x69\x5d\x2e\x70\x75\x73\x68\x28\x74\x29\x3b\x74\x2e\x65\x76\x61\x6c\x28\x27\x76\x61\x72 \x5f\x5f\x70\x69\x70\x65\x6c\x69\x6e\x65\x53\x74\x61\x67\x65\x3d \x28\x27\x2b\x66\x6e\x2b\x27\x29\x3b\x27\x29\x3b\x7d\x7d\n\x70\x3d\x54\x2e\x6e\x65\x77\x50\x69\x70\x65\x6c\x69\x6e\x65\x28\x74\x68\x72\x65\x61\x64\x73\x2c\x64\x65\x70\x74\x68\x29\x3b\x7d\x63\x61\x74\x63\x68\x28\x65\x24\x29\x7b\x65\x3d\x65\x24\x3b\x64\x65\x73\x74\x72\x6f\x79\x54\x68\x72\x65\x61\x64\x73\x28\x29\x3b\x74\x68\x72\x6f\x77 \x65\x3b\x7d\n\x6e\x61\x74\x69\x76\x65\x44\x65\x73\x74\x72\x6f\x79\x3d\x70\x2e\x64\x65\x73\x74\x72\x6f\x79\x3b\x70\x2e\x64\x65\x73\x74\x72\x6f\x79\x3d\x64\x65\x73\x74\x72\x6f\x79\x3b\x6c\x69\x73\x74\x65\x6e\x65\x72\x73\x3d\x7b\x7d\x3b\x70\x2e\x6f\x6e\x3d\x6f\x6e\x3b\x70\x2e\x65\x6d\x69\x74\x3d\x65\x6d\x69\x74\x3b\x72\x65\x74\x75\x72\x6e \x70\x3b\x66\x75\x6e\x63\x74\x69\x6f\x6e \x6f\x6e\x28\x65\x76\x65\x6e\x74\x2c\x6c\x69\x73\x74\x65\x6e\x65\x72\x29\x7b\x28\x6c\x69\x73\x74\x65\x6e\x65\x72\x73\x5b\x65\x76\x65\x6e\x74\x5d\x7c\x7c\x28\x6c\x69\x73\x74\x65\x6e\x65\x72\x73\x5b\x65\x76\x65\x6e\x74\x5d\x3d\x5b\x5d\x29\x29\x2e\x70\x75\x73\x68\x28\x6c\x69\x73\x74\x65\x6e\x65\x72\x29\x3b\x72\x65\x74\x75\x72\x6e \x70\x3b\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x65\x6d\x69\x74\x28\x65\x76\x65\x6e\x74\x29\x7b\x76\x61\x72 \x69\x24\x2c\x72\x65\x66\x24\x2c\x6c\x65\x6e\x24\x2c\x6c\x69\x73\x74\x65\x6e\x65\x72\x3b\x66\x6f\x72\x28\x69\x24\x3d\x30\x2c\x6c\x65\x6e\x24\x3d\x28\x72\x65\x66\x24\x3d\x28\x6c\x69\x73\x74\x65\x6e\x65\x72\x73\x5b\x65\x76\x65\x6e\x74\x5d\x7c\x7c\x5b\x5d\x29\x2e\x73\x6c\x69\x63\x65\x28\x29\x29\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x69\x24\x3c\x6c\x65\x6e\x24\x3b\x2b\x2b\x69\x24\x29\x7b\x6c\x69\x73\x74\x65\x6e\x65\x72\x3d\x72\x65\x66\x24\x5b\x69\x24\x5d\x3b\x6c\x69\x73\x74\x65\x6e\x65\x72\x2e\x63\x61\x6c\x6c\x28\x70\x29\x3b\x7d\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x64\x65\x73\x74\x72\x6f\x79\x28\x72\x75\x64\x65\x6c\x79\x29\x7b\x76\x61\x72 \x62\x65\x4e\x69\x63\x65\x2c\x62\x65\x52\x75\x64\x65\x3b\x62\x65\x4e\x69\x63\x65\x3d\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x29\x7b\x69\x66\x28\x70\x2e\x70\x65\x6e\x64\x69\x6e\x67\x4a\x6f\x62\x73\x28\x29\x29\x7b\x72\x65\x74\x75\x72\x6e \x73\x65\x74\x54\x69\x6d\x65\x6f\x75\x74\x28\x62\x65\x4e\x69\x63\x65\x2c\x36\x36\x36\x29\x3b\x7d\x65\x6c\x73\x65\x7b\x72\x65\x74\x75\x72\x6e \x62\x65\x52\x75\x64\x65\x28\x29\x3b\x7d\x7d\x3b\x62\x65\x52\x75\x64\x65\x3d\x66\x75\x6e\x63\x74\x69\x6f\x6e\x28\x29\x7b\x6e\x61\x74\x69\x76\x65\x44\x65\x73\x74\x72\x6f\x79\x2e\x63\x61\x6c\x6c\x28\x70\x29\x3b\x72\x65\x74\x75\x72\x6e \x64\x65\x73\x74\x72\x6f\x79\x54\x68\x72\x65\x61\x64\x73\x28\x29\x3b\x7d\x3b\x69\x66\x28\x72\x75\x64\x65\x6c\x79\x29\x7b\x62\x65\x52\x75\x64\x65\x28\x29\x3b\x7d\x65\x6c\x73\x65\x7b\x62\x65\x4e\x69\x63\x65\x28\x29\x3b\x7d\x7d\n\x66\x75\x6e\x63\x74\x69\x6f\x6e \x64\x65\x73\x74\x72\x6f\x79\x54\x68\x72\x65\x61\x64\x73\x28\x29\x7b\x76\x61\x72 \x69\x24\x2c\x72\x65\x66\x24\x2c\x6c\x65\x6e\x24\x2c\x73\x74\x61\x67\x65\x2c\x6a\x24\x2c\x6c\x65\x6e\x31\x24\x2c\x74\x3b\x66\x6f\x72\x28\x69\x24\x3d\x30\x2c\x6c\x65\x6e\x24\x3d\x28\x72\x65\x66\x24\x3d\x74\x68\x72\x65\x61\x64\x73\x29\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x69\x24\x3c\x6c\x65\x6e\x24\x3b\x2b\x2b\x69\x24\x29\x7b\x73\x74\x61\x67\x65\x3d\x72\x65\x66\x24\x5b\x69\x24\x5d\x3b\x66\x6f\x72\x28\x6a\x24\x3d\x30\x2c\x6c\x65\x6e\x31\x24\x3d\x73\x74\x61\x67\x65\x2e\x6c\x65\x6e\x67\x74\x68\x3b\x6a\x24\x3c\x6c\x65\x6e\x31\x24\x3b\x2b\x2b\x6a\x24\x29\x7b\x74\x3d\x73\x74\x61\x67\x65\x5b\x6a\x24\x5d\x3b\x74\x2e\x64\x65\x73\x74\x72\x6f\x79\x28\x29\x3b\x7d\x7d\x7d\x7d)";
@@ -37,6 +37,12 @@ typedef struct {
 static typeQueue* queuesPool= NULL;
 static typeQueue* freeItemsQueue= NULL;
 
+// The free lists never grow past their high watermark, and are trimmed down to
+// their low watermark when they've been idle for a while: see queue_trim().
+static long int freeListHighWater= 16384;
+static long int freeListLowWater= 256;
+static volatile long freeListUses= 0; // Pulls from the free lists since the last trimFreeLists()
+
 
 
 
@@ -58,6 +64,50 @@ static void queue_push (typeQueueItem* qitem, typeQueue* queue) {
 
 
 
+// LIFO push, for the free lists: queue_pull() gets back the most recently
+// used (and thus most likely still cached) item first.
+static void stack_push (typeQueueItem* qitem, typeQueue* queue) {
+  uv_mutex_lock(&queue->queueLock);
+  if (!(qitem->next= queue->first)) {
+    queue->last= qitem;
+  }
+  queue->first= qitem;
+  queue->length++;
+  uv_mutex_unlock(&queue->queueLock);
+}
+
+
+
+
+// Detaches and returns the items past the first keep ones, NULL terminated.
+static typeQueueItem* queue_trim (typeQueue* queue, long int keep) {
+  typeQueueItem* qitem;
+  typeQueueItem* trimmed= NULL;
+
+  uv_mutex_lock(&queue->queueLock);
+  if (queue->length > keep) {
+    if (keep <= 0) {
+      trimmed= queue->first;
+      queue->first= queue->last= NULL;
+    }
+    else {
+      long int i= keep;
+      qitem= queue->first;
+      while (--i) qitem= qitem->next;
+      trimmed= qitem->next;
+      qitem->next= NULL;
+      queue->last= qitem;
+    }
+    queue->length= keep > 0 ? keep : 0;
+  }
+  uv_mutex_unlock(&queue->queueLock);
+
+  return trimmed;
+}
+
+
+
+
 static typeQueueItem* queue_pull (typeQueue* queue) {
   typeQueueItem* qitem;
   
@@ -86,6 +136,9 @@ static typeQueueItem* nuItem (int itemType, void* item) {
   if (!qitem) {
     qitem= (typeQueueItem*) calloc(1, sizeof(typeQueueItem));
   }
+  else {
+    atomic_inc(&freeListUses);
+  }
   
   qitem->next= NULL;
   qitem->itemType= itemType;
@@ -104,8 +157,8 @@ static typeQueueItem* nuItem (int itemType, void* item) {
 
 static void destroyItem (typeQueueItem* qitem) {
   
-  if (freeItemsQueue) {
-    queue_push(qitem, freeItemsQueue);
+  if (freeItemsQueue && (freeItemsQueue->length < freeListHighWater)) {
+    stack_push(qitem, freeItemsQueue);
   }
   else {
     free(qitem);
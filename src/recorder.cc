@@ -0,0 +1,128 @@
+//recorder.cc
+//The log of Threads.startRecording(): every job submitted to a thread or a
+//pool, appended to a file as it's submitted, to be replayed later (see
+//benchmark/b15_replay.js). A header, then the records one after the other,
+//in the byte order of the machine that wrote them. Only the main thread
+//submits jobs, so there's no locking. No V8 in here.
+
+#include <errno.h>
+
+#define kRecordMagic 0x52545757 //"WWTR"
+#define kRecordVersion 1
+
+enum recordTypes {
+  kRecordEval= 1, //name: the source. These match RUN, EMIT and CALL in createPool.ls
+  kRecordEmit,    //name: the event's. The payload: BSON [args...]
+  kRecordCall,    //name: the function's, '\n' between those of a chain. The payload: BSON [args...]
+  kRecordLoad     //name: the path of the file
+};
+
+enum recordOrigins {
+  kRecordThread,  //thread.eval() & co., target is the thread's id
+  kRecordPoolAny, //pool.any.*, target is the pool's (its first thread's) id
+  kRecordPoolAll  //pool.all.* and pool.load()
+};
+
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  double startedAt; //Date.now() when the recording started
+} typeRecordHeader;
+
+typedef struct {
+  uint32_t length;     //Of the name and the payload that follow
+  uint32_t nameLength;
+  uint64_t at;         //Microseconds since the recording started
+  uint32_t target;
+  uint8_t type;
+  uint8_t origin;
+  uint16_t pad;
+} typeRecord;
+
+static FILE* recorder= NULL;
+static uint64_t recorderStart;
+static long recordedJobs= 0;
+static long recordedBytes= 0;
+
+
+
+
+
+
+// Starts a log at path, truncating it. Returns 0, or -1 with errno set.
+static int record_start (const char* path, double now) {
+  FILE* file= fopen(path, "wb");
+  if (!file) return -1;
+  typeRecordHeader header;
+  header.magic= kRecordMagic;
+  header.version= kRecordVersion;
+  header.startedAt= now;
+  if (fwrite(&header, sizeof(header), 1, file) != 1) {
+    fclose(file);
+    return -1;
+  }
+  if (recorder) fclose(recorder);
+  recorder= file;
+  recorderStart= uv_hrtime();
+  recordedJobs= 0;
+  recordedBytes= sizeof(header);
+  return 0;
+}
+
+static void record_stop (void) {
+  if (!recorder) return;
+  fclose(recorder);
+  recorder= NULL;
+}
+
+// A full disk stops the recording: it doesn't fail the jobs.
+static void record_job (int type, int origin, long target, const char* name, size_t nameLength, const char* payload, size_t payloadLength) {
+  typeRecord record;
+  record.length= (uint32_t) (nameLength+ payloadLength);
+  record.nameLength= (uint32_t) nameLength;
+  record.at= (uv_hrtime()- recorderStart)/ 1000;
+  record.target= (uint32_t) target;
+  record.type= (uint8_t) type;
+  record.origin= (uint8_t) origin;
+  record.pad= 0;
+  if ((fwrite(&record, sizeof(record), 1, recorder) != 1) ||
+      (nameLength && (fwrite(name, nameLength, 1, recorder) != 1)) ||
+      (payloadLength && (fwrite(payload, payloadLength, 1, recorder) != 1))) {
+    record_stop();
+    return;
+  }
+  recordedJobs++;
+  recordedBytes+= sizeof(record)+ record.length;
+}
+
+
+
+
+
+
+// Reading a log: opens it and checks its header. NULL, with errno set, if it isn't one.
+static FILE* record_open (const char* path, typeRecordHeader* header) {
+  FILE* file= fopen(path, "rb");
+  if (!file) return NULL;
+  if ((fread(header, sizeof(*header), 1, file) != 1) || (header->magic != kRecordMagic) || (header->version != kRecordVersion)) {
+    fclose(file);
+    errno= EINVAL;
+    return NULL;
+  }
+  return file;
+}
+
+// The next record, and its name and payload in a malloc()ed *data. 0 at the
+// end of the log (a record cut short at its end, by a crash, is left out).
+static int record_next (FILE* file, typeRecord* record, char** data) {
+  if (fread(record, sizeof(*record), 1, file) != 1) return 0;
+  if (record->nameLength > record->length) return 0;
+  *data= (char*) malloc(record->length+ 1);
+  if (!*data) return 0;
+  if (record->length && (fread(*data, record->length, 1, file) != 1)) {
+    free(*data);
+    return 0;
+  }
+  (*data)[record->length]= 0;
+  return 1;
+}
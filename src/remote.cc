@@ -0,0 +1,128 @@
+//remote.cc
+//The binary framing of the jobs and results that other processes send to a
+//pool: see Threads.serve() and Threads.connect(). No V8 in here.
+//Frames are in the native byte order: both ends are on the same machine.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum frameKinds {
+  kFrameCall= 1,    //name: the function's name, payload: BSON [args...]
+  kFrameEval,       //payload: the program's source
+  kFrameResult,     //payload: BSON [result]
+  kFrameResultText, //payload: an eval()'s completion value, utf8
+  kFrameError,      //payload: the error message, utf8
+  kFrameHello,      //shm: a client's first frame, payload: the path of its replies ring
+  kFrameBye         //shm: a client's last frame
+};
+
+#define kFrameMaxLength (1 << 30)
+
+typedef struct {
+  uint32_t length;     //Of the whole frame, this header included
+  uint32_t kind;
+  uint32_t id;         //Chosen by the client, echoed in the result
+  uint32_t argc;       //kFrameCall: number of arguments
+  uint32_t nameLength; //Bytes of name between the header and the payload
+  uint32_t channel;    //shm: the client that sent it, see shm_ring.cc
+} typeFrameHeader;
+
+
+
+
+
+
+// Builds a frame in a single malloc()ed block of header->length bytes.
+static char* frameNew (uint32_t kind, uint32_t id, uint32_t argc, const char* name, size_t nameLength, const char* payload, size_t payloadLength) {
+  size_t length= sizeof(typeFrameHeader)+ nameLength+ payloadLength;
+  if (length > kFrameMaxLength) return NULL;
+
+  char* frame= (char*) malloc(length);
+  if (!frame) return NULL;
+
+  typeFrameHeader* header= (typeFrameHeader*) frame;
+  header->length= (uint32_t) length;
+  header->kind= kind;
+  header->id= id;
+  header->argc= argc;
+  header->nameLength= (uint32_t) nameLength;
+  header->channel= 0;
+  if (nameLength) memcpy(frame+ sizeof(typeFrameHeader), name, nameLength);
+  if (payloadLength) memcpy(frame+ sizeof(typeFrameHeader)+ nameLength, payload, payloadLength);
+  return frame;
+}
+
+static char* frameName (char* frame) {
+  return frame+ sizeof(typeFrameHeader);
+}
+
+static char* framePayload (char* frame) {
+  return frame+ sizeof(typeFrameHeader)+ ((typeFrameHeader*) frame)->nameLength;
+}
+
+static size_t framePayloadLength (char* frame) {
+  typeFrameHeader* header= (typeFrameHeader*) frame;
+  return header->length- sizeof(typeFrameHeader)- header->nameLength;
+}
+
+
+
+
+
+
+// Reassembles the frames out of a byte stream.
+typedef struct {
+  char* data;
+  size_t start;  //Of the first frame not yet taken
+  size_t length; //Bytes from start on
+  size_t capacity;
+} typeFrameReader;
+
+// Room for at least `wanted` more bytes at the end.
+static char* frameReaderRoom (typeFrameReader* reader, size_t wanted, size_t* size) {
+  if (reader->start) {
+    memmove(reader->data, reader->data+ reader->start, reader->length);
+    reader->start= 0;
+  }
+  if (reader->capacity- reader->length < wanted) {
+    size_t capacity= reader->capacity ? reader->capacity : 65536;
+    while (capacity- reader->length < wanted) capacity*= 2;
+    char* data= (char*) realloc(reader->data, capacity);
+    if (!data) return NULL;
+    reader->data= data;
+    reader->capacity= capacity;
+  }
+  *size= reader->capacity- reader->length;
+  return reader->data+ reader->length;
+}
+
+static void frameReaderCommit (typeFrameReader* reader, size_t bytes) {
+  reader->length+= bytes;
+}
+
+// The next complete frame, or NULL. The frame is valid until the next frameReaderRoom().
+// *bad is set if the stream is garbage.
+static char* frameReaderNext (typeFrameReader* reader, int* bad) {
+  *bad= 0;
+  if (reader->length < sizeof(typeFrameHeader)) return NULL;
+
+  char* frame= reader->data+ reader->start;
+  typeFrameHeader* header= (typeFrameHeader*) frame;
+  if ((header->length < sizeof(typeFrameHeader)) || (header->length > kFrameMaxLength) ||
+      (header->nameLength > header->length- sizeof(typeFrameHeader))) {
+    *bad= 1;
+    return NULL;
+  }
+  if (reader->length < header->length) return NULL;
+
+  reader->start+= header->length;
+  reader->length-= header->length;
+  return frame;
+}
+
+static void frameReaderFree (typeFrameReader* reader) {
+  free(reader->data);
+  reader->data= NULL;
+  reader->start= reader->length= reader->capacity= 0;
+}
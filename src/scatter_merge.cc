@@ -0,0 +1,79 @@
+//scatter_merge.cc
+//The merges of pool.scatter(): the partial results of the shards, reduced to
+//their keys, become one. No V8 in here: MergePartials() does the translation.
+
+#include <algorithm>
+#include <vector>
+
+typedef struct {
+  double key;
+  uint32_t source; //Which partial result
+  uint32_t index;  //Where in it
+} typeMergeItem;
+
+// Like sortAscending() and sortDescending(), NaNs go last.
+static bool mergeBefore (const typeMergeItem& a, const typeMergeItem& b, int descending) {
+  if (a.key != a.key) return false;
+  if (b.key != b.key) return true;
+  return descending ? (a.key > b.key) : (a.key < b.key);
+}
+
+struct mergeItemAscending {
+  bool operator() (const typeMergeItem& a, const typeMergeItem& b) const { return mergeBefore(a, b, 0); }
+};
+
+struct mergeItemDescending {
+  bool operator() (const typeMergeItem& a, const typeMergeItem& b) const { return mergeBefore(a, b, 1); }
+};
+
+
+
+
+
+
+// The heap's top is the source whose next item goes first.
+struct mergeHeapOrder {
+  const typeMergeItem* items;
+  std::vector<size_t>* cursor;
+  int descending;
+  mergeHeapOrder (const typeMergeItem* i, std::vector<size_t>* c, int d) : items(i), cursor(c), descending(d) {}
+  bool operator() (size_t a, size_t b) const {
+    const typeMergeItem& x= items[(*cursor)[a]];
+    const typeMergeItem& y= items[(*cursor)[b]];
+    if (mergeBefore(y, x, descending)) return true;
+    if (mergeBefore(x, y, descending)) return false;
+    return a > b;
+  }
+};
+
+// items holds the sources one after the other, each already in order:
+// starts[s] is where source s begins, and starts[sources] == length.
+// Writes into out the order of the k-way merge, stable between sources.
+static void merge_kway (const typeMergeItem* items, const size_t* starts, size_t sources, int descending, typeMergeItem* out) {
+  std::vector<size_t> cursor(starts, starts+ sources);
+  std::vector<size_t> heap; //Of sources, by their next item
+  size_t s= 0;
+  while (s < sources) {
+    if (cursor[s] < starts[s+ 1]) heap.push_back(s);
+    s++;
+  }
+
+  mergeHeapOrder later(items, &cursor, descending);
+
+  std::make_heap(heap.begin(), heap.end(), later);
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), later);
+    s= heap.back();
+    *out++= items[cursor[s]++];
+    if (cursor[s] < starts[s+ 1]) std::push_heap(heap.begin(), heap.end(), later);
+    else heap.pop_back();
+  }
+}
+
+// Moves the first k (by key) of items to the front, in order. Returns how many there are.
+static size_t merge_top_k (typeMergeItem* items, size_t length, size_t k, int descending) {
+  if (k > length) k= length;
+  if (descending) std::partial_sort(items, items+ k, items+ length, mergeItemDescending());
+  else std::partial_sort(items, items+ k, items+ length, mergeItemAscending());
+  return k;
+}
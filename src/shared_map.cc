@@ -0,0 +1,399 @@
+//shared_map.cc
+//The maps of SharedMap: named hash maps shared by all the threads (and the
+//main thread) of the process, without message passing. Keys are strings or
+//integers and values opaque bytes (see SharedMapSet() for their encoding).
+//
+//The map is split in shards. Writers take their shard's lock; readers don't
+//take any: entries are never modified once published, a write links a new
+//entry in place of the old one, and the old ones are freed only after the
+//readers that could be looking at them are gone (each shard counts its
+//readers in two epochs, RCU-style). Memory is bounded: when the map is over
+//maxEntries or maxBytes, a CLOCK sweep of the writer's shard (then of the
+//others, in turns) evicts entries that haven't been read since the hand last
+//passed them. The counters of incr() are never evicted.
+//No V8 in here.
+
+#if defined(WWT_PTHREAD)
+#include <sched.h>
+#define sharedMapYield() sched_yield()
+#else
+#define sharedMapYield() Sleep(0)
+#endif
+
+#define kSharedMapShards 64
+#define kSharedMapRetireBatch 32
+#define kSharedMapDefaultEntries 100000
+#define kSharedMapDefaultBytes (64* 1024* 1024)
+
+enum sharedKeyTags {
+  kSharedKeyInt= 'i',   //8 bytes, int64_t
+  kSharedKeyString= 's' //utf8
+};
+
+typedef struct typeSharedEntry {
+  struct typeSharedEntry* volatile next; //In its bucket
+  struct typeSharedEntry* clockPrev;     //Writers only, as all but next and referenced
+  struct typeSharedEntry* clockNext;
+  struct typeSharedEntry* retiredNext;
+  uint64_t hash;
+  volatile int referenced;               //Read since the CLOCK hand last passed
+  int counter;                           //Written by shared_map_update(): not evicted
+  uint32_t keyLength;
+  uint32_t valueLength;
+  char data[1];                          //The key, then the value
+} typeSharedEntry;
+
+typedef struct {
+  uv_mutex_t lock;                       //Writers
+  typeSharedEntry* volatile* buckets;
+  size_t bucketsLength;                  //A power of 2, fixed
+  volatile long epoch;
+  volatile long readers[2];              //By epoch parity
+  size_t entries;
+  size_t bytes;
+  typeSharedEntry* clockFirst;
+  typeSharedEntry* clockLast;
+  typeSharedEntry* clockHand;
+  typeSharedEntry* retired;              //Unlinked, to be freed
+  int retiredLength;
+} typeSharedShard;
+
+typedef struct typeSharedMap {
+  struct typeSharedMap* next;            //In sharedMaps
+  char* name;
+  size_t maxEntries;
+  size_t maxBytes;
+  volatile long entries, bytes;          //Of all the shards
+  volatile long evictTurn;               //The shard to evict from next, when the writer's can't
+  volatile long hits, misses, writes, evictions, casFailures;
+  typeSharedShard shards[kSharedMapShards];
+} typeSharedMap;
+
+static typeSharedMap* sharedMaps= NULL;
+static uv_mutex_t sharedMapsLock;
+
+
+
+
+
+
+static void shared_map_init (void) {
+  uv_mutex_init(&sharedMapsLock);
+}
+
+static typeSharedShard* sharedShard (typeSharedMap* map, uint64_t hash) {
+  return &map->shards[hash >> 58];
+}
+
+static typeSharedEntry* volatile* sharedBucket (typeSharedShard* shard, uint64_t hash) {
+  return &shard->buckets[hash & (shard->bucketsLength- 1)];
+}
+
+static size_t sharedEntrySize (typeSharedEntry* entry) {
+  return sizeof(typeSharedEntry)+ entry->keyLength+ entry->valueLength;
+}
+
+static int sharedEntryIs (typeSharedEntry* entry, const char* key, uint32_t keyLength, uint64_t hash) {
+  return (entry->hash == hash) && (entry->keyLength == keyLength) && !memcmp(entry->data, key, keyLength);
+}
+
+// The map called name, created with these bounds if there isn't one yet.
+static typeSharedMap* shared_map_open (const char* name, size_t maxEntries, size_t maxBytes) {
+  uv_mutex_lock(&sharedMapsLock);
+  typeSharedMap* map= sharedMaps;
+  while (map && strcmp(map->name, name)) map= map->next;
+  if (!map && (map= (typeSharedMap*) calloc(1, sizeof(typeSharedMap)))) {
+    map->name= strdup(name);
+    map->maxEntries= maxEntries;
+    map->maxBytes= maxBytes;
+    size_t bucketsLength= 16;
+    while (bucketsLength < (maxEntries+ kSharedMapShards- 1)/ kSharedMapShards) bucketsLength*= 2;
+    int i= 0;
+    while (i < kSharedMapShards) {
+      typeSharedShard* shard= &map->shards[i++];
+      uv_mutex_init(&shard->lock);
+      shard->bucketsLength= bucketsLength;
+      shard->buckets= (typeSharedEntry* volatile*) calloc(bucketsLength, sizeof(typeSharedEntry*));
+    }
+    map->next= sharedMaps;
+    sharedMaps= map;
+  }
+  uv_mutex_unlock(&sharedMapsLock);
+  return map;
+}
+
+
+
+
+
+
+// Readers: in between, the entries reachable from the shard stay allocated.
+static long sharedReadBegin (typeSharedShard* shard) {
+  while (1) {
+    long epoch= shard->epoch;
+    atomic_inc(&shard->readers[epoch & 1]);
+    if (shard->epoch == epoch) return epoch;
+    atomic_dec(&shard->readers[epoch & 1]);
+  }
+}
+
+static void sharedReadEnd (typeSharedShard* shard, long epoch) {
+  atomic_dec(&shard->readers[epoch & 1]);
+}
+
+// Under shard->lock: frees the retired entries once no reader can see them.
+static void sharedReclaim (typeSharedShard* shard) {
+  long epoch= shard->epoch;
+  atomic_inc(&shard->epoch);
+  while (atomic_read(&shard->readers[epoch & 1])) sharedMapYield();
+  while (shard->retired) {
+    typeSharedEntry* entry= shard->retired;
+    shard->retired= entry->retiredNext;
+    free(entry);
+  }
+  shard->retiredLength= 0;
+}
+
+static void sharedRetire (typeSharedShard* shard, typeSharedEntry* entry) {
+  entry->retiredNext= shard->retired;
+  shard->retired= entry;
+  if (++shard->retiredLength >= kSharedMapRetireBatch) sharedReclaim(shard);
+}
+
+
+
+
+
+
+// Under shard->lock
+static void sharedClockUnlink (typeSharedShard* shard, typeSharedEntry* entry) {
+  if (shard->clockHand == entry) shard->clockHand= entry->clockNext;
+  if (entry->clockPrev) entry->clockPrev->clockNext= entry->clockNext;
+  else shard->clockFirst= entry->clockNext;
+  if (entry->clockNext) entry->clockNext->clockPrev= entry->clockPrev;
+  else shard->clockLast= entry->clockPrev;
+}
+
+static void sharedClockAppend (typeSharedShard* shard, typeSharedEntry* entry) {
+  entry->clockNext= NULL;
+  entry->clockPrev= shard->clockLast;
+  if (shard->clockLast) shard->clockLast->clockNext= entry;
+  else shard->clockFirst= entry;
+  shard->clockLast= entry;
+}
+
+static void sharedCount (typeSharedMap* map, typeSharedShard* shard, typeSharedEntry* entry, long sign) {
+  long size= (long) sharedEntrySize(entry);
+  shard->entries+= sign;
+  shard->bytes+= sign* size;
+  atomic_add(&map->entries, sign);
+  atomic_add(&map->bytes, sign* size);
+}
+
+static int sharedOver (typeSharedMap* map) {
+  return ((size_t) atomic_read(&map->entries) > map->maxEntries) || ((size_t) atomic_read(&map->bytes) > map->maxBytes);
+}
+
+// Unlinks entry from its bucket, where *link points to it.
+static void sharedUnlink (typeSharedMap* map, typeSharedShard* shard, typeSharedEntry* volatile* link, typeSharedEntry* entry) {
+  *link= entry->next;
+  sharedClockUnlink(shard, entry);
+  sharedCount(map, shard, entry, -1);
+  sharedRetire(shard, entry);
+}
+
+static typeSharedEntry* volatile* sharedFindLink (typeSharedShard* shard, const char* key, uint32_t keyLength, uint64_t hash) {
+  typeSharedEntry* volatile* link= sharedBucket(shard, hash);
+  while (*link && !sharedEntryIs(*link, key, keyLength, hash)) link= &(*link)->next;
+  return link;
+}
+
+// Under shard->lock: evicts from the shard while the map is over its bounds.
+// Neither keep (just written) nor the counters go: after two turns of the
+// hand without evicting any, it gives up.
+static void sharedEvict (typeSharedMap* map, typeSharedShard* shard, typeSharedEntry* keep) {
+  size_t idle= 0;
+  while (shard->clockFirst && sharedOver(map) && (idle <= 2* shard->entries)) {
+    typeSharedEntry* entry= shard->clockHand ? shard->clockHand : shard->clockFirst;
+    shard->clockHand= entry->clockNext;
+    idle++;
+    if ((entry == keep) || entry->counter) continue;
+    if (entry->referenced) {
+      entry->referenced= 0;
+      continue;
+    }
+    sharedUnlink(map, shard, sharedFindLink(shard, entry->data, entry->keyLength, entry->hash), entry);
+    atomic_inc(&map->evictions);
+    idle= 0;
+  }
+}
+
+// Not under any lock: the writer's shard couldn't bring the map within its
+// bounds, the others take turns.
+static void sharedEvictOthers (typeSharedMap* map) {
+  int n= kSharedMapShards;
+  while (n-- && sharedOver(map)) {
+    typeSharedShard* shard= &map->shards[(unsigned long) atomic_inc(&map->evictTurn) % kSharedMapShards];
+    uv_mutex_lock(&shard->lock);
+    sharedEvict(map, shard, NULL);
+    uv_mutex_unlock(&shard->lock);
+  }
+}
+
+static typeSharedEntry* sharedEntryNew (const char* key, uint32_t keyLength, uint64_t hash, const char* value, uint32_t valueLength) {
+  typeSharedEntry* entry= (typeSharedEntry*) malloc(sizeof(typeSharedEntry)+ keyLength+ valueLength);
+  if (!entry) return NULL;
+  entry->hash= hash;
+  entry->referenced= 1;
+  entry->counter= 0;
+  entry->keyLength= keyLength;
+  entry->valueLength= valueLength;
+  memcpy(entry->data, key, keyLength);
+  memcpy(entry->data+ keyLength, value, valueLength);
+  return entry;
+}
+
+// Under shard->lock: entry takes the place of the one at *link, if any.
+static void sharedPublish (typeSharedMap* map, typeSharedShard* shard, typeSharedEntry* volatile* link, typeSharedEntry* entry) {
+  typeSharedEntry* old= *link; //Or the end of the bucket
+  entry->next= old ? old->next : NULL;
+  memory_barrier();
+  *link= entry;
+  if (old) {
+    sharedClockUnlink(shard, old);
+    sharedCount(map, shard, old, -1);
+    sharedRetire(shard, old);
+  }
+  sharedClockAppend(shard, entry);
+  sharedCount(map, shard, entry, 1);
+  atomic_inc(&map->writes);
+  sharedEvict(map, shard, entry);
+}
+
+
+
+
+
+
+// A malloc()ed copy of the value of key, or NULL if there isn't any.
+static char* shared_map_get (typeSharedMap* map, const char* key, uint32_t keyLength, uint64_t hash, uint32_t* valueLength) {
+  typeSharedShard* shard= sharedShard(map, hash);
+  char* value= NULL;
+
+  long epoch= sharedReadBegin(shard);
+  typeSharedEntry* entry= *sharedBucket(shard, hash);
+  while (entry && !sharedEntryIs(entry, key, keyLength, hash)) entry= entry->next;
+  if (entry && (value= (char*) malloc(entry->valueLength ? entry->valueLength : 1))) {
+    memcpy(value, entry->data+ entry->keyLength, entry->valueLength);
+    *valueLength= entry->valueLength;
+    if (!entry->referenced) entry->referenced= 1;
+  }
+  sharedReadEnd(shard, epoch);
+
+  atomic_inc(value ? &map->hits : &map->misses);
+  return value;
+}
+
+// Returns 0, or -1 if there's no memory, or the value doesn't fit in the map.
+static int shared_map_set (typeSharedMap* map, const char* key, uint32_t keyLength, uint64_t hash, const char* value, uint32_t valueLength) {
+  typeSharedShard* shard= sharedShard(map, hash);
+  typeSharedEntry* entry= sharedEntryNew(key, keyLength, hash, value, valueLength);
+  if (!entry) return -1;
+  if (sharedEntrySize(entry) > map->maxBytes) {
+    free(entry);
+    return -1;
+  }
+
+  uv_mutex_lock(&shard->lock);
+  sharedPublish(map, shard, sharedFindLink(shard, key, keyLength, hash), entry);
+  uv_mutex_unlock(&shard->lock);
+  sharedEvictOthers(map);
+  return 0;
+}
+
+// Returns whether there was such a key.
+static int shared_map_delete (typeSharedMap* map, const char* key, uint32_t keyLength, uint64_t hash) {
+  typeSharedShard* shard= sharedShard(map, hash);
+  uv_mutex_lock(&shard->lock);
+  typeSharedEntry* volatile* link= sharedFindLink(shard, key, keyLength, hash);
+  int found= (*link != NULL);
+  if (found) sharedUnlink(map, shard, link, *link);
+  uv_mutex_unlock(&shard->lock);
+  return found;
+}
+
+// Sets key to value if its value is expected (expected NULL: if there's no
+// such key). value NULL deletes it. Returns whether it did.
+static int shared_map_cas (typeSharedMap* map, const char* key, uint32_t keyLength, uint64_t hash, const char* expected, uint32_t expectedLength, const char* value, uint32_t valueLength) {
+  typeSharedShard* shard= sharedShard(map, hash);
+  typeSharedEntry* entry= value ? sharedEntryNew(key, keyLength, hash, value, valueLength) : NULL;
+  if (value && (!entry || (sharedEntrySize(entry) > map->maxBytes))) {
+    free(entry);
+    return 0;
+  }
+
+  uv_mutex_lock(&shard->lock);
+  typeSharedEntry* volatile* link= sharedFindLink(shard, key, keyLength, hash);
+  typeSharedEntry* old= *link;
+  int swap= expected ?
+    (old && (old->valueLength == expectedLength) && !memcmp(old->data+ old->keyLength, expected, expectedLength)) :
+    !old;
+  if (swap) {
+    if (entry) sharedPublish(map, shard, link, entry);
+    else if (old) sharedUnlink(map, shard, link, old);
+  }
+  uv_mutex_unlock(&shard->lock);
+
+  if (!swap) {
+    free(entry);
+    atomic_inc(&map->casFailures);
+  }
+  else if (entry) sharedEvictOthers(map);
+  return swap;
+}
+
+// The value of key becomes what update() makes of it (old NULL: there's no
+// such key), atomically. update() returns a malloc()ed value, or NULL to give
+// up. Returns the new value, which the caller frees, or NULL. It's a counter:
+// it isn't evicted.
+static char* shared_map_update (typeSharedMap* map, const char* key, uint32_t keyLength, uint64_t hash, char* (*update) (const char* old, uint32_t oldLength, void* data, uint32_t* length), void* data) {
+  typeSharedShard* shard= sharedShard(map, hash);
+  char* result= NULL;
+
+  uv_mutex_lock(&shard->lock);
+  typeSharedEntry* volatile* link= sharedFindLink(shard, key, keyLength, hash);
+  typeSharedEntry* old= *link;
+  uint32_t length;
+  char* value= update(old ? old->data+ old->keyLength : NULL, old ? old->valueLength : 0, data, &length);
+  typeSharedEntry* entry= value ? sharedEntryNew(key, keyLength, hash, value, length) : NULL;
+  if (entry) {
+    entry->counter= 1;
+    sharedPublish(map, shard, link, entry);
+    result= value;
+  }
+  else {
+    free(value);
+  }
+  uv_mutex_unlock(&shard->lock);
+  if (result) sharedEvictOthers(map);
+  return result;
+}
+
+static void shared_map_clear (typeSharedMap* map) {
+  int i= 0;
+  while (i < kSharedMapShards) {
+    typeSharedShard* shard= &map->shards[i++];
+    uv_mutex_lock(&shard->lock);
+    while (shard->clockFirst) {
+      typeSharedEntry* entry= shard->clockFirst;
+      sharedUnlink(map, shard, sharedFindLink(shard, entry->data, entry->keyLength, entry->hash), entry);
+    }
+    sharedReclaim(shard);
+    uv_mutex_unlock(&shard->lock);
+  }
+}
+
+static void shared_map_usage (typeSharedMap* map, long* entries, long* bytes) {
+  *entries= atomic_read(&map->entries);
+  *bytes= atomic_read(&map->bytes);
+}
@@ -0,0 +1,367 @@
+//shm_ring.cc
+//A ring of frames (see remote.cc) in a file mmap()ed from /dev/shm, shared by
+//processes: many may push, one pulls. The puller sleeps on a futex while it's
+//empty, the pushers while it's full. Its calls mirror queue_push() and
+//queue_pull(). Any of those processes may die at any time: the ring knows the
+//pid of the one that created it, and each record that of its pusher, so that
+//the others can tell. Linux only. No V8 in here.
+
+#if defined(__linux__)
+#define WWT_SHM_RING 1
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <time.h>
+#include <errno.h>
+
+#define kRingMagic 0x52494e47
+#define kRingPad 0x80000000u     //Commit word of the filler at the end of the ring
+#define kRingBusy 0x40000000u    //Commit word of a record being written, with its size
+#define kRingMinCapacity 65536
+#define kRingWaitMs 100
+#define kRingRetryMs 2       //How often the frames waiting for room in a ring are retried
+#define kRingWatchMs 500     //How often the other end is checked, otherwise
+#define kRingStuckMs 1000    //How long a record may stay unfinished before its pusher is checked
+
+typedef struct typeRingHeader {
+  int magic;
+  int capacity;                 //Bytes of records, a power of 2
+  volatile long head;           //Reserved by the pushers
+  volatile long tail;           //Taken by the puller
+  volatile int pullerSeq;       //futex: bumped when there's something to pull
+  volatile int pullerWaiting;
+  volatile int pusherSeq;       //futex: bumped when there's room
+  volatile int pushersWaiting;
+  volatile int closed;
+  int pid;                      //Of the process that created it
+  char pad[64];
+} typeRingHeader;
+
+// Each record is a uint32_t commit word, then the uint32_t pid of its pusher,
+// then the frame. The commit word is 0 until the space is reserved, then
+// kRingBusy and the record's size until the frame is completely written, then
+// the frame's length. Records are 8 byte aligned, and the puller zeroes what
+// it takes so that any commit word yet to be written is 0.
+typedef struct typeRing {
+  typeRingHeader* header;
+  char* data;
+  size_t mappedLength;
+  char* path;
+  int owner;                 //Created it: unlinks it when destroyed
+  struct typeRing* nextOwned; //In ownedRings
+  long stuckTail;            //The puller: the record it's been waiting for since stuckSince
+  struct timespec stuckSince;
+} typeRing;
+
+// Those this process created, to unlink at exit if they're still there.
+static typeRing* ownedRings= NULL;
+
+
+
+
+
+
+static void futexWait (volatile int* addr, int value, int ms) {
+  struct timespec ts;
+  ts.tv_sec= ms/ 1000;
+  ts.tv_nsec= (ms % 1000)* 1000000;
+  syscall(SYS_futex, (int*) addr, FUTEX_WAIT, value, &ts, NULL, 0);
+}
+
+static void futexWake (volatile int* addr) {
+  atomic_add_int(addr, 1);
+  syscall(SYS_futex, (int*) addr, FUTEX_WAKE, 0x7fffffff, NULL, NULL, 0);
+}
+
+static long msSince (struct timespec* t0) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (t.tv_sec- t0->tv_sec)* 1000+ (t.tv_nsec- t0->tv_nsec)/ 1000000;
+}
+
+static size_t ringRecordSize (size_t frameLength) {
+  return (2* sizeof(uint32_t)+ frameLength+ 7) & ~((size_t) 7);
+}
+
+// Whether the process pid is still there. 0 is nobody's: it's there.
+static int ringPidAlive (int pid) {
+  return !pid || !kill(pid, 0) || (errno != ESRCH);
+}
+
+// Whether the ring at path was left behind by a process that died: then it's
+// unlinked.
+static int ringStale (const char* path) {
+  int fd= open(path, O_RDWR);
+  if (fd < 0) return 0;
+  struct stat st;
+  int stale= 0;
+  if (!fstat(fd, &st) && ((size_t) st.st_size >= sizeof(typeRingHeader))) {
+    typeRingHeader* h= (typeRingHeader*) mmap(NULL, sizeof(typeRingHeader), PROT_READ, MAP_SHARED, fd, 0);
+    if (h != MAP_FAILED) {
+      stale= (h->magic == kRingMagic) && !ringPidAlive(h->pid);
+      munmap(h, sizeof(typeRingHeader));
+    }
+  }
+  close(fd);
+  if (stale) unlink(path);
+  return stale;
+}
+
+static void ringUnlinkOwned (void) {
+  typeRing* ring= ownedRings;
+  while (ring) {
+    unlink(ring->path);
+    ring= ring->nextOwned;
+  }
+}
+
+static char* ringPath (const char* name) {
+  if (strchr(name, '/')) return strdup(name);
+  char* path= (char*) malloc(strlen(name)+ 10);
+  strcpy(path, "/dev/shm/");
+  strcat(path, name);
+  return path;
+}
+
+
+
+
+
+
+static typeRing* ring_map (const char* name, size_t capacity, int create) {
+  typeRing* ring= (typeRing*) calloc(1, sizeof(typeRing));
+  ring->path= ringPath(name);
+  ring->owner= create;
+  ring->stuckTail= -1;
+
+  int fd= open(ring->path, create ? (O_RDWR | O_CREAT | O_EXCL) : O_RDWR, 0600);
+  if ((fd < 0) && create && (errno == EEXIST) && ringStale(ring->path)) {
+    fd= open(ring->path, O_RDWR | O_CREAT | O_EXCL, 0600);
+  }
+  if (fd < 0) goto fail;
+
+  if (create) {
+    size_t c= kRingMinCapacity;
+    while (c < capacity) c*= 2;
+    capacity= c;
+    if (ftruncate(fd, sizeof(typeRingHeader)+ capacity)) {
+      close(fd);
+      unlink(ring->path);
+      goto fail;
+    }
+  }
+  else {
+    struct stat st;
+    if (fstat(fd, &st) || ((size_t) st.st_size < sizeof(typeRingHeader)+ kRingMinCapacity)) {
+      close(fd);
+      errno= EINVAL;
+      goto fail;
+    }
+    capacity= st.st_size- sizeof(typeRingHeader);
+  }
+
+  ring->mappedLength= sizeof(typeRingHeader)+ capacity;
+  ring->header= (typeRingHeader*) mmap(NULL, ring->mappedLength, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ring->header == MAP_FAILED) {
+    if (create) unlink(ring->path);
+    goto fail;
+  }
+  ring->data= (char*) (ring->header+ 1);
+
+  if (create) {
+    static int atExit= 0;
+    if (!atExit++) atexit(ringUnlinkOwned);
+    ring->nextOwned= ownedRings;
+    ownedRings= ring;
+    ring->header->capacity= (int) capacity;
+    ring->header->pid= (int) getpid();
+    memory_barrier();
+    ring->header->magic= kRingMagic;
+  }
+  else if ((ring->header->magic != kRingMagic) || ((size_t) ring->header->capacity != capacity)) {
+    munmap(ring->header, ring->mappedLength);
+    errno= EINVAL;
+    goto fail;
+  }
+  return ring;
+
+fail:
+  free(ring->path);
+  free(ring);
+  return NULL;
+}
+
+static typeRing* ring_create (const char* name, size_t capacity) {
+  return ring_map(name, capacity, 1);
+}
+
+static typeRing* ring_open (const char* name) {
+  return ring_map(name, 0, 0);
+}
+
+// Wakes up everybody, and from now on ring_push() and ring_pull() fail.
+static void ring_close (typeRing* ring) {
+  ring->header->closed= 1;
+  futexWake(&ring->header->pullerSeq);
+  futexWake(&ring->header->pusherSeq);
+}
+
+// Whether the process that created the ring is still there.
+static int ring_owner_alive (typeRing* ring) {
+  return ringPidAlive(ring->header->pid);
+}
+
+static void ring_destroy (typeRing* ring) {
+  typeRing** p= &ownedRings;
+  while (*p && (*p != ring)) p= &(*p)->nextOwned;
+  if (*p) *p= ring->nextOwned;
+  munmap(ring->header, ring->mappedLength);
+  if (ring->owner) unlink(ring->path);
+  free(ring->path);
+  free(ring);
+}
+
+
+
+
+
+
+// Whether the frame fits in the ring at all: one can take up to half of it.
+static int ring_fits (typeRing* ring, char* frame) {
+  return (long) ringRecordSize(((typeFrameHeader*) frame)->length) <= ring->header->capacity/ 2;
+}
+
+// Copies the frame into the ring, waiting up to ms (forever if < 0) while it's full.
+// Returns 0, or -1 if the frame can never fit, -2 if the ring is closed, -3 if it's still full.
+static int ring_push (typeRing* ring, char* frame, int ms) {
+  typeRingHeader* h= ring->header;
+  long capacity= h->capacity;
+  uint32_t length= ((typeFrameHeader*) frame)->length;
+  long size= (long) ringRecordSize(length);
+  long head, pos, total;
+  struct timespec t0;
+
+  if (!ring_fits(ring, frame)) return -1;
+  if (ms > 0) clock_gettime(CLOCK_MONOTONIC, &t0);
+
+  while (1) {
+    if (h->closed) return -2;
+    head= h->head;
+    pos= head & (capacity- 1);
+    total= (capacity- pos < size) ? (capacity- pos)+ size : size;
+    if (head+ total- h->tail > capacity) {
+      if (!ms || ((ms > 0) && (msSince(&t0) >= ms))) return -3;
+      int seq= h->pusherSeq;
+      atomic_add_int(&h->pushersWaiting, 1);
+      if (head+ total- h->tail > capacity) futexWait(&h->pusherSeq, seq, kRingWaitMs);
+      atomic_add_int(&h->pushersWaiting, -1);
+      continue;
+    }
+    if (atomic_cas(&h->head, head, head+ total) == head) break;
+  }
+
+  if (total != size) {
+    // The frame doesn't fit before the end: fill it, and wrap around
+    memory_barrier();
+    *((volatile uint32_t*) (ring->data+ pos))= kRingPad | (uint32_t) (capacity- pos);
+    pos= 0;
+  }
+  *((volatile uint32_t*) (ring->data+ pos+ sizeof(uint32_t)))= (uint32_t) getpid();
+  memory_barrier();
+  *((volatile uint32_t*) (ring->data+ pos))= kRingBusy | (uint32_t) size;
+  memcpy(ring->data+ pos+ 2* sizeof(uint32_t), frame, length);
+  memory_barrier();
+  *((volatile uint32_t*) (ring->data+ pos))= length;
+
+  memory_barrier();
+  if (h->pullerWaiting) futexWake(&h->pullerSeq);
+  return 0;
+}
+
+
+
+
+
+
+// How long the puller has been waiting for the record at tail, while there
+// are others reserved after it.
+static long ringStuck (typeRing* ring, long tail) {
+  if (ring->header->head == tail) {
+    ring->stuckTail= -1;
+    return 0;
+  }
+  if (ring->stuckTail != tail) {
+    ring->stuckTail= tail;
+    clock_gettime(CLOCK_MONOTONIC, &ring->stuckSince);
+    return 0;
+  }
+  return msSince(&ring->stuckSince);
+}
+
+// A malloc()ed copy of the next frame. Waits up to ms for one: NULL if there
+// isn't any, or if the ring is closed.
+static char* ring_pull (typeRing* ring, int ms) {
+  typeRingHeader* h= ring->header;
+  long capacity= h->capacity;
+  int waited= 0;
+
+  while (1) {
+    long tail= h->tail;
+    long pos= tail & (capacity- 1);
+    uint32_t word= *((volatile uint32_t*) (ring->data+ pos));
+
+    if (!word || (word & kRingBusy)) {
+      long stuck= ringStuck(ring, tail);
+      if (word && (stuck >= kRingStuckMs) && !ringPidAlive((int) *((volatile uint32_t*) (ring->data+ pos+ sizeof(uint32_t))))) {
+        // Its pusher died while writing it: skip it
+        word= kRingPad | (word & ~kRingBusy);
+      }
+      else if (!word && (stuck >= kRingStuckMs* 10)) {
+        // Its pusher died right after reserving it, and there's no telling
+        // how long it is: nothing after it can be pulled.
+        ring_close(ring);
+        return NULL;
+      }
+    }
+    if (!word || (word & kRingBusy)) {
+      if (h->closed || waited) return NULL;
+      int seq= h->pullerSeq;
+      h->pullerWaiting= 1;
+      memory_barrier();
+      word= *((volatile uint32_t*) (ring->data+ pos));
+      if (!word || (word & kRingBusy)) futexWait(&h->pullerSeq, seq, ms);
+      h->pullerWaiting= 0;
+      waited= 1;
+      continue;
+    }
+    memory_barrier();
+
+    char* frame= NULL;
+    long size= (word & kRingPad) ? (long) (word & ~kRingPad) : (long) ringRecordSize(word);
+    if (!size || (size > capacity- pos)) {
+      // Garbage: whoever wrote it isn't playing by the rules
+      ring_close(ring);
+      return NULL;
+    }
+    if (!(word & kRingPad)) {
+      frame= (char*) malloc(word);
+      if (frame) memcpy(frame, ring->data+ pos+ 2* sizeof(uint32_t), word);
+    }
+    memset(ring->data+ pos, 0, size);
+    memory_barrier();
+    h->tail= tail+ size;
+    memory_barrier();
+    if (h->pushersWaiting) futexWake(&h->pusherSeq);
+
+    if (frame) return frame;
+  }
+}
+
+#endif
@@ -0,0 +1,35 @@
+
+
+var T= require('webworker-threads');
+
+var t= T.create();
+var big= new Array(1e5+ 1).join('x'); // 100KB per job
+var i= 0;
+var rejected= 0;
+
+T.setQueueLimit(1e6);
+
+t.eval('while (Date.now() < '+ (Date.now()+ 500)+ ');');
+while (i++ < 100) {
+  try {
+    t.eval('"'+ big+ '".length');
+  }
+  catch (e) {
+    rejected++;
+  }
+}
+
+console.log('queued: '+ t.queuedBytes()+ ' bytes, rejected: '+ rejected);
+console.log(T.stats());
+if (!rejected) throw 'the queue limit was not enforced';
+
+// The queue is still at the limit: lift it, or this job would be rejected too.
+T.setQueueLimit(0);
+t.eval('0', function (err, data) {
+  console.log('drained, queued: '+ this.queuedBytes()+ ' bytes');
+  this.destroy();
+});
+
+process.on('exit', function () {
+  console.log("process.on('exit') -> BYE!");
+});
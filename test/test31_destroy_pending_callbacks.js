@@ -0,0 +1,38 @@
+
+
+var T= require('webworker-threads');
+
+var t= T.create();
+var i= 0;
+var ok= 0;
+var aborted= 0;
+
+function cb (err, data) {
+  if (err) {
+    aborted++;
+    console.log('['+ this.id+ '] callback with error -> '+ err.message);
+  }
+  else {
+    ok++;
+    console.log('['+ this.id+ '] callback with data -> '+ data);
+  }
+}
+
+t.eval('"first job"', cb);
+t.eval('while (true);', cb);
+while (i++ < 10) t.eval(''+ i, cb);
+setTimeout(function () {
+  t.destroy();
+  try {
+    t.eval('0');
+  }
+  catch (e) {
+    console.log('eval() after destroy() throws -> '+ e.message);
+  }
+}, 100);
+
+process.on('exit', function () {
+  console.log('ok: '+ ok+ ', aborted: '+ aborted+ ', stats: '+ JSON.stringify(T.stats()));
+  if (ok+ aborted !== 12) throw 'some callbacks were never called';
+  console.log("process.on('exit') -> BYE!");
+});
@@ -0,0 +1,42 @@
+
+
+var T= require('webworker-threads');
+
+var pool= T.createPool(2);
+var arr= new Float64Array(1e6);
+var i= arr.length;
+while (i--) arr[i]= i;
+
+pool.all.eval(kernel);
+
+function kernel (a, factor) {
+  var i= a.length;
+  var sum= 0;
+  while (i--) sum+= (a[i]*= factor);
+  return sum;
+}
+
+pool.any.call('kernel', [arr, 2], function (err, sum) {
+  if (err) throw err;
+  console.log('kernel -> '+ sum+ ', arr.length: '+ arr.length+ ', arr[10]: '+ arr[10]);
+  if (arr.length !== 1e6 || arr[10] !== 20) throw 'the array was not lent back';
+  if (sum !== (1e6- 1)* 1e6) throw 'wrong sum';
+  pool.destroy();
+});
+
+console.log('pinned arr.length -> '+ arr.length+ ', arr[10] -> '+ arr[10]);
+if (arr[10] !== undefined) throw 'the array should be locked while the job runs';
+
+var lentTwice= false;
+try {
+  pool.all.call('kernel', [arr, 1]);
+}
+catch (e) {
+  lentTwice= true;
+  console.log('lending it twice throws -> '+ e.message);
+}
+if (!lentTwice) throw 'lending the array twice should throw';
+
+process.on('exit', function () {
+  console.log("process.on('exit') -> BYE!");
+});
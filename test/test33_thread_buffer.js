@@ -0,0 +1,27 @@
+
+
+var T= require('webworker-threads');
+
+var t= T.create();
+var buf= new Buffer('¡Hola, mundo!');
+
+t.eval(function echo (o) {
+  var b= new Buffer(o.b.length);
+  var i= o.b.length;
+  while (i--) b[i]= o.b[i];
+  return { isBuffer: Buffer.isBuffer(o.b), text: o.b.toString(), copy: b };
+});
+
+t.call('echo', [{ b: buf }], function (err, result) {
+  if (err) throw err;
+  console.log('isBuffer in the thread -> '+ result.isBuffer);
+  console.log('toString() in the thread -> '+ result.text);
+  console.log('copy back in the main thread -> '+ result.copy.toString());
+  if (!Buffer.isBuffer(result.copy)) throw 'the result should be a Buffer';
+  if (result.copy.toString() !== buf.toString()) throw 'the bytes differ';
+  t.destroy();
+});
+
+process.on('exit', function () {
+  console.log("process.on('exit') -> BYE!");
+});
@@ -0,0 +1,41 @@
+
+
+var T= require('webworker-threads');
+
+var pool= T.createPool(4);
+var length= 1e6+ 7;
+var a= new Float64Array(length);
+var i= length;
+while (i--) a[i]= Math.random()* 1e3 | 0;
+a[123]= NaN;
+
+pool.sort(a, function (err, sorted) {
+  if (err) throw err;
+  if (sorted !== a || a.length !== length) throw 'the array was not lent back';
+  var i= length- 1;
+  if (a[i] === a[i]) throw 'NaN should go last';
+  while (--i > 0) if (a[i- 1] > a[i]) throw 'not sorted at '+ i;
+  console.log('ascending OK');
+
+  pool.binarySearchMany(a, [0, 500.5, 999, 1e6], function (err, results) {
+    if (err) throw err;
+    console.log('binarySearchMany -> '+ Array.prototype.join.call(results, ', '));
+    if (a[results[0]] !== 0 || a[results[2]] !== 999) throw 'wrong index';
+    if (results[1] >= 0 || a[-results[1]- 1] !== 501) throw 'wrong insertion point';
+    if (results[3] !== -(length- 1)- 1) throw 'wrong insertion point at the end';
+
+    pool.sort(a, { compare: 'desc' }, function (err, sorted) {
+      if (err) throw err;
+      var i= length- 1;
+      while (--i > 0) if (a[i- 1] < a[i]) throw 'not sorted descending at '+ i;
+      console.log('descending OK');
+      pool.destroy();
+    });
+  });
+});
+
+if (a[0] !== undefined) throw 'the array should be locked while it is sorted';
+
+process.on('exit', function () {
+  console.log("process.on('exit') -> BYE!");
+});
@@ -0,0 +1,66 @@
+
+
+var T= require('webworker-threads');
+
+var pool= T.createPool(3);
+var doc= { name: 'test', list: [1, 2.5, 'three', null, true, { nested: [] }], when: 'now' };
+var big= [];
+var i= 100;
+while (i--) big.push({ i: i, s: 'x'+ i });
+
+pool.parseJSON(JSON.stringify(doc), function (err, result) {
+  if (err) throw err;
+  console.log('parseJSON(string) -> '+ JSON.stringify(result));
+  if (JSON.stringify(result) !== JSON.stringify(doc)) throw 'parseJSON(string) differs';
+
+  pool.parseJSON(new Buffer(JSON.stringify(doc)), function (err, result) {
+    if (err) throw err;
+    if (JSON.stringify(result) !== JSON.stringify(doc)) throw 'parseJSON(buffer) differs';
+    console.log('parseJSON(buffer) OK');
+
+    pool.parseJSON('{ bad json', function (err, result) {
+      console.log('parseJSON(bad json) -> '+ err);
+      if (!err) throw 'parseJSON(bad json) should fail';
+
+      pool.stringifyJSON(big, function (err, text) {
+        if (err) throw err;
+        if (text !== JSON.stringify(big)) throw 'stringifyJSON() differs';
+        console.log('stringifyJSON() OK');
+
+        var dated= { list: big, when: new Date(0), nested: [{ toJSON: function () { return 'custom' } }] };
+        pool.stringifyJSON(dated, function (err, text) {
+          if (err) throw err;
+          if (text !== JSON.stringify(dated)) throw 'stringifyJSON() lost a nested toJSON()';
+          console.log('stringifyJSON(toJSON) OK');
+
+          var odd= { list: big, none: undefined, boxed: [new Number(1), new String('s')], 'a\u0000b': 1 };
+          Object.defineProperty(odd, 'hidden', { value: 1 });
+          pool.stringifyJSON(odd, function (err, text) {
+            if (err) throw err;
+            if (text !== JSON.stringify(odd)) throw 'stringifyJSON() differs from JSON.stringify()';
+            console.log('stringifyJSON(undefined, non-enumerable, boxed, NUL) OK');
+
+            var ref= { $ref: 'things', $id: 1, $db: 'db' };
+            pool.parseJSON(JSON.stringify(ref), function (err, result) {
+              if (err) throw err;
+              if (JSON.stringify(result) !== JSON.stringify(ref)) throw 'parseJSON($id, $ref) differs';
+              console.log('parseJSON($id, $ref) OK');
+
+              pool.all.eval('function same (o) { return o }');
+              pool.any.call('same', [ref], function (err, result) {
+                if (err) throw err;
+                if (JSON.stringify(result) !== JSON.stringify(ref)) throw 'call($id, $ref) differs';
+                console.log('call($id, $ref) OK');
+                pool.destroy();
+              });
+            });
+          });
+        });
+      });
+    });
+  });
+});
+
+process.on('exit', function () {
+  console.log("process.on('exit') -> BYE!");
+});
@@ -0,0 +1,36 @@
+
+
+var T= require('webworker-threads');
+var path= '/tmp/webworker-threads-test36.'+ process.pid+ '.sock';
+
+if (process.argv[2] === 'client') {
+  var remote= T.connect(process.argv[3]);
+  remote.any.call('add', [2, 3], function (err, data) {
+    if (err) throw err;
+    console.log('[client] add(2, 3) -> '+ data);
+    remote.eval('"threadId: "+ thread.id', function (err, data) {
+      if (err) throw err;
+      console.log('[client] eval() -> '+ data);
+      remote.call('nope', [], function (err, data) {
+        console.log('[client] call(\'nope\') -> '+ err);
+        if (!err) throw 'calling an undefined function should fail';
+        remote.destroy();
+        process.send('OK');
+      });
+    });
+  });
+}
+else {
+  var pool= T.createPool(2).all.eval('function add (a, b) { return a+ b }');
+  var server= pool.serve(path);
+  var child= require('child_process').fork(__filename, ['client', path]);
+  child.on('message', function (m) {
+    console.log('[server] the client says '+ m+ ', stats: '+ JSON.stringify(server.stats()));
+    if (m !== 'OK') throw 'the client failed';
+    server.close();
+    pool.destroy();
+  });
+  process.on('exit', function () {
+    console.log("process.on('exit') -> BYE!");
+  });
+}
@@ -0,0 +1,72 @@
+
+
+var T= require('webworker-threads');
+var name= 'webworker-threads-test37.'+ process.pid;
+var options= { transport: 'shm' };
+
+if (process.platform !== 'linux') {
+  console.log("transport 'shm' is Linux only: skipped");
+}
+else if (process.argv[2] === 'client') {
+  var remote= T.connect(process.argv[3], options);
+  var big= new Buffer(100000);
+  big.fill(7);
+  remote.any.call('add', [2, 3], function (err, data) {
+    if (err) throw err;
+    console.log('[client] add(2, 3) -> '+ data);
+    remote.call('sum', [big], function (err, data) {
+      if (err) throw err;
+      console.log('[client] sum(big) -> '+ data);
+      if (data !== 700000) throw 'the buffer got mangled';
+      remote.call('nope', [], function (err, data) {
+        console.log('[client] call(\'nope\') -> '+ err);
+        if (!err) throw 'calling an undefined function should fail';
+        remote.destroy();
+        process.send('OK');
+      });
+    });
+  });
+}
+else if (process.argv[2] === 'killed') {
+  var remote= T.connect(process.argv[3], options);
+  remote.call('add', [1, 1], function (err, data) {
+    if (err) throw err;
+    process.send('ready');
+    setInterval(function () {}, 1000);
+  });
+}
+else {
+  var pool= T.createPool(2).all.eval('function add (a, b) { return a+ b }')
+    .all.eval('function sum (b) { var s= 0; for (var i= 0; i < b.length; i++) s+= b[i]; return s }');
+  var server= pool.serve(name, options);
+  if (server.transport !== 'shm') throw 'the server should be on shm';
+  var child= require('child_process').fork(__filename, ['client', name]);
+  child.on('message', function (m) {
+    console.log('[server] the client says '+ m+ ', stats: '+ JSON.stringify(server.stats()));
+    if (m !== 'OK') throw 'the client failed';
+    killed();
+  });
+
+  // A client killed without a bye is dropped, and its ring unlinked
+  function killed () {
+    var child= require('child_process').fork(__filename, ['killed', name]);
+    child.on('message', function (m) {
+      var ring= '/dev/shm/'+ name+ '.'+ child.pid+ '.0';
+      if (!require('fs').existsSync(ring)) throw 'the client\'s ring should be there';
+      child.kill('SIGKILL');
+      var giveUp= Date.now()+ 5000;
+      (function poll () {
+        if (server.stats().connections || require('fs').existsSync(ring)) {
+          if (Date.now() > giveUp) throw 'the killed client is still connected';
+          return setTimeout(poll, 100);
+        }
+        console.log('[server] the killed client was dropped');
+        server.close();
+        pool.destroy();
+      })();
+    });
+  }
+  process.on('exit', function () {
+    console.log("process.on('exit') -> BYE!");
+  });
+}
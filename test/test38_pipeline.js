@@ -0,0 +1,47 @@
+
+
+var T= require('webworker-threads');
+
+var N= 2000;
+var pipeline= T.pipeline([
+  function decode (s) { return JSON.parse(s) },
+  function enrich (o) { if (o.n === 13) throw 'unlucky'; o.square= o.n* o.n; o.thread= thread.id; return o },
+  function encode (o) { return o.n+ ':'+ o.square }
+], { threadsPerStage: 2, queueDepth: 8 });
+
+var done= 0;
+var errors= 0;
+var full= 0;
+var drains= 0;
+var i= 0;
+pipeline.on('drain', function () { drains++ });
+while (i < N) (function (n) {
+  if (!pipeline.push(JSON.stringify({ n: n }), function (err, data) {
+    if (err) {
+      errors++;
+      if (n !== 13) throw err;
+    }
+    else if (data !== n+ ':'+ (n* n)) {
+      throw 'wrong result for '+ n+ ': '+ data;
+    }
+    if (++done === N) finish();
+  })) full++;
+})(i++);
+
+function finish () {
+  var stats= pipeline.stats();
+  console.log(JSON.stringify(stats));
+  if (errors !== 1 || stats.errors !== 1) throw 'expected exactly one error';
+  if (stats.done !== N || stats.inFlight !== 0) throw 'wrong counters';
+  if (!full || !drains) throw 'push() returned false '+ full+ ' times, and there were '+ drains+ ' drains';
+  stats.stages.forEach(function (stage, i) {
+    if (stage.maxQueueDepth > 8 && i) throw 'stage '+ i+ ' went over its queueDepth';
+    if (stage.processed !== (i === 2 ? N- 1 : N)) throw 'stage '+ i+ ' processed '+ stage.processed;
+  });
+  pipeline.destroy();
+  console.log('OK: '+ N+ ' items through 3 stages');
+}
+
+process.on('exit', function () {
+  console.log("process.on('exit') -> BYE!");
+});
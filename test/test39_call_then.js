@@ -0,0 +1,49 @@
+
+
+var T= require('webworker-threads');
+
+var pool= T.createPool(2).all.eval('var where= []; function a (x) { where.push(thread.id); return x+ 1 } function b (x) { where.push(thread.id); return x* 10 } function c (x) { where.push(thread.id); return where.splice(0).concat([x]) } function boom () { throw "boom" } function inc (x) { return x+ 1 }');
+
+var pending= 4;
+function done () {
+  if (--pending) return;
+  pool.destroy();
+  console.log('OK');
+}
+
+pool.any.chain('a', [1]).then('b').then('c').then(function (err, data) {
+  if (err) throw err;
+  console.log('a(1) -> b -> c: '+ JSON.stringify(data));
+  var result= data.pop();
+  if (result !== 20) throw 'expected 20, got '+ result;
+  if ((data[0] !== data[1]) || (data[1] !== data[2])) throw 'the chain should have run in a single thread';
+  done();
+});
+
+pool.any.chain('boom').then('c').then(function (err, data) {
+  console.log('boom -> c: '+ err);
+  if (!err || (data !== null)) throw 'the error should skip the rest of the chain';
+  done();
+});
+
+if (pool.any.call('inc', [3]) !== pool) throw '.any.call() without a callback should be queued right away';
+pool.any.call('inc', [3], function (err, data) {
+  if (err) throw err;
+  console.log('inc(3): '+ data);
+  if (data !== 4) throw 'expected 4, got '+ data;
+  done();
+});
+
+var future= pool.any.chain('a', [2]);
+setTimeout(function () {
+  future.then('b').then(function (err, data) {
+    if (err) throw err;
+    console.log('a(2), later -> b: '+ data);
+    if (data !== 30) throw 'expected 30, got '+ data;
+    done();
+  });
+}, 100);
+
+process.on('exit', function () {
+  console.log("process.on('exit') -> BYE!");
+});
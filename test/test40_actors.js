@@ -0,0 +1,58 @@
+
+
+var T= require('webworker-threads');
+
+var numActors= 50;
+var numMessages= 200;
+var pool= T.createPool(3);
+
+function counter () {
+  return {
+    total: 0,
+    seen: [],
+    add: function (n) { this.seen.push(n); return this.total+= n },
+    check: function () { for (var i= 0; i < this.seen.length; i++) if (this.seen[i] !== i) return false; return true }
+  };
+}
+
+var pending= numActors+ 1;
+var i= 0;
+
+// An init that throws: its error goes to spawnActor()'s cb, and to every call
+var initError= null;
+var broken= pool.spawnActor(function () { throw new Error('bad init') }, function (err, actor) {
+  if (!err || actor !== null) throw 'spawnActor() should fail';
+  initError= err;
+});
+broken.call('add', [1], function (err) {
+  if (!err || !/bad init/.test(err)) throw 'a call to a broken actor should fail with its init error, not with '+ err;
+  if (!initError) throw "spawnActor()'s cb should come first";
+  broken.destroy();
+  done();
+});
+
+while (i < numActors) (function (actor) {
+  var n= 0;
+  while (n < numMessages) actor.call('add', [n++]);
+  actor.call('check', function (err, inOrder) {
+    if (err) throw err;
+    if (!inOrder) throw 'an actor got its messages out of order';
+    actor.call('add', [0], function (err, total) {
+      if (err) throw err;
+      if (total !== numMessages* (numMessages- 1)/ 2) throw 'wrong total: '+ total;
+      if (actor.stats().messages !== numMessages+ 3) throw 'wrong messages count';
+      actor.destroy();
+      done();
+    });
+  });
+})(pool.spawnActor(counter), i++);
+
+function done () {
+  if (--pending) return;
+  pool.destroy();
+  console.log('OK: '+ numActors+ ' actors, '+ numMessages+ ' messages each, in 3 threads');
+}
+
+process.on('exit', function () {
+  console.log("process.on('exit') -> BYE!");
+});
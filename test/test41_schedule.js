@@ -0,0 +1,39 @@
+
+
+var T= require('webworker-threads');
+
+var pool= T.createPool(2);
+var ticks= 0;
+
+pool.on('tick', function (n) {
+  ticks++;
+});
+
+var schedule= pool.schedule(function () {
+  thread.emit('tick', thread.id);
+}, { everyMs: 20, jitter: 5 });
+
+var slow= pool.schedule(function () {
+  var t= Date.now();
+  while (Date.now()- t < 100);
+}, { everyMs: 10, overlap: 'skip' });
+
+// Waits for the runs rather than for a while, so that a slow machine doesn't fail it
+var giveUp= Date.now()+ 10000;
+(function check () {
+  var stats= schedule.stats();
+  var slowStats= slow.stats();
+  if (((ticks < 10) || !slowStats.overlapSkipped) && (Date.now() < giveUp)) return setTimeout(check, 50);
+  schedule.cancel();
+  slow.cancel();
+  if (ticks < 10) throw 'too few ticks: '+ ticks;
+  if (stats.runs < ticks) throw 'more ticks than runs';
+  if (stats.errors) throw 'the schedule threw';
+  if (!slowStats.overlapSkipped) throw 'the slow schedule should have skipped runs';
+  pool.destroy();
+  console.log('OK: '+ ticks+ ' ticks, '+ slowStats.overlapSkipped+ ' overlapping runs skipped');
+})();
+
+process.on('exit', function () {
+  console.log("process.on('exit') -> BYE!");
+});
@@ -0,0 +1,43 @@
+
+
+var T= require('webworker-threads');
+var fs= require('fs');
+var path= require('path');
+
+var file= path.join(require('os').tmpdir(), 'wwt_test42_'+ process.pid+ '.js');
+fs.writeFileSync(file, 'function twice (n) { return 2* n }\ntwice(21)');
+
+var pool= T.createPool(4);
+var pending= 4+ 1+ 1;
+
+function done () {
+  if (--pending) return;
+  fs.unlinkSync(file);
+  pool.destroy();
+  console.log('OK: loaded in the threads, and the errors reported');
+}
+
+pool.load(file, function (err, data) {
+  if (err) throw err;
+  if (data !== '42') throw 'wrong result: '+ data;
+  done();
+});
+
+var lonely= T.create();
+lonely.load('/nonexistent/wwt_test42.js', function (err, data) {
+  if (!err || !/nonexistent/.test(err.message)) throw 'expected an error for a missing file';
+  done();
+});
+
+var quiet= T.create();
+quiet.on('error', function (e) {
+  if (e.filename !== '/nonexistent/wwt_test42.js') throw 'wrong filename: '+ e.filename;
+  quiet.destroy();
+  lonely.destroy();
+  done();
+});
+quiet.load('/nonexistent/wwt_test42.js');
+
+process.on('exit', function () {
+  console.log("process.on('exit') -> BYE!");
+});
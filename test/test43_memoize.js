@@ -0,0 +1,38 @@
+
+
+var T= require('webworker-threads');
+
+var pool= T.createPool(4);
+pool.all.eval('var runs= 0; function square (n) { runs++; return { n: n, square: n* n } }');
+
+var keys= 20;
+var rounds= 5;
+
+function round (r) {
+  var pending= keys;
+  var i= 0;
+  while (i < keys) (function (n) {
+    pool.any.call('square', [n], { memoize: true }, function (err, data) {
+      if (err) throw err;
+      if (data.square !== n* n) throw 'wrong result for '+ n;
+      if (!--pending) next(r);
+    });
+  })(i++);
+}
+
+function next (r) {
+  if (++r < rounds) return round(r);
+  var stats= T.memoStats();
+  if (stats.hits < keys* (rounds- 1)) throw 'expected at least '+ keys* (rounds- 1)+ ' hits, got '+ stats.hits;
+  if (stats.entries < keys) throw 'expected '+ keys+ ' entries';
+  T.setMemoLimit(0);
+  if (T.memoStats().entries) throw 'setMemoLimit(0) should empty the cache';
+  pool.destroy();
+  console.log('OK: hit rate '+ stats.hitRate.toFixed(2));
+}
+
+round(0);
+
+process.on('exit', function () {
+  console.log("process.on('exit') -> BYE!");
+});
@@ -0,0 +1,36 @@
+
+
+var T= require('webworker-threads');
+
+var pool= T.createPool(2);
+pool.all.eval('var runs= 0; function slow (n) { var t= Date.now(); while (Date.now()- t < 50); return { n: n, runs: ++runs } }');
+
+var calls= 500;
+var pending= calls;
+var first= null;
+var i= 0;
+while (i++ < calls) {
+  pool.any.call('slow', [7], { coalesce: true }, function (err, data) {
+    if (err) throw err;
+    if (data.n !== 7) throw 'wrong result';
+    if (!first) first= data;
+    else if (data !== first) throw 'the coalesced calls should get the same result';
+    if (--pending) return;
+
+    var stats= pool.coalesceStats();
+    if (stats.leaders !== 1) throw 'expected 1 leader, got '+ stats.leaders;
+    if (stats.coalesced !== calls- 1) throw 'expected '+ (calls- 1)+ ' coalesced, got '+ stats.coalesced;
+    if (stats.inFlight) throw 'nothing should be in flight';
+
+    pool.any.call('slow', [7], { coalesce: true }, function (err, data) {
+      if (err) throw err;
+      if (data === first) throw 'a call after the first is done should run again';
+      pool.destroy();
+      console.log('OK: '+ calls+ ' identical calls, coalescing ratio '+ stats.ratio.toFixed(3));
+    });
+  });
+}
+
+process.on('exit', function () {
+  console.log("process.on('exit') -> BYE!");
+});
@@ -0,0 +1,47 @@
+
+
+var T= require('webworker-threads');
+
+var pool= T.createPool(3);
+var partitions= [];
+var i= 0;
+while (i < 8) partitions.push({ from: i* 1000, to: (i+ 1)* 1000 }), i++;
+
+function loader (partition, index) {
+  var docs= [];
+  for (var n= partition.from; n < partition.to; n++) docs.push({ id: n, score: (n* 7919) % 1000 });
+  return docs;
+}
+
+pool.shard(loader, partitions, function (err, shards) {
+  if (err) throw err;
+  if (shards !== 8) throw 'expected 8 shards, got '+ shards;
+
+  pool.scatter(function (docs, min) {
+    return docs.filter(function (d) { return d.score >= min }).length;
+  }, [900], 'sum', function (err, count) {
+    if (err) throw err;
+    if (count !== 800) throw 'expected 800, got '+ count;
+
+    pool.scatter(function (docs, k) {
+      return docs.slice().sort(function (a, b) { return b.score- a.score }).slice(0, k);
+    }, [5], { kind: 'topK', k: 5, key: 'score' }, function (err, top) {
+      if (err) throw err;
+      if (top.length !== 5 || top[0].score !== 999 || top[4].score > top[0].score) throw 'wrong top 5';
+
+      pool.scatter(function (docs) {
+        return docs.map(function (d) { return d.id }).filter(function (id) { return id % 100 === 0 });
+      }, [], 'merge', function (err, ids) {
+        if (err) throw err;
+        if (ids.length !== 80) throw 'expected 80 ids';
+        for (var j= 1; j < ids.length; j++) if (ids[j- 1] > ids[j]) throw 'the merge is out of order';
+        pool.destroy();
+        console.log('OK: 8 shards in 3 threads, sum, topK and merge');
+      });
+    });
+  });
+});
+
+process.on('exit', function () {
+  console.log("process.on('exit') -> BYE!");
+});
@@ -0,0 +1,43 @@
+
+
+var T= require('webworker-threads');
+
+var numThreads= 4;
+var increments= 10000;
+var pool= T.createPool(numThreads);
+var map= new T.SharedMap('test46', { maxEntries: 1000 });
+
+map.set('greeting', 'hello').set(7, { seven: [7] });
+if (map.get('greeting') !== 'hello') throw 'get a string';
+if (map.get(7).seven[0] !== 7) throw 'get an object';
+if (!map.cas('lock', undefined, 'mine') || map.cas('lock', undefined, 'yours')) throw 'cas of a missing key';
+if (!map.cas('lock', 'mine', undefined) || map.has('lock')) throw 'cas to delete';
+map.set(NaN, 'nan').set(-Infinity, 'minf').set(1e300, 'big').set(-2, 'int');
+if (map.get(NaN) !== 'nan' || map.get(-Infinity) !== 'minf' || map.get(1e300) !== 'big' || map.get(-2) !== 'int') throw 'keys that are no int64_t';
+
+pool.all.eval('var shared= new SharedMap("test46")');
+pool.all.eval('function work (n) { for (var i= 0; i < n; i++) { shared.incr("hits"); shared.set(i % 50, thread.id) } return shared.get("greeting") }');
+
+var pending= numThreads;
+pool.all.call('work', [increments], function (err, greeting) {
+  if (err) throw err;
+  if (greeting !== 'hello') throw 'a thread should see the main thread\'s entries';
+  if (--pending) return;
+  var hits= map.get('hits');
+  if (hits !== numThreads* increments) throw 'lost increments: '+ hits;
+  var k= 0;
+  while (k < 2000) map.set('filler'+ k++, k);
+  if (map.size() > 1000) throw 'the map should be bounded, size '+ map.size();
+  if (!map.stats().evictions) throw 'expected evictions';
+  if (map.get('hits') !== hits) throw 'a counter was evicted';
+  var small= new T.SharedMap('test46-small', { maxEntries: 64 });
+  k= 0;
+  while (k < 1000) small.set('filler'+ k++, k);
+  if (small.size() !== 64) throw 'a small map should be full, size '+ small.size();
+  pool.destroy();
+  console.log('OK: '+ hits+ ' atomic increments from '+ numThreads+ ' threads');
+});
+
+process.on('exit', function () {
+  console.log("process.on('exit') -> BYE!");
+});
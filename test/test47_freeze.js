@@ -0,0 +1,65 @@
+
+
+var T= require('webworker-threads');
+
+var numThreads= 4;
+var pool= T.createPool(numThreads);
+
+var long= new Array(200).join('x');
+var table= { names: [], byCode: {}, when: new Date(0), pi: 3.14159, big: 3e9, neg: -42, nothing: null, yes: true, skip: undefined, long: long, 'ñandú': 'ü' };
+var i= 0;
+while (i < 1000) {
+  table.names.push('name'+ i);
+  table.byCode['c'+ i]= { code: i, even: !(i % 2) };
+  i++;
+}
+
+var view= T.freeze('test47', table);
+if (view.pi !== 3.14159 || view.big !== 3e9 || view.neg !== -42 || view.nothing !== null || view.yes !== true) throw 'numbers and constants';
+if ('skip' in view || view.when !== new Date(0).toJSON()) throw 'as JSON.stringify() would have it';
+if (view.long !== long || view['ñandú'] !== 'ü') throw 'strings';
+if (view.names.length !== 1000 || view.names[999] !== 'name999' || view.names[1000] !== undefined) throw 'arrays';
+if (view.names.slice(1, 3).join() !== 'name1,name2') throw 'arrays should have Array.prototype';
+if (view.byCode.c7.code !== 7 || view.byCode.c8.even !== true || view.byCode.c1000) throw 'nested objects';
+if (Object.keys(view)[0] !== 'names' || Object.keys(view.byCode).length !== 1000) throw 'keys, in order';
+if (JSON.stringify(T.frozen('test47').byCode.c3) !== '{"code":3,"even":false}') throw 'frozen()';
+
+var threw= false;
+try { view.pi= 3 } catch (e) { threw= true }
+if (!threw || view.pi !== 3.14159) throw 'frozen objects should be read-only';
+
+var circular= {};
+circular.self= circular;
+threw= false;
+try { T.freeze('circular', circular) } catch (e) { threw= true }
+if (!threw) throw 'freezing a circular object should throw';
+
+var bytes= T.frozenStats().bytes;
+if (!bytes || T.frozenStats().snapshots !== 1) throw 'frozenStats()';
+
+threw= false;
+try { T.freeze('undefined', { toJSON: function () {} }) } catch (e) { threw= true }
+if (!threw) throw 'a toJSON() that returns no object should throw';
+
+var odd= { n: new Number(1), s: new String('s'), b: new Boolean(false) };
+Object.defineProperty(odd, 'hidden', { value: 1, enumerable: false });
+if (JSON.stringify(T.freeze('odd', odd)) !== JSON.stringify(odd)) throw 'boxed primitives and non-enumerable properties, as JSON.stringify() has them';
+T.unfreeze('odd');
+
+pool.all.eval('var table= frozen("test47")');
+pool.all.eval('function lookup (code) { return [table.byCode["c"+ code].code, table.names[code], table.names.length, typeof frozen("nope")] }');
+
+var pending= numThreads;
+pool.all.call('lookup', [500], function (err, result) {
+  if (err) throw err;
+  if (result.join() !== '500,name500,1000,undefined') throw 'a thread should read the same snapshot: '+ result;
+  if (--pending) return;
+  if (!T.unfreeze('test47') || T.unfreeze('test47') || T.frozen('test47')) throw 'unfreeze()';
+  if (view.byCode.c999.code !== 999) throw 'views outlive the name';
+  pool.destroy();
+  console.log('OK: '+ numThreads+ ' threads read one snapshot of '+ bytes+ ' bytes');
+});
+
+process.on('exit', function () {
+  console.log("process.on('exit') -> BYE!");
+});
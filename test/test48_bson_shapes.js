@@ -0,0 +1,43 @@
+
+
+var T= require('webworker-threads');
+
+// The deserializer makes documents with the keys it has seen before out of a
+// cached boilerplate: the objects must be the same as if it didn't.
+var thread= T.create();
+
+function documents () {
+  var big= {};
+  for (var i= 0; i < 100; i++) big['k'+ i]= i;
+  var shapes= [];
+  for (var i= 0; i < 6; i++) {
+    shapes.push({ a: i, b: 'x'+ i, c: [i, { d: i }] });
+    shapes.push({ b: i, a: i });
+    shapes.push({ a: i, b: 'y', c: null, e: true });
+    shapes.push({ '0': i, '1': i+ 1, z: i });
+    shapes.push(big);
+    shapes.push({});
+  }
+  return shapes;
+}
+
+thread.eval(documents.toString());
+thread.call('documents', [], function (err, shapes) {
+  if (err) throw err;
+  for (var i= 0; i < 6; i++) {
+    var s= shapes.slice(i* 6, i* 6+ 6);
+    if (JSON.stringify(s[0]) !== JSON.stringify({ a: i, b: 'x'+ i, c: [i, { d: i }] })) throw 'shape 0, round '+ i;
+    if (Object.keys(s[1]).join() !== 'b,a' || s[1].a !== i) throw 'the keys should keep their order, round '+ i;
+    if (JSON.stringify(s[2]) !== JSON.stringify({ a: i, b: 'y', c: null, e: true })) throw 'shape 2, round '+ i;
+    if (s[3][0] !== i || s[3]['1'] !== i+ 1 || s[3].z !== i) throw 'numeric keys, round '+ i;
+    if (Object.keys(s[4]).length !== 100 || s[4].k99 !== 99) throw 'more keys than the shape cache takes, round '+ i;
+    if (Object.keys(s[5]).length) throw 'empty objects, round '+ i;
+  }
+  if (shapes[0] === shapes[6] || shapes[0].c === shapes[6].c) throw 'objects must not be shared';
+  thread.destroy();
+  console.log('OK: '+ shapes.length+ ' documents');
+});
+
+process.on('exit', function () {
+  console.log("process.on('exit') -> BYE!");
+});
@@ -0,0 +1,47 @@
+
+
+var T= require('webworker-threads');
+
+var pool= T.createPool(2, { batch: { maxJobs: 32, lingerMs: 1 } });
+pool.all.eval('function sq (x) { if (x === 13) throw "unlucky"; if (x === 7) return { toBSON: 7 }; return x* x }');
+pool.all.eval('var lib= { k: 3, times: function (x) { return x* this.k } }');
+
+var n= 5000, done= 0, errors= 0;
+var i= 0;
+while (i < n) (function (i) {
+  pool.any.call('sq', [i], function (err, result) {
+    if (i === 13) {
+      if (!err || !/unlucky/.test(err.message)) throw 'the error of a batched call should go to its own callback';
+      errors++;
+    }
+    else if (i === 7) {
+      if (!err || !/toBSON/.test(err.message)) throw 'a result that can\'t be serialized should fail its own call';
+      errors++;
+    }
+    else if (err || result !== i* i) throw 'sq('+ i+ ') returned '+ result;
+    finish();
+  });
+})(i++);
+
+pool.any.call('lib.times', 5, function (err, result) {
+  if (result !== 15) throw 'a batched call should have its holder as this';
+  finish();
+});
+
+pool.any.call('sort', new Float64Array([3, 1, 2]), function (err) {
+  if (!err) throw 'calls with typed arrays should still go on their own';
+  finish();
+});
+
+function finish () {
+  if (++done < n+ 2) return;
+  var stats= pool.batchStats();
+  if (errors !== 2) throw 'expected 2 errors, got '+ errors;
+  if (!stats.batches || stats.average <= 1) throw 'expected batches';
+  pool.destroy();
+  console.log('OK: '+ stats.batched+ ' calls in '+ stats.batches+ ' batches, '+ stats.average.toFixed(1)+ ' per batch');
+}
+
+process.on('exit', function () {
+  console.log("process.on('exit') -> BYE!");
+});
@@ -0,0 +1,44 @@
+
+
+var T= require('webworker-threads');
+
+var pool= T.createPool(1, { queue: 'edf' });
+pool.all.eval('function id (x) { return x } function spin (ms) { var t= Date.now(); while (Date.now()- t < ms); }');
+
+var order= [], dropped= 0, done= 0;
+var now= Date.now();
+
+// Keeps the only thread busy while the rest are queued
+pool.any.call('spin', [200], function () { finish() });
+
+[500, 100, 400, 200, 300].forEach(function (ms) {
+  pool.any.call('id', [ms], { deadline: now+ 60000+ ms }, function (err, result) {
+    if (err) throw err;
+    order.push(result);
+    finish();
+  });
+});
+
+pool.any.call('id', ['whenever'], function (err, result) {
+  order.push(result);
+  finish();
+});
+
+pool.any.call('id', ['too late'], { deadline: now+ 50 }, function (err, result) {
+  if (!err || err.code !== 'EDEADLINE') throw 'a call whose deadline has passed should not run';
+  dropped++;
+  finish();
+});
+
+function finish () {
+  if (++done < 8) return;
+  var stats= pool.deadlineStats();
+  if (order.join() !== '100,200,300,400,500,whenever') throw 'not earliest deadline first: '+ order;
+  if (dropped !== 1 || stats.dropped !== 1 || stats.met !== 5) throw 'bad deadlineStats '+ JSON.stringify(stats);
+  pool.destroy();
+  console.log('OK: '+ order+ ', '+ stats.dropped+ ' dropped');
+}
+
+process.on('exit', function () {
+  console.log("process.on('exit') -> BYE!");
+});
@@ -0,0 +1,43 @@
+
+
+var T= require('webworker-threads');
+
+var pool= T.createPool(1, { shed: { targetMs: 10, intervalMs: 50 } });
+pool.all.eval('function spin (ms) { var t= Date.now(); while (Date.now()- t < ms); return ms }');
+
+var n= 20, done= 0, rejected= 0, shed= 0;
+
+// A standing queue: 20 jobs of 20ms for 1 thread
+var i= 0;
+while (i++ < n) pool.any.call('spin', [20], function (err) {
+  if (err) throw 'only the low priority calls should be shed: '+ err;
+  finish();
+});
+
+// Queued before the pool got overloaded, dropped when its turn comes
+pool.any.call('spin', [1], { priority: 'low' }, function (err) {
+  if (!err || err.code !== 'EOVERLOAD') throw 'expected the queued low priority call to be shed';
+  shed++;
+  finish();
+});
+
+setTimeout(function () {
+  if (!pool.shedStats().dropping) throw 'the pool should be shedding by now';
+  pool.any.call('spin', [1], { priority: 'low' }, function (err) {
+    if (!err || err.code !== 'EOVERLOAD') throw 'expected the new low priority call to be rejected';
+    rejected++;
+    finish();
+  });
+}, 200);
+
+function finish () {
+  if (++done < n+ 2) return;
+  var stats= pool.shedStats();
+  if (stats.rejected !== 1 || stats.shed !== 1 || stats.episodes < 1) throw 'bad shedStats '+ JSON.stringify(stats);
+  pool.destroy();
+  console.log('OK: '+ stats.rejected+ ' rejected, '+ stats.shed+ ' shed');
+}
+
+process.on('exit', function () {
+  console.log("process.on('exit') -> BYE!");
+});
@@ -0,0 +1,39 @@
+
+
+var T= require('webworker-threads');
+
+T.setStallThreshold(200);
+
+var t= T.create();
+var stalls= [];
+
+t.on('stall', function (stall) {
+  stalls.push(stall);
+});
+
+t.eval('function stuck (ms) { var t= Date.now(); while (Date.now()- t < ms); return ms }');
+t.eval('function quick (x) { return x }');
+
+t.call('quick', [1], function (err) {
+  if (err) throw err;
+  t.call('stuck', [1000], function (err, result) {
+    if (err) throw err;
+    // The event may still be on its way
+    setTimeout(done, 100);
+  });
+});
+
+function done () {
+  if (stalls.length !== 1) throw 'expected 1 stall, got '+ stalls.length;
+  var stall= stalls[0];
+  if (stall.thread !== t.id || !(stall.ms >= 200)) throw 'bad stall '+ JSON.stringify(stall);
+  if (!/at stuck \(/.test(stall.stack)) throw 'expected stuck() in the stack:\n'+ stall.stack;
+  if (T.stats().stalls < 1) throw 'expected the stall in stats()';
+  T.setStallThreshold(0);
+  t.destroy();
+  console.log('OK: a stall after '+ Math.round(stall.ms)+ 'ms at\n'+ stall.stack);
+}
+
+process.on('exit', function () {
+  console.log("process.on('exit') -> BYE!");
+});
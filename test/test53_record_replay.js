@@ -0,0 +1,54 @@
+
+
+var T= require('webworker-threads');
+var fs= require('fs');
+
+var path= '/tmp/webworker-threads-test53.'+ process.pid+ '.log';
+
+T.startRecording(path);
+
+var t= T.create();
+t.eval('function add (a, b) { return a+ b }');
+t.call('add', [1, 2], function (err, result) {
+  if (err || result !== 3) throw 'thread.call() failed: '+ err;
+
+  var pool= T.createPool(2);
+  pool.all.eval('function add (a, b) { return a+ b }');
+  pool.any.call('add', [{ x: 1 }, 'y'], function (err) {
+    if (err) throw err;
+    pool.any.emit('ping', 'pong');
+
+    var stats= T.stopRecording();
+    if (stats.jobs !== 5) throw 'expected 5 jobs recorded, got '+ stats.jobs;
+    pool.any.call('add', [0, 0], function () {
+      check(T.readRecording(path), pool);
+    });
+  });
+});
+
+function check (log, pool) {
+  var r= log.records;
+  if (!(log.startedAt > 0) || (r.length !== 5)) throw 'bad log: '+ JSON.stringify(log);
+  var expected= [
+    ['eval', 'thread', t.id, 'function add (a, b) { return a+ b }'],
+    ['call', 'thread', t.id, 'add', [1, 2]],
+    ['eval', 'all', r[2].target, 'function add (a, b) { return a+ b }'],
+    ['call', 'any', r[2].target, 'add', [{ x: 1 }, 'y']],
+    ['emit', 'any', r[2].target, 'ping', ['pong']]
+  ];
+  expected.forEach(function (e, i) {
+    var got= [r[i].type, r[i].origin, r[i].target, r[i].name];
+    if (e[4]) got.push(r[i].args);
+    if (JSON.stringify(got) !== JSON.stringify(e)) throw 'record '+ i+ ': expected '+ JSON.stringify(e)+ ', got '+ JSON.stringify(got);
+    if (i && (r[i].at < r[i- 1].at)) throw 'records out of order';
+  });
+  if (r[2].target === t.id) throw 'the pool\'s jobs should be recorded as the pool\'s';
+  fs.unlinkSync(path);
+  t.destroy();
+  pool.destroy();
+  console.log('OK: '+ r.length+ ' jobs recorded and read back');
+}
+
+process.on('exit', function () {
+  console.log("process.on('exit') -> BYE!");
+});